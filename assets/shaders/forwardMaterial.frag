@@ -1,9 +1,7 @@
 #version 330 core
 
-uniform vec4 materialAlbedo;
-uniform float materialRoughness;
-uniform float materialMetallic;
+flat in vec4 fragAlbedo;
 
 void main() {
-    gl_FragColor = vec4(materialAlbedo.rgb, 1.0);
+    gl_FragColor = vec4(fragAlbedo.rgb, 1.0);
 }
\ No newline at end of file
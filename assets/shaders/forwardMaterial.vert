@@ -1,14 +1,49 @@
-#version 330 core
+#version 430 core
 layout (location = 0) in vec3 vertexPosition;
 layout (location = 1) in vec3 vertexNormal;
 layout (location = 2) in vec2 vertexTexCoord;
+// Per instance, the instance's slot in its MeshInstanceContainer, see MeshInstanceBuffer
+layout (location = 3) in uint instanceSlot;
 
+// The layouts are shared with InstanceData and InstanceMaterial in MeshInstanceList
+struct InstanceData
+{
+    mat4 transform;
+    uint materialOffset;
+    uint pickId;
+};
+
+struct InstanceMaterial
+{
+    vec4 albedo;
+    float roughness;
+    float metallic;
+};
+
+layout(std430, binding = 4) readonly buffer Instances
+{
+    InstanceData instances[];
+};
+
+layout(std430, binding = 5) readonly buffer InstanceMaterials
+{
+    InstanceMaterial materials[];
+};
+
+flat out vec4 fragAlbedo;
+
+// The primitive's transform inside the model
 uniform mat4 matModel;
 uniform mat4 matView;
 uniform mat4 matProjection;
+// The primitive's material, relative to the instance's first material
+uniform uint materialIndex;
 
 void main()
 {
-    vec4 worldPos = matModel * vec4(vertexPosition, 1.0);
+    InstanceData instance = instances[instanceSlot];
+    vec4 worldPos = instance.transform * matModel * vec4(vertexPosition, 1.0);
+    fragAlbedo = materials[instance.materialOffset + materialIndex].albedo;
+
     gl_Position = matProjection * matView * worldPos;
 }
\ No newline at end of file
@@ -8,10 +8,8 @@ layout (location = 4) out float gDepth;
 in vec3 fragPosition;
 in vec3 fragNormal;
 in vec2 fragTexCoord;
-
-uniform vec4 materialAlbedo;
-uniform float materialRoughness;
-uniform float materialMetallic;
+flat in vec4 fragAlbedo;
+flat in vec2 fragRoughnessMetallic;
 
 uniform sampler2D diffuseTexture;
 uniform sampler2D specularTexture;
@@ -19,7 +17,7 @@ uniform sampler2D specularTexture;
 void main() {
     gPosition = fragPosition;
     gNormal = normalize(fragNormal);
-    gAlbedo = materialAlbedo.rgb;
-    gMetallicRoughness = vec2(materialRoughness, materialMetallic);
+    gAlbedo = fragAlbedo.rgb;
+    gMetallicRoughness = fragRoughnessMetallic;
     gDepth = gl_FragDepth;
 }
\ No newline at end of file
@@ -1,24 +1,62 @@
-#version 330 core
+#version 430 core
 layout (location = 0) in vec3 vertexPosition;
 layout (location = 1) in vec3 vertexNormal;
 layout (location = 2) in vec2 vertexTexCoord;
+// Per instance, the instance's slot in its MeshInstanceContainer, see MeshInstanceBuffer
+layout (location = 3) in uint instanceSlot;
+
+// The layouts are shared with InstanceData and InstanceMaterial in MeshInstanceList
+struct InstanceData
+{
+    mat4 transform;
+    uint materialOffset;
+    uint pickId;
+};
+
+struct InstanceMaterial
+{
+    vec4 albedo;
+    float roughness;
+    float metallic;
+};
+
+layout(std430, binding = 4) readonly buffer Instances
+{
+    InstanceData instances[];
+};
+
+layout(std430, binding = 5) readonly buffer InstanceMaterials
+{
+    InstanceMaterial materials[];
+};
 
 out vec3 fragPosition;
 out vec2 fragTexCoord;
 out vec3 fragNormal;
+flat out vec4 fragAlbedo;
+flat out vec2 fragRoughnessMetallic;
 
+// The primitive's transform inside the model
 uniform mat4 matModel;
 uniform mat4 matView;
 uniform mat4 matProjection;
+// The primitive's material, relative to the instance's first material
+uniform uint materialIndex;
 
 void main()
 {
-    vec4 worldPos = matModel * vec4(vertexPosition, 1.0);
+    InstanceData instance = instances[instanceSlot];
+    mat4 matWorld = instance.transform * matModel;
+    vec4 worldPos = matWorld * vec4(vertexPosition, 1.0);
     fragPosition = worldPos.xyz; 
     fragTexCoord = vertexTexCoord;
 
-    mat3 normalMatrix = transpose(inverse(mat3(matModel)));
+    mat3 normalMatrix = transpose(inverse(mat3(matWorld)));
     fragNormal = normalMatrix * vertexNormal;
 
+    InstanceMaterial material = materials[instance.materialOffset + materialIndex];
+    fragAlbedo = material.albedo;
+    fragRoughnessMetallic = vec2(material.roughness, material.metallic);
+
     gl_Position = matProjection * matView * worldPos;
 }
\ No newline at end of file
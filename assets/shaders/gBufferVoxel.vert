@@ -1,26 +1,40 @@
 #version 330 core
-layout (location = 0) in vec3 vertexPosition;
-layout (location = 1) in vec2 vertexTexCoord;
-layout (location = 2) in vec3 vertexNormal;
-layout (location = 3) in uint vertexTextureId;
+// See VoxelVertex, positions and texture coordinates use 6 bits per axis
+layout (location = 0) in uvec2 packedVertex;
+// Per draw, every chunk is a single instance of the multi-draw
+layout (location = 1) in vec3 chunkOffset;
 
 out vec3 fragPosition;
 out vec2 fragTexCoord;
 out vec3 fragNormal;
 flat out uint fragTextureId;
 
-uniform mat4 matModel;
 uniform mat4 matView;
 uniform mat4 matProjection;
 
+// Indexed by VoxelFace
+const vec3 faceNormals[6] = vec3[6](
+    vec3(0.0, 1.0, 0.0),
+    vec3(0.0, -1.0, 0.0),
+    vec3(-1.0, 0.0, 0.0),
+    vec3(1.0, 0.0, 0.0),
+    vec3(0.0, 0.0, 1.0),
+    vec3(0.0, 0.0, -1.0)
+);
+
 void main()
 {
-    vec4 worldPos = matModel * vec4(vertexPosition, 1.0);
+    vec3 vertexPosition = vec3(packedVertex.x & 63u, (packedVertex.x >> 6) & 63u, (packedVertex.x >> 12) & 63u);
+    vec3 vertexNormal = faceNormals[int((packedVertex.x >> 18) & 7u)];
+    vec2 vertexTexCoord = vec2(packedVertex.y & 63u, (packedVertex.y >> 6) & 63u);
+    uint vertexTextureId = packedVertex.y >> 12;
+
+    vec4 worldPos = vec4(vertexPosition + chunkOffset, 1.0);
     fragPosition = worldPos.xyz; 
     fragTexCoord = vertexTexCoord;
 
-    mat3 normalMatrix = transpose(inverse(mat3(matModel)));
-    fragNormal = normalMatrix * vertexNormal;
+    // Chunks are only ever translated, so the normals are already in world space
+    fragNormal = vertexNormal;
     fragTextureId = vertexTextureId;
 
     gl_Position = matProjection * matView * worldPos;
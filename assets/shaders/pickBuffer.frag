@@ -1,8 +1,8 @@
 #version 330 core
 
-uniform uint objectId;
+flat in uint fragObjectId;
 layout (location = 0) out uint object;
 
 void main() {
-    object = objectId;
+    object = fragObjectId;
 }
\ No newline at end of file
@@ -8,11 +8,20 @@ layout (location = 4) in vec4 vertexWeights;
 out vec3 fragPosition;
 out vec2 fragTexCoord;
 out vec3 fragNormal;
+// Skeletal meshes aren't instanced, so these come straight from uniforms
+flat out vec4 fragAlbedo;
+flat out vec2 fragRoughnessMetallic;
+flat out uint fragObjectId;
 
 uniform mat4 matModel;
 uniform mat4 matView;
 uniform mat4 matProjection;
 
+uniform vec4 materialAlbedo;
+uniform float materialRoughness;
+uniform float materialMetallic;
+uniform uint objectId;
+
 uniform data
 {
     mat4 transform[64];
@@ -34,5 +43,9 @@ void main()
     mat3 normalMatrix = transpose(inverse(mat3(matSkin)));
     fragNormal = normalMatrix * vertexNormal;
 
+    fragAlbedo = materialAlbedo;
+    fragRoughnessMetallic = vec2(materialRoughness, materialMetallic);
+    fragObjectId = objectId;
+
     gl_Position = matProjection * matView * worldPos;
 }
\ No newline at end of file
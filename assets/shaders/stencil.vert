@@ -1,5 +1,20 @@
-#version 330 core
+#version 430 core
 layout (location = 0) in vec3 vertexPosition;
+// Per instance, the instance's slot in its MeshInstanceContainer, see MeshInstanceBuffer
+layout (location = 3) in uint instanceSlot;
+
+// The layout is shared with InstanceData in MeshInstanceList
+struct InstanceData
+{
+    mat4 transform;
+    uint materialOffset;
+    uint pickId;
+};
+
+layout(std430, binding = 4) readonly buffer Instances
+{
+    InstanceData instances[];
+};
 
 uniform mat4 matModel;
 uniform mat4 matView;
@@ -7,6 +22,7 @@ uniform mat4 matProjection;
 
 void main()
 {
-    vec4 worldPos = matModel * vec4(vertexPosition, 1.0);
+    InstanceData instance = instances[instanceSlot];
+    vec4 worldPos = instance.transform * matModel * vec4(vertexPosition, 1.0);
     gl_Position = matProjection * matView * worldPos;
 }
\ No newline at end of file
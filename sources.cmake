@@ -22,13 +22,19 @@ target_sources(Vox PRIVATE
 	"src/core/datatypes/DelegateHandle.h"
 	"src/core/datatypes/DynamicObjectContainer.h"
 	"src/core/datatypes/DynamicRef.h"
+	"src/core/datatypes/MappedFile.cpp"
+	"src/core/datatypes/MappedFile.h"
 	"src/core/datatypes/ObjectContainer.h"
+	"src/core/datatypes/RangeAllocator.cpp"
+	"src/core/datatypes/RangeAllocator.h"
 	"src/core/datatypes/Ref.h"
 	"src/core/datatypes/Transform.cpp"
 	"src/core/datatypes/Transform.h"
 	"src/core/datatypes/WeakRef.h"
 	"src/core/logging/Logging.cpp"
 	"src/core/logging/Logging.h"
+	"src/core/math/BoundingBox.cpp"
+	"src/core/math/BoundingBox.h"
 	"src/core/math/Formatting.cpp"
 	"src/core/math/Formatting.h"
 	"src/core/math/Math.cpp"
@@ -77,6 +83,8 @@ target_sources(Vox PRIVATE
 	"src/core/services/ObjectService.h"
 	"src/core/services/ServiceLocator.cpp"
 	"src/core/services/ServiceLocator.h"
+	"src/core/services/ThreadPool.cpp"
+	"src/core/services/ThreadPool.h"
 
 	"src/editor/AssetDisplayWindow.cpp"
 	"src/editor/AssetDisplayWindow.h"
@@ -130,25 +138,39 @@ target_sources(Vox PRIVATE
 	"src/physics/VoxelBody.cpp"
 	"src/physics/VoxelBody.h"
 
+	"src/rendering/CountingRenderBackend.cpp"
+	"src/rendering/CountingRenderBackend.h"
 	"src/rendering/DebugRenderer.cpp"
 	"src/rendering/DebugRenderer.h"
+	"src/rendering/FrustumCuller.cpp"
+	"src/rendering/FrustumCuller.h"
 	"src/rendering/FullscreenQuad.cpp"
 	"src/rendering/FullscreenQuad.h"
+	"src/rendering/GLRenderBackend.cpp"
+	"src/rendering/GLRenderBackend.h"
 	"src/rendering/Light.cpp"
 	"src/rendering/Light.h"
 	"src/rendering/PBRMaterial.h"
 	"src/rendering/PickContainer.cpp"
 	"src/rendering/PickContainer.h"
+	"src/rendering/RenderQueue.cpp"
+	"src/rendering/RenderQueue.h"
 	"src/rendering/Renderer.cpp"
 	"src/rendering/Renderer.h"
 	"src/rendering/SceneRenderer.cpp"
 	"src/rendering/SceneRenderer.h"
 	"src/rendering/buffers/ArrayTexture.cpp"
 	"src/rendering/buffers/ArrayTexture.h"
+	"src/rendering/buffers/JointPaletteBuffer.cpp"
+	"src/rendering/buffers/JointPaletteBuffer.h"
+	"src/rendering/buffers/MeshInstanceBuffer.cpp"
+	"src/rendering/buffers/MeshInstanceBuffer.h"
 	"src/rendering/buffers/RenderTexture.cpp"
 	"src/rendering/buffers/RenderTexture.h"
 	"src/rendering/buffers/Texture.cpp"
 	"src/rendering/buffers/Texture.h"
+	"src/rendering/buffers/VoxelGeometryArena.cpp"
+	"src/rendering/buffers/VoxelGeometryArena.h"
 	"src/rendering/buffers/frame_buffers/ColorDepthFramebuffer.cpp"
 	"src/rendering/buffers/frame_buffers/ColorDepthFramebuffer.h"
 	"src/rendering/buffers/frame_buffers/Framebuffer.cpp"
@@ -165,20 +187,32 @@ target_sources(Vox PRIVATE
 	"src/rendering/camera/Camera.h"
 	"src/rendering/camera/FlyCamera.cpp"
 	"src/rendering/camera/FlyCamera.h"
+	"src/rendering/camera/Frustum.cpp"
+	"src/rendering/camera/Frustum.h"
 	"src/rendering/gizmos/Gizmo.cpp"
 	"src/rendering/gizmos/Gizmo.h"
 	"src/rendering/mesh/MeshInstance.cpp"
 	"src/rendering/mesh/MeshInstance.h"
 	"src/rendering/mesh/MeshInstanceContainer.cpp"
 	"src/rendering/mesh/MeshInstanceContainer.h"
+	"src/rendering/mesh/MeshInstanceList.cpp"
+	"src/rendering/mesh/MeshInstanceList.h"
 	"src/rendering/mesh/Model.cpp"
 	"src/rendering/mesh/Model.h"
 	"src/rendering/mesh/ModelNode.cpp"
 	"src/rendering/mesh/ModelNode.h"
 	"src/rendering/mesh/Primitive.cpp"
 	"src/rendering/mesh/Primitive.h"
+	"src/rendering/mesh/VoxelDrawList.cpp"
+	"src/rendering/mesh/VoxelDrawList.h"
 	"src/rendering/mesh/VoxelMesh.cpp"
 	"src/rendering/mesh/VoxelMesh.h"
+	"src/rendering/mesh/VoxelMeshGenerator.cpp"
+	"src/rendering/mesh/VoxelMeshGenerator.h"
+	"src/rendering/mesh/VoxelMesherBackend.cpp"
+	"src/rendering/mesh/VoxelMesherBackend.h"
+	"src/rendering/mesh/VoxelRemeshScheduler.cpp"
+	"src/rendering/mesh/VoxelRemeshScheduler.h"
 	"src/rendering/shaders/compute_shaders/ComputeShader.cpp"
 	"src/rendering/shaders/compute_shaders/ComputeShader.h"
 	"src/rendering/shaders/compute_shaders/VoxelGenerationShader.cpp"
@@ -213,28 +247,47 @@ target_sources(Vox PRIVATE
 	"src/rendering/skeletal_mesh/Animation.h"
 	"src/rendering/skeletal_mesh/AnimationChannel.cpp"
 	"src/rendering/skeletal_mesh/AnimationChannel.h"
+	"src/rendering/skeletal_mesh/AnimationImportSettings.h"
+	"src/rendering/skeletal_mesh/CompressedAnimation.cpp"
+	"src/rendering/skeletal_mesh/CompressedAnimation.h"
 	"src/rendering/skeletal_mesh/SkeletalMeshInstance.cpp"
 	"src/rendering/skeletal_mesh/SkeletalMeshInstance.h"
 	"src/rendering/skeletal_mesh/SkeletalMeshInstanceContainer.cpp"
 	"src/rendering/skeletal_mesh/SkeletalMeshInstanceContainer.h"
 	"src/rendering/skeletal_mesh/SkeletalModel.cpp"
 	"src/rendering/skeletal_mesh/SkeletalModel.h"
+	"src/rendering/skeletal_mesh/SkeletalPose.h"
 	"src/rendering/skeletal_mesh/SkeletalPrimitive.h"
 
 	"src/voxel/CollisionOctree.cpp"
 	"src/voxel/CollisionOctree.h"
+	"src/voxel/LinearOctree.h"
 	"src/voxel/Octree.cpp"
 	"src/voxel/Octree.h"
+	"src/voxel/PackedOctree.h"
+	"src/voxel/PalettedVoxelStorage.cpp"
+	"src/voxel/PalettedVoxelStorage.h"
 	"src/voxel/Vector.cpp"
 	"src/voxel/Vector.h"
 	"src/voxel/Voxel.cpp"
 	"src/voxel/Voxel.h"
 	"src/voxel/VoxelChunk.cpp"
 	"src/voxel/VoxelChunk.h"
+	"src/voxel/VoxelChunkMap.cpp"
+	"src/voxel/VoxelChunkMap.h"
 	"src/voxel/VoxelGrid.cpp"
 	"src/voxel/VoxelGrid.h"
 	"src/voxel/VoxelMaterial.cpp"
 	"src/voxel/VoxelMaterial.h"
+	"src/voxel/VoxelMesher.cpp"
+	"src/voxel/VoxelMesher.h"
+	"src/voxel/VoxelStreamingSettings.h"
+	"src/voxel/VoxelVertex.cpp"
+	"src/voxel/VoxelVertex.h"
 	"src/voxel/VoxelWorld.cpp"
 	"src/voxel/VoxelWorld.h"
+	"src/voxel/VoxelWorldFile.cpp"
+	"src/voxel/VoxelWorldFile.h"
+	"src/voxel/VoxelWorldStore.cpp"
+	"src/voxel/VoxelWorldStore.h"
 )
\ No newline at end of file
@@ -152,12 +152,13 @@ int main()
         ServiceLocator::GetObjectService()->RegisterPrefab("test.json");
 
         testWorld->Load(SavedWorld(ServiceLocator::GetFileIoService()->LoadFile("worlds/MainWorld.world")));
-        testWorld->LoadVoxels("MainWorld");
+        testWorld->LoadVoxels("MainWorld", config.voxelStreaming);
 
         while (!ServiceLocator::GetInputService()->ShouldCloseWindow())
         {
             ServiceLocator::GetInputService()->PollEvents();
             testWorld->Tick(1 / 60.0f);
+            testWorld->UpdateVoxelStreaming();
             ServiceLocator::GetRenderer()->Render(ServiceLocator::GetEditorService()->GetEditor());
         }
         runPhysics = false;
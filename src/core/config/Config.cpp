@@ -1,5 +1,7 @@
 #include "Config.h"
 
+#include <algorithm>
+
 #include <nlohmann/json.hpp>
 #include <SDL3/SDL_iostream.h>
 
@@ -68,6 +70,27 @@ namespace Vox
 	            windowMaximized = window["maximized"];
 	        }
 	    }
+	    if (configJson.contains("voxelStreaming"))
+	    {
+	        json& streaming = configJson["voxelStreaming"];
+	        if (streaming.contains("enabled") && streaming["enabled"].is_boolean())
+	        {
+	            voxelStreaming.enabled = streaming["enabled"];
+	        }
+	        if (streaming.contains("loadRadius") && streaming["loadRadius"].is_number_integer())
+	        {
+	            voxelStreaming.loadRadius = std::max(streaming["loadRadius"].get<int>(), 0);
+	        }
+	        if (streaming.contains("unloadRadius") && streaming["unloadRadius"].is_number_integer())
+	        {
+	            voxelStreaming.unloadRadius = streaming["unloadRadius"];
+	        }
+	        if (streaming.contains("memoryBudgetMiB") && streaming["memoryBudgetMiB"].is_number_unsigned())
+	        {
+	            voxelStreaming.memoryBudgetMiB = streaming["memoryBudgetMiB"];
+	        }
+	        voxelStreaming.unloadRadius = std::max(voxelStreaming.unloadRadius, voxelStreaming.loadRadius + 1);
+	    }
 	}
 
 	void VoxConfig::Write()
@@ -85,6 +108,10 @@ namespace Vox
 		configJson["window"]["w"] = windowSize.x;
 		configJson["window"]["h"] = windowSize.y;
 		configJson["window"]["maximized"] = windowMaximized;
+		configJson["voxelStreaming"]["enabled"] = voxelStreaming.enabled;
+		configJson["voxelStreaming"]["loadRadius"] = voxelStreaming.loadRadius;
+		configJson["voxelStreaming"]["unloadRadius"] = voxelStreaming.unloadRadius;
+		configJson["voxelStreaming"]["memoryBudgetMiB"] = voxelStreaming.memoryBudgetMiB;
 
 		std::string configString = configJson.dump(4);
 		SDL_WriteIO(configStream, configString.c_str(), configString.size());
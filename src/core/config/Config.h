@@ -4,6 +4,8 @@
 
 #include <glm/vec2.hpp>
 
+#include "voxel/VoxelStreamingSettings.h"
+
 namespace Vox
 {
 	class VoxConfig
@@ -22,5 +24,7 @@ namespace Vox
 		glm::ivec2 windowSize;
 		
 		bool windowMaximized;
+
+		VoxelStreamingSettings voxelStreaming;
 	};
 }
\ No newline at end of file
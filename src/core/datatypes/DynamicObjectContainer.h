@@ -29,7 +29,7 @@ namespace Vox
 		{
 			for (const std::pair<size_t, int>& dirtyInstance : dirtyInstances)
 			{
-				if (dirtyInstance.first == index)
+				if (dirtyInstance.first == index && dirtyInstance.second == id)
 				{
 					return;
 				}
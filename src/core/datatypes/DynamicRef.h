@@ -27,12 +27,23 @@ namespace Vox
 			return container->Get(index, id);
 		}
 
+		const T* operator->() const
+		{
+			assert(container);
+			return container->Get(index, id);
+		}
+
 		void MarkDirty()
 		{
 			assert(container);
 			container->MarkDirty(index, id);
 		}
 
+		[[nodiscard]] std::pair<size_t, int> GetId() const
+		{
+			return {index, id};
+		}
+
 	private:
 		DynamicObjectContainer<T>* container;
 		size_t index;
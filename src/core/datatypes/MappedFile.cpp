@@ -0,0 +1,140 @@
+#include "MappedFile.h"
+
+#include <utility>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace Vox
+{
+    MappedFile::MappedFile(const std::string& filepath)
+    {
+#ifdef _WIN32
+        fileHandle = CreateFileA(filepath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (fileHandle == INVALID_HANDLE_VALUE)
+        {
+            fileHandle = nullptr;
+            return;
+        }
+
+        LARGE_INTEGER fileSize;
+        if (!GetFileSizeEx(fileHandle, &fileSize) || fileSize.QuadPart == 0)
+        {
+            Unmap();
+            return;
+        }
+
+        mappingHandle = CreateFileMappingA(fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (!mappingHandle)
+        {
+            Unmap();
+            return;
+        }
+
+        data = static_cast<const char*>(MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0));
+        if (!data)
+        {
+            Unmap();
+            return;
+        }
+        size = static_cast<size_t>(fileSize.QuadPart);
+#else
+        const int fileDescriptor = open(filepath.c_str(), O_RDONLY);
+        if (fileDescriptor < 0)
+        {
+            return;
+        }
+
+        struct stat fileStat = {};
+        if (fstat(fileDescriptor, &fileStat) == 0 && fileStat.st_size > 0)
+        {
+            if (void* mapping = mmap(nullptr, static_cast<size_t>(fileStat.st_size), PROT_READ, MAP_PRIVATE, fileDescriptor, 0); mapping != MAP_FAILED)
+            {
+                data = static_cast<const char*>(mapping);
+                size = static_cast<size_t>(fileStat.st_size);
+            }
+        }
+        // The mapping keeps its own reference to the file
+        close(fileDescriptor);
+#endif
+    }
+
+    MappedFile::~MappedFile()
+    {
+        Unmap();
+    }
+
+    MappedFile::MappedFile(MappedFile&& other) noexcept
+    {
+        *this = std::move(other);
+    }
+
+    MappedFile& MappedFile::operator=(MappedFile&& other) noexcept
+    {
+        if (this != &other)
+        {
+            Unmap();
+            data = std::exchange(other.data, nullptr);
+            size = std::exchange(other.size, 0);
+#ifdef _WIN32
+            fileHandle = std::exchange(other.fileHandle, nullptr);
+            mappingHandle = std::exchange(other.mappingHandle, nullptr);
+#endif
+        }
+        return *this;
+    }
+
+    bool MappedFile::IsValid() const
+    {
+        return data != nullptr;
+    }
+
+    const char* MappedFile::GetData() const
+    {
+        return data;
+    }
+
+    size_t MappedFile::GetSize() const
+    {
+        return size;
+    }
+
+    std::string_view MappedFile::GetView() const
+    {
+        return {data, size};
+    }
+
+    void MappedFile::Unmap()
+    {
+#ifdef _WIN32
+        if (data)
+        {
+            UnmapViewOfFile(data);
+        }
+        if (mappingHandle)
+        {
+            CloseHandle(mappingHandle);
+        }
+        if (fileHandle)
+        {
+            CloseHandle(fileHandle);
+        }
+        fileHandle = mappingHandle = nullptr;
+#else
+        if (data)
+        {
+            munmap(const_cast<char*>(data), size);
+        }
+#endif
+        data = nullptr;
+        size = 0;
+    }
+}
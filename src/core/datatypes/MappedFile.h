@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+namespace Vox
+{
+    /**
+     * @brief Read-only memory mapping of a whole file, unmapped when destroyed
+     * This doesn't log, so it can be used from worker threads. Check IsValid after construction
+     */
+    class MappedFile
+    {
+    public:
+        MappedFile() = default;
+        explicit MappedFile(const std::string& filepath);
+        ~MappedFile();
+
+        MappedFile(MappedFile&& other) noexcept;
+        MappedFile& operator=(MappedFile&& other) noexcept;
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        [[nodiscard]] bool IsValid() const;
+
+        [[nodiscard]] const char* GetData() const;
+
+        [[nodiscard]] size_t GetSize() const;
+
+        [[nodiscard]] std::string_view GetView() const;
+
+    private:
+        void Unmap();
+
+        const char* data = nullptr;
+        size_t size = 0;
+
+#ifdef _WIN32
+        void* fileHandle = nullptr;
+        void* mappingHandle = nullptr;
+#endif
+    };
+}
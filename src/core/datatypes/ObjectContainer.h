@@ -50,6 +50,20 @@ namespace Vox
 			return nullptr;
 		}
 
+		const T* Get(size_t index, const int id) const
+		{
+			if (backingIds.at(index) != id)
+			{
+				return nullptr;
+			}
+
+			if (backingData.at(index).has_value())
+			{
+				return &*backingData.at(index);
+			}
+			return nullptr;
+		}
+
 		template <class... Args>
 		std::pair<size_t, int> Create(Args&&... args)
 		{
@@ -69,6 +83,18 @@ namespace Vox
 			return std::pair<size_t, int>(backingData.size() - 1, currentIndex++);
 		}
 
+		/**
+		 * @brief Destroy an object immediately, regardless of its ref count. Stale refs to it will return nullptr
+		 */
+		void Remove(const std::pair<size_t, int> refPair)
+		{
+			if (refPair.first < backingIds.size() && backingIds[refPair.first] == refPair.second)
+			{
+				backingData[refPair.first].reset();
+				backingRefCount[refPair.first] = 0;
+			}
+		}
+
 		[[nodiscard]] size_t size() const
 		{
 			return backingData.size();
@@ -0,0 +1,170 @@
+#include "RangeAllocator.h"
+
+#include <algorithm>
+#include <cassert>
+
+namespace Vox
+{
+    RangeAllocator::RangeAllocator(const size_t capacity)
+        :capacity(capacity)
+    {
+        if (capacity > 0)
+        {
+            AddFreeRange(0, capacity);
+        }
+    }
+
+    RangeAllocator::Handle RangeAllocator::Allocate(const size_t size)
+    {
+        assert(size > 0);
+
+        const auto bestFit = freeRangesBySize.lower_bound({size, 0});
+        if (bestFit == freeRangesBySize.end())
+        {
+            return invalidHandle;
+        }
+
+        const auto [freeSize, freeOffset] = *bestFit;
+        RemoveFreeRange(freeOffset, freeSize);
+        if (freeSize > size)
+        {
+            AddFreeRange(freeOffset + size, freeSize - size);
+        }
+
+        Handle handle;
+        if (unusedHandles.empty())
+        {
+            handle = static_cast<Handle>(allocations.size());
+            allocations.emplace_back();
+        }
+        else
+        {
+            handle = unusedHandles.back();
+            unusedHandles.pop_back();
+        }
+
+        allocations[handle] = {freeOffset, size};
+        usedSize += size;
+        return handle;
+    }
+
+    void RangeAllocator::Free(const Handle handle)
+    {
+        assert(handle < allocations.size() && allocations[handle].size > 0);
+
+        auto [offset, size] = allocations[handle];
+        allocations[handle] = {};
+        unusedHandles.push_back(handle);
+        usedSize -= size;
+
+        // Merge with the free ranges on either side
+        if (const auto next = freeRangesByOffset.find(offset + size); next != freeRangesByOffset.end())
+        {
+            const size_t nextSize = next->second;
+            RemoveFreeRange(offset + size, nextSize);
+            size += nextSize;
+        }
+
+        if (auto previous = freeRangesByOffset.lower_bound(offset); previous != freeRangesByOffset.begin())
+        {
+            --previous;
+            if (const auto [previousOffset, previousSize] = *previous; previousOffset + previousSize == offset)
+            {
+                RemoveFreeRange(previousOffset, previousSize);
+                offset = previousOffset;
+                size += previousSize;
+            }
+        }
+
+        AddFreeRange(offset, size);
+    }
+
+    RangeAllocator::Range RangeAllocator::GetRange(const Handle handle) const
+    {
+        assert(handle < allocations.size() && allocations[handle].size > 0);
+        return allocations[handle];
+    }
+
+    std::vector<RangeAllocator::Move> RangeAllocator::Compact(const size_t newCapacity)
+    {
+        assert(newCapacity >= usedSize);
+
+        std::vector<Handle> liveHandles;
+        liveHandles.reserve(allocations.size() - unusedHandles.size());
+        for (Handle handle = 0; handle < allocations.size(); ++handle)
+        {
+            if (allocations[handle].size > 0)
+            {
+                liveHandles.push_back(handle);
+            }
+        }
+        std::ranges::sort(liveHandles, [this](const Handle a, const Handle b)
+        {
+            return allocations[a].offset < allocations[b].offset;
+        });
+
+        std::vector<Move> moves;
+        size_t nextOffset = 0;
+        for (const Handle handle : liveHandles)
+        {
+            Range& range = allocations[handle];
+            if (!moves.empty() && moves.back().sourceOffset + moves.back().size == range.offset)
+            {
+                moves.back().size += range.size;
+            }
+            else
+            {
+                moves.push_back({range.offset, nextOffset, range.size});
+            }
+            range.offset = nextOffset;
+            nextOffset += range.size;
+        }
+
+        capacity = newCapacity;
+        freeRangesBySize.clear();
+        freeRangesByOffset.clear();
+        if (capacity > usedSize)
+        {
+            AddFreeRange(usedSize, capacity - usedSize);
+        }
+
+        return moves;
+    }
+
+    size_t RangeAllocator::GetCapacity() const
+    {
+        return capacity;
+    }
+
+    size_t RangeAllocator::GetUsedSize() const
+    {
+        return usedSize;
+    }
+
+    size_t RangeAllocator::GetFreeSize() const
+    {
+        return capacity - usedSize;
+    }
+
+    size_t RangeAllocator::GetLargestFreeRange() const
+    {
+        return freeRangesBySize.empty() ? 0 : freeRangesBySize.rbegin()->first;
+    }
+
+    size_t RangeAllocator::GetAllocationCount() const
+    {
+        return allocations.size() - unusedHandles.size();
+    }
+
+    void RangeAllocator::AddFreeRange(const size_t offset, const size_t size)
+    {
+        freeRangesBySize.emplace(size, offset);
+        freeRangesByOffset.emplace(offset, size);
+    }
+
+    void RangeAllocator::RemoveFreeRange(const size_t offset, const size_t size)
+    {
+        freeRangesBySize.erase({size, offset});
+        freeRangesByOffset.erase(offset);
+    }
+}
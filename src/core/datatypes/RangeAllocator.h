@@ -0,0 +1,89 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <set>
+#include <utility>
+#include <vector>
+
+namespace Vox
+{
+    /**
+     * @brief Sub-allocates ranges out of one fixed-size region, like a large GPU buffer
+     * Doesn't own any memory, only tracks offsets, so the units are up to the caller. Allocations are best-fit,
+     * and freed ranges are merged with their neighbours. Ranges are referred to by handles, which stay valid
+     * when the region is compacted
+     */
+    class RangeAllocator
+    {
+    public:
+        using Handle = uint32_t;
+
+        static constexpr Handle invalidHandle = UINT32_MAX;
+
+        struct Range
+        {
+            size_t offset = 0;
+            size_t size = 0;
+        };
+
+        /**
+         * @brief A block of allocations that has to be copied when compacting
+         */
+        struct Move
+        {
+            size_t sourceOffset = 0;
+            size_t destinationOffset = 0;
+            size_t size = 0;
+        };
+
+        explicit RangeAllocator(size_t capacity);
+
+        /**
+         * @brief Take the smallest free range that fits, preferring the lowest offset between ranges of the same size
+         * @param size must be greater than zero
+         * @return The handle of the new range, or invalidHandle if no free range is large enough
+         */
+        [[nodiscard]] Handle Allocate(size_t size);
+
+        void Free(Handle handle);
+
+        [[nodiscard]] Range GetRange(Handle handle) const;
+
+        /**
+         * @brief Move every allocation to the start of the region, in offset order, leaving one free range at the end
+         * Handles stay valid, only their offsets change
+         * @param newCapacity the new size of the region, at least GetUsedSize
+         * @return The copies needed to move the contents, merged where allocations were already next to each other.
+         * Ranges only move towards the start, so they can also be applied in place, in order, with an overlap-safe copy
+         */
+        std::vector<Move> Compact(size_t newCapacity);
+
+        [[nodiscard]] size_t GetCapacity() const;
+
+        [[nodiscard]] size_t GetUsedSize() const;
+
+        [[nodiscard]] size_t GetFreeSize() const;
+
+        [[nodiscard]] size_t GetLargestFreeRange() const;
+
+        [[nodiscard]] size_t GetAllocationCount() const;
+
+    private:
+        void AddFreeRange(size_t offset, size_t size);
+
+        void RemoveFreeRange(size_t offset, size_t size);
+
+        size_t capacity;
+        size_t usedSize = 0;
+
+        // Indexed by handle, a size of zero means the handle is unused
+        std::vector<Range> allocations;
+        std::vector<Handle> unusedHandles;
+
+        // Free ranges ordered by size then offset, for best-fit, and by offset, for merging neighbours
+        std::set<std::pair<size_t, size_t>> freeRangesBySize;
+        std::map<size_t, size_t> freeRangesByOffset;
+    };
+}
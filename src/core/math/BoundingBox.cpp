@@ -0,0 +1,66 @@
+#include "BoundingBox.h"
+
+#include <limits>
+
+#include <glm/common.hpp>
+
+namespace Vox
+{
+    BoundingBox::BoundingBox()
+        :min(std::numeric_limits<float>::max()), max(std::numeric_limits<float>::lowest())
+    {
+    }
+
+    BoundingBox::BoundingBox(const glm::vec3& min, const glm::vec3& max)
+        :min(min), max(max)
+    {
+    }
+
+    void BoundingBox::Expand(const glm::vec3& point)
+    {
+        min = glm::min(min, point);
+        max = glm::max(max, point);
+    }
+
+    void BoundingBox::Expand(const BoundingBox& box)
+    {
+        min = glm::min(min, box.min);
+        max = glm::max(max, box.max);
+    }
+
+    bool BoundingBox::IsEmpty() const
+    {
+        return min.x > max.x || min.y > max.y || min.z > max.z;
+    }
+
+    glm::vec3 BoundingBox::GetCenter() const
+    {
+        return (min + max) * 0.5f;
+    }
+
+    glm::vec3 BoundingBox::GetExtents() const
+    {
+        return (max - min) * 0.5f;
+    }
+
+    BoundingBox BoundingBox::GetTransformed(const glm::mat4x4& transform) const
+    {
+        if (IsEmpty())
+        {
+            return {};
+        }
+
+        // Each axis of the transform moves the center, and stretches the extents by the absolute value of its components
+        const glm::vec3 center = GetCenter();
+        const glm::vec3 extents = GetExtents();
+        glm::vec3 newCenter = glm::vec3(transform[3]);
+        glm::vec3 newExtents(0.0f);
+        for (int axis = 0; axis < 3; ++axis)
+        {
+            const glm::vec3 column = glm::vec3(transform[axis]);
+            newCenter += column * center[axis];
+            newExtents += glm::abs(column) * extents[axis];
+        }
+        return {newCenter - newExtents, newCenter + newExtents};
+    }
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <glm/mat4x4.hpp>
+#include <glm/vec3.hpp>
+
+namespace Vox
+{
+    /**
+     * @brief An axis aligned bounding box. A default constructed box is empty, and grows as points are added
+     */
+    struct BoundingBox
+    {
+        BoundingBox();
+        BoundingBox(const glm::vec3& min, const glm::vec3& max);
+
+        void Expand(const glm::vec3& point);
+
+        void Expand(const BoundingBox& box);
+
+        [[nodiscard]] bool IsEmpty() const;
+
+        [[nodiscard]] glm::vec3 GetCenter() const;
+
+        /**
+         * @brief Get half the size of the box on each axis
+         */
+        [[nodiscard]] glm::vec3 GetExtents() const;
+
+        /**
+         * @brief Get the axis aligned box that bounds this box after it is transformed
+         */
+        [[nodiscard]] BoundingBox GetTransformed(const glm::mat4x4& transform) const;
+
+        glm::vec3 min;
+        glm::vec3 max;
+    };
+}
@@ -12,6 +12,7 @@
 #include "core/services/ServiceLocator.h"
 #include "physics/PhysicsServer.h"
 #include "rendering/SceneRenderer.h"
+#include "rendering/camera/Camera.h"
 #include "voxel/VoxelWorld.h"
 
 namespace Vox
@@ -191,9 +192,20 @@ namespace Vox
         }
     }
 
-    void World::LoadVoxels(const std::string& filename)
+    void World::LoadVoxels(const std::string& filename, const VoxelStreamingSettings& streamingSettings)
     {
-        voxels = std::make_unique<VoxelWorld>(this, filename);
+        voxels = std::make_unique<VoxelWorld>(this, filename, streamingSettings);
+    }
+
+    void World::UpdateVoxelStreaming()
+    {
+        const std::shared_ptr<Camera> camera = renderer->GetCurrentCamera();
+        if (!voxels || !camera)
+        {
+            return;
+        }
+
+        voxels->UpdateStreaming(camera->GetPosition());
     }
 
     void World::InitializeVoxels()
@@ -5,6 +5,7 @@
 #include "core/concepts/Concepts.h"
 #include "core/datatypes/DelegateHandle.h"
 #include "core/objects/Object.h"
+#include "voxel/VoxelStreamingSettings.h"
 
 namespace Vox
 {
@@ -81,7 +82,12 @@ namespace Vox
 
         void Load(const SavedWorld& savedWorld);
 
-        void LoadVoxels(const std::string& filename);
+        void LoadVoxels(const std::string& filename, const VoxelStreamingSettings& streamingSettings = {});
+
+        /**
+         * @brief Stream voxel chunks in and out around the current camera
+         */
+        void UpdateVoxelStreaming();
 
         void InitializeVoxels();
 
@@ -3,6 +3,7 @@
 #include "EditorService.h"
 #include "FileIOService.h"
 #include "ObjectService.h"
+#include "ThreadPool.h"
 #include "core/services/InputService.h"
 #include "rendering/Renderer.h"
 #include "physics/PhysicsServer.h"
@@ -14,9 +15,11 @@ namespace Vox
 	InputService* ServiceLocator::inputService = nullptr;
 	ObjectService* ServiceLocator::objectService = nullptr;
 	Renderer* ServiceLocator::renderer = nullptr;
+	ThreadPool* ServiceLocator::threadPool = nullptr;
 
 	void ServiceLocator::InitServices(SDL_Window* window)
 	{
+		threadPool = new ThreadPool();
 		fileIoService = new FileIOService();
 		inputService = new InputService(window);
 		objectService = new ObjectService();
@@ -26,6 +29,9 @@ namespace Vox
 
 	void ServiceLocator::DeleteServices()
 	{
+	    // Finish any queued work first, it may still depend on the other services
+	    delete threadPool;
+	    threadPool = nullptr;
 		delete objectService;
 		delete editorService;
 		delete fileIoService;
@@ -62,4 +68,9 @@ namespace Vox
 	{
 		return objectService;
 	}
+
+	ThreadPool* ServiceLocator::GetThreadPool()
+	{
+		return threadPool;
+	}
 }
@@ -14,6 +14,7 @@ namespace Vox
 	class ObjectService;
 	class PhysicsServer;
 	class Renderer;
+	class ThreadPool;
 
 	class ServiceLocator
 	{
@@ -26,6 +27,7 @@ namespace Vox
 		static InputService* GetInputService();
 		static ObjectService* GetObjectService();
 		static Renderer* GetRenderer();
+		static ThreadPool* GetThreadPool();
 
 	private:
 		static EditorService* editorService;
@@ -33,5 +35,6 @@ namespace Vox
 		static InputService* inputService;
 		static ObjectService* objectService;
 		static Renderer* renderer;
+		static ThreadPool* threadPool;
 	};
 }
\ No newline at end of file
@@ -0,0 +1,118 @@
+#include "ThreadPool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+
+namespace Vox
+{
+    ThreadPool::ThreadPool(const unsigned int threadCount)
+    {
+        workers.reserve(threadCount);
+        for (unsigned int i = 0; i < threadCount; ++i)
+        {
+            workers.emplace_back([this] { WorkerLoop(); });
+        }
+    }
+
+    ThreadPool::~ThreadPool()
+    {
+        {
+            std::scoped_lock lock(taskMutex);
+            stopping = true;
+        }
+        taskAvailable.notify_all();
+        for (std::thread& worker : workers)
+        {
+            worker.join();
+        }
+    }
+
+    void ThreadPool::Submit(std::function<void()> task)
+    {
+        if (workers.empty())
+        {
+            task();
+            return;
+        }
+
+        {
+            std::scoped_lock lock(taskMutex);
+            tasks.emplace_back(std::move(task));
+        }
+        taskAvailable.notify_one();
+    }
+
+    void ThreadPool::ParallelFor(const size_t count, const std::function<void(size_t)>& function)
+    {
+        // Helpers can start after the loop is already finished, so the shared state has to outlive this call
+        struct LoopState
+        {
+            std::atomic<size_t> nextIndex = 0;
+            size_t completedCount = 0;
+            std::mutex mutex;
+            std::condition_variable finished;
+        };
+        const auto state = std::make_shared<LoopState>();
+
+        auto runIndices = [state, count, &function]
+        {
+            size_t completed = 0;
+            for (size_t index = state->nextIndex++; index < count; index = state->nextIndex++)
+            {
+                function(index);
+                ++completed;
+            }
+
+            if (completed > 0)
+            {
+                std::scoped_lock lock(state->mutex);
+                state->completedCount += completed;
+                if (state->completedCount == count)
+                {
+                    state->finished.notify_all();
+                }
+            }
+        };
+
+        const size_t helperCount = std::min(static_cast<size_t>(workers.size()), count > 0 ? count - 1 : 0);
+        for (size_t i = 0; i < helperCount; ++i)
+        {
+            Submit(runIndices);
+        }
+        runIndices();
+
+        std::unique_lock lock(state->mutex);
+        state->finished.wait(lock, [&state, count] { return state->completedCount == count; });
+    }
+
+    unsigned int ThreadPool::GetThreadCount() const
+    {
+        return static_cast<unsigned int>(workers.size());
+    }
+
+    unsigned int ThreadPool::GetDefaultThreadCount()
+    {
+        // Leave a thread for the main loop, the physics thread already has its own job system
+        return std::max(std::thread::hardware_concurrency(), 2u) - 1;
+    }
+
+    void ThreadPool::WorkerLoop()
+    {
+        while (true)
+        {
+            std::function<void()> task;
+            {
+                std::unique_lock lock(taskMutex);
+                taskAvailable.wait(lock, [this] { return stopping || !tasks.empty(); });
+                if (tasks.empty())
+                {
+                    return;
+                }
+                task = std::move(tasks.front());
+                tasks.pop_front();
+            }
+            task();
+        }
+    }
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Vox
+{
+    /**
+     * @brief Fixed set of worker threads for CPU work that doesn't touch GL or physics state
+     * Tasks must not log, the logger is not thread safe.
+     */
+    class ThreadPool
+    {
+    public:
+        /**
+         * @param threadCount number of workers, defaults to one less than the hardware thread count
+         */
+        explicit ThreadPool(unsigned int threadCount = GetDefaultThreadCount());
+
+        /**
+         * @brief Waits for every queued task to finish, then joins the workers
+         */
+        ~ThreadPool();
+
+        ThreadPool(ThreadPool&&) = delete;
+        ThreadPool(const ThreadPool&) = delete;
+        ThreadPool& operator=(ThreadPool&&) = delete;
+        ThreadPool& operator=(const ThreadPool&) = delete;
+
+        void Submit(std::function<void()> task);
+
+        /**
+         * @brief Run function for every index in [0, count), and block until all of them are done
+         * The calling thread works through indices as well, so this is safe to call while the workers are busy
+         */
+        void ParallelFor(size_t count, const std::function<void(size_t)>& function);
+
+        [[nodiscard]] unsigned int GetThreadCount() const;
+
+        [[nodiscard]] static unsigned int GetDefaultThreadCount();
+
+    private:
+        void WorkerLoop();
+
+        std::vector<std::thread> workers;
+
+        std::deque<std::function<void()>> tasks;
+
+        std::mutex taskMutex;
+
+        std::condition_variable taskAvailable;
+
+        bool stopping = false;
+    };
+}
@@ -293,6 +293,14 @@ namespace Vox
                 }
             }
 
+            if (ImGui::MenuItem("Export Voxels as ASCII"))
+            {
+                if (const std::shared_ptr<World> world = currentWorld.lock(); world && world->GetVoxels())
+                {
+                    world->GetVoxels()->ExportToAsciiFile("MainWorld");
+                }
+            }
+
             if (ImGui::MenuItem("Load"))
             {
                 SDL_DialogFileCallback callback = [](void *userdata, const char * const *filelist, int filter)
@@ -21,11 +21,6 @@ namespace Vox
                 if (const std::optional<VoxelRaycastResult> result = worldLock->GetVoxels()->CastScreenSpaceRay({x, y}); result.has_value())
                 {
                     const glm::ivec3 clickedVoxel = voxelMaterialId ? result.value().voxel + result.value().voxelNormal : result.value().voxel;
-                    if (clickedVoxel.y <= 0 || clickedVoxel.y >= 32)
-                    {
-                        return;
-                    }
-
                     Voxel newVoxel;
                     newVoxel.materialId = voxelMaterialId;
                     worldLock->GetVoxels()->SetVoxel(clickedVoxel, newVoxel);
@@ -50,6 +45,24 @@ namespace Vox
         if (ImGui::BeginChild("VoxelsInternalPanel"))
         {
             ImGui::SliderInt("Material", &voxelMaterialId, 0, 6);
+
+            const std::shared_ptr<World> worldLock = world.lock();
+            if (VoxelWorld* voxels = worldLock ? worldLock->GetVoxels() : nullptr)
+            {
+                const VoxelMemoryReport report = voxels->GetMemoryReport();
+                ImGui::Text("Chunks: %zu (%zu uniform)", report.chunkCount, report.uniformChunkCount);
+                ImGui::Text("Voxel memory: %zu KiB (dense: %zu KiB)", report.residentBytes / 1024, report.denseBytes / 1024);
+
+                voxels->LogFinishedSaves();
+                if (const VoxelSaveStatus saveStatus = voxels->GetSaveStatus(); saveStatus.pendingSaveCount > 0)
+                {
+                    ImGui::Text("Saving...");
+                }
+                else if (saveStatus.lastSavedChunkCount > 0)
+                {
+                    ImGui::Text("Last save: %zu chunks, %zu KiB in %.1f ms", saveStatus.lastSavedChunkCount, saveStatus.lastBytesWritten / 1024, saveStatus.lastSaveMs);
+                }
+            }
         }
         ImGui::EndChild();
         ImGui::PopStyleVar();
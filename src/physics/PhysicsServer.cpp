@@ -164,24 +164,76 @@ namespace Vox
 
 	void PhysicsServer::UpdateVoxelBodies()
 	{
-		JPH::BodyInterface& bodyInterface = physicsSystem.GetBodyInterface();
-		for (const auto& [id, index] : voxelBodies.GetDirtyIndices())
+		struct VoxelBodyRebuild
+		{
+			std::pair<size_t, int> id;
+			std::unique_ptr<Octree::CollisionNode> collisionMask;
+			glm::ivec3 chunkPosition;
+			JPH::BodyID bodyId;
+		};
+
+		// Only take the work out of the container while locked. The main thread can grow the container at any time,
+		// so no pointers into it are kept after unlocking, and building the shapes happens without the lock
+		std::vector<JPH::BodyID> bodiesToDestroy;
+		std::vector<VoxelBodyRebuild> rebuilds;
 		{
-			if (VoxelBody* body = voxelBodies.Get(id, index))
+			std::scoped_lock lock(voxelBodyMutex);
+			std::vector<std::pair<size_t, int>> destroys;
+			destroys.swap(pendingVoxelBodyDestroys);
+			for (const std::pair<size_t, int>& bodyId : destroys)
 			{
-				if (!body->GetBodyId().IsInvalid())
+				if (const VoxelBody* body = voxelBodies.Get(bodyId.first, bodyId.second); body && !body->GetBodyId().IsInvalid())
 				{
-					VoxLog(Display, Physics, "Destroying voxel body.");
-					bodyInterface.RemoveBody(body->GetBodyId());
-					bodyInterface.DestroyBody(body->GetBodyId());
+					bodiesToDestroy.push_back(body->GetBodyId());
 				}
-				VoxLog(Display, Physics, "Creating new voxel body.");
-				body->SetBodyId(CreateCompoundShape(body->GetShapeSettings(), Vec3From(
-				    VoxelChunk::CalculatePosition(body->GetChunkPosition()) + glm::vec3(VoxelChunk::chunkHalfSize, VoxelChunk::chunkHalfSize, VoxelChunk::chunkHalfSize)
-				    )));
+				voxelBodies.Remove(bodyId);
+			}
+
+			for (const auto& [id, index] : voxelBodies.GetDirtyIndices())
+			{
+				if (VoxelBody* body = voxelBodies.Get(id, index))
+				{
+					if (!body->GetBodyId().IsInvalid())
+					{
+						bodiesToDestroy.push_back(body->GetBodyId());
+						body->SetBodyId(JPH::BodyID());
+					}
+					std::unique_ptr<Octree::CollisionNode>& collisionMask = body->pendingCollisionMask ? body->pendingCollisionMask : body->voxelCollisionMask;
+					rebuilds.push_back({std::pair(id, index), std::move(collisionMask), body->GetChunkPosition()});
+				}
+			}
+			voxelBodies.ClearDirty();
+		}
+
+		JPH::BodyInterface& bodyInterface = physicsSystem.GetBodyInterface();
+		for (const JPH::BodyID bodyId : bodiesToDestroy)
+		{
+			bodyInterface.RemoveBody(bodyId);
+			bodyInterface.DestroyBody(bodyId);
+		}
+
+		for (VoxelBodyRebuild& rebuild : rebuilds)
+		{
+			rebuild.bodyId = CreateCompoundShape(rebuild.collisionMask->MakeCompoundShape(), Vec3From(
+			    VoxelChunk::CalculatePosition(rebuild.chunkPosition) + glm::vec3(VoxelChunk::chunkHalfSize, VoxelChunk::chunkHalfSize, VoxelChunk::chunkHalfSize)
+			    ));
+		}
+		if (!bodiesToDestroy.empty() || !rebuilds.empty())
+		{
+			VoxLog(Display, Physics, "Destroyed {} and created {} voxel bodies.", bodiesToDestroy.size(), rebuilds.size());
+		}
+
+		// Bodies are only removed from the container above, on this thread, so every rebuilt body is still there.
+		// A destroy requested in the meantime is handled next step, with the new body id
+		std::scoped_lock lock(voxelBodyMutex);
+		for (VoxelBodyRebuild& rebuild : rebuilds)
+		{
+			if (VoxelBody* body = voxelBodies.Get(rebuild.id.first, rebuild.id.second))
+			{
+				body->voxelCollisionMask = std::move(rebuild.collisionMask);
+				body->SetBodyId(rebuild.bodyId);
 			}
 		}
-		voxelBodies.ClearDirty();
 	}
 
 	JPH::BodyID PhysicsServer::CreateStaticShape(const JPH::Shape* shape, const JPH::Vec3& position)
@@ -208,9 +260,33 @@ namespace Vox
 		return bodyId;
 	}
 
-	DynamicRef<VoxelBody> PhysicsServer::CreateVoxelBody()
+	DynamicRef<VoxelBody> PhysicsServer::CreateVoxelBody(const glm::ivec3& chunkPosition)
+	{
+		std::scoped_lock lock(voxelBodyMutex);
+		DynamicRef<VoxelBody> body(&voxelBodies, voxelBodies.Create());
+		body->chunkPosition = chunkPosition;
+		return body;
+	}
+
+	void PhysicsServer::MarkVoxelBodyDirty(const DynamicRef<VoxelBody>& body)
+	{
+		std::scoped_lock lock(voxelBodyMutex);
+		voxelBodies.MarkDirty(body.GetId().first, body.GetId().second);
+	}
+
+	void PhysicsServer::SetVoxelBodyCollision(const DynamicRef<VoxelBody>& body, std::unique_ptr<Octree::CollisionNode> collisionMask)
+	{
+		std::scoped_lock lock(voxelBodyMutex);
+		if (VoxelBody* voxelBody = voxelBodies.Get(body.GetId().first, body.GetId().second))
+		{
+			voxelBody->pendingCollisionMask = std::move(collisionMask);
+		}
+	}
+
+	void PhysicsServer::DestroyVoxelBody(const DynamicRef<VoxelBody>& body)
 	{
-		return DynamicRef<VoxelBody>(&voxelBodies, voxelBodies.Create());
+		std::scoped_lock lock(voxelBodyMutex);
+		pendingVoxelBodyDestroys.emplace_back(body.GetId());
 	}
 
 	bool PhysicsServer::RayCast(const JPH::Vec3 origin, const JPH::Vec3 direction, RayCastResultNormal& resultOut) const
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <memory>
+#include <mutex>
 #include <vector>
 
 #include <Jolt/Jolt.h>
@@ -43,7 +44,27 @@ namespace Vox
 
 		JPH::BodyID CreateCompoundShape(const JPH::StaticCompoundShapeSettings* settings, const JPH::Vec3& position);
 
-		DynamicRef<VoxelBody> CreateVoxelBody();
+		/**
+		 * @brief Create a voxel body for the chunk at a chunk position. It is added to the simulation once it's marked dirty
+		 */
+		DynamicRef<VoxelBody> CreateVoxelBody(const glm::ivec3& chunkPosition);
+
+		/**
+		 * @brief Queue a voxel body to have its shape rebuilt on the next step. The physics thread reads the dirty list,
+		 * so this has to be used instead of marking the ref dirty directly
+		 */
+		void MarkVoxelBodyDirty(const DynamicRef<VoxelBody>& body);
+
+		/**
+		 * @brief Give a voxel body a new collision mask. It replaces the current one when the body is next rebuilt,
+		 * on the physics thread, so the mask is never changed while the physics thread is reading it
+		 */
+		void SetVoxelBodyCollision(const DynamicRef<VoxelBody>& body, std::unique_ptr<Octree::CollisionNode> collisionMask);
+
+		/**
+		 * @brief Queue a voxel body to be removed from the simulation and destroyed on the next step
+		 */
+		void DestroyVoxelBody(const DynamicRef<VoxelBody>& body);
 
 		bool RayCast(JPH::Vec3 origin, JPH::Vec3 direction, RayCastResultNormal& resultOut) const;
         bool RayCast(glm::vec3 origin, glm::vec3 direction, RayCastResultNormal& resultOut) const;
@@ -92,6 +113,10 @@ namespace Vox
 
 		DynamicObjectContainer<VoxelBody> voxelBodies;
 
+		// Voxel bodies are created and destroyed from the main thread, but updated on the physics thread
+		std::mutex voxelBodyMutex;
+		std::vector<std::pair<size_t, int>> pendingVoxelBodyDestroys;
+
 		BroadPhaseLayerImplementation broadPhaseLayerImplementation;
 		ObjectVsBroadPhaseLayerFilterImplementation	objectVsBroadPhaseLayerFilter;
 		ObjectLayerPairFilterImplementation	objectLayerPairFilter;
@@ -5,7 +5,7 @@
 namespace Vox
 {
     VoxelBody::VoxelBody()
-        :chunkPosition({0, 0})
+        :chunkPosition({0, 0, 0})
     {
         voxelCollisionMask = std::make_unique<Octree::CollisionNode>(VoxelChunk::chunkSize);
     }
@@ -18,25 +18,12 @@ namespace Vox
     {
         bodyId = other.bodyId;
         voxelCollisionMask = std::move(other.voxelCollisionMask);
+        pendingCollisionMask = std::move(other.pendingCollisionMask);
     }
 
-    void VoxelBody::CreateVoxel(const glm::uvec3 position)
+    std::unique_ptr<Octree::CollisionNode> VoxelBody::BuildCollisionMask(const std::array<std::array<std::array<Voxel, 32>, 32>, 32>& voxels)
     {
-        auto solidVoxel = Octree::PhysicsVoxel(true);
-        voxelCollisionMask->SetVoxel(
-            static_cast<int>(position.x - VoxelChunk::chunkHalfSize),
-            static_cast<int>(position.y - VoxelChunk::chunkHalfSize),
-            static_cast<int>(position.z - VoxelChunk::chunkHalfSize),
-            solidVoxel);
-    }
-
-    void VoxelBody::EraseVoxel(const glm::uvec3 position)
-    {
-        voxelCollisionMask->SetVoxel(
-            static_cast<int>(position.x - VoxelChunk::chunkHalfSize),
-            static_cast<int>(position.y - VoxelChunk::chunkHalfSize),
-            static_cast<int>(position.z - VoxelChunk::chunkHalfSize),
-            Octree::PhysicsVoxel());
+        return std::make_unique<Octree::CollisionNode>(VoxelChunk::chunkSize, voxels[0][0].data());
     }
 
     JPH::BodyID VoxelBody::GetBodyId() const
@@ -54,7 +41,7 @@ namespace Vox
         return voxelCollisionMask->MakeCompoundShape();
     }
 
-    const glm::ivec2& VoxelBody::GetChunkPosition() const
+    const glm::ivec3& VoxelBody::GetChunkPosition() const
     {
         return chunkPosition;
     }
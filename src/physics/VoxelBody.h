@@ -1,5 +1,6 @@
 #pragma once
 
+#include <array>
 #include <vector>
 
 #include <glm/glm.hpp>
@@ -8,6 +9,7 @@
 #include <Jolt/Physics/Body/BodyID.h>
 
 #include "Voxel/CollisionOctree.h"
+#include "voxel/Voxel.h"
 
 namespace JPH
 {
@@ -26,20 +28,25 @@ namespace Vox
 
 	    VoxelBody(VoxelBody&& other) noexcept;
 
-		void CreateVoxel(glm::uvec3 position);
-		void EraseVoxel(glm::uvec3 position);
+	    /**
+	     * @brief Build a collision mask from a dense voxel array. This doesn't touch any physics state, so it can run on worker threads
+	     */
+	    [[nodiscard]] static std::unique_ptr<Octree::CollisionNode> BuildCollisionMask(const std::array<std::array<std::array<Voxel, 32>, 32>, 32>& voxels);
 
 		JPH::BodyID GetBodyId() const;
 		void SetBodyId(JPH::BodyID bodyIdIn);
 
 		JPH::Ref<JPH::StaticCompoundShapeSettings> GetShapeSettings() const;
 
-	    const glm::ivec2& GetChunkPosition() const;
+	    const glm::ivec3& GetChunkPosition() const;
 
-	    glm::ivec2 chunkPosition;
+	    glm::ivec3 chunkPosition;
 
 	private:
 		JPH::BodyID bodyId;
 		std::unique_ptr<Octree::CollisionNode> voxelCollisionMask;
+
+	    // Handed over from the main thread, and swapped in by the physics thread before the shape is rebuilt
+	    std::unique_ptr<Octree::CollisionNode> pendingCollisionMask;
 	};
 }
\ No newline at end of file
@@ -0,0 +1,40 @@
+#include "CountingRenderBackend.h"
+
+namespace Vox
+{
+    void CountingRenderBackend::BindShader(uint32_t)
+    {
+        ++shaderBinds;
+    }
+
+    void CountingRenderBackend::BindInstances(const std::function<void()>&)
+    {
+        ++instanceBinds;
+    }
+
+    void CountingRenderBackend::BindGeometry(const DrawGeometry&)
+    {
+        ++geometryBinds;
+    }
+
+    void CountingRenderBackend::SetMaterial(uint32_t, uint32_t, const std::vector<PBRMaterial>&)
+    {
+        ++materialSets;
+    }
+
+    void CountingRenderBackend::SetTransform(uint32_t, const glm::mat4x4&)
+    {
+        ++transformSets;
+    }
+
+    void CountingRenderBackend::Draw(const DrawGeometry&, uint32_t, const uint32_t instanceCount)
+    {
+        ++draws;
+        drawnInstances += instanceCount;
+    }
+
+    void CountingRenderBackend::Reset()
+    {
+        *this = CountingRenderBackend();
+    }
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cstddef>
+
+#include "rendering/RenderQueue.h"
+
+namespace Vox
+{
+    /**
+     * @brief A RenderBackend that only counts what it is asked to do, so a RenderQueue can be tested and
+     * benchmarked without a GL context. Instance bindings are never called
+     */
+    class CountingRenderBackend : public RenderBackend
+    {
+    public:
+        void BindShader(uint32_t shader) override;
+
+        void BindInstances(const std::function<void()>& bind) override;
+
+        void BindGeometry(const DrawGeometry& geometry) override;
+
+        void SetMaterial(uint32_t shader, uint32_t material, const std::vector<PBRMaterial>& materials) override;
+
+        void SetTransform(uint32_t shader, const glm::mat4x4& transform) override;
+
+        void Draw(const DrawGeometry& geometry, uint32_t baseInstance, uint32_t instanceCount) override;
+
+        void Reset();
+
+        size_t shaderBinds = 0;
+        size_t instanceBinds = 0;
+        size_t geometryBinds = 0;
+        size_t materialSets = 0;
+        size_t transformSets = 0;
+        size_t draws = 0;
+        size_t drawnInstances = 0;
+    };
+}
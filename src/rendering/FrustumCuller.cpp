@@ -0,0 +1,85 @@
+#include "FrustumCuller.h"
+
+#include <cassert>
+#include <cmath>
+
+#include "rendering/camera/Frustum.h"
+
+namespace Vox
+{
+    void FrustumCuller::Clear()
+    {
+        centerX.clear();
+        centerY.clear();
+        centerZ.clear();
+        extentX.clear();
+        extentY.clear();
+        extentZ.clear();
+    }
+
+    void FrustumCuller::Reserve(const size_t boxCount)
+    {
+        centerX.reserve(boxCount);
+        centerY.reserve(boxCount);
+        centerZ.reserve(boxCount);
+        extentX.reserve(boxCount);
+        extentY.reserve(boxCount);
+        extentZ.reserve(boxCount);
+    }
+
+    uint32_t FrustumCuller::Add(const BoundingBox& box)
+    {
+        assert(!box.IsEmpty());
+        const glm::vec3 center = box.GetCenter();
+        const glm::vec3 extents = box.GetExtents();
+        centerX.push_back(center.x);
+        centerY.push_back(center.y);
+        centerZ.push_back(center.z);
+        extentX.push_back(extents.x);
+        extentY.push_back(extents.y);
+        extentZ.push_back(extents.z);
+        return static_cast<uint32_t>(centerX.size() - 1);
+    }
+
+    const std::vector<uint32_t>& FrustumCuller::Cull(const Frustum& frustum)
+    {
+        const size_t boxCount = centerX.size();
+        insideMask.assign(boxCount, 1);
+
+        // Plain pointers, since writing through the mask could otherwise alias the vectors themselves,
+        // and the compiler would reload their data every iteration instead of vectorizing
+        const float* boxCenterX = centerX.data();
+        const float* boxCenterY = centerY.data();
+        const float* boxCenterZ = centerZ.data();
+        const float* boxExtentX = extentX.data();
+        const float* boxExtentY = extentY.data();
+        const float* boxExtentZ = extentZ.data();
+        uint8_t* mask = insideMask.data();
+        for (const glm::vec4& plane : frustum.planes)
+        {
+            const float normalX = plane.x, normalY = plane.y, normalZ = plane.z, distance = plane.w;
+            const float absNormalX = std::abs(normalX), absNormalY = std::abs(normalY), absNormalZ = std::abs(normalZ);
+            for (size_t i = 0; i < boxCount; ++i)
+            {
+                const float centerDistance = normalX * boxCenterX[i] + normalY * boxCenterY[i] + normalZ * boxCenterZ[i] + distance;
+                const float radius = absNormalX * boxExtentX[i] + absNormalY * boxExtentY[i] + absNormalZ * boxExtentZ[i];
+                mask[i] &= static_cast<uint8_t>(centerDistance + radius >= 0.0f);
+            }
+        }
+
+        visibleIndices.clear();
+        for (size_t i = 0; i < boxCount; ++i)
+        {
+            if (insideMask[i])
+            {
+                visibleIndices.push_back(static_cast<uint32_t>(i));
+            }
+        }
+        return visibleIndices;
+    }
+
+    size_t FrustumCuller::GetBoxCount() const
+    {
+        return centerX.size();
+    }
+}
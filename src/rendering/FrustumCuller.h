@@ -0,0 +1,49 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "core/math/BoundingBox.h"
+
+namespace Vox
+{
+    struct Frustum;
+
+    /**
+     * @brief Tests a batch of bounding boxes against a frustum at once
+     * Boxes are stored as separate arrays of centers and extents, so each plane is tested against every box
+     * in a loop without branches, which compilers turn into SIMD code
+     */
+    class FrustumCuller
+    {
+    public:
+        void Clear();
+
+        void Reserve(size_t boxCount);
+
+        /**
+         * @param box must not be empty
+         * @return The index of the box, boxes are numbered in the order they are added
+         */
+        uint32_t Add(const BoundingBox& box);
+
+        /**
+         * @brief Test every box against the frustum, with the same test as Frustum::Intersects
+         * @return The indices of the boxes that are at least partly inside, in ascending order.
+         * Only valid until the next call
+         */
+        const std::vector<uint32_t>& Cull(const Frustum& frustum);
+
+        [[nodiscard]] size_t GetBoxCount() const;
+
+    private:
+        std::vector<float> centerX, centerY, centerZ;
+        std::vector<float> extentX, extentY, extentZ;
+
+        // One byte per box, cleared as soon as the box is outside any plane
+        std::vector<uint8_t> insideMask;
+
+        std::vector<uint32_t> visibleIndices;
+    };
+}
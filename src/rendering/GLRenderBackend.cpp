@@ -0,0 +1,72 @@
+#include "GLRenderBackend.h"
+
+#include <GL/glew.h>
+
+#include "rendering/shaders/pixel_shaders/mesh_shaders/MaterialShader.h"
+
+namespace Vox
+{
+    uint32_t GLRenderBackend::RegisterShader(const MeshShader* shader, const unsigned int vertexArray)
+    {
+        shaders.push_back({shader, nullptr, vertexArray, MaterialMode::None});
+        return static_cast<uint32_t>(shaders.size() - 1);
+    }
+
+    uint32_t GLRenderBackend::RegisterShader(const MaterialShader* shader, const unsigned int vertexArray, const MaterialMode materialMode)
+    {
+        shaders.push_back({shader, shader, vertexArray, materialMode});
+        return static_cast<uint32_t>(shaders.size() - 1);
+    }
+
+    void GLRenderBackend::BindShader(const uint32_t shader)
+    {
+        const RegisteredShader& registeredShader = shaders[shader];
+        registeredShader.shader->Enable();
+        glBindVertexArray(registeredShader.vertexArray);
+    }
+
+    void GLRenderBackend::BindInstances(const std::function<void()>& bind)
+    {
+        bind();
+    }
+
+    void GLRenderBackend::BindGeometry(const DrawGeometry& geometry)
+    {
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, geometry.indexBuffer);
+        for (uint32_t i = 0; i < geometry.vertexBufferCount; ++i)
+        {
+            glBindVertexBuffer(i, geometry.vertexBuffers[i], 0, static_cast<int>(geometry.vertexStrides[i]));
+        }
+    }
+
+    void GLRenderBackend::SetMaterial(const uint32_t shader, const uint32_t material, const std::vector<PBRMaterial>& materials)
+    {
+        const RegisteredShader& registeredShader = shaders[shader];
+        switch (registeredShader.materialMode)
+        {
+        case MaterialMode::None:
+            break;
+        case MaterialMode::Index:
+            registeredShader.materialShader->SetMaterialIndex(material);
+            break;
+        case MaterialMode::Value:
+            // Primitives without a material keep whatever was set before
+            if (material < materials.size())
+            {
+                registeredShader.materialShader->SetMaterial(materials[material]);
+            }
+            break;
+        }
+    }
+
+    void GLRenderBackend::SetTransform(const uint32_t shader, const glm::mat4x4& transform)
+    {
+        shaders[shader].shader->SetModelMatrix(transform);
+    }
+
+    void GLRenderBackend::Draw(const DrawGeometry& geometry, const uint32_t baseInstance, const uint32_t instanceCount)
+    {
+        glDrawElementsInstancedBaseInstance(GL_TRIANGLES, static_cast<int>(geometry.indexCount), geometry.indexType, nullptr,
+            static_cast<int>(instanceCount), baseInstance);
+    }
+}
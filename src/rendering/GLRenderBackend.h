@@ -0,0 +1,60 @@
+#pragma once
+
+#include <vector>
+
+#include "rendering/RenderQueue.h"
+
+namespace Vox
+{
+    class MaterialShader;
+    class MeshShader;
+
+    /**
+     * @brief Submits a RenderQueue with GL. Shaders are registered once, and referred to by the handles
+     * returned here
+     */
+    class GLRenderBackend : public RenderBackend
+    {
+    public:
+        enum class MaterialMode : char
+        {
+            // The shader has no material uniforms
+            None,
+            // The shader looks the material up itself, DrawCommand::material is passed as the material index
+            Index,
+            // DrawCommand::material is a handle into the queue's material table, set through the material uniforms
+            Value
+        };
+
+        /**
+         * @param vertexArray bound along with the shader
+         * @return The handle for DrawCommand::shader
+         */
+        uint32_t RegisterShader(const MeshShader* shader, unsigned int vertexArray);
+
+        uint32_t RegisterShader(const MaterialShader* shader, unsigned int vertexArray, MaterialMode materialMode);
+
+        void BindShader(uint32_t shader) override;
+
+        void BindInstances(const std::function<void()>& bind) override;
+
+        void BindGeometry(const DrawGeometry& geometry) override;
+
+        void SetMaterial(uint32_t shader, uint32_t material, const std::vector<PBRMaterial>& materials) override;
+
+        void SetTransform(uint32_t shader, const glm::mat4x4& transform) override;
+
+        void Draw(const DrawGeometry& geometry, uint32_t baseInstance, uint32_t instanceCount) override;
+
+    private:
+        struct RegisteredShader
+        {
+            const MeshShader* shader = nullptr;
+            const MaterialShader* materialShader = nullptr;
+            unsigned int vertexArray = 0;
+            MaterialMode materialMode = MaterialMode::None;
+        };
+
+        std::vector<RegisteredShader> shaders;
+    };
+}
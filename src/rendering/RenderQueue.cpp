@@ -0,0 +1,208 @@
+#include "RenderQueue.h"
+
+#include <algorithm>
+#include <cassert>
+#include <utility>
+
+namespace Vox
+{
+    namespace
+    {
+        // Bit positions of each part of the key, from the most significant
+        constexpr int passShift = 60;
+        constexpr int shaderShift = 52;
+        constexpr int instancesShift = 36;
+        constexpr int materialShift = 24;
+        constexpr int geometryShift = 8;
+
+        constexpr uint64_t shaderMask = 0xFF;
+        constexpr uint64_t instancesMask = 0xFFFF;
+        constexpr uint64_t materialMask = 0xFFF;
+        constexpr uint64_t geometryMask = 0xFFFF;
+        constexpr uint64_t depthMask = 0xFF;
+    }
+
+    void RenderQueue::Clear()
+    {
+        items.clear();
+        commands.clear();
+        instances.clear();
+        materials.clear();
+        geometries.clear();
+        transforms.clear();
+        stats = {};
+    }
+
+    uint32_t RenderQueue::AddInstances(std::function<void()> bind)
+    {
+        instances.emplace_back(std::move(bind));
+        return static_cast<uint32_t>(instances.size() - 1);
+    }
+
+    uint32_t RenderQueue::AddMaterials(const std::vector<PBRMaterial>& newMaterials)
+    {
+        const auto first = static_cast<uint32_t>(materials.size());
+        materials.insert(materials.end(), newMaterials.begin(), newMaterials.end());
+        return first;
+    }
+
+    uint32_t RenderQueue::AddGeometry(const DrawGeometry& geometry)
+    {
+        geometries.emplace_back(geometry);
+        return static_cast<uint32_t>(geometries.size() - 1);
+    }
+
+    uint32_t RenderQueue::AddTransform(const glm::mat4x4& transform)
+    {
+        transforms.emplace_back(transform);
+        return static_cast<uint32_t>(transforms.size() - 1);
+    }
+
+    void RenderQueue::Add(const RenderPass pass, const DrawCommand& command, const float depth)
+    {
+        assert(command.geometry < geometries.size() && command.transform < transforms.size());
+        assert(command.instances == DrawCommand::noInstances || command.instances < instances.size());
+        items.push_back({MakeKey(pass, command, geometries[command.geometry].indexBuffer, depth), static_cast<uint32_t>(commands.size())});
+        commands.emplace_back(command);
+    }
+
+    void RenderQueue::Sort()
+    {
+        // Least significant digit radix sort, a byte at a time. Bytes that are the same for every key are skipped,
+        // which is most of them when there are only a few shaders and passes
+        sortBuffer.resize(items.size());
+        for (int shift = 0; shift < 64; shift += 8)
+        {
+            std::array<size_t, 256> offsets{};
+            for (const DrawItem& item : items)
+            {
+                ++offsets[(item.key >> shift) & 0xFF];
+            }
+            if (std::ranges::find(offsets, items.size()) != offsets.end())
+            {
+                continue;
+            }
+
+            size_t total = 0;
+            for (size_t& offset : offsets)
+            {
+                const size_t count = offset;
+                offset = total;
+                total += count;
+            }
+            for (const DrawItem& item : items)
+            {
+                sortBuffer[offsets[(item.key >> shift) & 0xFF]++] = item;
+            }
+            items.swap(sortBuffer);
+        }
+    }
+
+    void RenderQueue::Submit(const RenderPass pass, RenderBackend& backend)
+    {
+        const uint64_t passKey = static_cast<uint64_t>(pass) << passShift;
+        const uint64_t nextPassKey = (static_cast<uint64_t>(pass) + 1) << passShift;
+        const auto first = std::ranges::partition_point(items, [passKey](const DrawItem& item) { return item.key < passKey; });
+        const auto last = std::partition_point(first, items.end(), [nextPassKey](const DrawItem& item) { return nextPassKey == 0 || item.key < nextPassKey; });
+
+        // Nothing is bound at the start of a pass, the caller may have changed any state in between
+        bool hasShader = false, hasInstances = false, hasGeometry = false, hasMaterial = false, hasTransform = false;
+        uint32_t boundShader = 0, boundInstances = 0, boundMaterial = 0;
+        DrawGeometry boundGeometry;
+        glm::mat4x4 boundTransform{};
+        for (auto item = first; item != last; ++item)
+        {
+            const DrawCommand& command = commands[item->command];
+            if (!hasShader || command.shader != boundShader)
+            {
+                backend.BindShader(command.shader);
+                boundShader = command.shader;
+                hasShader = true;
+                hasInstances = hasGeometry = hasMaterial = hasTransform = false;
+                ++stats.shaderBinds;
+            }
+            else
+            {
+                ++stats.skippedBinds;
+            }
+
+            if (command.instances != DrawCommand::noInstances)
+            {
+                if (!hasInstances || command.instances != boundInstances)
+                {
+                    backend.BindInstances(instances[command.instances]);
+                    boundInstances = command.instances;
+                    hasInstances = true;
+                    ++stats.instanceBinds;
+                }
+                else
+                {
+                    ++stats.skippedBinds;
+                }
+            }
+
+            const DrawGeometry& geometry = geometries[command.geometry];
+            if (!hasGeometry || geometry != boundGeometry)
+            {
+                backend.BindGeometry(geometry);
+                boundGeometry = geometry;
+                hasGeometry = true;
+                ++stats.geometryBinds;
+            }
+            else
+            {
+                ++stats.skippedBinds;
+            }
+
+            if (!hasMaterial || command.material != boundMaterial)
+            {
+                backend.SetMaterial(command.shader, command.material, materials);
+                boundMaterial = command.material;
+                hasMaterial = true;
+                ++stats.materialSets;
+            }
+            else
+            {
+                ++stats.skippedBinds;
+            }
+
+            const glm::mat4x4& transform = transforms[command.transform];
+            if (!hasTransform || transform != boundTransform)
+            {
+                backend.SetTransform(command.shader, transform);
+                boundTransform = transform;
+                hasTransform = true;
+                ++stats.transformSets;
+            }
+            else
+            {
+                ++stats.skippedBinds;
+            }
+
+            backend.Draw(geometry, command.baseInstance, command.instanceCount);
+            ++stats.draws;
+        }
+    }
+
+    const RenderQueueStats& RenderQueue::GetStats() const
+    {
+        return stats;
+    }
+
+    size_t RenderQueue::GetDrawCount() const
+    {
+        return items.size();
+    }
+
+    uint64_t RenderQueue::MakeKey(const RenderPass pass, const DrawCommand& command, const unsigned int geometryKey, const float depth)
+    {
+        // Handles wider than their field only make the grouping worse, submitting still compares the actual state
+        const auto quantizedDepth = static_cast<uint64_t>(std::clamp(depth, 0.0f, 1.0f) * static_cast<float>(depthMask));
+        return static_cast<uint64_t>(pass) << passShift
+            | (command.shader & shaderMask) << shaderShift
+            | (command.instances & instancesMask) << instancesShift
+            | (command.material & materialMask) << materialShift
+            | (geometryKey & geometryMask) << geometryShift
+            | quantizedDepth;
+    }
+}
@@ -0,0 +1,174 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+#include <glm/mat4x4.hpp>
+
+#include "rendering/PBRMaterial.h"
+
+namespace Vox
+{
+    /**
+     * @brief Passes are the most significant part of the sort key, so every pass is submitted as one block
+     */
+    enum class RenderPass : uint8_t
+    {
+        GBuffer,
+        Pick,
+        Outline
+    };
+
+    /**
+     * @brief The index buffer and vertex buffers of one primitive, bound together
+     */
+    struct DrawGeometry
+    {
+        static constexpr size_t maxVertexBuffers = 5;
+
+        unsigned int indexBuffer = 0;
+        unsigned int indexType = 0;
+        uint32_t indexCount = 0;
+
+        // Bound to the vertex buffer bindings of the same index, only the first vertexBufferCount are used
+        std::array<unsigned int, maxVertexBuffers> vertexBuffers{};
+        std::array<uint32_t, maxVertexBuffers> vertexStrides{};
+        uint32_t vertexBufferCount = 0;
+
+        bool operator==(const DrawGeometry&) const = default;
+    };
+
+    /**
+     * @brief Everything one draw needs. Handles are returned by the RenderQueue's Add functions, shaders are
+     * whatever the backend registered them as
+     */
+    struct DrawCommand
+    {
+        static constexpr uint32_t noInstances = UINT32_MAX;
+
+        uint32_t shader = 0;
+        uint32_t instances = noInstances;
+        // Either a handle from AddMaterial, or a material index for shaders that look materials up themselves
+        uint32_t material = 0;
+        uint32_t geometry = 0;
+        uint32_t transform = 0;
+        uint32_t baseInstance = 0;
+        uint32_t instanceCount = 1;
+    };
+
+    /**
+     * @brief Applies the state changes a RenderQueue asks for. The queue only calls these when the state
+     * actually changes, so the backend doesn't have to check
+     */
+    class RenderBackend
+    {
+    public:
+        virtual ~RenderBackend() = default;
+
+        /**
+         * @brief Everything else has to be bound again after a shader change
+         */
+        virtual void BindShader(uint32_t shader) = 0;
+
+        virtual void BindInstances(const std::function<void()>& bind) = 0;
+
+        virtual void BindGeometry(const DrawGeometry& geometry) = 0;
+
+        /**
+         * @param materials the queue's material table, for materials that are handles instead of indices
+         */
+        virtual void SetMaterial(uint32_t shader, uint32_t material, const std::vector<PBRMaterial>& materials) = 0;
+
+        virtual void SetTransform(uint32_t shader, const glm::mat4x4& transform) = 0;
+
+        virtual void Draw(const DrawGeometry& geometry, uint32_t baseInstance, uint32_t instanceCount) = 0;
+    };
+
+    /**
+     * @brief How many state changes a submit made, and how many it skipped because nothing changed
+     */
+    struct RenderQueueStats
+    {
+        size_t draws = 0;
+        size_t shaderBinds = 0;
+        size_t instanceBinds = 0;
+        size_t geometryBinds = 0;
+        size_t materialSets = 0;
+        size_t transformSets = 0;
+        size_t skippedBinds = 0;
+    };
+
+    /**
+     * @brief Collects the draws of a frame, sorts them by state, and submits each pass with as few state changes
+     * as possible
+     * The sort key is, from the most significant bits: pass, shader, instances, material, geometry and depth.
+     * Instances come before materials because rebinding them is the most expensive change within a shader.
+     * Doesn't touch GL itself, that's left to the backend
+     */
+    class RenderQueue
+    {
+    public:
+        void Clear();
+
+        /**
+         * @brief Add something to bind before the draws that use it, like an instance buffer or a pose
+         * @return A handle for DrawCommand::instances
+         */
+        uint32_t AddInstances(std::function<void()> bind);
+
+        /**
+         * @return A handle for DrawCommand::material, the materials get consecutive handles
+         */
+        uint32_t AddMaterials(const std::vector<PBRMaterial>& materials);
+
+        uint32_t AddGeometry(const DrawGeometry& geometry);
+
+        uint32_t AddTransform(const glm::mat4x4& transform);
+
+        /**
+         * @param depth distance from the camera, from 0 to 1. Only breaks ties between draws with the same state,
+         * closest first
+         */
+        void Add(RenderPass pass, const DrawCommand& command, float depth = 0.0f);
+
+        /**
+         * @brief Sort every draw by its key. Draws with the same key keep the order they were added in
+         */
+        void Sort();
+
+        /**
+         * @brief Submit the draws of one pass in sorted order. Sort has to be called first
+         */
+        void Submit(RenderPass pass, RenderBackend& backend);
+
+        /**
+         * @brief Get the totals of every submit since the last clear
+         */
+        [[nodiscard]] const RenderQueueStats& GetStats() const;
+
+        [[nodiscard]] size_t GetDrawCount() const;
+
+        [[nodiscard]] static uint64_t MakeKey(RenderPass pass, const DrawCommand& command, unsigned int geometryKey, float depth);
+
+    private:
+        struct DrawItem
+        {
+            uint64_t key;
+            uint32_t command;
+        };
+
+        std::vector<DrawItem> items;
+        std::vector<DrawItem> sortBuffer;
+
+        std::vector<DrawCommand> commands;
+        std::vector<std::function<void()>> instances;
+        std::vector<PBRMaterial> materials;
+        std::vector<DrawGeometry> geometries;
+        std::vector<glm::mat4x4> transforms;
+
+        RenderQueueStats stats;
+    };
+}
@@ -15,6 +15,7 @@
 #include "physics/PhysicsServer.h"
 #include "rendering/FullscreenQuad.h"
 #include "rendering/buffers/ArrayTexture.h"
+#include "rendering/buffers/MeshInstanceBuffer.h"
 #include "rendering/buffers/RenderTexture.h"
 #include "rendering/shaders/pixel_shaders/DeferredShader.h"
 #include "rendering/shaders/pixel_shaders/mesh_shaders/VoxelShader.h"
@@ -53,11 +54,15 @@ namespace Vox
         voxelMaterials.emplace_back(1);
         voxelMaterials.emplace_back(2);
         voxelMaterials.emplace_back(3, 3, 4);
+
+        glCreateBuffers(1, &voxelMaterialBuffer);
+        glNamedBufferStorage(voxelMaterialBuffer, static_cast<GLsizeiptr>(sizeof(VoxelMaterial) * voxelMaterials.size()), voxelMaterials.data(), 0);
     }
 
     Renderer::~Renderer()
     {
         glDeleteBuffers(1, &voxelMeshVao);
+        glDeleteBuffers(1, &voxelMaterialBuffer);
     }
 
     SDL_Window* Renderer::GetWindow() const
@@ -105,7 +110,7 @@ namespace Vox
         return true;
     }
 
-    bool Renderer::UploadSkeletalModel(std::string alias, const std::string& relativeFilePath)
+    bool Renderer::UploadSkeletalModel(std::string alias, const std::string& relativeFilePath, const AnimationImportSettings& animationSettings)
     {
         if (uploadedSkeletalMeshes.contains(alias))
         {
@@ -113,7 +118,7 @@ namespace Vox
             return false;
         }
 
-        uploadedSkeletalMeshes.emplace(alias, std::make_shared<SkeletalModel>(ServiceLocator::GetFileIoService()->GetAssetPath() + "models/" + relativeFilePath));
+        uploadedSkeletalMeshes.emplace(alias, std::make_shared<SkeletalModel>(ServiceLocator::GetFileIoService()->GetAssetPath() + "models/" + relativeFilePath, animationSettings));
         return true;
     }
 
@@ -212,6 +217,11 @@ namespace Vox
         glEnableVertexArrayAttrib(meshVao, 2);
         glVertexArrayAttribFormat(meshVao, 2, 2, GL_FLOAT, false, 0);
         glVertexArrayAttribBinding(meshVao, 2, 2);
+        // Instance slot, every mesh draw is instanced and reads its instances through this, see MeshInstanceBuffer
+        glEnableVertexArrayAttrib(meshVao, 3);
+        glVertexArrayAttribIFormat(meshVao, 3, 1, GL_UNSIGNED_INT, 0);
+        glVertexArrayAttribBinding(meshVao, 3, MeshInstanceBuffer::slotBinding);
+        glVertexArrayBindingDivisor(meshVao, MeshInstanceBuffer::slotBinding, 1);
     }
 
     void Renderer::CreateSkeletalMeshVao()
@@ -244,21 +254,15 @@ namespace Vox
     {
         glGenVertexArrays(1, &voxelMeshVao);
         glBindVertexArray(voxelMeshVao);
-        constexpr size_t texCoordOffset = sizeof(float) * 4;
-        constexpr size_t normalOffset = sizeof(float) * 8;
-        constexpr size_t materialIdOffset = sizeof(float) * 11;
-        glVertexAttribFormat(0, 3, GL_FLOAT, false, 0);
-        glVertexAttribFormat(1, 2, GL_FLOAT, false, texCoordOffset);
-        glVertexAttribFormat(2, 3, GL_FLOAT, false, normalOffset);
-        glVertexAttribIFormat(3, 1, GL_UNSIGNED_INT, materialIdOffset);
+        // Vertices are packed into two integers, and unpacked in gBufferVoxel.vert
+        glVertexAttribIFormat(0, 2, GL_UNSIGNED_INT, 0);
         glVertexAttribBinding(0, 0);
-        glVertexAttribBinding(1, 0);
-        glVertexAttribBinding(2, 0);
-        glVertexAttribBinding(3, 0);
         glEnableVertexAttribArray(0);
+        // Chunk offsets, one per draw of the multi-draw, picked by each draw's base instance
+        glVertexAttribFormat(1, 3, GL_FLOAT, GL_FALSE, 0);
+        glVertexAttribBinding(1, 1);
+        glVertexBindingDivisor(1, 1);
         glEnableVertexAttribArray(1);
-        glEnableVertexAttribArray(2);
-        glEnableVertexAttribArray(3);
     }
 
     std::shared_ptr<Model> Renderer::GetMesh(const std::string& name) const
@@ -293,6 +297,16 @@ namespace Vox
         return &voxelMaterials.at(materialIndex - 1);
     }
 
+    const std::vector<VoxelMaterial>& Renderer::GetVoxelMaterials() const
+    {
+        return voxelMaterials;
+    }
+
+    unsigned int Renderer::GetVoxelMaterialBuffer() const
+    {
+        return voxelMaterialBuffer;
+    }
+
     MaterialShader* Renderer::GetGBufferShader() const
     {
         return gBufferShader.get();
@@ -303,6 +317,11 @@ namespace Vox
         glBindVertexArray(meshVao);
     }
 
+    unsigned int Renderer::GetMeshVao() const
+    {
+        return meshVao;
+    }
+
     MaterialShader* Renderer::GetGBufferShaderSkeleton() const
     {
         return gBufferShaderSkeleton.get();
@@ -313,6 +332,11 @@ namespace Vox
         glBindVertexArray(skeletalMeshVao);
     }
 
+    unsigned int Renderer::GetSkeletalMeshVao() const
+    {
+        return skeletalMeshVao;
+    }
+
     DeferredShader* Renderer::GetDeferredShader() const
     {
         return deferredShader.get();
@@ -76,9 +76,10 @@ namespace Vox
          * @brief Uploads a skeletal model (glTF) to the GPU
          * @param alias name key to be used
          * @param relativeFilePath file path of the model, relative to 'assets' folder
+         * @param animationSettings how the animations are resampled and compressed, the defaults keep the keys from the file
          * @return true if the model was loaded successfully, false otherwise
          */
-        bool UploadSkeletalModel(std::string alias, const std::string& relativeFilePath);
+        bool UploadSkeletalModel(std::string alias, const std::string& relativeFilePath, const AnimationImportSettings& animationSettings = {});
 
         /**
          * @brief Convert GL error code into human-readable string
@@ -95,13 +96,21 @@ namespace Vox
 	    [[nodiscard]] std::shared_ptr<Model> GetMesh(const std::string& name) const;
 	    [[nodiscard]] std::shared_ptr<SkeletalModel> GetSkeletalMesh(const std::string& name) const;
 	    [[nodiscard]] const VoxelMaterial* GetVoxelMaterial(unsigned int materialIndex) const;
+	    [[nodiscard]] const std::vector<VoxelMaterial>& GetVoxelMaterials() const;
+
+	    /**
+	     * @brief Get the storage buffer holding every voxel material, indexed by material id - 1, for voxelGeneration.comp
+	     */
+	    [[nodiscard]] unsigned int GetVoxelMaterialBuffer() const;
 
 	    // SCENE RENDERER NECESSARY METHODS
 	    [[nodiscard]] MaterialShader* GetGBufferShader() const;
 	    void BindMeshVao() const;
+	    [[nodiscard]] unsigned int GetMeshVao() const;
 
 	    [[nodiscard]] MaterialShader* GetGBufferShaderSkeleton() const;
 	    void BindSkeletalMeshVao() const;
+	    [[nodiscard]] unsigned int GetSkeletalMeshVao() const;
 
 	    [[nodiscard]] DeferredShader* GetDeferredShader() const;
 	    void BindQuadVao() const;
@@ -170,6 +179,7 @@ namespace Vox
 		std::unordered_map<std::string, std::shared_ptr<Model>> uploadedMeshes;
 		std::unordered_map<std::string, std::shared_ptr<SkeletalModel>> uploadedSkeletalMeshes;
 	    std::vector<VoxelMaterial> voxelMaterials;
+	    unsigned int voxelMaterialBuffer = 0;
 
 		SDL_Window* mainWindow;
 
@@ -8,8 +8,10 @@
 #include "physics/PhysicsServer.h"
 #include "camera/Camera.h"
 #include "camera/FlyCamera.h"
+#include "camera/Frustum.h"
 #include "core/objects/world/World.h"
 #include "rendering/DebugRenderer.h"
+#include "rendering/GLRenderBackend.h"
 #include "rendering/PickContainer.h"
 #include "rendering/Renderer.h"
 #include "rendering/buffers/frame_buffers/ColorDepthFramebuffer.h"
@@ -17,7 +19,11 @@
 #include "rendering/buffers/frame_buffers/PickBuffer.h"
 #include "rendering/buffers/frame_buffers/StencilBuffer.h"
 #include "rendering/buffers/frame_buffers/UVec2Buffer.h"
+#include "rendering/buffers/VoxelGeometryArena.h"
 #include "rendering/mesh/VoxelMesh.h"
+#include "rendering/mesh/VoxelMeshGenerator.h"
+#include "rendering/mesh/VoxelMesherBackend.h"
+#include "rendering/mesh/VoxelRemeshScheduler.h"
 #include "rendering/skeletal_mesh/SkeletalMeshInstanceContainer.h"
 #include "shaders/compute_shaders/VoxelGenerationShader.h"
 #include "shaders/pixel_shaders/DebugShader.h"
@@ -29,6 +35,7 @@
 #include "shaders/pixel_shaders/outline_shaders/OutlineShader.h"
 #include "shaders/pixel_shaders/outline_shaders/OutlineShaderDistance.h"
 #include "shaders/pixel_shaders/outline_shaders/OutlineShaderJump.h"
+#include "voxel/VoxelVertex.h"
 
 namespace Vox
 {
@@ -36,6 +43,7 @@ namespace Vox
         :viewportSize({400, 400}), owningWorld(world)
     {
         GenerateBuffers();
+        RegisterMeshShaders();
         testLight = Light(1, 1, glm::vec3(4.5f, 4.5f, 0.5f), glm::vec3(), glm::vec4(1.0f, 1.0f, 1.0f, 1.0f), 1000.0f);
         defaultCamera = std::make_shared<FlyCamera>();
         defaultCamera->SetPosition(0.0f, 0.0f, 0.0f);
@@ -44,7 +52,11 @@ namespace Vox
         currentCamera = defaultCamera;
     }
 
-    SceneRenderer::~SceneRenderer() = default;
+    SceneRenderer::~SceneRenderer()
+    {
+        const unsigned int buffers[2] = { voxelDrawCommandBuffer, voxelChunkOffsetBuffer };
+        glDeleteBuffers(2, buffers);
+    }
 
     void SceneRenderer::Draw()
     {
@@ -55,6 +67,9 @@ namespace Vox
         ConditionalResizeFramebuffers();
         glViewport(0, 0, static_cast<int>(viewportSize.x), static_cast<int>(viewportSize.y));
         currentCamera->SetAspectRatio(viewportSize.y == 0 ? 1 : static_cast<float>(viewportSize.x) / static_cast<float>(viewportSize.y));
+        UpdateVisibility();
+        UpdateAnimations();
+        BuildRenderQueue();
 
         DrawGBuffer();
         DrawDeferredPass();
@@ -105,9 +120,14 @@ namespace Vox
         return {};
     }
 
-    DynamicRef<VoxelMesh> SceneRenderer::CreateVoxelMesh(glm::ivec2 chunkLocation)
+    DynamicRef<VoxelMesh> SceneRenderer::CreateVoxelMesh(glm::ivec3 chunkLocation)
     {
-        return {&voxelMeshes, voxelMeshes.Create(chunkLocation)};
+        return {&voxelMeshes, voxelMeshes.Create(chunkLocation, voxelGeometryArena.get())};
+    }
+
+    void SceneRenderer::DestroyVoxelMesh(const DynamicRef<VoxelMesh>& mesh)
+    {
+        voxelMeshes.Remove(mesh.GetId());
     }
 
     std::shared_ptr<Camera> SceneRenderer::GetCurrentCamera() const
@@ -145,22 +165,12 @@ namespace Vox
         const MaterialShader* gBufferShader = GetRenderer()->GetGBufferShader();
         gBufferShader->Enable();
         gBufferShader->SetCamera(currentCamera);
-        GetRenderer()->BindMeshVao();
-
-        for (auto& val : meshInstances | std::views::values)
-        {
-            val.Render(gBufferShader);
-        }
 
-        MaterialShader* skeletonShader = GetRenderer()->GetGBufferShaderSkeleton();
+        const MaterialShader* skeletonShader = GetRenderer()->GetGBufferShaderSkeleton();
         skeletonShader->Enable();
         skeletonShader->SetCamera(currentCamera);
-        GetRenderer()->BindSkeletalMeshVao();
 
-        for (SkeletalMeshInstanceContainer& val : skeletalMeshInstances | std::views::values)
-        {
-            val.Render(skeletonShader);
-        }
+        renderQueue.Submit(RenderPass::GBuffer, *renderBackend);
 
         UpdateVoxels();
         DrawVoxels();
@@ -199,22 +209,12 @@ namespace Vox
         const PickShader* pickShader = GetRenderer()->GetPickShader();
         pickShader->Enable();
         pickShader->SetCamera(currentCamera);
-        GetRenderer()->BindMeshVao();
-
-        for (auto& val : meshInstances | std::views::values)
-        {
-            val.Render(pickShader);
-        }
 
         const PickShader* pickShaderSkeleton = GetRenderer()->GetPickShaderSkeleton();
         pickShaderSkeleton->Enable();
         pickShaderSkeleton->SetCamera(currentCamera);
-        GetRenderer()->BindSkeletalMeshVao();
 
-        for (auto& val : skeletalMeshInstances | std::views::values)
-        {
-            val.Render(pickShaderSkeleton);
-        }
+        renderQueue.Submit(RenderPass::Pick, *renderBackend);
 
         pickShader->Enable();
         GetRenderer()->BindMeshVao();
@@ -233,30 +233,12 @@ namespace Vox
         const StencilShader* stencilShader = GetRenderer()->GetStencilShader();
         stencilShader->Enable();
         stencilShader->SetCamera(currentCamera);
-        GetRenderer()->BindMeshVao();
-
-        std::erase_if(outlinedMeshes, [](const WeakRef<MeshInstance>& meshInstance)
-            {
-                return !meshInstance;
-            });
-        std::erase_if(outlinedSkeletalMeshes, [](const WeakRef<SkeletalMeshInstance>& meshInstance)
-            {
-                return !meshInstance;
-            });
-
-        for (const WeakRef<MeshInstance>& mesh : outlinedMeshes)
-        {
-            mesh->GetMeshOwner()->RenderInstance(stencilShader, *mesh);
-        }
 
         const StencilShader* stencilShaderSkeleton = GetRenderer()->GetStencilShaderSkeleton();
         stencilShaderSkeleton->Enable();
         stencilShaderSkeleton->SetCamera(currentCamera);
-        GetRenderer()->BindSkeletalMeshVao();
-        for (const auto& mesh : outlinedSkeletalMeshes)
-        {
-            mesh->GetMeshOwner()->RenderInstance(stencilShader, *mesh);
-        }
+
+        renderQueue.Submit(RenderPass::Outline, *renderBackend);
 
         constexpr int outlineWidth = 2;
         GetRenderer()->BindQuadVao();
@@ -320,21 +302,47 @@ namespace Vox
 
     void SceneRenderer::DrawVoxels()
     {
+        voxelCuller.Clear();
+        culledVoxelMeshes.clear();
+        for (const std::optional<VoxelMesh>& voxelMesh : voxelMeshes)
+        {
+            if (voxelMesh.has_value() && voxelMesh->GetVertexCount() > 0)
+            {
+                voxelCuller.Add(voxelMesh->GetBounds());
+                culledVoxelMeshes.emplace_back(&*voxelMesh);
+            }
+        }
+
+        voxelDrawList.Clear();
+        for (const uint32_t index : voxelCuller.Cull(currentCamera->GetFrustum()))
+        {
+            const VoxelMesh* voxelMesh = culledVoxelMeshes[index];
+            voxelDrawList.Add(voxelMesh->GetFirstVertex(), voxelMesh->GetVertexCount(), voxelMesh->GetPosition());
+        }
+
+        if (voxelDrawList.IsEmpty())
+        {
+            return;
+        }
+
+        const std::vector<DrawArraysIndirectCommand>& commands = voxelDrawList.GetCommands();
+        const std::vector<glm::vec4>& chunkOffsets = voxelDrawList.GetChunkOffsets();
+        glNamedBufferData(voxelDrawCommandBuffer, static_cast<GLsizeiptr>(sizeof(DrawArraysIndirectCommand) * commands.size()),
+            commands.data(), GL_STREAM_DRAW);
+        glNamedBufferData(voxelChunkOffsetBuffer, static_cast<GLsizeiptr>(sizeof(glm::vec4) * chunkOffsets.size()),
+            chunkOffsets.data(), GL_STREAM_DRAW);
+
         GetRenderer()->BindVoxelMeshVao();
         const VoxelShader* voxelShader = GetRenderer()->GetVoxelMeshShader();
         voxelShader->Enable();
         voxelShader->SetCamera(currentCamera);
         voxelShader->SetArrayTexture(GetRenderer()->GetVoxelTextures());
 
-        for (std::optional<VoxelMesh>& voxelMesh : voxelMeshes)
-        {
-            if (voxelMesh.has_value())
-            {
-                glBindVertexBuffer(0, voxelMesh->GetMeshId(), 0, sizeof(float) * 16);
-                voxelShader->SetModelMatrix(voxelMesh->GetTransform());
-                glDrawArrays(GL_TRIANGLES, 0, static_cast<int>(voxelMesh->GetVertexCount()));
-            }
-        }
+        glBindVertexBuffer(0, voxelGeometryArena->GetBufferId(), 0, sizeof(VoxelVertex));
+        glBindVertexBuffer(1, voxelChunkOffsetBuffer, 0, sizeof(glm::vec4));
+        glBindBuffer(GL_DRAW_INDIRECT_BUFFER, voxelDrawCommandBuffer);
+        glMultiDrawArraysIndirect(GL_TRIANGLES, nullptr, static_cast<int>(voxelDrawList.GetDrawCount()), 0);
+        glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
     }
 
     void SceneRenderer::DrawSky() const
@@ -377,17 +385,93 @@ namespace Vox
         glDrawArrays(GL_TRIANGLES, 0, static_cast<int>(physicsServer->GetDebugRenderer()->GetTriangleVertexCount()));
     }
 
+    void SceneRenderer::UpdateVisibility()
+    {
+        const Frustum& frustum = currentCamera->GetFrustum();
+        for (MeshInstanceContainer& meshInstanceContainer : meshInstances | std::views::values)
+        {
+            meshInstanceContainer.UpdateVisibility(frustum);
+        }
+        for (SkeletalMeshInstanceContainer& meshInstanceContainer : skeletalMeshInstances | std::views::values)
+        {
+            meshInstanceContainer.UpdateVisibility(frustum);
+        }
+    }
+
+    void SceneRenderer::UpdateAnimations()
+    {
+        for (SkeletalMeshInstanceContainer& meshInstanceContainer : skeletalMeshInstances | std::views::values)
+        {
+            meshInstanceContainer.UpdatePoses();
+        }
+    }
+
+    void SceneRenderer::BuildRenderQueue()
+    {
+        renderQueue.Clear();
+        for (const MeshInstanceContainer& meshInstanceContainer : meshInstances | std::views::values)
+        {
+            meshInstanceContainer.Enqueue(renderQueue, RenderPass::GBuffer, gBufferShaderHandle);
+        }
+        for (const SkeletalMeshInstanceContainer& meshInstanceContainer : skeletalMeshInstances | std::views::values)
+        {
+            meshInstanceContainer.Enqueue(renderQueue, RenderPass::GBuffer, gBufferSkeletonShaderHandle);
+        }
+
+#ifdef EDITOR
+        for (const MeshInstanceContainer& meshInstanceContainer : meshInstances | std::views::values)
+        {
+            meshInstanceContainer.Enqueue(renderQueue, RenderPass::Pick, pickShaderHandle);
+        }
+        for (const SkeletalMeshInstanceContainer& meshInstanceContainer : skeletalMeshInstances | std::views::values)
+        {
+            meshInstanceContainer.EnqueuePick(renderQueue, pickSkeletonShaderHandle, GetRenderer()->GetPickShaderSkeleton());
+        }
+
+        std::erase_if(outlinedMeshes, [](const WeakRef<MeshInstance>& meshInstance)
+            {
+                return !meshInstance;
+            });
+        std::erase_if(outlinedSkeletalMeshes, [](const WeakRef<SkeletalMeshInstance>& meshInstance)
+            {
+                return !meshInstance;
+            });
+
+        const Frustum& frustum = currentCamera->GetFrustum();
+        for (const WeakRef<MeshInstance>& mesh : outlinedMeshes)
+        {
+            if (frustum.Intersects(mesh->GetMeshOwner()->GetInstanceBounds(*mesh)))
+            {
+                mesh->GetMeshOwner()->EnqueueInstance(renderQueue, RenderPass::Outline, stencilShaderHandle, *mesh);
+            }
+        }
+        for (const WeakRef<SkeletalMeshInstance>& mesh : outlinedSkeletalMeshes)
+        {
+            if (frustum.Intersects(mesh->GetMeshOwner()->GetInstanceBounds(*mesh)))
+            {
+                mesh->GetMeshOwner()->EnqueueInstance(renderQueue, RenderPass::Outline, stencilSkeletonShaderHandle, *mesh);
+            }
+        }
+#endif
+
+        renderQueue.Sort();
+    }
+
     void SceneRenderer::UpdateVoxels()
     {
-        GetRenderer()->GetVoxelGenerationShader()->Enable();
         for (const auto& [index, snd] : voxelMeshes.GetDirtyIndices())
         {
-            if (VoxelMesh* mesh = voxelMeshes.Get(index, snd))
+            if (const VoxelMesh* mesh = voxelMeshes.Get(index, snd))
             {
-                mesh->Regenerate(*GetRenderer()->GetVoxelGenerationShader());
+                voxelRemeshScheduler->Request({index, snd}, mesh->GetCenter());
             }
         }
         voxelMeshes.ClearDirty();
+
+#ifndef CPU_VOXEL_MESHING
+        GetRenderer()->GetVoxelGenerationShader()->Enable();
+#endif
+        voxelRemeshScheduler->Update(currentCamera->GetPosition());
     }
 
     void SceneRenderer::GenerateBuffers()
@@ -405,6 +489,42 @@ namespace Vox
         outlineBuffer = std::make_unique<UVec2Buffer>(defaultWidth, defaultHeight);
         outlineBuffer2 = std::make_unique<UVec2Buffer>(defaultWidth, defaultHeight);
 #endif
+
+        // 8 MiB to start with, the arena grows when it runs out
+        constexpr size_t initialVoxelVertexCapacity = 1024 * 1024;
+        voxelGeometryArena = std::make_unique<VoxelGeometryArena>(initialVoxelVertexCapacity);
+
+        // Chunks closest to the camera are remeshed first, a few per frame, so painting voxels doesn't stall the frame
+        constexpr unsigned int voxelGenerationSlots = 8;
+        constexpr unsigned int voxelRemeshBudgetPerFrame = 4;
+#ifdef CPU_VOXEL_MESHING
+        voxelRemeshBackend = std::make_unique<VoxelMesherBackend>(&voxelMeshes, &GetRenderer()->GetVoxelMaterials(), voxelGenerationSlots);
+#else
+        voxelRemeshBackend = std::make_unique<VoxelMeshGenerator>(&voxelMeshes, voxelGenerationSlots);
+#endif
+        voxelRemeshScheduler = std::make_unique<VoxelRemeshScheduler>(voxelRemeshBackend.get(), voxelRemeshBudgetPerFrame);
+
+        unsigned int buffers[2] = {};
+        glCreateBuffers(2, buffers);
+        voxelDrawCommandBuffer = buffers[0];
+        voxelChunkOffsetBuffer = buffers[1];
+    }
+
+    void SceneRenderer::RegisterMeshShaders()
+    {
+        using MaterialMode = GLRenderBackend::MaterialMode;
+        const Renderer* renderer = GetRenderer();
+        renderBackend = std::make_unique<GLRenderBackend>();
+
+        // Static meshes look their materials up from the instance data, skeletal meshes are given theirs
+        gBufferShaderHandle = renderBackend->RegisterShader(renderer->GetGBufferShader(), renderer->GetMeshVao(), MaterialMode::Index);
+        gBufferSkeletonShaderHandle = renderBackend->RegisterShader(renderer->GetGBufferShaderSkeleton(), renderer->GetSkeletalMeshVao(), MaterialMode::Value);
+#ifdef EDITOR
+        pickShaderHandle = renderBackend->RegisterShader(renderer->GetPickShader(), renderer->GetMeshVao());
+        pickSkeletonShaderHandle = renderBackend->RegisterShader(renderer->GetPickShaderSkeleton(), renderer->GetSkeletalMeshVao());
+        stencilShaderHandle = renderBackend->RegisterShader(renderer->GetStencilShader(), renderer->GetMeshVao());
+        stencilSkeletonShaderHandle = renderBackend->RegisterShader(renderer->GetStencilShaderSkeleton(), renderer->GetSkeletalMeshVao());
+#endif
     }
 
     void SceneRenderer::ConditionalResizeFramebuffers()
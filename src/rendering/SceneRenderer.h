@@ -14,6 +14,9 @@
 #include "core/datatypes/Ref.h"
 #include "core/datatypes/WeakRef.h"
 #include "mesh/MeshInstanceContainer.h"
+#include "FrustumCuller.h"
+#include "RenderQueue.h"
+#include "mesh/VoxelDrawList.h"
 #include "skeletal_mesh/SkeletalMeshInstanceContainer.h"
 
 namespace Vox
@@ -28,13 +31,17 @@ namespace Vox
     class Camera;
     class ColorDepthFramebuffer;
     class GBuffer;
+    class GLRenderBackend;
     class PickBuffer;
     class PickContainer;
     class RenderTexture;
     class Renderer;
     class StencilBuffer;
     class UVec2Buffer;
+    class VoxelGeometryArena;
     class VoxelMesh;
+    class VoxelRemeshBackend;
+    class VoxelRemeshScheduler;
 
     /**
      * @brief A renderer for holding all the resources related to a 3D world
@@ -52,7 +59,12 @@ namespace Vox
 
         Ref<SkeletalMeshInstance> CreateSkeletalMeshInstance(const std::string& meshName);
 
-        DynamicRef<VoxelMesh> CreateVoxelMesh(glm::ivec2 chunkLocation);
+        DynamicRef<VoxelMesh> CreateVoxelMesh(glm::ivec3 chunkLocation);
+
+        /**
+         * @brief Destroy a voxel mesh and free its range of the voxel geometry arena immediately
+         */
+        void DestroyVoxelMesh(const DynamicRef<VoxelMesh>& mesh);
 
         [[nodiscard]] std::shared_ptr<Camera> GetCurrentCamera() const;
 
@@ -97,16 +109,39 @@ namespace Vox
         void DrawOverlay();
 #endif
 
+        /**
+         * @brief Draw every voxel chunk in the camera frustum with a single glMultiDrawArraysIndirect over the geometry arena
+         */
         void DrawVoxels();
 
         void DrawSky() const;
 
         void DrawDebugShapes() const;
 
+        /**
+         * @brief Cull every mesh instance container against the current camera, before any pass draws them
+         */
+        void UpdateVisibility();
+
+        /**
+         * @brief Pose every visible skeletal mesh instance once, for all the passes this frame. Has to be called after UpdateVisibility
+         */
+        void UpdateAnimations();
+
+        /**
+         * @brief Queue the draws of every mesh pass for this frame, and sort them. Has to be called after UpdateVisibility
+         */
+        void BuildRenderQueue();
+
+        /**
+         * @brief Queue the meshes that changed since last frame, and let the scheduler start and finish a few of them
+         */
         void UpdateVoxels();
 
         void GenerateBuffers();
 
+        void RegisterMeshShaders();
+
         void ConditionalResizeFramebuffers();
 
         [[nodiscard]] static Renderer* GetRenderer();
@@ -130,7 +165,28 @@ namespace Vox
         // MESH INSTANCES
         std::unordered_map<std::string, MeshInstanceContainer> meshInstances;
         std::unordered_map<std::string, SkeletalMeshInstanceContainer> skeletalMeshInstances;
+
+        RenderQueue renderQueue;
+        std::unique_ptr<GLRenderBackend> renderBackend;
+
+        // Handles of the mesh shaders in renderBackend
+        uint32_t gBufferShaderHandle = 0, gBufferSkeletonShaderHandle = 0;
+#ifdef EDITOR
+        uint32_t pickShaderHandle = 0, pickSkeletonShaderHandle = 0, stencilShaderHandle = 0, stencilSkeletonShaderHandle = 0;
+#endif
+
+        // Declared before the meshes, so they can release their ranges before it's destroyed
+        std::unique_ptr<VoxelGeometryArena> voxelGeometryArena;
         DynamicObjectContainer<VoxelMesh> voxelMeshes;
+        // VoxelMeshGenerator, or VoxelMesherBackend when built with CPU_VOXEL_MESHING
+        std::unique_ptr<VoxelRemeshBackend> voxelRemeshBackend;
+        std::unique_ptr<VoxelRemeshScheduler> voxelRemeshScheduler;
+
+        FrustumCuller voxelCuller;
+        // The meshes given to voxelCuller, in the same order
+        std::vector<const VoxelMesh*> culledVoxelMeshes;
+        VoxelDrawList voxelDrawList;
+        unsigned int voxelDrawCommandBuffer = 0, voxelChunkOffsetBuffer = 0;
 
         Light testLight;
 
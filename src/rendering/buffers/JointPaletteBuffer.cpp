@@ -0,0 +1,64 @@
+#include "JointPaletteBuffer.h"
+
+#include <algorithm>
+#include <cassert>
+
+#include <GL/glew.h>
+
+#include "rendering/skeletal_mesh/SkeletalPose.h"
+
+namespace Vox
+{
+    namespace
+    {
+        constexpr size_t paletteSize = sizeof(glm::mat4x4) * SkeletalPose::maxJointCount;
+    }
+
+    JointPaletteBuffer::JointPaletteBuffer()
+    {
+        glCreateBuffers(1, &buffer);
+    }
+
+    JointPaletteBuffer::~JointPaletteBuffer()
+    {
+        glDeleteBuffers(1, &buffer);
+    }
+
+    void JointPaletteBuffer::Upload(const std::vector<SkeletalPose>& poses, const std::vector<size_t>& poseIndices)
+    {
+        const size_t poseCount = poseIndices.size();
+        paletteCount = poseCount;
+        if (poseCount == 0)
+        {
+            return;
+        }
+
+        if (poseCount > capacity)
+        {
+            constexpr size_t minimumCapacity = 8;
+            capacity = std::max({capacity * 2, poseCount, minimumCapacity});
+            glNamedBufferData(buffer, static_cast<GLsizeiptr>(paletteSize * capacity), nullptr, GL_DYNAMIC_DRAW);
+        }
+
+        stagingMatrices.resize(poseCount * SkeletalPose::maxJointCount);
+        for (size_t i = 0; i < poseCount; ++i)
+        {
+            assert(poseIndices[i] < poses.size());
+            const std::vector<glm::mat4x4>& jointMatrices = poses[poseIndices[i]].jointMatrices;
+            std::copy_n(jointMatrices.begin(), std::min(jointMatrices.size(), SkeletalPose::maxJointCount),
+                stagingMatrices.begin() + static_cast<std::ptrdiff_t>(i * SkeletalPose::maxJointCount));
+        }
+        glNamedBufferSubData(buffer, 0, static_cast<GLsizeiptr>(paletteSize * poseCount), stagingMatrices.data());
+    }
+
+    void JointPaletteBuffer::Bind(const size_t palette) const
+    {
+        assert(palette < paletteCount);
+        glBindBufferRange(GL_UNIFORM_BUFFER, binding, buffer, static_cast<GLintptr>(paletteSize * palette), static_cast<GLsizeiptr>(paletteSize));
+    }
+
+    size_t JointPaletteBuffer::GetPaletteCount() const
+    {
+        return paletteCount;
+    }
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include <glm/mat4x4.hpp>
+
+namespace Vox
+{
+    struct SkeletalPose;
+
+    /**
+     * @brief The joint matrices of every posed instance of a skeletal model, uploaded once a frame and shared by
+     * every pass that draws them
+     * Each palette takes up a full joint array, 4 KiB, which keeps every palette aligned for glBindBufferRange
+     */
+    class JointPaletteBuffer
+    {
+    public:
+        // Uniform block binding of the joint matrices in skeletalMesh.vert
+        static constexpr unsigned int binding = 0;
+
+        JointPaletteBuffer();
+        ~JointPaletteBuffer();
+
+        JointPaletteBuffer(JointPaletteBuffer&&) = delete;
+        JointPaletteBuffer(const JointPaletteBuffer&) = delete;
+        JointPaletteBuffer& operator=(JointPaletteBuffer&&) = delete;
+        JointPaletteBuffer& operator=(const JointPaletteBuffer&) = delete;
+
+        /**
+         * @brief Replace the palettes with the joint matrices of some of the poses, in one upload
+         * @param poseIndices the poses to upload, palettes are numbered in this order
+         */
+        void Upload(const std::vector<SkeletalPose>& poses, const std::vector<size_t>& poseIndices);
+
+        /**
+         * @brief Bind one palette for the draws that follow
+         * @param palette index of the pose in the last upload
+         */
+        void Bind(size_t palette) const;
+
+        [[nodiscard]] size_t GetPaletteCount() const;
+
+    private:
+        unsigned int buffer = 0;
+
+        size_t capacity = 0;
+        size_t paletteCount = 0;
+
+        std::vector<glm::mat4x4> stagingMatrices;
+    };
+}
@@ -0,0 +1,103 @@
+#include "MeshInstanceBuffer.h"
+
+#include <algorithm>
+#include <cassert>
+#include <numeric>
+
+#include <GL/glew.h>
+
+#include "rendering/mesh/MeshInstanceList.h"
+
+namespace Vox
+{
+    MeshInstanceBuffer::MeshInstanceBuffer()
+    {
+        unsigned int buffers[3] = {};
+        glCreateBuffers(3, buffers);
+        instanceBuffer = buffers[0];
+        materialBuffer = buffers[1];
+        slotBuffer = buffers[2];
+    }
+
+    MeshInstanceBuffer::~MeshInstanceBuffer()
+    {
+        const unsigned int buffers[3] = { instanceBuffer, materialBuffer, slotBuffer };
+        glDeleteBuffers(3, buffers);
+    }
+
+    void MeshInstanceBuffer::Upload(const MeshInstanceList& instances)
+    {
+        const size_t materialsPerInstance = instances.GetMaterialsPerInstance();
+        if (instances.GetSlotCount() > capacity)
+        {
+            constexpr size_t minimumCapacity = 8;
+            Reallocate(std::max({capacity * 2, instances.GetSlotCount(), minimumCapacity}), materialsPerInstance);
+            slotCount = instances.GetSlotCount();
+            glNamedBufferSubData(instanceBuffer, 0, static_cast<GLsizeiptr>(sizeof(InstanceData) * slotCount), instances.GetInstances().data());
+            glNamedBufferSubData(materialBuffer, 0, static_cast<GLsizeiptr>(sizeof(InstanceMaterial) * slotCount * materialsPerInstance),
+                instances.GetMaterials().data());
+            return;
+        }
+
+        slotCount = instances.GetSlotCount();
+        if (!instances.HasChanges())
+        {
+            return;
+        }
+
+        const size_t first = instances.GetFirstChangedSlot();
+        const size_t count = instances.GetChangedSlotEnd() - first;
+        glNamedBufferSubData(instanceBuffer, static_cast<GLintptr>(sizeof(InstanceData) * first),
+            static_cast<GLsizeiptr>(sizeof(InstanceData) * count), instances.GetInstances().data() + first);
+        glNamedBufferSubData(materialBuffer, static_cast<GLintptr>(sizeof(InstanceMaterial) * first * materialsPerInstance),
+            static_cast<GLsizeiptr>(sizeof(InstanceMaterial) * count * materialsPerInstance),
+            instances.GetMaterials().data() + first * materialsPerInstance);
+    }
+
+    void MeshInstanceBuffer::SetDrawnSlots(const std::vector<uint32_t>& slots)
+    {
+        assert(slots.size() <= capacity);
+        drawnCount = static_cast<uint32_t>(slots.size());
+        if (drawnCount > 0)
+        {
+            glNamedBufferSubData(slotBuffer, static_cast<GLintptr>(sizeof(uint32_t) * capacity),
+                static_cast<GLsizeiptr>(sizeof(uint32_t) * slots.size()), slots.data());
+        }
+    }
+
+    void MeshInstanceBuffer::Bind() const
+    {
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, instanceBinding, instanceBuffer);
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, materialBinding, materialBuffer);
+        glBindVertexBuffer(slotBinding, slotBuffer, 0, sizeof(uint32_t));
+    }
+
+    uint32_t MeshInstanceBuffer::GetDrawnBaseInstance() const
+    {
+        return static_cast<uint32_t>(capacity);
+    }
+
+    uint32_t MeshInstanceBuffer::GetDrawnCount() const
+    {
+        return drawnCount;
+    }
+
+    size_t MeshInstanceBuffer::GetSlotCount() const
+    {
+        return slotCount;
+    }
+
+    void MeshInstanceBuffer::Reallocate(const size_t newCapacity, const size_t materialsPerInstance)
+    {
+        capacity = newCapacity;
+        drawnCount = 0;
+        glNamedBufferData(instanceBuffer, static_cast<GLsizeiptr>(sizeof(InstanceData) * capacity), nullptr, GL_DYNAMIC_DRAW);
+        glNamedBufferData(materialBuffer, static_cast<GLsizeiptr>(sizeof(InstanceMaterial) * capacity * materialsPerInstance), nullptr, GL_DYNAMIC_DRAW);
+
+        // The first half never changes until the next reallocation, the drawn slots are written after it every frame
+        std::vector<uint32_t> identitySlots(capacity);
+        std::iota(identitySlots.begin(), identitySlots.end(), 0u);
+        glNamedBufferData(slotBuffer, static_cast<GLsizeiptr>(sizeof(uint32_t) * capacity * 2), nullptr, GL_DYNAMIC_DRAW);
+        glNamedBufferSubData(slotBuffer, 0, static_cast<GLsizeiptr>(sizeof(uint32_t) * capacity), identitySlots.data());
+    }
+}
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace Vox
+{
+    class MeshInstanceList;
+
+    /**
+     * @brief The GPU side of a MeshInstanceList, so every instance of a model can be drawn with one instanced draw
+     * per primitive
+     * Instance data and materials live in storage buffers that are only written when instances change. The instanced
+     * slot attribute reads from a third buffer: first every slot in order, so a single instance can be drawn with its
+     * slot as the base instance, then the slots drawn this frame, starting at GetDrawnBaseInstance
+     */
+    class MeshInstanceBuffer
+    {
+    public:
+        // Storage buffer bindings, these have to match the mesh shaders
+        static constexpr unsigned int instanceBinding = 4;
+        static constexpr unsigned int materialBinding = 5;
+
+        // Vertex buffer binding of the instanced slot attribute, see Renderer::CreateMeshVao
+        static constexpr unsigned int slotBinding = 3;
+
+        MeshInstanceBuffer();
+        ~MeshInstanceBuffer();
+
+        MeshInstanceBuffer(MeshInstanceBuffer&&) = delete;
+        MeshInstanceBuffer(const MeshInstanceBuffer&) = delete;
+        MeshInstanceBuffer& operator=(MeshInstanceBuffer&&) = delete;
+        MeshInstanceBuffer& operator=(const MeshInstanceBuffer&) = delete;
+
+        /**
+         * @brief Upload the slots that changed in the list. Everything is uploaded again if the buffers have to grow
+         */
+        void Upload(const MeshInstanceList& instances);
+
+        /**
+         * @brief Set the slots drawn by the next instanced draws, in order
+         * @param slots each must be less than the slot count of the last upload
+         */
+        void SetDrawnSlots(const std::vector<uint32_t>& slots);
+
+        void Bind() const;
+
+        [[nodiscard]] uint32_t GetDrawnBaseInstance() const;
+
+        [[nodiscard]] uint32_t GetDrawnCount() const;
+
+        /**
+         * @brief Get how many slots have been uploaded, only these can be drawn
+         */
+        [[nodiscard]] size_t GetSlotCount() const;
+
+    private:
+        void Reallocate(size_t newCapacity, size_t materialsPerInstance);
+
+        unsigned int instanceBuffer = 0, materialBuffer = 0, slotBuffer = 0;
+
+        size_t capacity = 0;
+        size_t slotCount = 0;
+        uint32_t drawnCount = 0;
+    };
+}
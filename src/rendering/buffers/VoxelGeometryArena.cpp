@@ -0,0 +1,108 @@
+#include "VoxelGeometryArena.h"
+
+#include <algorithm>
+#include <cassert>
+
+#include <GL/glew.h>
+
+#include "core/logging/Logging.h"
+#include "voxel/VoxelVertex.h"
+
+namespace Vox
+{
+    VoxelGeometryArena::VoxelGeometryArena(const size_t initialVertexCapacity)
+        :allocator(initialVertexCapacity), buffer(CreateBuffer(initialVertexCapacity))
+    {
+    }
+
+    VoxelGeometryArena::~VoxelGeometryArena()
+    {
+        glDeleteBuffers(1, &buffer);
+    }
+
+    VoxelGeometryArena::Handle VoxelGeometryArena::Allocate(const size_t vertexCount)
+    {
+        Handle handle = allocator.Allocate(vertexCount);
+        if (handle != invalidHandle)
+        {
+            return handle;
+        }
+
+        // Compacting leaves all the free space in one range, so only grow if that still isn't enough
+        size_t newCapacity = allocator.GetCapacity();
+        if (allocator.GetFreeSize() < vertexCount)
+        {
+            newCapacity = std::max(newCapacity * 2, allocator.GetUsedSize() + vertexCount);
+        }
+        Reallocate(newCapacity);
+
+        handle = allocator.Allocate(vertexCount);
+        assert(handle != invalidHandle);
+        return handle;
+    }
+
+    void VoxelGeometryArena::Free(const Handle handle)
+    {
+        allocator.Free(handle);
+    }
+
+    void VoxelGeometryArena::Upload(const Handle handle, const std::vector<VoxelVertex>& vertices)
+    {
+        const RangeAllocator::Range range = allocator.GetRange(handle);
+        assert(vertices.size() <= range.size);
+        glNamedBufferSubData(buffer, static_cast<GLintptr>(range.offset * sizeof(VoxelVertex)),
+            static_cast<GLsizeiptr>(vertices.size() * sizeof(VoxelVertex)), vertices.data());
+    }
+
+    void VoxelGeometryArena::CopyFrom(const Handle handle, const unsigned int sourceBuffer)
+    {
+        const RangeAllocator::Range range = allocator.GetRange(handle);
+        glCopyNamedBufferSubData(sourceBuffer, buffer, 0, static_cast<GLintptr>(range.offset * sizeof(VoxelVertex)),
+            static_cast<GLsizeiptr>(range.size * sizeof(VoxelVertex)));
+    }
+
+    RangeAllocator::Range VoxelGeometryArena::GetRange(const Handle handle) const
+    {
+        return allocator.GetRange(handle);
+    }
+
+    unsigned int VoxelGeometryArena::GetBufferId() const
+    {
+        return buffer;
+    }
+
+    size_t VoxelGeometryArena::GetCapacityBytes() const
+    {
+        return allocator.GetCapacity() * sizeof(VoxelVertex);
+    }
+
+    size_t VoxelGeometryArena::GetUsedBytes() const
+    {
+        return allocator.GetUsedSize() * sizeof(VoxelVertex);
+    }
+
+    void VoxelGeometryArena::Reallocate(const size_t newVertexCapacity)
+    {
+        VoxLog(Display, Rendering, "Compacting voxel geometry arena, {} of {} vertices in use, new capacity {} vertices.",
+            allocator.GetUsedSize(), allocator.GetCapacity(), newVertexCapacity);
+
+        const unsigned int newBuffer = CreateBuffer(newVertexCapacity);
+        for (const RangeAllocator::Move& move : allocator.Compact(newVertexCapacity))
+        {
+            glCopyNamedBufferSubData(buffer, newBuffer,
+                static_cast<GLintptr>(move.sourceOffset * sizeof(VoxelVertex)),
+                static_cast<GLintptr>(move.destinationOffset * sizeof(VoxelVertex)),
+                static_cast<GLsizeiptr>(move.size * sizeof(VoxelVertex)));
+        }
+        glDeleteBuffers(1, &buffer);
+        buffer = newBuffer;
+    }
+
+    unsigned int VoxelGeometryArena::CreateBuffer(const size_t vertexCapacity)
+    {
+        unsigned int newBuffer;
+        glCreateBuffers(1, &newBuffer);
+        glNamedBufferStorage(newBuffer, static_cast<GLsizeiptr>(vertexCapacity * sizeof(VoxelVertex)), nullptr, GL_DYNAMIC_STORAGE_BIT);
+        return newBuffer;
+    }
+}
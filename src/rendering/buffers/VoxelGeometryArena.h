@@ -0,0 +1,72 @@
+#pragma once
+
+#include <vector>
+
+#include "core/datatypes/RangeAllocator.h"
+
+namespace Vox
+{
+    struct VoxelVertex;
+
+    /**
+     * @brief One vertex buffer shared by every voxel chunk mesh, so they can all be drawn with a single multi-draw
+     * Each mesh takes a range that is exactly as large as its vertices. When no free range is large enough, the
+     * buffer is compacted into a new one, and grown if there isn't enough free space in total
+     */
+    class VoxelGeometryArena
+    {
+    public:
+        using Handle = RangeAllocator::Handle;
+
+        static constexpr Handle invalidHandle = RangeAllocator::invalidHandle;
+
+        explicit VoxelGeometryArena(size_t initialVertexCapacity);
+        ~VoxelGeometryArena();
+
+        VoxelGeometryArena(VoxelGeometryArena&&) = delete;
+        VoxelGeometryArena(const VoxelGeometryArena&) = delete;
+        VoxelGeometryArena& operator=(VoxelGeometryArena&&) = delete;
+        VoxelGeometryArena& operator=(const VoxelGeometryArena&) = delete;
+
+        /**
+         * @brief Reserve a range for vertexCount vertices. Always succeeds, but may replace the buffer
+         * @param vertexCount must be greater than zero
+         */
+        [[nodiscard]] Handle Allocate(size_t vertexCount);
+
+        void Free(Handle handle);
+
+        /**
+         * @brief Write vertices to the start of a range
+         */
+        void Upload(Handle handle, const std::vector<VoxelVertex>& vertices);
+
+        /**
+         * @brief Fill a range from the start of another buffer, without reading it back to the CPU
+         */
+        void CopyFrom(Handle handle, unsigned int sourceBuffer);
+
+        /**
+         * @brief Get the first vertex and vertex count of a range
+         */
+        [[nodiscard]] RangeAllocator::Range GetRange(Handle handle) const;
+
+        [[nodiscard]] unsigned int GetBufferId() const;
+
+        [[nodiscard]] size_t GetCapacityBytes() const;
+
+        [[nodiscard]] size_t GetUsedBytes() const;
+
+    private:
+        /**
+         * @brief Replace the buffer with a compacted one, copying every range across on the GPU
+         */
+        void Reallocate(size_t newVertexCapacity);
+
+        static unsigned int CreateBuffer(size_t vertexCapacity);
+
+        RangeAllocator allocator;
+
+        unsigned int buffer;
+    };
+}
@@ -134,6 +134,11 @@ namespace Vox
         return glm::inverse(viewProjectionMatrix);
     }
 
+    const Frustum& Camera::GetFrustum() const
+    {
+        return frustum;
+    }
+
     void Camera::SetTarget(glm::vec3 targetPosition)
     {
         useLookAt = true;
@@ -183,6 +188,7 @@ namespace Vox
     void Camera::UpdateViewProjectionMatrix()
     {
         viewProjectionMatrix = projectionMatrix * viewMatrix;
+        frustum = Frustum::FromMatrix(viewProjectionMatrix);
     }
 
     void Camera::UpdateLocalVectors()
@@ -4,6 +4,8 @@
 #include <glm/vec3.hpp>
 #include <utility>
 
+#include "rendering/camera/Frustum.h"
+
 namespace Vox
 {
 	class Camera
@@ -34,6 +36,11 @@ namespace Vox
 		[[nodiscard]] glm::mat4x4 GetViewProjectionMatrix() const;
 		[[nodiscard]] glm::mat4x4 GetInverseMatrix() const;
 
+	    /**
+	     * @brief Get the planes of the view, updated along with the view projection matrix
+	     */
+	    [[nodiscard]] const Frustum& GetFrustum() const;
+
 		void SetTarget(glm::vec3 targetPosition);
 
 	    std::pair<glm::vec4, glm::vec4> GetWorldSpaceRay(const glm::vec2& screenspace) const;
@@ -62,5 +69,7 @@ namespace Vox
 		glm::mat4x4 viewMatrix{};
 		glm::mat4x4 projectionMatrix{};
 		glm::mat4x4 viewProjectionMatrix{};
+
+	    Frustum frustum{};
 	};
 }
@@ -0,0 +1,53 @@
+#include "Frustum.h"
+
+#include <glm/common.hpp>
+#include <glm/geometric.hpp>
+
+namespace Vox
+{
+    Frustum Frustum::FromMatrix(const glm::mat4x4& viewProjection)
+    {
+        // Each plane is the sum or difference of the w row of the matrix and one of the others (Gribb and Hartmann)
+        // glm matrices are indexed by column, so the rows are gathered first
+        std::array<glm::vec4, 4> rows;
+        for (int row = 0; row < 4; ++row)
+        {
+            rows[row] = {viewProjection[0][row], viewProjection[1][row], viewProjection[2][row], viewProjection[3][row]};
+        }
+
+        Frustum result;
+        result.planes[static_cast<int>(Plane::Left)] = rows[3] + rows[0];
+        result.planes[static_cast<int>(Plane::Right)] = rows[3] - rows[0];
+        result.planes[static_cast<int>(Plane::Bottom)] = rows[3] + rows[1];
+        result.planes[static_cast<int>(Plane::Top)] = rows[3] - rows[1];
+        result.planes[static_cast<int>(Plane::Near)] = rows[3] + rows[2];
+        result.planes[static_cast<int>(Plane::Far)] = rows[3] - rows[2];
+        for (glm::vec4& plane : result.planes)
+        {
+            plane /= glm::length(glm::vec3(plane));
+        }
+        return result;
+    }
+
+    bool Frustum::Intersects(const BoundingBox& box) const
+    {
+        const glm::vec3 center = box.GetCenter();
+        const glm::vec3 extents = box.GetExtents();
+        for (const glm::vec4& plane : planes)
+        {
+            // The box is outside if even its corner furthest along the plane's normal is behind the plane
+            const glm::vec3 normal = glm::vec3(plane);
+            const float radius = glm::dot(glm::abs(normal), extents);
+            if (glm::dot(normal, center) + plane.w + radius < 0.0f)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    const glm::vec4& Frustum::GetPlane(const Plane plane) const
+    {
+        return planes[static_cast<int>(plane)];
+    }
+}
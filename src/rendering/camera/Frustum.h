@@ -0,0 +1,46 @@
+#pragma once
+
+#include <array>
+
+#include <glm/mat4x4.hpp>
+#include <glm/vec4.hpp>
+
+#include "core/math/BoundingBox.h"
+
+namespace Vox
+{
+    /**
+     * @brief The six planes bounding a camera's view, in world space
+     */
+    struct Frustum
+    {
+        enum class Plane : char
+        {
+            Left,
+            Right,
+            Bottom,
+            Top,
+            Near,
+            Far
+        };
+
+        static constexpr int planeCount = 6;
+
+        /**
+         * @brief Extract the planes from a view projection matrix, with OpenGL's clip space depth of -1 to 1
+         */
+        [[nodiscard]] static Frustum FromMatrix(const glm::mat4x4& viewProjection);
+
+        /**
+         * @brief Check if a box is at least partly inside the frustum
+         * Boxes near the frustum's corners can pass without actually touching it, but visible boxes never fail
+         */
+        [[nodiscard]] bool Intersects(const BoundingBox& box) const;
+
+        [[nodiscard]] const glm::vec4& GetPlane(Plane plane) const;
+
+        // xyz is the normal, facing into the frustum and normalized, and w is the distance along it to the origin.
+        // A point is inside a plane when dot(normal, point) + w >= 0
+        std::array<glm::vec4, planeCount> planes;
+    };
+}
@@ -1,5 +1,7 @@
 #include "MeshInstance.h"
 
+#include <utility>
+
 #include <glm/ext/matrix_transform.hpp>
 
 #include "core/logging/Logging.h"
@@ -25,7 +27,8 @@ namespace Vox
     }
 
     MeshInstance::MeshInstance(MeshInstance&& other) noexcept
-        :visible(other.visible), transform(other.transform), materials(other.materials), meshOwner(other.meshOwner)
+        :visible(other.visible), transform(other.transform), materials(other.materials), meshOwner(other.meshOwner),
+        renderDataChanged(other.renderDataChanged)
     {
 #ifdef EDITOR
         pickId = other.pickId;
@@ -36,6 +39,7 @@ namespace Vox
     void MeshInstance::SetTransform(glm::mat4x4 transformIn)
     {
         transform = transformIn;
+        renderDataChanged = true;
     }
 
     void MeshInstance::SetMaterial(unsigned int index, const PBRMaterial& material)
@@ -48,6 +52,12 @@ namespace Vox
         }
 
         materials.at(index) = material;
+        renderDataChanged = true;
+    }
+
+    bool MeshInstance::TakeRenderDataChanged()
+    {
+        return std::exchange(renderDataChanged, false);
     }
 
     glm::mat4x4 MeshInstance::GetTransform() const
@@ -69,6 +79,7 @@ namespace Vox
     void MeshInstance::RegisterClickCallback(std::function<void(glm::ivec2)> callback)
     {
         pickId = meshOwner->GetOwner()->GetPickContainer()->RegisterCallback(std::move(callback));
+        renderDataChanged = true;
     }
 
     unsigned int MeshInstance::GetPickId() const
@@ -29,6 +29,11 @@ namespace Vox
 
 	    void SetMaterial(unsigned int index, const PBRMaterial& material);
 
+	    /**
+	     * @brief Check if anything the instanced draws use changed since the last call, and reset it
+	     */
+	    bool TakeRenderDataChanged();
+
 #ifdef EDITOR
 		void RegisterClickCallback(std::function<void(glm::ivec2)> callback);
 
@@ -42,6 +47,8 @@ namespace Vox
 	    std::vector<PBRMaterial> materials;
 	    MeshInstanceContainer* meshOwner;
 
+	    // New instances have never been packed into their container's instance buffer
+	    bool renderDataChanged = true;
 
 #ifdef EDITOR
 		unsigned int pickId = 0;
@@ -3,52 +3,104 @@
 #include <algorithm>
 
 #include "rendering/SceneRenderer.h"
+#include "rendering/buffers/MeshInstanceBuffer.h"
+#include "rendering/camera/Frustum.h"
 #include "rendering/shaders/Shader.h"
 
 namespace Vox
 {
     MeshInstanceContainer::MeshInstanceContainer(SceneRenderer* owner, const size_t size, const std::shared_ptr<Model>& mesh)
-        :owner(owner), mesh(mesh), meshInstances(size)
+        :owner(owner), mesh(mesh), meshInstances(size), instanceList(mesh->GetMaterials().size()),
+        instanceBuffer(std::make_unique<MeshInstanceBuffer>())
     {
     }
 
-	void MeshInstanceContainer::Render(const MaterialShader* shader)
+    MeshInstanceContainer::~MeshInstanceContainer() = default;
+
+    MeshInstanceContainer::MeshInstanceContainer(MeshInstanceContainer&&) noexcept = default;
+
+    void MeshInstanceContainer::UpdateVisibility(const Frustum& frustum)
+    {
+        culler.Clear();
+        culledSlots.clear();
+        for (auto meshInstance = meshInstances.begin(); meshInstance != meshInstances.end(); ++meshInstance)
+        {
+            if (!meshInstance->has_value())
+            {
+                continue;
+            }
+
+            const auto slot = static_cast<uint32_t>(meshInstance - meshInstances.begin());
+            if ((*meshInstance)->TakeRenderDataChanged())
+            {
+#ifdef EDITOR
+                const unsigned int pickId = (*meshInstance)->GetPickId();
+#else
+                constexpr unsigned int pickId = 0;
+#endif
+                instanceList.Set(slot, (*meshInstance)->GetTransform(), (*meshInstance)->GetMaterials(), pickId);
+            }
+
+            if ((*meshInstance)->visible)
+            {
+                culler.Add(GetInstanceBounds(**meshInstance));
+                culledSlots.emplace_back(slot);
+            }
+        }
+        instanceBuffer->Upload(instanceList);
+        instanceList.ClearChanges();
+
+        visibleSlots.clear();
+        for (const uint32_t index : culler.Cull(frustum))
+        {
+            visibleSlots.emplace_back(culledSlots[index]);
+        }
+        instanceBuffer->SetDrawnSlots(visibleSlots);
+    }
+
+	void MeshInstanceContainer::Enqueue(RenderQueue& queue, const RenderPass pass, const uint32_t shader) const
 	{
-		for (std::optional<MeshInstance>& meshInstance : meshInstances)
+		if (instanceBuffer->GetDrawnCount() == 0)
 		{
-			if (meshInstance.has_value() && meshInstance->visible)
-			{
-				mesh->Render(shader, meshInstance->GetTransform(), meshInstance->GetMaterials());
-			}
+			return;
 		}
+
+		mesh->Enqueue(queue, pass, shader, AddInstances(queue), instanceBuffer->GetDrawnBaseInstance(), instanceBuffer->GetDrawnCount());
 	}
 
+    void MeshInstanceContainer::EnqueueInstance(RenderQueue& queue, const RenderPass pass, const uint32_t shader, const MeshInstance& meshInstance) const
+    {
+	    uint32_t slot = 0;
+	    if (GetUploadedSlot(meshInstance, slot))
+	    {
+	        mesh->Enqueue(queue, pass, shader, AddInstances(queue), slot, 1);
+	    }
+    }
+
     void MeshInstanceContainer::RenderInstance(const MeshShader* shader, const MeshInstance& meshInstance) const
     {
-	    mesh->Render(shader, meshInstance.GetTransform());
+	    uint32_t slot = 0;
+	    if (GetUploadedSlot(meshInstance, slot))
+	    {
+	        instanceBuffer->Bind();
+	        mesh->Render(shader, slot, 1);
+	    }
     }
 
     void MeshInstanceContainer::RenderInstance(const MaterialShader* shader, const MeshInstance& meshInstance) const
     {
-	    mesh->Render(shader, meshInstance.GetTransform(), meshInstance.GetMaterials());
+	    uint32_t slot = 0;
+	    if (GetUploadedSlot(meshInstance, slot))
+	    {
+	        instanceBuffer->Bind();
+	        mesh->Render(shader, slot, 1);
+	    }
     }
 
 #ifdef EDITOR
-	void MeshInstanceContainer::Render(const PickShader* shader)
-	{
-		for (std::optional<MeshInstance>& meshInstance : meshInstances)
-		{
-			if (meshInstance.has_value() && meshInstance->visible)
-			{
-				mesh->Render(shader, meshInstance->GetPickId(), meshInstance->GetTransform());
-			}
-		}
-	}
-
     void MeshInstanceContainer::RenderInstance(const PickShader* shader, const MeshInstance& meshInstance) const
     {
-	    mesh->Render(shader, meshInstance.GetPickId(), meshInstance.GetTransform());
-
+	    RenderInstance(static_cast<const MeshShader*>(shader), meshInstance);
     }
 
     SceneRenderer* MeshInstanceContainer::GetOwner() const
@@ -69,4 +121,33 @@ namespace Vox
             return meshInstance.has_value();
         });
 	}
-}
+
+    BoundingBox MeshInstanceContainer::GetInstanceBounds(const MeshInstance& meshInstance) const
+    {
+        return mesh->GetBounds().GetTransformed(meshInstance.GetTransform());
+    }
+
+    bool MeshInstanceContainer::GetUploadedSlot(const MeshInstance& meshInstance, uint32_t& slotOut) const
+    {
+        // Only used for the few instances drawn on their own, like outlines and overlays
+        const auto storedInstance = std::ranges::find_if(meshInstances, [&meshInstance](const std::optional<MeshInstance>& instance)
+        {
+            return instance.has_value() && &*instance == &meshInstance;
+        });
+        const auto slot = static_cast<size_t>(storedInstance - meshInstances.begin());
+        if (storedInstance == meshInstances.end() || slot >= instanceBuffer->GetSlotCount())
+        {
+            return false;
+        }
+        slotOut = static_cast<uint32_t>(slot);
+        return true;
+    }
+
+    uint32_t MeshInstanceContainer::AddInstances(RenderQueue& queue) const
+    {
+        return queue.AddInstances([buffer = instanceBuffer.get()]
+        {
+            buffer->Bind();
+        });
+    }
+}
\ No newline at end of file
@@ -1,34 +1,63 @@
 #pragma once
 
 #include <memory>
+#include <vector>
+
 #include "Vox.h"
 #include "core/datatypes/ObjectContainer.h"
 #include "core/datatypes/Ref.h"
+#include "core/math/BoundingBox.h"
+#include "rendering/FrustumCuller.h"
 #include "rendering/mesh/MeshInstance.h"
+#include "rendering/mesh/MeshInstanceList.h"
 #include "rendering/mesh/Model.h"
 
 namespace Vox
 {
     class SceneRenderer;
+    struct Frustum;
+    class MeshInstanceBuffer;
     class MeshShader;
     class Model;
 	class PickShader;
 	class Shader;
 
+	/**
+	 * @brief Every instance of one model. Instances are packed into a shared instance buffer, so each primitive
+	 * of the model is drawn once with glDrawElementsInstanced, no matter how many instances there are
+	 */
 	class MeshInstanceContainer
 	{
 	public:
 		MeshInstanceContainer(SceneRenderer* owner, size_t size, const std::shared_ptr<Model>& mesh);
+		~MeshInstanceContainer();
+
+		MeshInstanceContainer(MeshInstanceContainer&&) noexcept;
+		MeshInstanceContainer(const MeshInstanceContainer&) = delete;
+		MeshInstanceContainer& operator=(MeshInstanceContainer&&) = delete;
+		MeshInstanceContainer& operator=(const MeshInstanceContainer&) = delete;
+
+		/**
+		 * @brief Upload the instances that changed, then cull the visible instances against the frustum.
+		 * Enqueue only draws the instances that passed, until this is called again
+		 */
+		void UpdateVisibility(const Frustum& frustum);
 
-		void Render(const MaterialShader* shader);
+		/**
+		 * @brief Queue the instances that passed culling, as one instanced draw per primitive
+		 */
+		void Enqueue(RenderQueue& queue, RenderPass pass, uint32_t shader) const;
+
+		/**
+		 * @brief Queue a single instance, for passes that only draw a few instances like outlines
+		 */
+		void EnqueueInstance(RenderQueue& queue, RenderPass pass, uint32_t shader, const MeshInstance& meshInstance) const;
 
 	    void RenderInstance(const MeshShader* shader, const MeshInstance& meshInstance) const;
 
 	    void RenderInstance(const MaterialShader* shader, const MeshInstance& meshInstance) const;
 
 #ifdef EDITOR
-		void Render(const PickShader* shader);
-
 	    void RenderInstance(const PickShader* shader, const MeshInstance& meshInstance) const;
 #endif
 
@@ -38,9 +67,30 @@ namespace Vox
 
 		[[nodiscard]] size_t GetInstanceCount() const;
 
+		[[nodiscard]] BoundingBox GetInstanceBounds(const MeshInstance& meshInstance) const;
+
 	private:
+		/**
+		 * @brief Find the slot of an instance that has been uploaded, so it can be drawn on its own
+		 */
+		bool GetUploadedSlot(const MeshInstance& meshInstance, uint32_t& slotOut) const;
+
+		/**
+		 * @brief Add the binding of our instance buffer to the queue
+		 */
+		[[nodiscard]] uint32_t AddInstances(RenderQueue& queue) const;
+
 	    SceneRenderer* owner;
 		std::shared_ptr<Model> mesh;
 		ObjectContainer<MeshInstance> meshInstances;
+
+		MeshInstanceList instanceList;
+		std::unique_ptr<MeshInstanceBuffer> instanceBuffer;
+
+		FrustumCuller culler;
+
+		// Slots of every instance given to the culler, then of the ones that passed
+		std::vector<uint32_t> culledSlots;
+		std::vector<uint32_t> visibleSlots;
 	};
 }
@@ -0,0 +1,86 @@
+#include "MeshInstanceList.h"
+
+#include <algorithm>
+
+namespace Vox
+{
+    MeshInstanceList::MeshInstanceList(const size_t materialsPerInstance)
+        :materialsPerInstance(materialsPerInstance)
+    {
+    }
+
+    void MeshInstanceList::Set(const size_t slot, const glm::mat4x4& transform, const std::vector<PBRMaterial>& materials, const uint32_t pickId)
+    {
+        if (slot >= instances.size())
+        {
+            instances.resize(slot + 1);
+            this->materials.resize((slot + 1) * materialsPerInstance);
+        }
+
+        InstanceData& instance = instances[slot];
+        instance.transform = transform;
+        instance.materialOffset = static_cast<uint32_t>(slot * materialsPerInstance);
+        instance.pickId = pickId;
+
+        const size_t materialCount = std::min(materials.size(), materialsPerInstance);
+        for (size_t i = 0; i < materialCount; ++i)
+        {
+            InstanceMaterial& material = this->materials[instance.materialOffset + i];
+            material.albedo = materials[i].albedo;
+            material.roughness = materials[i].roughness;
+            material.metallic = materials[i].metallic;
+        }
+
+        if (HasChanges())
+        {
+            firstChangedSlot = std::min(firstChangedSlot, slot);
+            changedSlotEnd = std::max(changedSlotEnd, slot + 1);
+        }
+        else
+        {
+            firstChangedSlot = slot;
+            changedSlotEnd = slot + 1;
+        }
+    }
+
+    bool MeshInstanceList::HasChanges() const
+    {
+        return firstChangedSlot < changedSlotEnd;
+    }
+
+    size_t MeshInstanceList::GetFirstChangedSlot() const
+    {
+        return firstChangedSlot;
+    }
+
+    size_t MeshInstanceList::GetChangedSlotEnd() const
+    {
+        return changedSlotEnd;
+    }
+
+    void MeshInstanceList::ClearChanges()
+    {
+        firstChangedSlot = 0;
+        changedSlotEnd = 0;
+    }
+
+    const std::vector<InstanceData>& MeshInstanceList::GetInstances() const
+    {
+        return instances;
+    }
+
+    const std::vector<InstanceMaterial>& MeshInstanceList::GetMaterials() const
+    {
+        return materials;
+    }
+
+    size_t MeshInstanceList::GetMaterialsPerInstance() const
+    {
+        return materialsPerInstance;
+    }
+
+    size_t MeshInstanceList::GetSlotCount() const
+    {
+        return instances.size();
+    }
+}
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <glm/mat4x4.hpp>
+#include <glm/vec4.hpp>
+
+#include "rendering/PBRMaterial.h"
+
+namespace Vox
+{
+    /**
+     * @brief Per instance data of a mesh, matches the std430 layout of InstanceData in the mesh shaders
+     */
+    struct InstanceData
+    {
+        glm::mat4x4 transform{};
+        // Index of the instance's first material in the material table, primitives add their own material index to it
+        uint32_t materialOffset = 0;
+        uint32_t pickId = 0;
+        uint32_t padding[2] = {};
+    };
+    static_assert(sizeof(InstanceData) == 80);
+
+    /**
+     * @brief Matches the std430 layout of InstanceMaterial in the mesh shaders
+     */
+    struct InstanceMaterial
+    {
+        glm::vec4 albedo{};
+        float roughness = 0.0f;
+        float metallic = 0.0f;
+        float padding[2] = {};
+    };
+    static_assert(sizeof(InstanceMaterial) == 32);
+
+    /**
+     * @brief Packs the instances of one model into the arrays the instanced mesh shaders read, indexed by the
+     * instance's slot in its MeshInstanceContainer
+     * Every instance of a model has the same number of materials, so each slot owns a fixed run of the material
+     * table. Keeps track of which slots changed since the changes were last cleared, so only those have to be
+     * uploaded. Doesn't touch GL, that's left to MeshInstanceBuffer
+     */
+    class MeshInstanceList
+    {
+    public:
+        explicit MeshInstanceList(size_t materialsPerInstance);
+
+        /**
+         * @brief Pack an instance into its slot, growing the list if the slot is past the end
+         * @param materials the instance's materials, extra materials are ignored and missing ones are left as they were
+         */
+        void Set(size_t slot, const glm::mat4x4& transform, const std::vector<PBRMaterial>& materials, uint32_t pickId);
+
+        [[nodiscard]] bool HasChanges() const;
+
+        /**
+         * @brief Get the first slot that changed. Only valid if HasChanges
+         */
+        [[nodiscard]] size_t GetFirstChangedSlot() const;
+
+        /**
+         * @brief Get one past the last slot that changed. Slots in between are uploaded even if they didn't change,
+         * one upload is cheaper than many small ones
+         */
+        [[nodiscard]] size_t GetChangedSlotEnd() const;
+
+        void ClearChanges();
+
+        [[nodiscard]] const std::vector<InstanceData>& GetInstances() const;
+
+        /**
+         * @brief Materials of every slot, materialsPerInstance at a time
+         */
+        [[nodiscard]] const std::vector<InstanceMaterial>& GetMaterials() const;
+
+        [[nodiscard]] size_t GetMaterialsPerInstance() const;
+
+        [[nodiscard]] size_t GetSlotCount() const;
+
+    private:
+        size_t materialsPerInstance;
+
+        std::vector<InstanceData> instances;
+        std::vector<InstanceMaterial> materials;
+
+        // Empty when first == end
+        size_t firstChangedSlot = 0;
+        size_t changedSlotEnd = 0;
+    };
+}
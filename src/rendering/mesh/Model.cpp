@@ -8,7 +8,6 @@
 #include "core/logging/Logging.h"
 #include "rendering/shaders/Shader.h"
 #include "rendering/shaders/pixel_shaders/mesh_shaders/MaterialShader.h"
-#include "rendering/shaders/pixel_shaders/mesh_shaders/PickShader.h"
 
 namespace Vox
 {
@@ -59,6 +58,8 @@ namespace Vox
 			}
 		}
 
+		// Bounds of each primitive before its node transform, in the same order as primitives
+		std::vector<BoundingBox> primitiveBounds;
 		for (const tinygltf::Mesh& mesh : model.meshes)
 		{
 			std::vector<unsigned int>& newMesh = meshes.emplace_back();
@@ -96,6 +97,7 @@ namespace Vox
 				const unsigned int normalBufferId = bufferIds[model.accessors[normalBuffer->second].bufferView];
 				const unsigned int uvBufferId = bufferIds[model.accessors[uvBuffer->second].bufferView];
 				primitives.emplace_back(indexCount, model.accessors[primitive.indices].componentType, primitive.material, indexBufferId, positionBufferId, normalBufferId, uvBufferId);
+				primitiveBounds.emplace_back(Primitive::GetPositionBounds(model, positionBuffer->second));
 				newMesh.emplace_back(static_cast<unsigned int>(primitives.size() - 1)); // Store the primitive index so our nodes can find it later
 			}
 		}
@@ -109,6 +111,18 @@ namespace Vox
 			}
 		}
 
+		for (size_t i = 0; i < primitives.size(); ++i)
+		{
+			if (!primitiveBounds[i].IsEmpty())
+			{
+				bounds.Expand(primitiveBounds[i].GetTransformed(primitives[i].GetTransform()));
+			}
+		}
+		if (bounds.IsEmpty())
+		{
+			bounds = BoundingBox(glm::vec3(0.0f), glm::vec3(0.0f));
+		}
+
 		const size_t separatorLocation = filepath.rfind('/') + 1;
 		VoxLog(Display, Rendering, "Successfully loaded model '{}' with {} primitives.", filepath.substr(separatorLocation, filepath.size() - separatorLocation), primitives.size());
 	}
@@ -118,38 +132,63 @@ namespace Vox
 		glDeleteBuffers(static_cast<int>(bufferIds.size()), bufferIds.data());
 	}
 
-	void Model::Render(const MaterialShader* shader, const glm::mat4x4& rootMatrix, const std::vector<PBRMaterial>& materialInstances) const
+	void Model::Render(const MaterialShader* shader, const unsigned int baseInstance, const unsigned int instanceCount) const
     {
-		// Assume our VAO is already bound?
-		// Render primitives one at a time;
-
+		// The model matrix is only the primitive's transform in the model, the instance transforms are applied on top
 		for (const Primitive& primitive : primitives)
 		{
-			const PBRMaterial& material = materialInstances.at(primitive.GetMaterialIndex());
-			shader->SetMaterial(material);
-			shader->SetModelMatrix(rootMatrix * primitive.GetTransform());
+			// Primitives without a material use the default one
+			shader->SetMaterialIndex(primitive.GetMaterialIndex() < materials.size() ? primitive.GetMaterialIndex() : 0);
+			shader->SetModelMatrix(primitive.GetTransform());
 
 			glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, primitive.GetIndexBuffer());
 			glBindVertexBuffer(0, primitive.GetPositionBuffer(), 0, sizeof(float) * 3);
 			glBindVertexBuffer(1, primitive.GetNormalBuffer(), 0, sizeof(float) * 3);
 			glBindVertexBuffer(2, primitive.GetUVBuffer(), 0, sizeof(float) * 2);
 
-			glDrawElements(GL_TRIANGLES, static_cast<int>(primitive.GetVertexCount()), primitive.GetComponentType(), nullptr);
+			glDrawElementsInstancedBaseInstance(GL_TRIANGLES, static_cast<int>(primitive.GetVertexCount()), primitive.GetComponentType(), nullptr,
+			    static_cast<int>(instanceCount), baseInstance);
 		}
 	}
 
-    void Model::Render(const MeshShader* shader, const glm::mat4x4& rootMatrix) const
+    void Model::Render(const MeshShader* shader, const unsigned int baseInstance, const unsigned int instanceCount) const
     {
 	    for (const Primitive& primitive : primitives)
 	    {
-	        shader->SetModelMatrix(rootMatrix * primitive.GetTransform());
+	        shader->SetModelMatrix(primitive.GetTransform());
 
 	        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, primitive.GetIndexBuffer());
 	        glBindVertexBuffer(0, primitive.GetPositionBuffer(), 0, sizeof(float) * 3);
 	        glBindVertexBuffer(1, primitive.GetNormalBuffer(), 0, sizeof(float) * 3);
 	        glBindVertexBuffer(2, primitive.GetUVBuffer(), 0, sizeof(float) * 2);
 
-	        glDrawElements(GL_TRIANGLES, static_cast<int>(primitive.GetVertexCount()), primitive.GetComponentType(), nullptr);
+	        glDrawElementsInstancedBaseInstance(GL_TRIANGLES, static_cast<int>(primitive.GetVertexCount()), primitive.GetComponentType(), nullptr,
+	            static_cast<int>(instanceCount), baseInstance);
+	    }
+    }
+
+    void Model::Enqueue(RenderQueue& queue, const RenderPass pass, const uint32_t shader, const uint32_t instances,
+        const unsigned int baseInstance, const unsigned int instanceCount) const
+    {
+	    for (const Primitive& primitive : primitives)
+	    {
+	        DrawGeometry geometry;
+	        geometry.indexBuffer = primitive.GetIndexBuffer();
+	        geometry.indexType = primitive.GetComponentType();
+	        geometry.indexCount = primitive.GetVertexCount();
+	        geometry.vertexBuffers = {primitive.GetPositionBuffer(), primitive.GetNormalBuffer(), primitive.GetUVBuffer()};
+	        geometry.vertexStrides = {sizeof(float) * 3, sizeof(float) * 3, sizeof(float) * 2};
+	        geometry.vertexBufferCount = 3;
+
+	        DrawCommand command;
+	        command.shader = shader;
+	        command.instances = instances;
+	        command.material = primitive.GetMaterialIndex() < materials.size() ? primitive.GetMaterialIndex() : 0;
+	        command.geometry = queue.AddGeometry(geometry);
+	        command.transform = queue.AddTransform(primitive.GetTransform());
+	        command.baseInstance = baseInstance;
+	        command.instanceCount = instanceCount;
+	        queue.Add(pass, command);
 	    }
     }
 
@@ -158,19 +197,10 @@ namespace Vox
         return materials;
     }
 
-#ifdef EDITOR
-	void Model::Render(const PickShader* shader, unsigned const int objectId, const glm::mat4x4& rootMatrix) const
+    const BoundingBox& Model::GetBounds() const
     {
-		for (const auto& primitive : primitives)
-		{
-			shader->SetObjectId(objectId);
-			shader->SetModelMatrix(rootMatrix * primitive.GetTransform());
-			glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, primitive.GetIndexBuffer());
-			glBindVertexBuffer(0, primitive.GetPositionBuffer(), 0, sizeof(float) * 3);
-			glDrawElements(GL_TRIANGLES, static_cast<int>(primitive.GetVertexCount()), primitive.GetComponentType(), nullptr);
-		}
-	}
-#endif
+        return bounds;
+    }
 
 	ModelTransform Model::CalculateNodeTransform(const tinygltf::Node& node)
     {
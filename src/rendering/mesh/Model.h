@@ -7,9 +7,11 @@
 #include <glm/mat4x4.hpp>
 
 #include "Vox.h"
+#include "core/math/BoundingBox.h"
 #include "rendering/mesh/ModelNode.h"
 #include "rendering/mesh/Primitive.h"
 #include "rendering/PBRMaterial.h"
+#include "rendering/RenderQueue.h"
 
 namespace tinygltf
 {
@@ -22,7 +24,6 @@ namespace Vox
 	class MaterialShader;
 	class Shader;
     class MeshShader;
-    class PickShader;
 
 	class Model
 	{
@@ -33,16 +34,31 @@ namespace Vox
 		Model(const Model&) = delete;
 		Model& operator=(Model&&) = delete;
 
-		void Render(const MaterialShader* shader, const glm::mat4x4& rootMatrix, const std::vector<PBRMaterial>& materialInstances) const;
+		/**
+		 * @brief Draw each primitive once for all the instances, reading them from the bound MeshInstanceBuffer
+		 * @param baseInstance where the instances start in the buffer's slot list
+		 */
+		void Render(const MaterialShader* shader, unsigned int baseInstance, unsigned int instanceCount) const;
 
-        void Render(const MeshShader* shader, const glm::mat4x4& rootMatrix) const;
+		/**
+		 * @brief Draw each primitive once for all the instances, without materials. Used for picking and outlines
+		 */
+        void Render(const MeshShader* shader, unsigned int baseInstance, unsigned int instanceCount) const;
+
+		/**
+		 * @brief Queue a draw of each primitive for all the instances, with the primitive's material index as the material
+		 * @param instances handle of the instance buffer binding in the queue
+		 */
+		void Enqueue(RenderQueue& queue, RenderPass pass, uint32_t shader, uint32_t instances, unsigned int baseInstance, unsigned int instanceCount) const;
 
 	    [[nodiscard]] const std::vector<PBRMaterial>& GetMaterials() const;
 
-#ifdef EDITOR
-		void Render(const PickShader* shader, unsigned int objectId, const glm::mat4x4& rootMatrix) const;
-#endif
-		
+	    /**
+	     * @brief Get the bounds of every primitive in model space, after its node transform
+	     */
+	    [[nodiscard]] const BoundingBox& GetBounds() const;
+
+
 	private:
         static ModelTransform CalculateNodeTransform(const tinygltf::Node& node);
 
@@ -58,5 +74,7 @@ namespace Vox
 		std::vector<PBRMaterial> materials;
 
 		std::vector<ModelNode> nodes;
+
+		BoundingBox bounds;
 	};
 }
\ No newline at end of file
@@ -1,5 +1,7 @@
 #include "Primitive.h"
 
+#include <cstring>
+
 #include <glm/ext/matrix_transform.hpp>
 
 namespace Vox
@@ -56,4 +58,34 @@ namespace Vox
 	{
 		return transform;
 	}
+
+    BoundingBox Primitive::GetPositionBounds(const tinygltf::Model& model, const int accessorIndex)
+    {
+	    const tinygltf::Accessor& accessor = model.accessors[accessorIndex];
+	    if (accessor.minValues.size() == 3 && accessor.maxValues.size() == 3)
+	    {
+	        return {
+	            glm::vec3(accessor.minValues[0], accessor.minValues[1], accessor.minValues[2]),
+	            glm::vec3(accessor.maxValues[0], accessor.maxValues[1], accessor.maxValues[2])
+	        };
+	    }
+
+	    // glTF requires min and max on positions, but not every exporter writes them
+	    BoundingBox result;
+	    if (accessor.bufferView < 0 || accessor.componentType != TINYGLTF_COMPONENT_TYPE_FLOAT)
+	    {
+	        return result;
+	    }
+
+	    const tinygltf::BufferView& bufferView = model.bufferViews[accessor.bufferView];
+	    const size_t stride = bufferView.byteStride != 0 ? bufferView.byteStride : sizeof(float) * 3;
+	    const unsigned char* data = model.buffers[bufferView.buffer].data.data() + bufferView.byteOffset + accessor.byteOffset;
+	    for (size_t i = 0; i < accessor.count; ++i)
+	    {
+	        float position[3];
+	        std::memcpy(position, data + i * stride, sizeof(position));
+	        result.Expand(glm::vec3(position[0], position[1], position[2]));
+	    }
+	    return result;
+    }
 }
@@ -4,6 +4,8 @@
 
 #include <glm/mat4x4.hpp>
 
+#include "core/math/BoundingBox.h"
+
 namespace Vox
 {
 	class Primitive
@@ -30,6 +32,11 @@ namespace Vox
 
 		[[nodiscard]] glm::mat4x4 GetTransform() const;
 
+	    /**
+	     * @brief Get the bounds of a POSITION accessor, from its min and max if it has them, otherwise from its data
+	     */
+	    [[nodiscard]] static BoundingBox GetPositionBounds(const tinygltf::Model& model, int accessorIndex);
+
 	private:
 		unsigned int vertexCount;
 		unsigned int componentType;
@@ -0,0 +1,41 @@
+#include "VoxelDrawList.h"
+
+namespace Vox
+{
+    void VoxelDrawList::Clear()
+    {
+        commands.clear();
+        chunkOffsets.clear();
+    }
+
+    void VoxelDrawList::Add(const uint32_t first, const uint32_t count, const glm::vec3& chunkOffset)
+    {
+        if (count == 0)
+        {
+            return;
+        }
+
+        commands.push_back({count, 1, first, static_cast<uint32_t>(chunkOffsets.size())});
+        chunkOffsets.emplace_back(chunkOffset, 0.0f);
+    }
+
+    const std::vector<DrawArraysIndirectCommand>& VoxelDrawList::GetCommands() const
+    {
+        return commands;
+    }
+
+    const std::vector<glm::vec4>& VoxelDrawList::GetChunkOffsets() const
+    {
+        return chunkOffsets;
+    }
+
+    size_t VoxelDrawList::GetDrawCount() const
+    {
+        return commands.size();
+    }
+
+    bool VoxelDrawList::IsEmpty() const
+    {
+        return commands.empty();
+    }
+}
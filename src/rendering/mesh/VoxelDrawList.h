@@ -0,0 +1,57 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <glm/vec3.hpp>
+#include <glm/vec4.hpp>
+
+namespace Vox
+{
+    /**
+     * @brief Matches the layout glMultiDrawArraysIndirect reads from the draw indirect buffer
+     */
+    struct DrawArraysIndirectCommand
+    {
+        uint32_t count = 0;
+        uint32_t instanceCount = 0;
+        uint32_t first = 0;
+        uint32_t baseInstance = 0;
+    };
+    static_assert(sizeof(DrawArraysIndirectCommand) == 16);
+
+    /**
+     * @brief Builds the commands for drawing every voxel chunk with one glMultiDrawArraysIndirect
+     * Each draw is a single instance, with its base instance pointing at its own chunk offset, so the offsets
+     * can be read through an instanced vertex attribute. Doesn't touch GL, that's left to the caller
+     */
+    class VoxelDrawList
+    {
+    public:
+        void Clear();
+
+        /**
+         * @brief Add a chunk to the list. Chunks without vertices are skipped
+         * @param first index of the chunk's first vertex in the shared vertex buffer
+         * @param count number of vertices
+         * @param chunkOffset world position of the chunk's origin
+         */
+        void Add(uint32_t first, uint32_t count, const glm::vec3& chunkOffset);
+
+        [[nodiscard]] const std::vector<DrawArraysIndirectCommand>& GetCommands() const;
+
+        /**
+         * @brief Chunk offsets, indexed by base instance. Padded to vec4, so each offset is 16 bytes in the instance buffer
+         */
+        [[nodiscard]] const std::vector<glm::vec4>& GetChunkOffsets() const;
+
+        [[nodiscard]] size_t GetDrawCount() const;
+
+        [[nodiscard]] bool IsEmpty() const;
+
+    private:
+        std::vector<DrawArraysIndirectCommand> commands;
+        std::vector<glm::vec4> chunkOffsets;
+    };
+}
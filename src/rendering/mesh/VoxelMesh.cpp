@@ -1,113 +1,129 @@
 #include "VoxelMesh.h"
 
-#include <GL/glew.h>
-#include <glm/ext/matrix_transform.hpp>
+#include <utility>
 
-#include "core/services/ServiceLocator.h"
-#include "rendering/Renderer.h"
-#include "rendering/shaders/compute_shaders/VoxelGenerationShader.h"
 #include "voxel/VoxelChunk.h"
+#include "voxel/VoxelVertex.h"
 
 namespace Vox
 {
-	VoxelMesh::VoxelMesh(const glm::ivec2 position)
-	    :transform(glm::translate(glm::mat4x4(1.0f), VoxelChunk::CalculatePosition(position))), vertexCount(0)
+	VoxelMesh::VoxelMesh(const glm::ivec3 position, VoxelGeometryArena* arena)
+	    :position(VoxelChunk::CalculatePosition(position)), arena(arena)
 	{
-		unsigned int buffers[3] = {};
-		glCreateBuffers(3, buffers);
-		voxelDataSsbo = buffers[0];
-		voxelMeshSsbo = buffers[1];
-		meshCounter = buffers[2];
-
-        constexpr unsigned int maxVertexCount = 1024 * 16 * 6;
-		glNamedBufferStorage(voxelDataSsbo, sizeof(int) * 32 * 32 * 32, nullptr, GL_DYNAMIC_STORAGE_BIT | GL_MAP_WRITE_BIT);
-		glNamedBufferStorage(voxelMeshSsbo, sizeof(float) * 16 * maxVertexCount, nullptr, GL_DYNAMIC_STORAGE_BIT | GL_MAP_WRITE_BIT);
-		glNamedBufferStorage(meshCounter, sizeof(unsigned int), nullptr,
-		    GL_DYNAMIC_STORAGE_BIT | GL_MAP_WRITE_BIT | GL_MAP_READ_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT);
 	}
 
 	VoxelMesh::~VoxelMesh()
 	{
-		const unsigned int buffers[3] = { voxelDataSsbo, voxelMeshSsbo, meshCounter };
-		glDeleteBuffers(3, buffers);
+	    if (range != VoxelGeometryArena::invalidHandle)
+	    {
+	        arena->Free(range);
+	    }
 	}
 
     VoxelMesh::VoxelMesh(VoxelMesh&& other) noexcept
-        :transform(other.transform), vertexCount(other.vertexCount)
+        :position(other.position), arena(other.arena),
+        range(std::exchange(other.range, VoxelGeometryArena::invalidHandle)), pendingVoxels(std::move(other.pendingVoxels)),
+        vertexCount(std::exchange(other.vertexCount, 0))
     {
-	    voxelDataSsbo = other.voxelDataSsbo;
-	    voxelMeshSsbo = other.voxelMeshSsbo;
-	    meshCounter = other.meshCounter;
-
-	    other.voxelDataSsbo = other.voxelMeshSsbo = other.meshCounter = 0;
     }
 
     VoxelMesh& VoxelMesh::operator=(VoxelMesh&& other) noexcept
     {
-	    voxelDataSsbo = other.voxelDataSsbo;
-	    voxelMeshSsbo = other.voxelMeshSsbo;
-	    meshCounter = other.meshCounter;
-
-	    transform = other.transform;
-	    vertexCount = other.vertexCount;
+	    if (range != VoxelGeometryArena::invalidHandle)
+	    {
+	        arena->Free(range);
+	    }
 
-	    other.voxelDataSsbo = other.voxelMeshSsbo = other.meshCounter = 0;
+	    position = other.position;
+	    arena = other.arena;
+	    range = std::exchange(other.range, VoxelGeometryArena::invalidHandle);
+	    pendingVoxels = std::move(other.pendingVoxels);
+	    vertexCount = std::exchange(other.vertexCount, 0);
 	    return *this;
     }
 
     bool VoxelMesh::NeedsRegeneration() const
 	{
-		return dirty;
+		return pendingVoxels != nullptr;
 	}
 
-	void VoxelMesh::Regenerate(VoxelGenerationShader& shader)
+    void VoxelMesh::UpdateData(const VoxelArray* data)
 	{
-        constexpr unsigned int counterStart = 0;
-		//glNamedBufferData(meshCounter, sizeof(unsigned int), &counterStart, GL_STREAM_READ);
-		glNamedBufferSubData(meshCounter, 0, sizeof(unsigned int), &counterStart);
-		glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, voxelDataSsbo);
-		glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 1, voxelMeshSsbo);
-		glBindBufferBase(GL_ATOMIC_COUNTER_BUFFER, 2, meshCounter);
-
-
-	    const Renderer* renderer = ServiceLocator::GetRenderer();
-	    //@TODO: cache what materials are contained in this chunk so we don't run the shader for every voxel and material
-	    // for (const int materialId : changedMaterials)
-	    for (int materialId = 1; materialId < 5; ++materialId)
+	    if (!pendingVoxels)
+	    {
+	        pendingVoxels = std::make_unique<VoxelArray>();
+	    }
+	    *pendingVoxels = *data;
+	}
+
+    std::unique_ptr<VoxelMesh::VoxelArray> VoxelMesh::TakePendingVoxels()
+    {
+	    return std::move(pendingVoxels);
+    }
+
+    void VoxelMesh::ApplyGeneratedVertices(const unsigned int sourceBuffer, const unsigned int newVertexCount)
+    {
+	    const VoxelGeometryArena::Handle newRange = AllocateRange(newVertexCount);
+	    if (newRange != VoxelGeometryArena::invalidHandle)
+	    {
+	        arena->CopyFrom(newRange, sourceBuffer);
+	    }
+	    SwapRange(newRange, newVertexCount);
+    }
+
+    void VoxelMesh::UploadVertices(const std::vector<VoxelVertex>& vertices)
+    {
+	    const auto newVertexCount = static_cast<unsigned int>(vertices.size());
+	    const VoxelGeometryArena::Handle newRange = AllocateRange(newVertexCount);
+	    if (newRange != VoxelGeometryArena::invalidHandle)
 	    {
-            if (const VoxelMaterial* voxelMaterial = renderer->GetVoxelMaterial(materialId))
-	        {
-	            shader.SetVoxelMaterial(materialId, *voxelMaterial);
-		        glDispatchCompute(1, 1, 1);
-	        }
+	        arena->Upload(newRange, vertices);
 	    }
-		dirty = false;
+	    SwapRange(newRange, newVertexCount);
+    }
 
-	    int quadCount = 0;
-	    glGetNamedBufferSubData(meshCounter, 0, sizeof(unsigned int), &quadCount);
-	    vertexCount = quadCount * 6;
+	glm::vec3 VoxelMesh::GetPosition() const
+    {
+		return position;
 	}
 
-    void VoxelMesh::UpdateData(const std::array<std::array<std::array<Voxel, 32>, 32>, 32>* data,
-        const std::vector<int>& changedMaterialsIn)
+	glm::vec3 VoxelMesh::GetCenter() const
 	{
-		glNamedBufferSubData(voxelDataSsbo, 0, sizeof(*data), data);
-	    changedMaterials = changedMaterialsIn;
-		dirty = true;
+		return position + glm::vec3(VoxelChunk::chunkSize / 2);
 	}
 
-	glm::mat4x4 VoxelMesh::GetTransform() const
-    {
-		return transform;
+	BoundingBox VoxelMesh::GetBounds() const
+	{
+		return {position, position + glm::vec3(VoxelChunk::chunkSize)};
 	}
 
-	unsigned int VoxelMesh::GetMeshId() const
+	unsigned int VoxelMesh::GetFirstVertex() const
 	{
-		return voxelMeshSsbo;
+		return range == VoxelGeometryArena::invalidHandle ? 0 : static_cast<unsigned int>(arena->GetRange(range).offset);
 	}
 
     unsigned int VoxelMesh::GetVertexCount() const
     {
         return vertexCount;
     }
+
+    size_t VoxelMesh::GetGpuMemoryUsage() const
+    {
+	    return sizeof(VoxelVertex) * vertexCount;
+    }
+
+    VoxelGeometryArena::Handle VoxelMesh::AllocateRange(const unsigned int newVertexCount) const
+    {
+	    return newVertexCount > 0 ? arena->Allocate(newVertexCount) : VoxelGeometryArena::invalidHandle;
+    }
+
+    void VoxelMesh::SwapRange(const VoxelGeometryArena::Handle newRange, const unsigned int newVertexCount)
+    {
+	    if (range != VoxelGeometryArena::invalidHandle)
+	    {
+	        arena->Free(range);
+	    }
+	    range = newRange;
+	    vertexCount = newVertexCount;
+    }
 }
@@ -1,22 +1,30 @@
 #pragma once
 
 #include <array>
+#include <memory>
 #include <vector>
 
 #include <glm/glm.hpp>
 
 #include "core/datatypes/Ref.h"
+#include "core/math/BoundingBox.h"
+#include "rendering/buffers/VoxelGeometryArena.h"
 #include "voxel/Voxel.h"
 
 namespace Vox
 {
-    class ComputeShader;
-    class VoxelGenerationShader;
+    struct VoxelVertex;
 
 	class VoxelMesh
 	{
 	public:
-		explicit VoxelMesh(glm::ivec2 position);
+	    // Same layout as VoxelChunk::PaddedVoxelArray, a 32 voxel cube with an apron from the neighbouring chunks
+	    using VoxelArray = std::array<std::array<std::array<Voxel, 34>, 34>, 34>;
+
+	    /**
+	     * @param arena shared vertex buffer the mesh takes its range from, has to outlive the mesh
+	     */
+		VoxelMesh(glm::ivec3 position, VoxelGeometryArena* arena);
 		~VoxelMesh();
 
 	    VoxelMesh(const VoxelMesh&) = delete;
@@ -24,27 +32,74 @@ namespace Vox
 	    VoxelMesh& operator =(const VoxelMesh&) = delete;
 	    VoxelMesh& operator =(VoxelMesh&& other) noexcept;
 
+	    /**
+	     * @brief Whether the voxels changed since they were last taken for generation
+	     */
 		[[nodiscard]] bool NeedsRegeneration() const;
 
-		void Regenerate(VoxelGenerationShader& shader);
+	    /**
+	     * @brief Keep a copy of the voxels until they're taken for generation, replacing any copy that wasn't taken yet
+	     */
+		void UpdateData(const VoxelArray* data);
+
+	    /**
+	     * @brief Take the voxels from the last UpdateData, see VoxelMeshGenerator
+	     * The current geometry keeps being drawn until the generated vertices are applied
+	     */
+	    [[nodiscard]] std::unique_ptr<VoxelArray> TakePendingVoxels();
+
+	    /**
+	     * @brief Replace the mesh with vertices generated on the GPU, copying them into an exactly sized range of the arena
+	     * @param sourceBuffer buffer holding the vertices from its start
+	     */
+	    void ApplyGeneratedVertices(unsigned int sourceBuffer, unsigned int newVertexCount);
+
+	    /**
+	     * @brief Replace the mesh with vertices built on the CPU, see VoxelMesherBackend. Skips the generation shader entirely
+	     */
+	    void UploadVertices(const std::vector<VoxelVertex>& vertices);
 
-		void UpdateData(const std::array<std::array<std::array<Voxel, 32>, 32>, 32>* data, const std::vector<int>& changedMaterialsIn);
+	    /**
+	     * @brief World position of the mesh's origin, vertex positions are relative to this
+	     */
+		[[nodiscard]] glm::vec3 GetPosition() const;
 
-		[[nodiscard]] glm::mat4x4 GetTransform() const;
+		[[nodiscard]] glm::vec3 GetCenter() const;
 
-		[[nodiscard]] unsigned int GetMeshId() const;
+		[[nodiscard]] BoundingBox GetBounds() const;
+
+	    /**
+	     * @brief Index of the mesh's first vertex in the arena's buffer
+	     */
+		[[nodiscard]] unsigned int GetFirstVertex() const;
 
 	    [[nodiscard]] unsigned int GetVertexCount() const;
 
+	    /**
+	     * @brief Get the number of bytes this mesh takes up in the arena
+	     */
+	    [[nodiscard]] size_t GetGpuMemoryUsage() const;
+
 	private:
-		bool dirty = false;
+	    /**
+	     * @brief Take a range for the new vertices. The old range is still drawn until SwapRange
+	     */
+	    [[nodiscard]] VoxelGeometryArena::Handle AllocateRange(unsigned int newVertexCount) const;
+
+	    /**
+	     * @brief Release the current range, and start drawing from the new one
+	     */
+	    void SwapRange(VoxelGeometryArena::Handle newRange, unsigned int newVertexCount);
+
+		glm::vec3 position;
 
-		glm::mat4x4 transform;
+	    VoxelGeometryArena* arena;
 
-	    std::vector<int> changedMaterials;
+	    VoxelGeometryArena::Handle range = VoxelGeometryArena::invalidHandle;
 
-		unsigned int voxelDataSsbo, voxelMeshSsbo, meshCounter;
+	    // Voxels waiting to be meshed, released once they're taken for generation
+	    std::unique_ptr<VoxelArray> pendingVoxels;
 
-	    unsigned int vertexCount;
+	    unsigned int vertexCount = 0;
 	};
 }
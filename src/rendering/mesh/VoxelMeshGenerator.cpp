@@ -0,0 +1,103 @@
+#include "VoxelMeshGenerator.h"
+
+#include <algorithm>
+
+#include "core/services/ServiceLocator.h"
+#include "rendering/Renderer.h"
+#include "rendering/mesh/VoxelMesh.h"
+#include "voxel/VoxelVertex.h"
+
+namespace Vox
+{
+    VoxelMeshGenerator::VoxelMeshGenerator(DynamicObjectContainer<VoxelMesh>* meshes, const unsigned int slotCount)
+        :meshes(meshes), slots(slotCount)
+    {
+        constexpr GLbitfield counterMapFlags = GL_MAP_READ_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+        for (Slot& slot : slots)
+        {
+            unsigned int buffers[3] = {};
+            glCreateBuffers(3, buffers);
+            slot.voxelDataSsbo = buffers[0];
+            slot.voxelMeshSsbo = buffers[1];
+            slot.meshCounter = buffers[2];
+
+            glNamedBufferStorage(slot.voxelDataSsbo, sizeof(VoxelMesh::VoxelArray), nullptr, GL_DYNAMIC_STORAGE_BIT);
+            glNamedBufferStorage(slot.voxelMeshSsbo, sizeof(VoxelVertex) * maxVertexCount, nullptr, 0);
+            glNamedBufferStorage(slot.meshCounter, sizeof(unsigned int), nullptr, GL_DYNAMIC_STORAGE_BIT | counterMapFlags);
+            slot.mappedCounter = static_cast<const unsigned int*>(glMapNamedBufferRange(slot.meshCounter, 0, sizeof(unsigned int), counterMapFlags));
+        }
+    }
+
+    VoxelMeshGenerator::~VoxelMeshGenerator()
+    {
+        for (const Slot& slot : slots)
+        {
+            if (slot.fence)
+            {
+                glDeleteSync(slot.fence);
+            }
+            glUnmapNamedBuffer(slot.meshCounter);
+            const unsigned int buffers[3] = { slot.voxelDataSsbo, slot.voxelMeshSsbo, slot.meshCounter };
+            glDeleteBuffers(3, buffers);
+        }
+    }
+
+    VoxelRemeshBackend::BeginResult VoxelMeshGenerator::Begin(const MeshId& mesh, unsigned int& slotOut)
+    {
+        const auto freeSlot = std::ranges::find_if(slots, [](const Slot& slot) { return !slot.inUse; });
+        if (freeSlot == slots.end())
+        {
+            return BeginResult::Busy;
+        }
+
+        VoxelMesh* voxelMesh = meshes->Get(mesh.first, mesh.second);
+        if (!voxelMesh || !voxelMesh->NeedsRegeneration())
+        {
+            return BeginResult::Skipped;
+        }
+
+        Slot& slot = *freeSlot;
+        constexpr unsigned int counterStart = 0;
+        const std::unique_ptr<VoxelMesh::VoxelArray> voxels = voxelMesh->TakePendingVoxels();
+        glNamedBufferSubData(slot.voxelDataSsbo, 0, sizeof(VoxelMesh::VoxelArray), voxels.get());
+        glNamedBufferSubData(slot.meshCounter, 0, sizeof(unsigned int), &counterStart);
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, slot.voxelDataSsbo);
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 1, slot.voxelMeshSsbo);
+        glBindBufferBase(GL_ATOMIC_COUNTER_BUFFER, 2, slot.meshCounter);
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 3, ServiceLocator::GetRenderer()->GetVoxelMaterialBuffer());
+
+        // Every material is meshed in the same pass, looked up from the material table
+        glDispatchCompute(1, 1, 1);
+
+        // The output is copied into the arena and the counter is read through its mapping, both after the fence
+        glMemoryBarrier(GL_BUFFER_UPDATE_BARRIER_BIT | GL_CLIENT_MAPPED_BUFFER_BARRIER_BIT);
+        slot.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        slot.inUse = true;
+
+        slotOut = static_cast<unsigned int>(freeSlot - slots.begin());
+        return BeginResult::Started;
+    }
+
+    bool VoxelMeshGenerator::IsFinished(const unsigned int slot)
+    {
+        // A timeout of zero only checks the fence, the flush makes sure it gets submitted at all
+        const GLenum result = glClientWaitSync(slots[slot].fence, GL_SYNC_FLUSH_COMMANDS_BIT, 0);
+        return result == GL_ALREADY_SIGNALED || result == GL_CONDITION_SATISFIED;
+    }
+
+    void VoxelMeshGenerator::Complete(const unsigned int slot, const MeshId& mesh)
+    {
+        Slot& finishedSlot = slots[slot];
+        glDeleteSync(finishedSlot.fence);
+        finishedSlot.fence = nullptr;
+        finishedSlot.inUse = false;
+
+        // The mesh may have been destroyed while the job was running
+        if (VoxelMesh* voxelMesh = meshes->Get(mesh.first, mesh.second))
+        {
+            // The counter keeps counting quads that didn't fit, the shader drops those so the mesh is only truncated
+            const unsigned int vertexCount = std::min(*finishedSlot.mappedCounter * 6, maxVertexCount);
+            voxelMesh->ApplyGeneratedVertices(finishedSlot.voxelMeshSsbo, vertexCount);
+        }
+    }
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <vector>
+
+#include <GL/glew.h>
+
+#include "core/datatypes/DynamicObjectContainer.h"
+#include "rendering/mesh/VoxelRemeshScheduler.h"
+
+namespace Vox
+{
+    class VoxelMesh;
+
+    /**
+     * @brief Runs voxelGeneration.comp for a VoxelRemeshScheduler, without waiting on the GPU
+     * Each job gets its own slot of input, output and counter buffers. A fence is placed after the dispatches,
+     * and the counter is only read through a persistent mapping once that fence has signaled
+     */
+    class VoxelMeshGenerator : public VoxelRemeshBackend
+    {
+    public:
+        static constexpr unsigned int maxVertexCount = 1024 * 16 * 6;
+
+        /**
+         * @param meshes container the scheduled mesh ids refer to, has to outlive the generator
+         * @param slotCount how many jobs can be in flight at once
+         */
+        VoxelMeshGenerator(DynamicObjectContainer<VoxelMesh>* meshes, unsigned int slotCount);
+        ~VoxelMeshGenerator() override;
+
+        VoxelMeshGenerator(VoxelMeshGenerator&&) = delete;
+        VoxelMeshGenerator(const VoxelMeshGenerator&) = delete;
+        VoxelMeshGenerator& operator=(VoxelMeshGenerator&&) = delete;
+        VoxelMeshGenerator& operator=(const VoxelMeshGenerator&) = delete;
+
+        /**
+         * @brief Upload the mesh's pending voxels and dispatch the generation shader. The shader has to be enabled
+         */
+        BeginResult Begin(const MeshId& mesh, unsigned int& slotOut) override;
+
+        [[nodiscard]] bool IsFinished(unsigned int slot) override;
+
+        void Complete(unsigned int slot, const MeshId& mesh) override;
+
+    private:
+        struct Slot
+        {
+            unsigned int voxelDataSsbo = 0, voxelMeshSsbo = 0, meshCounter = 0;
+
+            const unsigned int* mappedCounter = nullptr;
+
+            GLsync fence = nullptr;
+
+            bool inUse = false;
+        };
+
+        DynamicObjectContainer<VoxelMesh>* meshes;
+
+        std::vector<Slot> slots;
+    };
+}
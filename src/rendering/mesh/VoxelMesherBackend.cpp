@@ -0,0 +1,74 @@
+#include "VoxelMesherBackend.h"
+
+#include <algorithm>
+
+#include "core/services/ServiceLocator.h"
+#include "core/services/ThreadPool.h"
+#include "voxel/VoxelMesher.h"
+
+namespace Vox
+{
+    VoxelMesherBackend::VoxelMesherBackend(DynamicObjectContainer<VoxelMesh>* meshes, const std::vector<VoxelMaterial>* materials,
+        const unsigned int slotCount)
+        :meshes(meshes), materials(materials), slots(slotCount)
+    {
+    }
+
+    VoxelMesherBackend::~VoxelMesherBackend()
+    {
+        for (Slot& slot : slots)
+        {
+            if (slot.inUse)
+            {
+                slot.finished.wait(false, std::memory_order_acquire);
+            }
+        }
+    }
+
+    VoxelRemeshBackend::BeginResult VoxelMesherBackend::Begin(const MeshId& mesh, unsigned int& slotOut)
+    {
+        const auto freeSlot = std::ranges::find_if(slots, [](const Slot& slot) { return !slot.inUse; });
+        if (freeSlot == slots.end())
+        {
+            return BeginResult::Busy;
+        }
+
+        VoxelMesh* voxelMesh = meshes->Get(mesh.first, mesh.second);
+        if (!voxelMesh || !voxelMesh->NeedsRegeneration())
+        {
+            return BeginResult::Skipped;
+        }
+
+        Slot& slot = *freeSlot;
+        slot.voxels = voxelMesh->TakePendingVoxels();
+        slot.finished.store(false, std::memory_order_relaxed);
+        slot.inUse = true;
+        ServiceLocator::GetThreadPool()->Submit([&slot, materials = materials]
+        {
+            VoxelMesher::GenerateMesh(*slot.voxels, *materials, slot.vertices);
+            slot.finished.store(true, std::memory_order_release);
+            slot.finished.notify_one();
+        });
+
+        slotOut = static_cast<unsigned int>(freeSlot - slots.begin());
+        return BeginResult::Started;
+    }
+
+    bool VoxelMesherBackend::IsFinished(const unsigned int slot)
+    {
+        return slots[slot].finished.load(std::memory_order_acquire);
+    }
+
+    void VoxelMesherBackend::Complete(const unsigned int slot, const MeshId& mesh)
+    {
+        Slot& finishedSlot = slots[slot];
+        finishedSlot.inUse = false;
+        finishedSlot.voxels.reset();
+
+        // The mesh may have been destroyed while the job was running
+        if (VoxelMesh* voxelMesh = meshes->Get(mesh.first, mesh.second))
+        {
+            voxelMesh->UploadVertices(finishedSlot.vertices);
+        }
+    }
+}
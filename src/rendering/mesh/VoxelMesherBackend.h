@@ -0,0 +1,64 @@
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include "core/datatypes/DynamicObjectContainer.h"
+#include "rendering/mesh/VoxelMesh.h"
+#include "rendering/mesh/VoxelRemeshScheduler.h"
+#include "voxel/VoxelMaterial.h"
+#include "voxel/VoxelVertex.h"
+
+namespace Vox
+{
+    /**
+     * @brief Runs VoxelMesher on the thread pool for a VoxelRemeshScheduler, instead of the generation shader
+     * Each job meshes its voxels on a worker, and the vertices are uploaded to the mesh on the main thread once it's done
+     */
+    class VoxelMesherBackend : public VoxelRemeshBackend
+    {
+    public:
+        /**
+         * @param meshes container the scheduled mesh ids refer to, has to outlive the backend
+         * @param materials read from the workers, so it can't change while jobs are running
+         * @param slotCount how many jobs can be in flight at once
+         */
+        VoxelMesherBackend(DynamicObjectContainer<VoxelMesh>* meshes, const std::vector<VoxelMaterial>* materials, unsigned int slotCount);
+
+        /**
+         * @brief Waits for the jobs still running, as they write into the slots
+         */
+        ~VoxelMesherBackend() override;
+
+        VoxelMesherBackend(VoxelMesherBackend&&) = delete;
+        VoxelMesherBackend(const VoxelMesherBackend&) = delete;
+        VoxelMesherBackend& operator=(VoxelMesherBackend&&) = delete;
+        VoxelMesherBackend& operator=(const VoxelMesherBackend&) = delete;
+
+        BeginResult Begin(const MeshId& mesh, unsigned int& slotOut) override;
+
+        [[nodiscard]] bool IsFinished(unsigned int slot) override;
+
+        void Complete(unsigned int slot, const MeshId& mesh) override;
+
+    private:
+        struct Slot
+        {
+            std::unique_ptr<VoxelMesh::VoxelArray> voxels;
+
+            std::vector<VoxelVertex> vertices;
+
+            // Set by the worker once the vertices are written
+            std::atomic_bool finished = false;
+
+            bool inUse = false;
+        };
+
+        DynamicObjectContainer<VoxelMesh>* meshes;
+
+        const std::vector<VoxelMaterial>* materials;
+
+        std::vector<Slot> slots;
+    };
+}
@@ -0,0 +1,108 @@
+#include "VoxelRemeshScheduler.h"
+
+#include <algorithm>
+
+namespace Vox
+{
+    VoxelRemeshScheduler::VoxelRemeshScheduler(VoxelRemeshBackend* backend, const unsigned int budgetPerFrame)
+        :backend(backend), budgetPerFrame(budgetPerFrame)
+    {
+    }
+
+    void VoxelRemeshScheduler::Request(const MeshId& mesh, const glm::vec3& position)
+    {
+        const auto [queuedIndex, inserted] = queuedIndices.try_emplace(PackMeshId(mesh), queuedRequests.size());
+        if (!inserted)
+        {
+            queuedRequests[queuedIndex->second].position = position;
+            return;
+        }
+        queuedRequests.emplace_back(mesh, position);
+    }
+
+    void VoxelRemeshScheduler::Update(const glm::vec3& cameraPosition)
+    {
+        for (size_t i = 0; i < inFlightJobs.size();)
+        {
+            if (backend->IsFinished(inFlightJobs[i].slot))
+            {
+                backend->Complete(inFlightJobs[i].slot, inFlightJobs[i].mesh);
+                inFlightJobs.erase(inFlightJobs.begin() + static_cast<std::ptrdiff_t>(i));
+            }
+            else
+            {
+                ++i;
+            }
+        }
+
+        const auto distanceSquared = [&cameraPosition](const QueuedRequest& request)
+        {
+            const glm::vec3 offset = request.position - cameraPosition;
+            return offset.x * offset.x + offset.y * offset.y + offset.z * offset.z;
+        };
+        std::ranges::stable_sort(queuedRequests, {}, distanceSquared);
+
+        // Requests that couldn't be started stay queued, still closest first
+        std::vector<QueuedRequest> remainingRequests;
+        unsigned int startedCount = 0;
+        bool backendBusy = false;
+        for (const QueuedRequest& request : queuedRequests)
+        {
+            if (backendBusy || startedCount >= budgetPerFrame || IsInFlight(request.mesh))
+            {
+                remainingRequests.push_back(request);
+                continue;
+            }
+
+            unsigned int slot = 0;
+            switch (backend->Begin(request.mesh, slot))
+            {
+            case VoxelRemeshBackend::BeginResult::Started:
+                inFlightJobs.emplace_back(request.mesh, slot);
+                ++startedCount;
+                break;
+            case VoxelRemeshBackend::BeginResult::Skipped:
+                break;
+            case VoxelRemeshBackend::BeginResult::Busy:
+                backendBusy = true;
+                remainingRequests.push_back(request);
+                break;
+            }
+        }
+        queuedRequests = std::move(remainingRequests);
+
+        queuedIndices.clear();
+        for (size_t i = 0; i < queuedRequests.size(); ++i)
+        {
+            queuedIndices.emplace(PackMeshId(queuedRequests[i].mesh), i);
+        }
+    }
+
+    void VoxelRemeshScheduler::SetBudgetPerFrame(const unsigned int budget)
+    {
+        budgetPerFrame = budget;
+    }
+
+    size_t VoxelRemeshScheduler::GetQueuedCount() const
+    {
+        return queuedRequests.size();
+    }
+
+    size_t VoxelRemeshScheduler::GetInFlightCount() const
+    {
+        return inFlightJobs.size();
+    }
+
+    bool VoxelRemeshScheduler::IsInFlight(const MeshId& mesh) const
+    {
+        return std::ranges::any_of(inFlightJobs, [&mesh](const InFlightJob& job)
+        {
+            return job.mesh == mesh;
+        });
+    }
+
+    uint64_t VoxelRemeshScheduler::PackMeshId(const MeshId& mesh)
+    {
+        return static_cast<uint64_t>(mesh.first) << 32 | static_cast<uint32_t>(mesh.second);
+    }
+}
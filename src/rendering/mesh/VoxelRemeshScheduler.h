@@ -0,0 +1,114 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <glm/vec3.hpp>
+
+namespace Vox
+{
+    /**
+     * @brief Does the actual mesh generation for a VoxelRemeshScheduler
+     * Jobs are started and then polled on later frames, so the backend never has to wait on the GPU
+     */
+    class VoxelRemeshBackend
+    {
+    public:
+        // Index and id of the mesh in its DynamicObjectContainer
+        using MeshId = std::pair<size_t, int>;
+
+        enum class BeginResult : char
+        {
+            Started,
+            // The mesh doesn't exist anymore, or has nothing to generate
+            Skipped,
+            // Every job slot is in use, try again next frame
+            Busy
+        };
+
+        virtual ~VoxelRemeshBackend() = default;
+
+        /**
+         * @param slotOut set to the slot the job runs in, when it was started
+         */
+        virtual BeginResult Begin(const MeshId& mesh, unsigned int& slotOut) = 0;
+
+        /**
+         * @brief Check if a job has finished without blocking
+         */
+        [[nodiscard]] virtual bool IsFinished(unsigned int slot) = 0;
+
+        /**
+         * @brief Apply the result of a finished job to its mesh, and free the slot
+         */
+        virtual void Complete(unsigned int slot, const MeshId& mesh) = 0;
+    };
+
+    /**
+     * @brief Spreads voxel mesh regeneration over several frames
+     * Requests are started closest to the camera first, up to a budget per frame, and each mesh keeps drawing
+     * its previous geometry until its job completes. A mesh is never in flight twice, edits made while its job
+     * is running are picked up by the next one
+     */
+    class VoxelRemeshScheduler
+    {
+    public:
+        using MeshId = VoxelRemeshBackend::MeshId;
+
+        /**
+         * @param backend has to outlive the scheduler
+         * @param budgetPerFrame how many jobs can be started each frame
+         */
+        VoxelRemeshScheduler(VoxelRemeshBackend* backend, unsigned int budgetPerFrame);
+
+        /**
+         * @brief Queue a mesh for regeneration, or update its position if it's already queued
+         * @param position used to prioritize the mesh, usually its center
+         */
+        void Request(const MeshId& mesh, const glm::vec3& position);
+
+        /**
+         * @brief Complete any finished jobs, then start the queued requests closest to the camera
+         * Jobs started this frame are only checked from the next call on
+         */
+        void Update(const glm::vec3& cameraPosition);
+
+        void SetBudgetPerFrame(unsigned int budget);
+
+        [[nodiscard]] size_t GetQueuedCount() const;
+
+        [[nodiscard]] size_t GetInFlightCount() const;
+
+    private:
+        struct QueuedRequest
+        {
+            MeshId mesh;
+            glm::vec3 position;
+        };
+
+        struct InFlightJob
+        {
+            MeshId mesh;
+            unsigned int slot;
+        };
+
+        [[nodiscard]] bool IsInFlight(const MeshId& mesh) const;
+
+        [[nodiscard]] static uint64_t PackMeshId(const MeshId& mesh);
+
+        VoxelRemeshBackend* backend;
+
+        unsigned int budgetPerFrame;
+
+        std::vector<QueuedRequest> queuedRequests;
+
+        // Index of each queued mesh in queuedRequests, keyed by PackMeshId
+        std::unordered_map<uint64_t, size_t> queuedIndices;
+
+        // In the order they were started
+        std::vector<InFlightJob> inFlightJobs;
+    };
+}
@@ -7,29 +7,13 @@
 
 namespace Vox
 {
-    struct VoxelMaterial;
-
+    /**
+     * @brief Meshes a whole chunk in one dispatch, see VoxelMeshGenerator for the buffers it reads and writes
+     */
     class VoxelGenerationShader : public ComputeShader
     {
-        struct UniformLocations
-        {
-            int materialId = -1;
-
-            int front = -1;
-            int back = -1;
-            int left = -1;
-            int right = -1;
-            int top = -1;
-            int bottom = -1;
-        };
-
     public:
         VoxelGenerationShader();
-
-        void SetVoxelMaterial(unsigned int id, const VoxelMaterial& material);
-
-    private:
-        UniformLocations uniformLocations;
     };
 
 } // Vox
@@ -9,6 +9,7 @@ namespace Vox
     {
         uniformLocations.roughness = GetUniformLocation("materialRoughness");
         uniformLocations.albedo = GetUniformLocation("materialAlbedo");
+        uniformLocations.materialIndex = GetUniformLocation("materialIndex");
     }
 
     void MaterialShader::SetMaterial(const PBRMaterial& material) const
@@ -16,4 +17,9 @@ namespace Vox
         SetUniformColor(uniformLocations.albedo, material.albedo);
         SetUniformFloat(uniformLocations.roughness, material.roughness);
     }
+
+    void MaterialShader::SetMaterialIndex(const unsigned int index) const
+    {
+        SetUniformUint(uniformLocations.materialIndex, index);
+    }
 }
@@ -12,6 +12,7 @@ namespace Vox
         {
             int roughness = -1;
             int albedo = -1;
+            int materialIndex = -1;
         };
         
     public:
@@ -19,6 +20,11 @@ namespace Vox
 
         void SetMaterial(const PBRMaterial& material) const;
 
+        /**
+         * @brief Select a material from the instance's materials, for the instanced mesh shaders
+         */
+        void SetMaterialIndex(unsigned int index) const;
+
     private:
         UniformLocations uniformLocations;
     };
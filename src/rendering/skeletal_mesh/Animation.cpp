@@ -1,21 +1,31 @@
 #include "Animation.h"
 
 #include <algorithm>
+#include <cassert>
 
 #include <tiny_gltf.h>
 
 #include "rendering/mesh/ModelNode.h"
+#include "rendering/skeletal_mesh/AnimationImportSettings.h"
 
 namespace Vox
 {
-	Animation::Animation(const tinygltf::Animation& animation, tinygltf::Model& model)
+	Animation::Animation(const tinygltf::Animation& animation, tinygltf::Model& model, const AnimationImportSettings& settings)
 	{
 		duration = 0.0f;
 	    name = animation.name;
 		for (const tinygltf::AnimationChannel& channel : animation.channels)
 		{
 			AnimationChannel& animationChannel = channels.emplace_back(model, animation, channel);
+			animationChannel.Resample(settings.sampleRate);
 			duration = std::max(duration, animationChannel.GetDuration());
+			uncompressedMemorySize += sizeof(AnimationChannel) + animationChannel.GetMemorySize();
+		}
+
+		if (settings.compress)
+		{
+			compressed.emplace(channels, duration, settings);
+			channels = std::vector<AnimationChannel>();
 		}
 	}
 
@@ -24,14 +34,55 @@ namespace Vox
 		return duration;
 	}
 
-	void Animation::ApplyToNodes(std::vector<ModelNode>& nodes, float time)
+	void Animation::ApplyToNodes(std::vector<ModelTransform>& localTransforms, float time) const
 	{
-		for (AnimationChannel& animationChannel : channels)
+		if (compressed)
+		{
+			compressed->ApplyToNodes(localTransforms, time);
+			return;
+		}
+
+		for (const AnimationChannel& animationChannel : channels)
+		{
+			animationChannel.ApplyToNode(localTransforms, time);
+		}
+	}
+
+	void Animation::ApplyToNodes(std::vector<ModelTransform>& localTransforms, float time, std::vector<unsigned int>& cursors) const
+	{
+		if (compressed)
+		{
+			compressed->ApplyToNodes(localTransforms, time, cursors);
+			return;
+		}
+
+		assert(cursors.size() == channels.size());
+		for (size_t i = 0; i < channels.size(); ++i)
 		{
-			animationChannel.ApplyToNode(nodes, time);
+			channels[i].ApplyToNode(localTransforms, time, cursors[i]);
 		}
 	}
 
+	size_t Animation::GetChannelCount() const
+	{
+		return compressed ? compressed->GetTrackCount() : channels.size();
+	}
+
+	bool Animation::IsCompressed() const
+	{
+		return compressed.has_value();
+	}
+
+	size_t Animation::GetMemorySize() const
+	{
+		return compressed ? compressed->GetMemorySize() : uncompressedMemorySize;
+	}
+
+	size_t Animation::GetUncompressedMemorySize() const
+	{
+		return uncompressedMemorySize;
+	}
+
     const std::string& Animation::GetName() const
     {
         return name;
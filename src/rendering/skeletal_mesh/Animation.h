@@ -1,8 +1,10 @@
 #pragma once
 
+#include <optional>
 #include <vector>
 
 #include "rendering/skeletal_mesh/AnimationChannel.h"
+#include "rendering/skeletal_mesh/CompressedAnimation.h"
 
 namespace tinygltf
 {
@@ -12,22 +14,50 @@ namespace tinygltf
 
 namespace Vox
 {
-	struct ModelNode;
+	struct AnimationImportSettings;
+	struct ModelTransform;
 
 	class Animation
 	{
 	public:
-		Animation(const tinygltf::Animation& animation, tinygltf::Model& model);
+		Animation(const tinygltf::Animation& animation, tinygltf::Model& model, const AnimationImportSettings& settings);
 
 		float GetDuration() const;
 
-		void ApplyToNodes(std::vector<ModelNode>& nodes, float time);
+		/**
+		 * @brief Write the animated transforms of every channel's node, nodes without a channel are left alone
+		 */
+		void ApplyToNodes(std::vector<ModelTransform>& localTransforms, float time) const;
+
+		/**
+		 * @param cursors one per channel, where the last evaluation left each channel. See AnimationChannel::EvaluateRotation
+		 */
+		void ApplyToNodes(std::vector<ModelTransform>& localTransforms, float time, std::vector<unsigned int>& cursors) const;
+
+		[[nodiscard]] size_t GetChannelCount() const;
+
+		[[nodiscard]] bool IsCompressed() const;
+
+		/**
+		 * @brief Get the size of the channels and their keys as stored, in bytes
+		 */
+		[[nodiscard]] size_t GetMemorySize() const;
+
+		/**
+		 * @brief Get the size the keys had before compression, in bytes. The same as GetMemorySize when uncompressed
+		 */
+		[[nodiscard]] size_t GetUncompressedMemorySize() const;
 
 	    const std::string& GetName() const;
 
 	private:
 	    std::string name;
 		std::vector<AnimationChannel> channels;
+
+		// Replaces the channels when the animation is compressed
+		std::optional<CompressedAnimation> compressed;
+
+		size_t uncompressedMemorySize = 0;
 		float duration;
 	};
 }
\ No newline at end of file
@@ -1,5 +1,8 @@
 #include "AnimationChannel.h"
 
+#include <algorithm>
+#include <cassert>
+#include <cmath>
 #include <iterator>
 
 #include <tiny_gltf.h>
@@ -53,42 +56,65 @@ namespace Vox
 		}
 	}
 
-	glm::quat Vox::AnimationChannel::EvaluateRotation(float time) const
+	glm::quat AnimationChannel::EvaluateRotation(float time) const
 	{
-		assert(!rotations.empty());
-		int leftIndex = GetLeftIndex(time);
-		if (leftIndex == -1)
-		{
-			return rotations[0];
-		}
+		return EvaluateRotation(FindInterval(time, nullptr));
+	}
 
-		if (leftIndex == rotations.size() - 1)
-		{
-			return rotations[timeKeys.size() - 1];
-		}
+	glm::vec3 AnimationChannel::EvaulateVector(float time) const
+	{
+		return EvaulateVector(FindInterval(time, nullptr));
+	}
 
-		float alpha = RemapRange(time, timeKeys[leftIndex], timeKeys[leftIndex + 1], 0.0f, 1.0f);
+	glm::quat AnimationChannel::EvaluateRotation(float time, unsigned int& cursor) const
+	{
+		return EvaluateRotation(FindInterval(time, &cursor));
+	}
 
-		return glm::slerp(rotations[leftIndex], rotations[leftIndex + 1], alpha);
+	glm::vec3 AnimationChannel::EvaulateVector(float time, unsigned int& cursor) const
+	{
+		return EvaulateVector(FindInterval(time, &cursor));
 	}
 
-	glm::vec3 AnimationChannel::EvaulateVector(float time) const
+	void AnimationChannel::Resample(float newSampleRate)
 	{
-		assert(!vectors.empty());
-		int leftIndex = GetLeftIndex(time);
-		if (leftIndex == -1)
+		if (newSampleRate <= 0.0f || timeKeys.size() < 2)
 		{
-			return vectors[0];
+			return;
 		}
 
-		if (leftIndex == vectors.size() - 1)
+		// The last key may be a little past the end, so every interval is the same length
+		const float startTime = timeKeys.front();
+		const auto sampleCount = static_cast<unsigned int>(std::ceil((timeKeys.back() - startTime) * newSampleRate)) + 1;
+		std::vector<float> sampledKeys(sampleCount);
+		for (unsigned int i = 0; i < sampleCount; ++i)
 		{
-			return vectors[vectors.size() - 1];
+			sampledKeys[i] = startTime + static_cast<float>(i) / newSampleRate;
 		}
 
-		float alpha = RemapRange(time, timeKeys[leftIndex], timeKeys[leftIndex + 1], 0.0f, 1.0f);
+		// Sample the original keys in order, so the cursor only moves forward
+		unsigned int cursor = 0;
+		if (type == SamplerType::Rotation)
+		{
+			std::vector<glm::quat> sampledRotations(sampleCount);
+			for (unsigned int i = 0; i < sampleCount; ++i)
+			{
+				sampledRotations[i] = EvaluateRotation(sampledKeys[i], cursor);
+			}
+			rotations = std::move(sampledRotations);
+		}
+		else
+		{
+			std::vector<glm::vec3> sampledVectors(sampleCount);
+			for (unsigned int i = 0; i < sampleCount; ++i)
+			{
+				sampledVectors[i] = EvaulateVector(sampledKeys[i], cursor);
+			}
+			vectors = std::move(sampledVectors);
+		}
 
-		return glm::mix(vectors[leftIndex], vectors[leftIndex + 1], alpha);
+		timeKeys = std::move(sampledKeys);
+		sampleRate = newSampleRate;
 	}
 
 	float AnimationChannel::GetDuration() const
@@ -101,24 +127,71 @@ namespace Vox
 		return type;
 	}
 
-	void AnimationChannel::ApplyToNode(std::vector<ModelNode>& nodes, float time)
+	unsigned int AnimationChannel::GetNode() const
 	{
-		ModelNode& targetNode = nodes[node];
+		return node;
+	}
+
+	const std::vector<float>& AnimationChannel::GetTimeKeys() const
+	{
+		return timeKeys;
+	}
+
+	const std::vector<glm::quat>& AnimationChannel::GetRotations() const
+	{
+		return rotations;
+	}
+
+	const std::vector<glm::vec3>& AnimationChannel::GetVectors() const
+	{
+		return vectors;
+	}
+
+	size_t AnimationChannel::GetMemorySize() const
+	{
+		return timeKeys.size() * sizeof(float) + rotations.size() * sizeof(glm::quat) + vectors.size() * sizeof(glm::vec3);
+	}
+
+	void AnimationChannel::ApplyToNode(std::vector<ModelTransform>& localTransforms, float time) const
+	{
+		ModelTransform& targetTransform = localTransforms[node];
 		switch (type)
 		{
 		case SamplerType::Translation:
 		{
-			targetNode.localTransform.position = EvaulateVector(time);
+			targetTransform.position = EvaulateVector(time);
 			break;
 		}
 		case SamplerType::Rotation:
 		{
-			targetNode.localTransform.rotation = EvaluateRotation(time);
+			targetTransform.rotation = EvaluateRotation(time);
 			break;
 		}
 		case SamplerType::Scale:
 		{
-			targetNode.localTransform.scale = EvaulateVector(time);
+			targetTransform.scale = EvaulateVector(time);
+		}
+		}
+	}
+
+	void AnimationChannel::ApplyToNode(std::vector<ModelTransform>& localTransforms, float time, unsigned int& cursor) const
+	{
+		ModelTransform& targetTransform = localTransforms[node];
+		switch (type)
+		{
+		case SamplerType::Translation:
+		{
+			targetTransform.position = EvaulateVector(time, cursor);
+			break;
+		}
+		case SamplerType::Rotation:
+		{
+			targetTransform.rotation = EvaluateRotation(time, cursor);
+			break;
+		}
+		case SamplerType::Scale:
+		{
+			targetTransform.scale = EvaulateVector(time, cursor);
 		}
 		}
 	}
@@ -143,44 +216,77 @@ namespace Vox
 		return SamplerType::Error;
 	}
 
-	int AnimationChannel::GetLeftIndex(float time) const
+	AnimationChannel::KeyInterval AnimationChannel::FindInterval(float time, unsigned int* cursor) const
 	{
-		// Binary search
-
-		if (timeKeys.size() == 1)
+		const auto lastKey = static_cast<unsigned int>(timeKeys.size() - 1);
+		if (lastKey == 0 || time <= timeKeys.front())
+		{
+			return {0, 0, 0.0f};
+		}
+		if (time >= timeKeys.back())
 		{
-			return timeKeys.front();
+			return {lastKey, lastKey, 0.0f};
 		}
 
-		unsigned int left = 0;
-		unsigned int right = timeKeys.size() - 1;
-		unsigned int current = right / 2;
+		if (sampleRate > 0.0f)
+		{
+			const float position = (time - timeKeys.front()) * sampleRate;
+			const unsigned int left = std::min(static_cast<unsigned int>(position), lastKey - 1);
+			return {left, left + 1, std::clamp(position - static_cast<float>(left), 0.0f, 1.0f)};
+		}
 
-		for (;;)
+		unsigned int left;
+		if (cursor && *cursor < lastKey && timeKeys[*cursor] <= time)
 		{
-			if (left + 1 == right)
+			// Playback moves forward by less than a key most frames, so check the next two intervals before searching
+			left = *cursor;
+			if (time >= timeKeys[left + 1])
 			{
-				return left;
+				++left;
+				if (left < lastKey && time >= timeKeys[left + 1])
+				{
+					left = GetLeftIndex(time);
+				}
 			}
+		}
+		else
+		{
+			left = GetLeftIndex(time);
+		}
+		if (cursor)
+		{
+			*cursor = left;
+		}
 
-			const float comparedTime = timeKeys[current];
-			if (time == comparedTime)
-			{
-				return current;
-			}
+		return {left, left + 1, RemapRange(time, timeKeys[left], timeKeys[left + 1], 0.0f, 1.0f)};
+	}
 
-			if (time < comparedTime)
-			{
-				int newRight = current;
-				current = (left + right) / 2;
-				right = newRight;
-			}
-			else
-			{
-				int newLeft = current;
-				current = (left + right) / 2;
-				left = newLeft;
-			}
+	glm::quat AnimationChannel::EvaluateRotation(const KeyInterval& interval) const
+	{
+		assert(!rotations.empty());
+		if (interval.left == interval.right)
+		{
+			return rotations[interval.left];
 		}
+
+		return glm::slerp(rotations[interval.left], rotations[interval.right], interval.alpha);
+	}
+
+	glm::vec3 AnimationChannel::EvaulateVector(const KeyInterval& interval) const
+	{
+		assert(!vectors.empty());
+		if (interval.left == interval.right)
+		{
+			return vectors[interval.left];
+		}
+
+		return glm::mix(vectors[interval.left], vectors[interval.right], interval.alpha);
+	}
+
+	unsigned int AnimationChannel::GetLeftIndex(float time) const
+	{
+		// The last key at or before the time, the caller has already handled times outside of the keys
+		const auto right = std::upper_bound(timeKeys.begin(), timeKeys.end(), time);
+		return static_cast<unsigned int>(right - timeKeys.begin()) - 1;
 	}
 }
\ No newline at end of file
@@ -16,7 +16,7 @@ namespace tinygltf
 
 namespace Vox
 {
-	struct ModelNode;
+	struct ModelTransform;
 
 	class AnimationChannel
 	{
@@ -34,16 +34,67 @@ namespace Vox
 		glm::quat EvaluateRotation(float time) const;
 		glm::vec3 EvaulateVector(float time) const;
 
+		/**
+		 * @brief Evaluate starting from the key the last evaluation ended on, which is constant time while
+		 * playback moves forward. Seeks and loops fall back to a binary search
+		 * @param cursor the last key index, kept by the caller for each channel and instance
+		 */
+		glm::quat EvaluateRotation(float time, unsigned int& cursor) const;
+		glm::vec3 EvaulateVector(float time, unsigned int& cursor) const;
+
+		/**
+		 * @brief Replace the keys with keys at a fixed rate, so finding the key for a time is a single multiply
+		 * instead of a search. Curves are only exact at the new keys
+		 */
+		void Resample(float sampleRate);
+
 		float GetDuration() const;
 
 		SamplerType GetType() const;
 
-		void ApplyToNode(std::vector<ModelNode>& nodes, float time);
+		[[nodiscard]] unsigned int GetNode() const;
+
+		[[nodiscard]] const std::vector<float>& GetTimeKeys() const;
+
+		/**
+		 * @brief Get the keys of a rotation channel, empty for other channels
+		 */
+		[[nodiscard]] const std::vector<glm::quat>& GetRotations() const;
+
+		/**
+		 * @brief Get the keys of a translation or scale channel, empty for other channels
+		 */
+		[[nodiscard]] const std::vector<glm::vec3>& GetVectors() const;
+
+		/**
+		 * @brief Get the size of the keys, in bytes
+		 */
+		[[nodiscard]] size_t GetMemorySize() const;
+
+		void ApplyToNode(std::vector<ModelTransform>& localTransforms, float time) const;
+
+		void ApplyToNode(std::vector<ModelTransform>& localTransforms, float time, unsigned int& cursor) const;
 
 		static SamplerType GetSamplerTypeFromString(std::string string);
 
 	private:
-		int GetLeftIndex(float time) const;
+		// The two keys around a time, and how far between them the time is
+		struct KeyInterval
+		{
+			unsigned int left;
+			unsigned int right;
+			float alpha;
+		};
+
+		/**
+		 * @param cursor the key to start looking from, updated to the left key. Searches the whole channel if null
+		 */
+		[[nodiscard]] KeyInterval FindInterval(float time, unsigned int* cursor) const;
+
+		[[nodiscard]] glm::quat EvaluateRotation(const KeyInterval& interval) const;
+		[[nodiscard]] glm::vec3 EvaulateVector(const KeyInterval& interval) const;
+
+		[[nodiscard]] unsigned int GetLeftIndex(float time) const;
 
 		unsigned int node = 0;
 
@@ -51,6 +102,9 @@ namespace Vox
 
 		std::vector<float> timeKeys;
 
+		// Keys per second after resampling, 0 if the keys are the ones loaded
+		float sampleRate = 0.0f;
+
 		std::vector<glm::quat> rotations;
 		std::vector<glm::vec3> vectors;
 	};
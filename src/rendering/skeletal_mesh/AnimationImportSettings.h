@@ -0,0 +1,20 @@
+#pragma once
+
+namespace Vox
+{
+	/**
+	 * @brief How a skeletal model's animations are stored once loaded. The defaults keep the keys from the file
+	 */
+	struct AnimationImportSettings
+	{
+		// Keys per second to resample every channel to, or 0 to keep the keys as they are
+		float sampleRate = 0.0f;
+
+		// Store each animation as a CompressedAnimation instead of full precision channels
+		bool compress = false;
+
+		// Largest error keyframe reduction may add, in radians for rotations, and model units for translations and scales
+		float rotationTolerance = 0.001f;
+		float vectorTolerance = 0.0005f;
+	};
+}
@@ -0,0 +1,373 @@
+#include "CompressedAnimation.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <limits>
+
+#include "rendering/mesh/ModelNode.h"
+#include "rendering/skeletal_mesh/AnimationImportSettings.h"
+
+namespace Vox
+{
+	namespace
+	{
+		constexpr float quantizedMax = static_cast<float>(std::numeric_limits<uint16_t>::max());
+
+		// Smallest-three components are at most 1/sqrt(2) in magnitude, and have 15 bits each
+		constexpr float rotationComponentMax = 0.70710678f;
+		constexpr float rotationQuantizedMax = 32767.0f;
+
+		uint16_t Quantize(const float value, const float scale)
+		{
+			return static_cast<uint16_t>(std::clamp(std::round(value * scale), 0.0f, quantizedMax));
+		}
+
+		float GetRotationError(const glm::quat& a, const glm::quat& b)
+		{
+			const float dot = std::abs(a.x * b.x + a.y * b.y + a.z * b.z + a.w * b.w);
+			return 2.0f * std::acos(std::min(dot, 1.0f));
+		}
+
+		float GetVectorError(const glm::vec3& a, const glm::vec3& b)
+		{
+			return std::max({std::abs(a.x - b.x), std::abs(a.y - b.y), std::abs(a.z - b.z)});
+		}
+	}
+
+	CompressedAnimation::CompressedAnimation(const std::vector<AnimationChannel>& channels, const float duration, const AnimationImportSettings& settings)
+	{
+		timeScale = duration > 0.0f ? quantizedMax / duration : 0.0f;
+
+		std::vector<std::vector<uint32_t>> keptKeys;
+		keptKeys.reserve(channels.size());
+		for (const AnimationChannel& channel : channels)
+		{
+			std::vector<uint32_t>& kept = keptKeys.emplace_back(ReduceKeys(channel, settings));
+			keyCount += kept.size();
+		}
+
+		keys.resize(keyCount * (1 + valueComponents));
+		tracks.reserve(channels.size());
+		ranges.reserve(channels.size());
+		uint32_t firstKey = 0;
+		for (size_t i = 0; i < channels.size(); ++i)
+		{
+			const AnimationChannel& channel = channels[i];
+			const std::vector<uint32_t>& kept = keptKeys[i];
+			Track& track = tracks.emplace_back();
+			track.node = channel.GetNode();
+			track.type = channel.GetType();
+			track.firstKey = firstKey;
+			track.keyCount = static_cast<uint32_t>(kept.size());
+
+			const std::vector<float>& timeKeys = channel.GetTimeKeys();
+			uint16_t* times = keys.data() + firstKey;
+			uint16_t* values = keys.data() + keyCount + firstKey * valueComponents;
+			for (size_t key = 0; key < kept.size(); ++key)
+			{
+				times[key] = Quantize(timeKeys[kept[key]], timeScale);
+			}
+
+			if (track.type == AnimationChannel::SamplerType::Rotation)
+			{
+				const std::vector<glm::quat>& rotations = channel.GetRotations();
+				for (size_t key = 0; key < kept.size(); ++key)
+				{
+					EncodeRotation(rotations[kept[key]], values + key * valueComponents);
+				}
+			}
+			else if (!kept.empty())
+			{
+				const std::vector<glm::vec3>& vectors = channel.GetVectors();
+				glm::vec3 rangeMin = vectors[kept.front()];
+				glm::vec3 rangeMax = rangeMin;
+				for (const uint32_t key : kept)
+				{
+					rangeMin = glm::min(rangeMin, vectors[key]);
+					rangeMax = glm::max(rangeMax, vectors[key]);
+				}
+				const glm::vec3 extent = rangeMax - rangeMin;
+				track.range = static_cast<uint32_t>(ranges.size());
+				ranges.push_back({rangeMin, extent / quantizedMax});
+
+				for (size_t key = 0; key < kept.size(); ++key)
+				{
+					const glm::vec3 offset = vectors[kept[key]] - rangeMin;
+					for (int component = 0; component < 3; ++component)
+					{
+						const float scale = extent[component] > 0.0f ? quantizedMax / extent[component] : 0.0f;
+						values[key * valueComponents + component] = Quantize(offset[component], scale);
+					}
+				}
+			}
+			firstKey += track.keyCount;
+		}
+	}
+
+	void CompressedAnimation::ApplyToNodes(std::vector<ModelTransform>& localTransforms, const float time) const
+	{
+		for (size_t i = 0; i < tracks.size(); ++i)
+		{
+			const Track& track = tracks[i];
+			if (track.keyCount == 0)
+			{
+				continue;
+			}
+
+			ModelTransform& targetTransform = localTransforms[track.node];
+			const KeyInterval interval = FindInterval(track, time, nullptr);
+			switch (track.type)
+			{
+			case AnimationChannel::SamplerType::Translation:
+				targetTransform.position = EvaluateVector(track, interval);
+				break;
+			case AnimationChannel::SamplerType::Rotation:
+				targetTransform.rotation = EvaluateRotation(track, interval);
+				break;
+			case AnimationChannel::SamplerType::Scale:
+				targetTransform.scale = EvaluateVector(track, interval);
+				break;
+			default:
+				break;
+			}
+		}
+	}
+
+	void CompressedAnimation::ApplyToNodes(std::vector<ModelTransform>& localTransforms, const float time, std::vector<unsigned int>& cursors) const
+	{
+		assert(cursors.size() == tracks.size());
+		for (size_t i = 0; i < tracks.size(); ++i)
+		{
+			const Track& track = tracks[i];
+			if (track.keyCount == 0)
+			{
+				continue;
+			}
+
+			ModelTransform& targetTransform = localTransforms[track.node];
+			const KeyInterval interval = FindInterval(track, time, &cursors[i]);
+			switch (track.type)
+			{
+			case AnimationChannel::SamplerType::Translation:
+				targetTransform.position = EvaluateVector(track, interval);
+				break;
+			case AnimationChannel::SamplerType::Rotation:
+				targetTransform.rotation = EvaluateRotation(track, interval);
+				break;
+			case AnimationChannel::SamplerType::Scale:
+				targetTransform.scale = EvaluateVector(track, interval);
+				break;
+			default:
+				break;
+			}
+		}
+	}
+
+	glm::quat CompressedAnimation::EvaluateRotation(const size_t track, const float time) const
+	{
+		return EvaluateRotation(tracks[track], FindInterval(tracks[track], time, nullptr));
+	}
+
+	glm::vec3 CompressedAnimation::EvaluateVector(const size_t track, const float time) const
+	{
+		return EvaluateVector(tracks[track], FindInterval(tracks[track], time, nullptr));
+	}
+
+	size_t CompressedAnimation::GetTrackCount() const
+	{
+		return tracks.size();
+	}
+
+	size_t CompressedAnimation::GetKeyCount() const
+	{
+		return keyCount;
+	}
+
+	size_t CompressedAnimation::GetMemorySize() const
+	{
+		return tracks.size() * sizeof(Track) + ranges.size() * sizeof(Range) + keys.size() * sizeof(uint16_t);
+	}
+
+	std::vector<uint32_t> CompressedAnimation::ReduceKeys(const AnimationChannel& channel, const AnimationImportSettings& settings)
+	{
+		const std::vector<float>& timeKeys = channel.GetTimeKeys();
+		const bool rotation = channel.GetType() == AnimationChannel::SamplerType::Rotation;
+		const size_t valueCount = rotation ? channel.GetRotations().size() : channel.GetVectors().size();
+		if (channel.GetType() == AnimationChannel::SamplerType::Error || valueCount == 0 || timeKeys.empty())
+		{
+			return {};
+		}
+		assert(valueCount == timeKeys.size());
+
+		// Can every key between the two be rebuilt by interpolating the two?
+		auto canSkipBetween = [&](const uint32_t left, const uint32_t right)
+		{
+			const float interval = timeKeys[right] - timeKeys[left];
+			for (uint32_t key = left + 1; key < right; ++key)
+			{
+				const float alpha = interval > 0.0f ? (timeKeys[key] - timeKeys[left]) / interval : 0.0f;
+				if (rotation)
+				{
+					const std::vector<glm::quat>& rotations = channel.GetRotations();
+					const glm::quat interpolated = glm::slerp(rotations[left], rotations[right], alpha);
+					if (GetRotationError(interpolated, rotations[key]) > settings.rotationTolerance)
+					{
+						return false;
+					}
+				}
+				else
+				{
+					const std::vector<glm::vec3>& vectors = channel.GetVectors();
+					const glm::vec3 interpolated = glm::mix(vectors[left], vectors[right], alpha);
+					if (GetVectorError(interpolated, vectors[key]) > settings.vectorTolerance)
+					{
+						return false;
+					}
+				}
+			}
+			return true;
+		};
+
+		// Grow each span from the last kept key until a skipped key would be out of tolerance
+		const auto lastKey = static_cast<uint32_t>(timeKeys.size() - 1);
+		std::vector<uint32_t> kept = {0};
+		for (uint32_t key = 2; key <= lastKey; ++key)
+		{
+			if (!canSkipBetween(kept.back(), key))
+			{
+				kept.push_back(key - 1);
+			}
+		}
+		if (lastKey > 0)
+		{
+			kept.push_back(lastKey);
+		}
+		return kept;
+	}
+
+	void CompressedAnimation::EncodeRotation(const glm::quat& rotation, uint16_t* valueOut)
+	{
+		const glm::quat normalized = glm::normalize(rotation);
+		const float components[4] = {normalized.x, normalized.y, normalized.z, normalized.w};
+		unsigned int largest = 0;
+		for (unsigned int i = 1; i < 4; ++i)
+		{
+			if (std::abs(components[i]) > std::abs(components[largest]))
+			{
+				largest = i;
+			}
+		}
+
+		// q and -q are the same rotation, so flip the quaternion to make the dropped component positive
+		const float sign = components[largest] < 0.0f ? -1.0f : 1.0f;
+		unsigned int word = 0;
+		for (unsigned int i = 0; i < 4; ++i)
+		{
+			if (i == largest)
+			{
+				continue;
+			}
+			const float normalizedComponent = (components[i] * sign / rotationComponentMax) * 0.5f + 0.5f;
+			const auto quantized = static_cast<uint16_t>(std::clamp(std::round(normalizedComponent * rotationQuantizedMax), 0.0f, rotationQuantizedMax));
+			valueOut[word++] = static_cast<uint16_t>(quantized << 1);
+		}
+
+		// The index of the dropped component takes the low bit of the first two words
+		valueOut[0] |= largest & 1;
+		valueOut[1] |= (largest >> 1) & 1;
+	}
+
+	CompressedAnimation::KeyInterval CompressedAnimation::FindInterval(const Track& track, const float time, unsigned int* cursor) const
+	{
+		const uint16_t* times = keys.data() + track.firstKey;
+		const uint32_t lastKey = track.keyCount - 1;
+		const float position = time * timeScale;
+		if (lastKey == 0 || position <= times[0])
+		{
+			return {0, 0, 0.0f};
+		}
+		if (position >= times[lastKey])
+		{
+			return {lastKey, lastKey, 0.0f};
+		}
+
+		uint32_t left;
+		if (cursor && *cursor < lastKey && times[*cursor] <= position)
+		{
+			left = *cursor;
+			if (position >= times[left + 1])
+			{
+				++left;
+				if (left < lastKey && position >= times[left + 1])
+				{
+					left = static_cast<uint32_t>(std::upper_bound(times, times + track.keyCount, position) - times) - 1;
+				}
+			}
+		}
+		else
+		{
+			left = static_cast<uint32_t>(std::upper_bound(times, times + track.keyCount, position) - times) - 1;
+		}
+		if (cursor)
+		{
+			*cursor = left;
+		}
+
+		const float interval = static_cast<float>(times[left + 1] - times[left]);
+		const float alpha = interval > 0.0f ? (position - times[left]) / interval : 0.0f;
+		return {left, left + 1, std::clamp(alpha, 0.0f, 1.0f)};
+	}
+
+	glm::quat CompressedAnimation::EvaluateRotation(const Track& track, const KeyInterval& interval) const
+	{
+		const glm::quat left = DecodeRotation(track.firstKey + interval.left);
+		if (interval.left == interval.right)
+		{
+			return left;
+		}
+
+		return glm::slerp(left, DecodeRotation(track.firstKey + interval.right), interval.alpha);
+	}
+
+	glm::vec3 CompressedAnimation::EvaluateVector(const Track& track, const KeyInterval& interval) const
+	{
+		const glm::vec3 left = DecodeVector(track, track.firstKey + interval.left);
+		if (interval.left == interval.right)
+		{
+			return left;
+		}
+
+		return glm::mix(left, DecodeVector(track, track.firstKey + interval.right), interval.alpha);
+	}
+
+	glm::quat CompressedAnimation::DecodeRotation(const uint32_t key) const
+	{
+		const uint16_t* value = keys.data() + keyCount + key * valueComponents;
+		const unsigned int largest = (value[0] & 1) | ((value[1] & 1) << 1);
+
+		float components[4];
+		float sumOfSquares = 0.0f;
+		unsigned int word = 0;
+		for (unsigned int i = 0; i < 4; ++i)
+		{
+			if (i == largest)
+			{
+				continue;
+			}
+			const float normalizedComponent = static_cast<float>(value[word++] >> 1) / rotationQuantizedMax;
+			components[i] = (normalizedComponent * 2.0f - 1.0f) * rotationComponentMax;
+			sumOfSquares += components[i] * components[i];
+		}
+		components[largest] = std::sqrt(std::max(1.0f - sumOfSquares, 0.0f));
+
+		return {components[3], components[0], components[1], components[2]};
+	}
+
+	glm::vec3 CompressedAnimation::DecodeVector(const Track& track, const uint32_t key) const
+	{
+		const uint16_t* value = keys.data() + keyCount + key * valueComponents;
+		const Range& range = ranges[track.range];
+		return range.min + glm::vec3(value[0], value[1], value[2]) * range.step;
+	}
+}
@@ -0,0 +1,116 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <glm/gtx/quaternion.hpp>
+#include <glm/vec3.hpp>
+
+#include "rendering/skeletal_mesh/AnimationChannel.h"
+
+namespace Vox
+{
+	struct AnimationImportSettings;
+	struct ModelTransform;
+
+	/**
+	 * @brief Every channel of an animation, with the keys that interpolation can rebuild removed, and the rest
+	 * quantized to 16 bits per component
+	 * The key times and values of all tracks share one blob, times first, so sampling a pose reads two contiguous
+	 * arrays. Rotations keep their three smallest components, 48 bits in total, and rebuild the largest one.
+	 * Translations and scales are quantized to the range of their track
+	 */
+	class CompressedAnimation
+	{
+	public:
+		/**
+		 * @param duration length of the animation, key times are quantized to it
+		 */
+		CompressedAnimation(const std::vector<AnimationChannel>& channels, float duration, const AnimationImportSettings& settings);
+
+		void ApplyToNodes(std::vector<ModelTransform>& localTransforms, float time) const;
+
+		/**
+		 * @param cursors one per track, see AnimationChannel::EvaluateRotation
+		 */
+		void ApplyToNodes(std::vector<ModelTransform>& localTransforms, float time, std::vector<unsigned int>& cursors) const;
+
+		/**
+		 * @brief Evaluate one rotation track, tracks are in the same order as the channels they were made from
+		 */
+		[[nodiscard]] glm::quat EvaluateRotation(size_t track, float time) const;
+
+		/**
+		 * @brief Evaluate one translation or scale track
+		 */
+		[[nodiscard]] glm::vec3 EvaluateVector(size_t track, float time) const;
+
+		[[nodiscard]] size_t GetTrackCount() const;
+
+		/**
+		 * @brief Get how many keys were kept, over every track
+		 */
+		[[nodiscard]] size_t GetKeyCount() const;
+
+		/**
+		 * @brief Get the size of the tracks and their keys, in bytes
+		 */
+		[[nodiscard]] size_t GetMemorySize() const;
+
+	private:
+		struct Track
+		{
+			unsigned int node = 0;
+			uint32_t firstKey = 0;
+			uint32_t keyCount = 0;
+
+			// Index into ranges, for translations and scales
+			uint32_t range = 0;
+			AnimationChannel::SamplerType type = AnimationChannel::SamplerType::Error;
+		};
+
+		// Translations and scales are stored as min + value * step
+		struct Range
+		{
+			glm::vec3 min;
+			glm::vec3 step;
+		};
+
+		struct KeyInterval
+		{
+			uint32_t left;
+			uint32_t right;
+			float alpha;
+		};
+
+		/**
+		 * @brief Get the keys to keep, so that interpolating between them stays within the tolerance of the removed keys
+		 */
+		[[nodiscard]] static std::vector<uint32_t> ReduceKeys(const AnimationChannel& channel, const AnimationImportSettings& settings);
+
+		static void EncodeRotation(const glm::quat& rotation, uint16_t* valueOut);
+
+		[[nodiscard]] KeyInterval FindInterval(const Track& track, float time, unsigned int* cursor) const;
+
+		[[nodiscard]] glm::quat EvaluateRotation(const Track& track, const KeyInterval& interval) const;
+
+		[[nodiscard]] glm::vec3 EvaluateVector(const Track& track, const KeyInterval& interval) const;
+
+		[[nodiscard]] glm::quat DecodeRotation(uint32_t key) const;
+
+		[[nodiscard]] glm::vec3 DecodeVector(const Track& track, uint32_t key) const;
+
+		static constexpr size_t valueComponents = 3;
+
+		std::vector<Track> tracks;
+		std::vector<Range> ranges;
+
+		// Every key time, then every key value, valueComponents at a time
+		std::vector<uint16_t> keys;
+		size_t keyCount = 0;
+
+		// Quantized key times per second
+		float timeScale = 0.0f;
+	};
+}
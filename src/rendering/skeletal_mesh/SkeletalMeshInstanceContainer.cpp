@@ -4,18 +4,28 @@
 
 #include "SkeletalMeshInstanceContainer.h"
 
+#include <algorithm>
+
 #include "SkeletalModel.h"
 #include "core/logging/Logging.h"
 #include "core/services/FileIOService.h"
 #include "core/services/ServiceLocator.h"
+#include "core/services/ThreadPool.h"
+#include "rendering/buffers/JointPaletteBuffer.h"
+#include "rendering/camera/Frustum.h"
+#include "rendering/shaders/pixel_shaders/mesh_shaders/PickShader.h"
 
 namespace Vox
 {
     SkeletalMeshInstanceContainer::SkeletalMeshInstanceContainer(SceneRenderer* owner, const size_t size, const std::shared_ptr<SkeletalModel>& mesh)
-        :owner(owner), mesh(mesh), meshInstances(size)
+        :owner(owner), mesh(mesh), meshInstances(size), paletteBuffer(std::make_unique<JointPaletteBuffer>())
     {
     }
 
+    SkeletalMeshInstanceContainer::~SkeletalMeshInstanceContainer() = default;
+
+    SkeletalMeshInstanceContainer::SkeletalMeshInstanceContainer(SkeletalMeshInstanceContainer&&) noexcept = default;
+
     bool SkeletalMeshInstanceContainer::LoadMesh(const std::string& filepath)
     {
         if (mesh)
@@ -28,21 +38,76 @@ namespace Vox
         return true;
     }
 
-    void SkeletalMeshInstanceContainer::Render(MaterialShader* shader)
+    void SkeletalMeshInstanceContainer::UpdateVisibility(const Frustum& frustum)
+    {
+        culler.Clear();
+        culledInstances.clear();
+        for (auto meshInstance = meshInstances.begin(); meshInstance != meshInstances.end(); ++meshInstance)
+        {
+            if (meshInstance->has_value())
+            {
+                culler.Add(GetInstanceBounds(**meshInstance));
+                culledInstances.emplace_back(meshInstance - meshInstances.begin());
+            }
+        }
+
+        visibleInstances.clear();
+        for (const uint32_t index : culler.Cull(frustum))
+        {
+            visibleInstances.emplace_back(culledInstances[index]);
+        }
+    }
+
+    void SkeletalMeshInstanceContainer::UpdatePoses()
+    {
+        const auto instanceCount = static_cast<size_t>(meshInstances.end() - meshInstances.begin());
+        if (poses.size() < instanceCount)
+        {
+            poses.resize(instanceCount);
+        }
+
+        // Poses only read the model, and each instance writes its own pose
+        ServiceLocator::GetThreadPool()->ParallelFor(visibleInstances.size(), [this](const size_t palette)
+        {
+            const size_t index = visibleInstances[palette];
+            const std::optional<SkeletalMeshInstance>& meshInstance = *(meshInstances.begin() + index);
+            if (meshInstance.has_value())
+            {
+                mesh->EvaluatePose(meshInstance->GetAnimationIndex(), meshInstance->GetAnimationTime(), poses[index]);
+            }
+        });
+
+        paletteBuffer->Upload(poses, visibleInstances);
+    }
+
+    void SkeletalMeshInstanceContainer::Enqueue(RenderQueue& queue, const RenderPass pass, const uint32_t shader) const
     {
-        for (std::optional<SkeletalMeshInstance>& meshInstance : meshInstances)
+        if (visibleInstances.empty())
+        {
+            return;
+        }
+
+        const uint32_t firstMaterial = queue.AddMaterials(mesh->GetMaterials());
+        for (size_t palette = 0; palette < visibleInstances.size(); ++palette)
         {
+            // Instances can be removed between culling and rendering
+            const std::optional<SkeletalMeshInstance>& meshInstance = *(meshInstances.begin() + visibleInstances[palette]);
             if (meshInstance.has_value())
             {
-                mesh->Render(shader, meshInstance->GetTransform(), meshInstance->GetAnimationIndex(), meshInstance->GetAnimationTime());
+                mesh->Enqueue(queue, pass, shader, AddPalette(queue, palette), firstMaterial, queue.AddTransform(meshInstance->GetTransform()));
             }
         }
     }
 
-    void SkeletalMeshInstanceContainer::RenderInstance(const MeshShader* shader,
+    void SkeletalMeshInstanceContainer::EnqueueInstance(RenderQueue& queue, const RenderPass pass, const uint32_t shader,
         const SkeletalMeshInstance& meshInstance) const
     {
-        mesh->Render(shader, meshInstance.GetTransform(), meshInstance.GetAnimationIndex(), meshInstance.GetAnimationTime());
+        size_t palette = 0;
+        if (GetPalette(meshInstance, palette))
+        {
+            const uint32_t firstMaterial = queue.AddMaterials(mesh->GetMaterials());
+            mesh->Enqueue(queue, pass, shader, AddPalette(queue, palette), firstMaterial, queue.AddTransform(meshInstance.GetTransform()));
+        }
     }
 
     const std::vector<Animation>& SkeletalMeshInstanceContainer::GetAnimations() const
@@ -51,13 +116,19 @@ namespace Vox
     }
 
 #ifdef EDITOR
-    void SkeletalMeshInstanceContainer::Render(const PickShader* shader)
+    void SkeletalMeshInstanceContainer::EnqueuePick(RenderQueue& queue, const uint32_t shader, const PickShader* pickShader) const
     {
-        for (std::optional<SkeletalMeshInstance>& meshInstance : meshInstances)
+        for (size_t palette = 0; palette < visibleInstances.size(); ++palette)
         {
+            const std::optional<SkeletalMeshInstance>& meshInstance = *(meshInstances.begin() + visibleInstances[palette]);
             if (meshInstance.has_value())
             {
-                mesh->Render(shader, meshInstance->GetTransform(), meshInstance->GetPickId(), meshInstance->GetAnimationIndex(), meshInstance->GetAnimationTime());
+                const uint32_t instances = queue.AddInstances([buffer = paletteBuffer.get(), palette, pickShader, pickId = meshInstance->GetPickId()]
+                {
+                    buffer->Bind(palette);
+                    pickShader->SetObjectId(pickId);
+                });
+                mesh->Enqueue(queue, RenderPass::Pick, shader, instances, 0, queue.AddTransform(meshInstance->GetTransform()));
             }
         }
     }
@@ -72,4 +143,32 @@ namespace Vox
     {
         return owner;
     }
+
+    BoundingBox SkeletalMeshInstanceContainer::GetInstanceBounds(const SkeletalMeshInstance& meshInstance) const
+    {
+        return mesh->GetBounds().GetTransformed(meshInstance.GetTransform());
+    }
+
+    uint32_t SkeletalMeshInstanceContainer::AddPalette(RenderQueue& queue, const size_t palette) const
+    {
+        return queue.AddInstances([buffer = paletteBuffer.get(), palette]
+        {
+            buffer->Bind(palette);
+        });
+    }
+
+    bool SkeletalMeshInstanceContainer::GetPalette(const SkeletalMeshInstance& meshInstance, size_t& paletteOut) const
+    {
+        const auto visibleInstance = std::ranges::find_if(visibleInstances, [this, &meshInstance](const size_t index)
+        {
+            const std::optional<SkeletalMeshInstance>& storedInstance = *(meshInstances.begin() + index);
+            return storedInstance.has_value() && &*storedInstance == &meshInstance;
+        });
+        if (visibleInstance == visibleInstances.end() || static_cast<size_t>(visibleInstance - visibleInstances.begin()) >= paletteBuffer->GetPaletteCount())
+        {
+            return false;
+        }
+        paletteOut = static_cast<size_t>(visibleInstance - visibleInstances.begin());
+        return true;
+    }
 } // Vox
\ No newline at end of file
@@ -5,17 +5,22 @@
 #pragma once
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "Animation.h"
 #include "SkeletalMeshInstance.h"
+#include "SkeletalPose.h"
 #include "core/datatypes/ObjectContainer.h"
 #include "core/datatypes/Ref.h"
+#include "core/math/BoundingBox.h"
+#include "rendering/FrustumCuller.h"
+#include "rendering/RenderQueue.h"
 
 namespace Vox
 {
     class SceneRenderer;
-    class MaterialShader;
-    class MeshShader;
+    struct Frustum;
+    class JointPaletteBuffer;
     class PickShader;
     class SkeletalModel;
 
@@ -23,17 +28,45 @@ namespace Vox
     {
     public:
         SkeletalMeshInstanceContainer(SceneRenderer* owner, size_t size, const std::shared_ptr<SkeletalModel>& mesh);
+        ~SkeletalMeshInstanceContainer();
+
+        SkeletalMeshInstanceContainer(SkeletalMeshInstanceContainer&&) noexcept;
+        SkeletalMeshInstanceContainer(const SkeletalMeshInstanceContainer&) = delete;
+        SkeletalMeshInstanceContainer& operator=(SkeletalMeshInstanceContainer&&) = delete;
+        SkeletalMeshInstanceContainer& operator=(const SkeletalMeshInstanceContainer&) = delete;
 
         bool LoadMesh(const std::string& filepath);
 
-        void Render(MaterialShader* shader);
+        /**
+         * @brief Cull the instances against the frustum. Enqueue only draws the instances that passed,
+         * until this is called again
+         */
+        void UpdateVisibility(const Frustum& frustum);
+
+        /**
+         * @brief Evaluate the pose of every visible instance across the thread pool, then upload all of their
+         * joint palettes at once. Every pass this frame draws with these poses. Has to be called after UpdateVisibility
+         */
+        void UpdatePoses();
+
+        /**
+         * @brief Queue every instance that passed culling, each with its own joint palette
+         */
+        void Enqueue(RenderQueue& queue, RenderPass pass, uint32_t shader) const;
 
-        void RenderInstance(const MeshShader* shader, const SkeletalMeshInstance& meshInstance) const;
+        /**
+         * @brief Queue a single instance, for passes that only draw a few instances like outlines
+         */
+        void EnqueueInstance(RenderQueue& queue, RenderPass pass, uint32_t shader, const SkeletalMeshInstance& meshInstance) const;
 
         [[nodiscard]] const std::vector<Animation>& GetAnimations() const;
 
 #ifdef EDITOR
-        void Render(const PickShader* shader);
+        /**
+         * @brief Queue every instance that passed culling into the pick pass. Skeletal meshes aren't instanced,
+         * so the pick id is set along with each joint palette
+         */
+        void EnqueuePick(RenderQueue& queue, uint32_t shader, const PickShader* pickShader) const;
 #endif
 
         Ref<SkeletalMeshInstance> CreateMeshInstance();
@@ -42,9 +75,32 @@ namespace Vox
 
         [[nodiscard]] SceneRenderer* GetOwner() const;
 
+        [[nodiscard]] BoundingBox GetInstanceBounds(const SkeletalMeshInstance& meshInstance) const;
+
     private:
+        /**
+         * @brief Add the binding of a joint palette to the queue
+         */
+        [[nodiscard]] uint32_t AddPalette(RenderQueue& queue, size_t palette) const;
+
+        /**
+         * @brief Find the palette of a visible instance, so it can be drawn on its own
+         */
+        bool GetPalette(const SkeletalMeshInstance& meshInstance, size_t& paletteOut) const;
+
         SceneRenderer* owner;
         std::shared_ptr<SkeletalModel> mesh;
         ObjectContainer<SkeletalMeshInstance> meshInstances;
+
+        FrustumCuller culler;
+
+        // Indices into meshInstances, of every instance given to the culler, then of the ones that passed
+        std::vector<size_t> culledInstances;
+        std::vector<size_t> visibleInstances;
+
+        // One per instance, in the same order as meshInstances. Kept between frames, so evaluating doesn't allocate
+        // and each instance's key cursors pick up where the last frame left them
+        std::vector<SkeletalPose> poses;
+        std::unique_ptr<JointPaletteBuffer> paletteBuffer;
     };
 }
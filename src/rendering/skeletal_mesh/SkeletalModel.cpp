@@ -1,5 +1,6 @@
 #include "SkeletalModel.h"
 
+#include <algorithm>
 #include <ranges>
 
 #include <fmt/format.h>
@@ -9,19 +10,16 @@
 #include <tiny_gltf.h>
 
 #include "core/logging/Logging.h"
-#include "rendering/shaders/Shader.h"
-#include "rendering/shaders/pixel_shaders/mesh_shaders/MaterialShader.h"
-#include "rendering/shaders/pixel_shaders/mesh_shaders/PickShader.h"
+#include "rendering/mesh/Primitive.h"
 
 namespace Vox
 {
-	SkeletalModel::SkeletalModel(const std::string& filepath)
+	SkeletalModel::SkeletalModel(const std::string& filepath, const AnimationImportSettings& animationSettings)
 	{
 		tinygltf::TinyGLTF loader;
 		std::string err;
 		std::string warn;
 		tinygltf::Model model;
-	    matrixBuffer = 0;
 		loader.LoadBinaryFromFile(&model, &err, &warn, filepath);
 
 		std::vector<unsigned int> meshBuffers = GetMeshBuffers(model);
@@ -37,13 +35,22 @@ namespace Vox
 			glNamedBufferData(bufferIds[i], static_cast<int>(bufferView.byteLength), model.buffers[bufferView.buffer].data.data() + bufferView.byteOffset, GL_STATIC_DRAW);
 		}
 
-		// Allocate space for up to 'maxMatrixCount' matrix objects in our UBO
-		glCreateBuffers(1, &matrixBuffer);
-		glNamedBufferStorage(matrixBuffer, sizeof(glm::mat4x4) * maxMatrixCount, nullptr, GL_DYNAMIC_STORAGE_BIT);
-
 		for (const tinygltf::Animation& animation : model.animations)
 		{
-			animations.emplace_back(animation, model);
+			animations.emplace_back(animation, model, animationSettings);
+		}
+
+		if (animationSettings.compress)
+		{
+			size_t uncompressedSize = 0;
+			size_t compressedSize = 0;
+			for (const Animation& animation : animations)
+			{
+				uncompressedSize += animation.GetUncompressedMemorySize();
+				compressedSize += animation.GetMemorySize();
+			}
+			VoxLog(Display, Rendering, "Compressed skeletal mesh animations from {:.1f} KiB to {:.1f} KiB.",
+				static_cast<float>(uncompressedSize) / 1024.0f, static_cast<float>(compressedSize) / 1024.0f);
 		}
 
 		// Log our loaded animation names
@@ -180,13 +187,28 @@ namespace Vox
 				newPrimitive.componentType = model.accessors[primitive.indices].componentType;
 				newPrimitive.materialIndex = primitive.material;
 				newMesh.emplace_back(primitives.size() - 1);
+
+				// Skinned positions are already in model space, so the node transforms don't apply
+				const BoundingBox primitiveBounds = Primitive::GetPositionBounds(model, positionBuffer->second);
+				if (!primitiveBounds.IsEmpty())
+				{
+					bounds.Expand(primitiveBounds);
+				}
 			}
 		}
 
-		for (const unsigned int node : rootNodes)
+		if (joints.size() > SkeletalPose::maxJointCount)
+		{
+			VoxLog(Warning, Rendering, "Skeletal model has {} joints, only the first {} will be animated.", joints.size(), SkeletalPose::maxJointCount);
+		}
+
+		if (bounds.IsEmpty())
 		{
-			UpdateTransforms(node, glm::identity<glm::mat4x4>());
+			bounds = BoundingBox(glm::vec3(0.0f), glm::vec3(0.0f));
 		}
+		// Animations can move vertices outside of the bind pose, there's no cheap way to know how far
+		const glm::vec3 padding = (bounds.max - bounds.min) * animationBoundsPadding;
+		bounds = BoundingBox(bounds.min - padding, bounds.max + padding);
 
 		const size_t separatorLocation = filepath.rfind('/') + 1;
 		VoxLog(Display, Rendering, "Successfully loaded model '{}' with {} primitives.", filepath.substr(separatorLocation, filepath.size() - separatorLocation), primitives.size());
@@ -197,95 +219,68 @@ namespace Vox
 		glDeleteBuffers(static_cast<int>(bufferIds.size()), bufferIds.data());
 	}
 
-	void SkeletalModel::Render(const MaterialShader* shader, const glm::mat4x4& transform, unsigned int animationIndex, float animationTime)
-	{
-		SetAnimation(animationIndex, animationTime);
-
-		glBindBufferRange(GL_UNIFORM_BUFFER, 0, matrixBuffer, 0, nodes.size() * sizeof(glm::mat4x4));
-
-		for (const SkeletalPrimitive& primitive : primitives)
-		{
-		    shader->SetMaterial(materials[primitive.materialIndex]);
-			shader->SetModelMatrix(transform);
-
-			glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, primitive.indexBuffer);
-			glBindVertexBuffer(0, primitive.positionBuffer, 0, sizeof(float) * 3);
-			glBindVertexBuffer(1, primitive.normalBuffer, 0, sizeof(float) * 3);
-			glBindVertexBuffer(2, primitive.uvBuffer, 0, sizeof(float) * 2);
-			glBindVertexBuffer(3, primitive.jointsBuffer, 0, sizeof(unsigned char) * 4);
-			glBindVertexBuffer(4, primitive.weightsBuffer, 0, sizeof(float) * 4);
-
-			glDrawElements(GL_TRIANGLES, primitive.vertexCount, primitive.componentType, nullptr);
-		}
-	}
-
-    void SkeletalModel::Render(const MeshShader* shader, const glm::mat4x4& transform, unsigned int animationIndex,
-        float animationTime)
-    {
-	    SetAnimation(animationIndex, animationTime);
-
-	    glBindBufferRange(GL_UNIFORM_BUFFER, 0, matrixBuffer, 0, nodes.size() * sizeof(glm::mat4x4));
-
-	    for (const SkeletalPrimitive& primitive : primitives)
-	    {
-	        shader->SetModelMatrix(transform);
-
-	        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, primitive.indexBuffer);
-	        glBindVertexBuffer(0, primitive.positionBuffer, 0, sizeof(float) * 3);
-	        glBindVertexBuffer(1, primitive.normalBuffer, 0, sizeof(float) * 3);
-	        glBindVertexBuffer(2, primitive.uvBuffer, 0, sizeof(float) * 2);
-	        glBindVertexBuffer(3, primitive.jointsBuffer, 0, sizeof(unsigned char) * 4);
-	        glBindVertexBuffer(4, primitive.weightsBuffer, 0, sizeof(float) * 4);
-
-	        glDrawElements(GL_TRIANGLES, primitive.vertexCount, primitive.componentType, nullptr);
-	    }
-    }
-
-#ifdef EDITOR
-    void SkeletalModel::Render(const PickShader* shader, const glm::mat4x4& transform, unsigned int objectId,
-        unsigned int animationIndex, float animationTime)
+    void SkeletalModel::Enqueue(RenderQueue& queue, const RenderPass pass, const uint32_t shader, const uint32_t instances,
+        const uint32_t firstMaterial, const uint32_t transform) const
     {
 	    for (const SkeletalPrimitive& primitive : primitives)
 	    {
-	        shader->SetModelMatrix(transform);
-            shader->SetObjectId(objectId);
-
-	        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, primitive.indexBuffer);
-	        glBindVertexBuffer(0, primitive.positionBuffer, 0, sizeof(float) * 3);
-	        glBindVertexBuffer(1, primitive.normalBuffer, 0, sizeof(float) * 3);
-	        glBindVertexBuffer(2, primitive.uvBuffer, 0, sizeof(float) * 2);
-	        glBindVertexBuffer(3, primitive.jointsBuffer, 0, sizeof(unsigned char) * 4);
-	        glBindVertexBuffer(4, primitive.weightsBuffer, 0, sizeof(float) * 4);
-
-	        glDrawElements(GL_TRIANGLES, primitive.vertexCount, primitive.componentType, nullptr);
+	        DrawGeometry geometry;
+	        geometry.indexBuffer = primitive.indexBuffer;
+	        geometry.indexType = primitive.componentType;
+	        geometry.indexCount = primitive.vertexCount;
+	        geometry.vertexBuffers = {primitive.positionBuffer, primitive.normalBuffer, primitive.uvBuffer, primitive.jointsBuffer, primitive.weightsBuffer};
+	        geometry.vertexStrides = {sizeof(float) * 3, sizeof(float) * 3, sizeof(float) * 2, sizeof(unsigned char) * 4, sizeof(float) * 4};
+	        geometry.vertexBufferCount = 5;
+
+	        DrawCommand command;
+	        command.shader = shader;
+	        command.instances = instances;
+	        command.material = firstMaterial + primitive.materialIndex;
+	        command.geometry = queue.AddGeometry(geometry);
+	        command.transform = transform;
+	        queue.Add(pass, command);
 	    }
     }
-#endif
 
-    void SkeletalModel::SetAnimation(unsigned int animationIndex, float time)
+    void SkeletalModel::EvaluatePose(const unsigned int animationIndex, const float time, SkeletalPose& poseOut) const
 	{
-	    if (animationIndex >= animations.size())
-	    {
-            VoxLog(Error, Rendering, "Could not find animation at index '{}' for mesh.", animationIndex);
-	        return;
-	    }
-		animations[animationIndex].ApplyToNodes(nodes, time);
+		// Start from the bind pose every time, so nodes the animation doesn't touch don't keep another animation's transforms
+		poseOut.localTransforms.resize(nodes.size());
+		for (size_t i = 0; i < nodes.size(); ++i)
+		{
+			poseOut.localTransforms[i] = nodes[i].localTransform;
+		}
+		if (animationIndex < animations.size())
+		{
+			const Animation& animation = animations[animationIndex];
+			if (poseOut.cursorAnimation != animationIndex || poseOut.keyCursors.size() != animation.GetChannelCount())
+			{
+				poseOut.keyCursors.assign(animation.GetChannelCount(), 0);
+				poseOut.cursorAnimation = animationIndex;
+			}
+			animation.ApplyToNodes(poseOut.localTransforms, time, poseOut.keyCursors);
+		}
 
+		poseOut.globalTransforms.resize(nodes.size());
 		for (const unsigned int node : rootNodes)
 		{
-			UpdateTransforms(node, glm::identity<glm::mat4x4>());
+			UpdatePoseTransforms(node, glm::identity<glm::mat4x4>(), poseOut);
 		}
 
 		// @TODO: handle multiple skins -- even if blender doesn't necessarily export these
-		std::vector<glm::mat4x4> transforms;
-		for (int i = 0; i < joints.size(); ++i)
+		const size_t jointCount = std::min(joints.size(), SkeletalPose::maxJointCount);
+		poseOut.jointMatrices.resize(jointCount);
+		for (size_t i = 0; i < jointCount; ++i)
 		{
-			ModelNode& node = nodes[joints[i]];
-			transforms.emplace_back(node.globalTransform * node.inverseBindMatrix);
+			poseOut.jointMatrices[i] = poseOut.globalTransforms[joints[i]] * nodes[joints[i]].inverseBindMatrix;
 		}
-		glNamedBufferSubData(matrixBuffer, 0, transforms.size() * sizeof(glm::mat4x4), transforms.data());
 	}
 
+    const BoundingBox& SkeletalModel::GetBounds() const
+    {
+        return bounds;
+    }
+
     bool SkeletalModel::GetAnimationIndex(const std::string& animationName, unsigned int& animationIndexOut) const
     {
 	    auto animationLookup = std::ranges::find_if(animations.begin(), animations.end(),
@@ -303,6 +298,11 @@ namespace Vox
 		return animations;
 	}
 
+    const std::vector<PBRMaterial>& SkeletalModel::GetMaterials() const
+    {
+        return materials;
+    }
+
 	ModelTransform SkeletalModel::CalculateNodeTransform(const tinygltf::Node& node)
     {
 		ModelTransform transform;
@@ -336,19 +336,18 @@ namespace Vox
 		return transform;
 	}
 
-	void SkeletalModel::UpdateTransforms(const unsigned int nodeIndex, const glm::mat4x4& transform)
+	void SkeletalModel::UpdatePoseTransforms(const unsigned int nodeIndex, const glm::mat4x4& transform, SkeletalPose& pose) const
 	{
 		if (nodeIndex >= nodes.size())
 		{
 			return;
 		}
 
-		ModelNode& node = nodes[nodeIndex];
-		node.globalTransform = transform * node.localTransform.GetMatrix();
+		pose.globalTransforms[nodeIndex] = transform * pose.localTransforms[nodeIndex].GetMatrix();
 
-		for (const int updatedNodeIndex : node.children)
+		for (const int childIndex : nodes[nodeIndex].children)
 		{
-			UpdateTransforms(updatedNodeIndex, node.globalTransform);
+			UpdatePoseTransforms(childIndex, pose.globalTransforms[nodeIndex], pose);
 		}
 	}
 
@@ -5,10 +5,14 @@
 
 #include <glm/mat4x4.hpp>
 
+#include "core/math/BoundingBox.h"
 #include "rendering/PBRMaterial.h"
+#include "rendering/RenderQueue.h"
 #include "rendering/mesh/ModelNode.h"
 #include "rendering/skeletal_mesh/Animation.h"
 #include "rendering/skeletal_mesh/AnimationChannel.h"
+#include "rendering/skeletal_mesh/AnimationImportSettings.h"
+#include "rendering/skeletal_mesh/SkeletalPose.h"
 #include "rendering/skeletal_mesh/SkeletalPrimitive.h"
 
 namespace tinygltf
@@ -19,45 +23,52 @@ namespace tinygltf
 
 namespace Vox
 {
-	class Shader;
-    class MaterialShader;
-    class MeshShader;
-    class PickShader;
-
 	class SkeletalModel
 	{
 	public:
-		explicit SkeletalModel(const std::string& filepath);
+		/**
+		 * @param animationSettings how the animations are resampled and compressed, the defaults keep the keys as they are
+		 */
+		explicit SkeletalModel(const std::string& filepath, const AnimationImportSettings& animationSettings = {});
 		~SkeletalModel();
 
 		SkeletalModel(const SkeletalModel&) = delete;
 		SkeletalModel& operator=(SkeletalModel&&) = delete;
 
-		void Render(const MaterialShader* shader, const glm::mat4x4& transform, unsigned int animationIndex, float animationTime);
-
-		void Render(const MeshShader* shader, const glm::mat4x4& transform, unsigned int animationIndex, float animationTime);
+		/**
+		 * @brief Queue a draw of each primitive for one instance
+		 * @param instances handle of the instance's joint palette binding in the queue
+		 * @param firstMaterial handle of our first material in the queue's material table
+		 * @param transform handle of the instance transform in the queue
+		 */
+		void Enqueue(RenderQueue& queue, RenderPass pass, uint32_t shader, uint32_t instances, uint32_t firstMaterial, uint32_t transform) const;
 
-#ifdef EDITOR
-	    void Render(const PickShader* shader, const glm::mat4x4& transform, unsigned int objectId, unsigned int animationIndex, float animationTime);
-#endif
-
-		void SetAnimation(unsigned int animationIndex, float time);
+		/**
+		 * @brief Evaluate an animation at a time into a pose. Only reads the model, so the poses of different
+		 * instances can be evaluated in parallel. Invalid animation indices give the bind pose
+		 */
+		void EvaluatePose(unsigned int animationIndex, float time, SkeletalPose& poseOut) const;
 
 	    bool GetAnimationIndex(const std::string& animationName, unsigned int& animationIndexOut) const;
 
 		[[nodiscard]] const std::vector<Animation>& GetAnimations() const;
 
+	    [[nodiscard]] const std::vector<PBRMaterial>& GetMaterials() const;
+
+	    /**
+	     * @brief Get the bind pose bounds in model space, padded so animations stay inside them
+	     */
+	    [[nodiscard]] const BoundingBox& GetBounds() const;
+
 	private:
 		[[nodiscard]] static ModelTransform CalculateNodeTransform(const tinygltf::Node& node);
 
-		void UpdateTransforms(unsigned int node, const glm::mat4x4& transform);
+		void UpdatePoseTransforms(unsigned int node, const glm::mat4x4& transform, SkeletalPose& pose) const;
 
 		[[nodiscard]] static std::vector<unsigned int> GetMeshBuffers(const tinygltf::Model& model);
 
 		std::vector<unsigned int> bufferIds;
 
-		unsigned int matrixBuffer;
-
 		// store our mesh map separately, so our meshes can be iterated faster
 		std::vector<std::vector<unsigned int>> meshes;
 
@@ -74,6 +85,9 @@ namespace Vox
 
 		std::vector<int> joints;
 
-		static constexpr unsigned int maxMatrixCount = 64;
+		BoundingBox bounds;
+
+		// How far the bind pose bounds are grown on each side, relative to their size
+		static constexpr float animationBoundsPadding = 0.25f;
 	};
 }
\ No newline at end of file
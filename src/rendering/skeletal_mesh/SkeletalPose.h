@@ -0,0 +1,30 @@
+#pragma once
+
+#include <vector>
+
+#include <glm/mat4x4.hpp>
+
+#include "core/datatypes/Transform.h"
+
+namespace Vox
+{
+	/**
+	 * @brief The animated state of one skeletal mesh instance for one frame
+	 */
+	struct SkeletalPose
+	{
+		// Has to match the size of the joint array in skeletalMesh.vert
+		static constexpr size_t maxJointCount = 64;
+
+		// Per node, kept between evaluations so they don't allocate every frame
+		std::vector<ModelTransform> localTransforms;
+		std::vector<glm::mat4x4> globalTransforms;
+
+		// Skinning matrices, in the order of the skin's joints
+		std::vector<glm::mat4x4> jointMatrices;
+
+		// The key each channel of cursorAnimation was last evaluated at, so the next frame can start from there
+		std::vector<unsigned int> keyCursors;
+		unsigned int cursorAnimation = 0;
+	};
+}
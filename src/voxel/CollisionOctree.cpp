@@ -2,6 +2,7 @@
 // Don't use bindings with unions!!!
 #include "CollisionOctree.h"
 
+#include <algorithm>
 #include <cassert>
 #include <cstring>
 #include <cmath>
@@ -14,270 +15,69 @@
 
 namespace Octree
 {
+	namespace
+	{
+		char PhysicsVoxelToChar(const PhysicsVoxel& voxel)
+		{
+			return static_cast<char>(voxel.solid);
+		}
+
+		PhysicsVoxel CharToPhysicsVoxel(const char c)
+		{
+			return PhysicsVoxel(c != 0);
+		}
+	}
+
 	CollisionNode::CollisionNode(const unsigned int size)
-		:size(size)
+		:tree(size)
 	{
-		assert((size & (size - 1)) == 0);
-		state = State::Empty;
 	}
 
-	CollisionNode::CollisionNode(const unsigned int size, const PhysicsVoxel& voxel)
-		:CollisionNode(size)
+	CollisionNode::CollisionNode(const unsigned int size, const PhysicsVoxel* voxels)
+		:tree(size, voxels)
 	{
-	    // Size must be power of 2
-		assert((size & (size - 1)) == 0);
+	}
 
-		subNodes[0] = std::make_unique<PhysicsVoxel>(voxel);
-		state = State::Full;
+	CollisionNode::CollisionNode(const unsigned int size, const Voxel* voxels)
+		:tree(size, voxels, [](const Voxel& voxel) { return PhysicsVoxel(voxel.materialId != 0); })
+	{
 	}
 
 	CollisionNode::~CollisionNode()
 	= default;
 
     CollisionNode::CollisionNode(CollisionNode&& other) noexcept
-    {
-        state = other.state;
-        size = other.size;
-        subNodes = std::move(other.subNodes);
-    }
+	= default;
 
     CollisionNode& CollisionNode::operator=(CollisionNode&& other) noexcept
-    {
-        state = other.state;
-        size = other.size;
-        subNodes = std::move(other.subNodes);
-        return *this;
-    }
+	= default;
 
     unsigned short CollisionNode::GetSize() const
 	{
-		return size;
+		return tree.GetSize();
 	}
 
-	PhysicsVoxel* CollisionNode::GetVoxel(const int x, const int y, const int z) const // NOLINT(*-no-recursion)
+	const PhysicsVoxel* CollisionNode::GetVoxel(const int x, const int y, const int z) const
     {
-		const int halfSize = size / 2;
-	    assert(x >= -halfSize && x < halfSize && y >= -halfSize && y < halfSize && z >= -halfSize && z < halfSize);
-
-		switch (state)
-		{
-		case State::Empty:
-			return nullptr;
-
-		case State::Full:
-			return std::get<std::unique_ptr<PhysicsVoxel>>(subNodes[0]).get();
-
-		case State::Partial:
-		{
-			// Access the elements directly if we're at the smallest size
-			if (size == 2)
-			{
-				return std::get<std::unique_ptr<PhysicsVoxel>>(GetAccessor(x, y, z)).get();
-			}
-
-			const int half = size / 4;
-			const int subX = x + (x < 0 ? half : -half);
-			const int subY = y + (y < 0 ? half : -half);
-			const int subZ = z + (z < 0 ? half : -half);
-			return std::get<std::unique_ptr<CollisionNode>>(GetAccessor(x, y, z))->GetVoxel(subX, subY, subZ);
-		}
-		}
-
-		return nullptr;
+		return tree.GetData(x, y, z);
 	}
 
-	void CollisionNode::SetVoxel(const int x, const int y, const int z, const PhysicsVoxel& voxel) // NOLINT(*-no-recursion)
+	void CollisionNode::SetVoxel(const int x, const int y, const int z, const PhysicsVoxel& voxel)
 	{
-		const int halfSize = size / 2;
-	    assert(x >= -halfSize && x < halfSize && y >= -halfSize && y < halfSize && z >= -halfSize && z < halfSize);
-
-		if (size == 2)
-		{
-			switch (state)
-			{
-			case State::Empty:
-			{
-				// We don't have any nodes so allocate new voxels
-                // ReSharper disable once CppUseStructuredBinding -- Can't use this with unions
-                for (auto& subNode : subNodes)
-				{
-				    subNode = std::make_unique<PhysicsVoxel>();
-				}
-
-			    GetAccessor(x, y, z) = std::make_unique<PhysicsVoxel>(voxel);
-				state = State::Partial;
-				return;
-			}
-
-			case State::Full:
-			{
-			    const auto currentVoxel = *std::get<std::unique_ptr<PhysicsVoxel>>(subNodes[0]);
-                if (currentVoxel == voxel)
-				{
-					return;
-				}
-
-			    for (auto& node : subNodes)
-			    {
-			        node = std::make_unique<PhysicsVoxel>(currentVoxel);
-			    }
-
-				GetAccessor(x, y, z) = std::make_unique<PhysicsVoxel>(voxel);
-				state = State::Partial;
-				return;
-			}
-
-			case State::Partial:
-			{
-				// Copy our new voxel into the relevant location
-			    GetAccessor(x, y, z) = std::make_unique<PhysicsVoxel>(voxel);
-
-				// Check if all the voxels are the same
-				bool allSame = true;
-				for (const auto& subNode : subNodes)
-				{
-                    if (const PhysicsVoxel nodeVoxel = *std::get<std::unique_ptr<PhysicsVoxel>>(subNode); nodeVoxel != voxel)
-					{
-						allSame = false;
-						break;
-					}
-				}
-
-				if (allSame)
-				{
-				    if (voxel.solid)
-				    {
-				        state = State::Full;
-				        //subNodes[0] = reinterpret_cast<CollisionNode*>(new PhysicsVoxel(voxel));
-				        for (auto& subNode : subNodes)
-				        {
-				            std::get<std::unique_ptr<PhysicsVoxel>>(subNode).reset();
-				        }
-				        subNodes[0] = std::make_unique<PhysicsVoxel>(voxel);
-				    }
-				    else
-				    {
-				        state = State::Empty;
-				        for (auto& subNode : subNodes)
-				        {
-				            std::get<std::unique_ptr<PhysicsVoxel>>(subNode).reset();
-				        }
-				    }
-				}
-				return;
-			}
-			}
-		}
-
-		switch (state)
-		{
-		case State::Empty:
-		{
-			// Allocate subnodes
-			const int half = size / 4;
-			for (auto& subNode : subNodes)
-			{
-				subNode = std::make_unique<CollisionNode>(size / 2);
-			}
-			const int subX = x + (x < 0 ? half : -half);
-			const int subY = y + (y < 0 ? half : -half);
-			const int subZ = z + (z < 0 ? half : -half);
-
-			std::get<std::unique_ptr<CollisionNode>>(GetAccessor(x, y, z))->SetVoxel(subX, subY, subZ, voxel);
-			state = State::Partial;
-			break;
-		}
-
-		case State::Full:
-		{
-			// The same as empty, but delete our "Full" node representation
-			const PhysicsVoxel& fullVoxel = *std::get<std::unique_ptr<PhysicsVoxel>>(subNodes[0]);
-
-			// This wouldn't change the node -- it should still be full
-			if (fullVoxel == voxel)
-			{
-				return;
-			}
-
-			const int half = size / 4;
-
-			for (auto& subNode : subNodes)
-			{
-				subNode = std::make_unique<CollisionNode>(size / 2, fullVoxel);
-			}
-
-			const int subX = x + (x < 0 ? half : -half);
-			const int subY = y + (y < 0 ? half : -half);
-			const int subZ = z + (z < 0 ? half : -half);
-
-			std::get<std::unique_ptr<CollisionNode>>(GetAccessor(x, y, z))->SetVoxel(subX, subY, subZ, voxel);
-			state = State::Partial;
-			break;
-		}
-
-		case State::Partial:
-		{
-			const int half = size / 4;
-
-			const int subX = x + (x < 0 ? half : -half);
-			const int subY = y + (y < 0 ? half : -half);
-			const int subZ = z + (z < 0 ? half : -half);
-
-			const auto& assignedNode = std::get<std::unique_ptr<CollisionNode>>(GetAccessor(x, y, z));
-			assignedNode->SetVoxel(subX, subY, subZ, voxel);
-
-			// check if the recently assigned node has been collapsed by our assignment
-			if (assignedNode->state == State::Partial)
-			{
-				return;
-			}
-
-			for (const auto& subNode : subNodes)
-			{
-			    auto& collisionNode = std::get<std::unique_ptr<CollisionNode>>(subNode);
-			    if (collisionNode->state != State::Full)
-				{
-					return;
-				}
-
-			    auto& nodeFullVoxel = *std::get<std::unique_ptr<PhysicsVoxel>>(collisionNode->subNodes[0]);
-			    if (nodeFullVoxel != voxel)
-			    {
-			        return;
-			    }
-			}
-			// All nodes are full, and match the voxel we just inserted, collapse
-			CollapseSubnodes(voxel);
-			break;
-		}
-		}
+		tree.SetData(x, y, z, voxel);
 	}
 
 	JPH::Ref<JPH::StaticCompoundShapeSettings> CollisionNode::MakeCompoundShape() const
 	{
 		using namespace JPH;
 		Ref shapeSettings = new StaticCompoundShapeSettings;
-        const std::vector<Cube> cubes = GetCubes();
-        VoxLog(Display, Physics, "Created voxel body with '{}' cubes", cubes.size());
-        for (const Cube& cube : cubes)
+        const std::vector<Box> boxes = GetBoxes();
+        VoxLog(Display, Physics, "Created voxel body with '{}' boxes", boxes.size());
+        for (const Box& box : boxes)
 		{
-			const float cubeHalfExtent = static_cast<float>(cube.size) / 2.0f;
-			if (cube.size == 1)
-			{
-				shapeSettings->AddShape({
-				    static_cast<float>(cube.x) + cubeHalfExtent,
-				    static_cast<float>(cube.y) + cubeHalfExtent,
-				    static_cast<float>(cube.z) + cubeHalfExtent},
-				    Quat::sIdentity(), new BoxShape(Vec3(cubeHalfExtent, cubeHalfExtent, cubeHalfExtent)));
-			}
-			else
-			{
-				shapeSettings->AddShape({
-				    static_cast<float>(cube.x),
-				    static_cast<float>(cube.y),
-				    static_cast<float>(cube.z)},
-				    Quat::sIdentity(), new BoxShape(Vec3(cubeHalfExtent, cubeHalfExtent, cubeHalfExtent)));
-			}
+			const Vec3 corner(static_cast<float>(box.x), static_cast<float>(box.y), static_cast<float>(box.z));
+			const Vec3 halfExtent(static_cast<float>(box.sizeX) / 2.0f, static_cast<float>(box.sizeY) / 2.0f, static_cast<float>(box.sizeZ) / 2.0f);
+			shapeSettings->AddShape(corner + halfExtent, Quat::sIdentity(), new BoxShape(halfExtent));
 		}
 
 		return shapeSettings;
@@ -285,303 +85,161 @@ namespace Octree
 
 	std::vector<Cube> CollisionNode::GetCubes() const
 	{
+		// Cubes are centered on the tree, and cubes larger than a voxel are positioned by their center
 		std::vector<Cube> result;
-		GenerateCubes(0, 0, 0, result);
-		return result;
-	}
-
-	std::vector<char> CollisionNode::GetPacked() const
-	{
-		std::vector<char> result;
-		result.insert(result.begin(), reinterpret_cast<const char*>(&size), reinterpret_cast<const char*>(&size) + sizeof(short));
-
-		AccumulatePacked(result);
-
-		return result;
-	}
-
-	std::shared_ptr<CollisionNode> CollisionNode::FromPacked(const std::vector<char>& data)
-	{
-		unsigned short treeSize = *reinterpret_cast<const unsigned short*>(&data[0]);
-
-		if (treeSize < 2 || (treeSize & (treeSize - 1)) != 0)
-		{
-			VoxLog(Error, Game, "Unpacking octree failed: size constant is not a power of 2.");
-			return nullptr;
-		}
-
-		auto root = std::make_shared<CollisionNode>(treeSize);
-		size_t currentIndex = sizeof(unsigned short);
-		root->Unpack(data, currentIndex);
-		return root;
-	}
-
-	void CollisionNode::GenerateCubes(int x, int y, int z, std::vector<Cube>& cubes) const // NOLINT(*-no-recursion)
-	{
-		switch (state)
-		{
-		case State::Empty:
-		{
-			return;
-		}
-		case State::Full:
-		{
-			cubes.emplace_back(x, y, z, size);
-			return;
-		}
-		case State::Partial:
+		const int halfSize = tree.GetSize() / 2;
+		tree.ForEachFull([&result, halfSize](const unsigned int x, const unsigned int y, const unsigned int z, const unsigned int nodeSize, const PhysicsVoxel& voxel)
 		{
-			if (size == 2)
+			if (!voxel.solid)
 			{
-                const auto* physicsVoxel = std::get<std::unique_ptr<PhysicsVoxel>>(subNodes[0]).get();
-				if (physicsVoxel->solid) { cubes.emplace_back(x - 1, y - 1, z - 1, 1); }
-				physicsVoxel = std::get<std::unique_ptr<PhysicsVoxel>>(subNodes[1]).get();
-				if (physicsVoxel->solid) { cubes.emplace_back(x - 1, y - 1, z, 1); }
-				physicsVoxel = std::get<std::unique_ptr<PhysicsVoxel>>(subNodes[2]).get();
-				if (physicsVoxel->solid) { cubes.emplace_back(x - 1, y, z - 1, 1); }
-				physicsVoxel = std::get<std::unique_ptr<PhysicsVoxel>>(subNodes[3]).get();
-				if (physicsVoxel->solid) { cubes.emplace_back(x - 1, y, z, 1); }
-				physicsVoxel = std::get<std::unique_ptr<PhysicsVoxel>>(subNodes[4]).get();
-				if (physicsVoxel->solid) { cubes.emplace_back(x, y - 1, z - 1, 1); }
-				physicsVoxel = std::get<std::unique_ptr<PhysicsVoxel>>(subNodes[5]).get();
-				if (physicsVoxel->solid) { cubes.emplace_back(x, y - 1, z, 1); }
-				physicsVoxel = std::get<std::unique_ptr<PhysicsVoxel>>(subNodes[6]).get();
-				if (physicsVoxel->solid) { cubes.emplace_back(x, y, z - 1, 1); }
-				physicsVoxel = std::get<std::unique_ptr<PhysicsVoxel>>(subNodes[7]).get();
-				if (physicsVoxel->solid) { cubes.emplace_back(x, y, z, 1); }
-			}
-			else
-			{
-				const unsigned int halfSize = size / 4;
-				std::get<std::unique_ptr<CollisionNode>>(subNodes[0])->GenerateCubes(static_cast<int>(x - halfSize), static_cast<int>(y - halfSize), static_cast<int>(z - halfSize), cubes);
-				std::get<std::unique_ptr<CollisionNode>>(subNodes[1])->GenerateCubes(static_cast<int>(x - halfSize), static_cast<int>(y - halfSize), static_cast<int>(z + halfSize), cubes);
-				std::get<std::unique_ptr<CollisionNode>>(subNodes[2])->GenerateCubes(static_cast<int>(x - halfSize), static_cast<int>(y + halfSize), static_cast<int>(z - halfSize), cubes);
-				std::get<std::unique_ptr<CollisionNode>>(subNodes[3])->GenerateCubes(static_cast<int>(x - halfSize), static_cast<int>(y + halfSize), static_cast<int>(z + halfSize), cubes);
-				std::get<std::unique_ptr<CollisionNode>>(subNodes[4])->GenerateCubes(static_cast<int>(x + halfSize), static_cast<int>(y - halfSize), static_cast<int>(z - halfSize), cubes);
-				std::get<std::unique_ptr<CollisionNode>>(subNodes[5])->GenerateCubes(static_cast<int>(x + halfSize), static_cast<int>(y - halfSize), static_cast<int>(z + halfSize), cubes);
-				std::get<std::unique_ptr<CollisionNode>>(subNodes[6])->GenerateCubes(static_cast<int>(x + halfSize), static_cast<int>(y + halfSize), static_cast<int>(z - halfSize), cubes);
-				std::get<std::unique_ptr<CollisionNode>>(subNodes[7])->GenerateCubes(static_cast<int>(x + halfSize), static_cast<int>(y + halfSize), static_cast<int>(z + halfSize), cubes);
+				return;
 			}
-			return;
-		}
-		}
+			const int offset = nodeSize == 1 ? halfSize : halfSize - static_cast<int>(nodeSize / 2);
+			result.emplace_back(static_cast<int>(x) - offset, static_cast<int>(y) - offset, static_cast<int>(z) - offset, nodeSize);
+		});
+		return result;
 	}
 
-	void CollisionNode::AccumulatePacked(std::vector<char>& data) const // NOLINT(*-no-recursion)
+	std::vector<Box> CollisionNode::GetBoxes() const
 	{
-		if (size == 2)
+		std::vector<Box> result;
+		const int size = tree.GetSize();
+		const int halfSize = size / 2;
+
+		// Expand the full nodes into a dense mask, indexed by [x][y][z] from the lowest corner
+		auto getIndex = [size](const int x, const int y, const int z)
 		{
-			switch (state)
-			{
-			case State::Empty:
+			return (static_cast<size_t>(x) * size + y) * size + z;
+		};
+		std::vector<char> solid(static_cast<size_t>(size) * size * size, 0);
+		bool anySolid = false;
+		bool allSolid = false;
+		tree.ForEachFull([&](const unsigned int x, const unsigned int y, const unsigned int z, const unsigned int nodeSize, const PhysicsVoxel& voxel)
+		{
+			if (!voxel.solid)
 			{
-				data.emplace_back('E');
 				return;
 			}
-			case State::Full:
+			anySolid = true;
+			allSolid = nodeSize == static_cast<unsigned int>(size);
+			if (allSolid)
 			{
-				data.emplace_back('F');
-				const auto& voxel = std::get<std::unique_ptr<PhysicsVoxel>>(subNodes[0]);
-				data.insert(data.end(),
-				    reinterpret_cast<const char*>(voxel.get()),
-				    reinterpret_cast<const char*>(voxel.get()) + sizeof(PhysicsVoxel));
 				return;
 			}
-			case State::Partial:
+			for (unsigned int maskX = x; maskX < x + nodeSize; ++maskX)
 			{
-				data.emplace_back('P');
-				for (const auto& subNode : subNodes)
+				for (unsigned int maskY = y; maskY < y + nodeSize; ++maskY)
 				{
-				    const auto& voxel = std::get<std::unique_ptr<PhysicsVoxel>>(subNode);
-					data.insert(data.end(),
-					reinterpret_cast<const char*>(voxel.get()),
-					reinterpret_cast<const char*>(voxel.get()) + sizeof(PhysicsVoxel));
+					std::fill_n(solid.begin() + static_cast<std::ptrdiff_t>(getIndex(static_cast<int>(maskX), static_cast<int>(maskY), static_cast<int>(z))), nodeSize, 1);
 				}
-				return;
 			}
-			}
-		}
-
-		switch (state)
-		{
-		case State::Empty:
+		});
+		if (!anySolid)
 		{
-			data.emplace_back('E');
-			return;
-		}
-		case State::Full:
-		{
-			data.emplace_back('F');
-			const auto& voxel = std::get<std::unique_ptr<PhysicsVoxel>>(subNodes[0]);
-			data.insert(data.end(),
-			    reinterpret_cast<const char*>(voxel.get()),
-			    reinterpret_cast<const char*>(voxel.get()) + sizeof(PhysicsVoxel));
-			return;
-		}
-		case State::Partial:
-		{
-			data.emplace_back('P');
-			for (const auto& subNode : subNodes)
-			{
-				std::get<std::unique_ptr<CollisionNode>>(subNode)->AccumulatePacked(data);
-			}
-			return;
-		}
+			return result;
 		}
-	}
-
-	void CollisionNode::Unpack(const std::vector<char>& data, size_t& currentIndex) // NOLINT(*-no-recursion)
-	{
-        // ReSharper disable once CppTooWideScopeInitStatement
-        const char currentStateChar = data[currentIndex];
 
-		if (currentStateChar == 'E')
-		{
-			state = State::Empty;
-		}
-		else if (currentStateChar == 'F')
-		{
-			state = State::Full;
-		}
-		else if (currentStateChar == 'P')
+		// A full tree is already a single box
+		if (allSolid)
 		{
-			state = State::Partial;
+			result.emplace_back(-halfSize, -halfSize, -halfSize, size, size, size);
+			return result;
 		}
-		else
-		{
-			VoxLog(Error, Game, "Failure unpacking octree. A node was malformed.");
-			return;
-		}
-		currentIndex++;
 
-		if (size == 2)
+		// Grow each box from its lowest corner, and clear the voxels it covers so later boxes skip them
+		for (int x = 0; x < size; ++x)
 		{
-			switch (state)
+			for (int y = 0; y < size; ++y)
 			{
-			case State::Empty:
-			{
-				std::get<std::unique_ptr<CollisionNode>>(subNodes[0]) = nullptr;
-				return;
-			}
+				for (int z = 0; z < size; ++z)
+				{
+					if (!solid[getIndex(x, y, z)])
+					{
+						continue;
+					}
 
-			case State::Full:
-			{
-				subNodes[0] = std::make_unique<PhysicsVoxel>(*reinterpret_cast<const PhysicsVoxel*>(&data[currentIndex]));
-				currentIndex += sizeof(PhysicsVoxel);
-				return;
-			}
+					int endZ = z + 1;
+					while (endZ < size && solid[getIndex(x, y, endZ)])
+					{
+						++endZ;
+					}
 
-			case State::Partial:
-			{
-				for (auto& subNode: subNodes)
-				{
-				    subNode = std::make_unique<PhysicsVoxel>(*reinterpret_cast<const PhysicsVoxel*>(&data[currentIndex]));
-					currentIndex += sizeof(PhysicsVoxel);
-				}
-				return;
-			}
-			}
-		}
+					auto rowIsSolid = [&](const int rowX, const int rowY)
+					{
+						const auto row = solid.begin() + static_cast<std::ptrdiff_t>(getIndex(rowX, rowY, z));
+						return std::all_of(row, row + (endZ - z), [](const char voxel){ return voxel != 0; });
+					};
 
-		switch (state)
-		{
-		case State::Empty:
-		{
-			std::get<std::unique_ptr<CollisionNode>>(subNodes[0]) = nullptr;
-			return;
-		}
+					int endY = y + 1;
+					while (endY < size && rowIsSolid(x, endY))
+					{
+						++endY;
+					}
 
-		case State::Full:
-		{
-		    subNodes[0]= std::make_unique<PhysicsVoxel>(*reinterpret_cast<const PhysicsVoxel*>(&data[currentIndex]));
-			currentIndex += sizeof(PhysicsVoxel);
-			return;
-		}
+					int endX = x + 1;
+					while (endX < size)
+					{
+						bool sliceIsSolid = true;
+						for (int sliceY = y; sliceY < endY && sliceIsSolid; ++sliceY)
+						{
+							sliceIsSolid = rowIsSolid(endX, sliceY);
+						}
+						if (!sliceIsSolid)
+						{
+							break;
+						}
+						++endX;
+					}
 
-		case State::Partial:
-		{
-			for (auto& subNode : subNodes)
-			{
-				subNode = std::make_unique<CollisionNode>(size / 2);
-				std::get<std::unique_ptr<CollisionNode>>(subNode)->Unpack(data, currentIndex);
-			}
-		}
-		}
-	}
+					for (int boxX = x; boxX < endX; ++boxX)
+					{
+						for (int boxY = y; boxY < endY; ++boxY)
+						{
+							std::fill_n(solid.begin() + static_cast<std::ptrdiff_t>(getIndex(boxX, boxY, z)), endZ - z, 0);
+						}
+					}
 
-	int CollisionNode::GetIndex(const int x, const int y, const int z)
-	{
-		if (x < 0)
-		{
-			if (y < 0)
-			{
-				if (z < 0)
-				{
-					return 0;
-				}
-				else
-				{
-					return 1;
-				}
-			}
-			else
-			{
-				if (z < 0)
-				{
-					return 2;
-				}
-				else
-				{
-					return 3;
-				}
-			}
-		}
-		else
-		{
-			if (y < 0)
-			{
-				if (z < 0)
-				{
-					return 4;
-				}
-				else
-				{
-					return 5;
-				}
-			}
-			else
-			{
-				if (z < 0)
-				{
-					return 6;
-				}
-				else
-				{
-					return 7;
+					result.emplace_back(x - halfSize, y - halfSize, z - halfSize,
+						static_cast<unsigned int>(endX - x), static_cast<unsigned int>(endY - y), static_cast<unsigned int>(endZ - z));
 				}
 			}
 		}
+		return result;
 	}
 
-	CollisionNode::NodeVariant& CollisionNode::GetAccessor(const int x, const int y, const int z)
+	std::vector<char> CollisionNode::GetPacked() const
 	{
-		return subNodes[GetIndex(x, y, z)];
+		// The same nodes as the tree's packed string, after a binary size instead of a text one
+		const unsigned short size = tree.GetSize();
+		const std::string packed = tree.GetPacked(PhysicsVoxelToChar);
+		const size_t nodesStart = packed.find(',') + 1;
+		std::vector<char> result(sizeof(unsigned short) + packed.size() - nodesStart);
+		std::memcpy(result.data(), &size, sizeof(unsigned short));
+		std::copy(packed.begin() + static_cast<std::ptrdiff_t>(nodesStart), packed.end(), result.begin() + sizeof(unsigned short));
+		return result;
 	}
 
-    const CollisionNode::NodeVariant& CollisionNode::GetAccessor(const int x, const int y, const int z) const
-    {
-		return subNodes[GetIndex(x, y, z)];
-    }
-
-    void CollisionNode::CollapseSubnodes(const PhysicsVoxel& voxel)
+	std::shared_ptr<CollisionNode> CollisionNode::FromPacked(const std::vector<char>& data)
 	{
-		for (int i = 1; i < 8; ++i)
+		if (data.size() < sizeof(unsigned short))
 		{
-			std::get<std::unique_ptr<CollisionNode>>(subNodes[i]).reset();
+			VoxLog(Error, Game, "Unpacking octree failed: data is too short.");
+			return nullptr;
 		}
 
-		subNodes[0] = std::make_unique<PhysicsVoxel>(voxel);
-		state = State::Full;
+		unsigned short treeSize;
+		std::memcpy(&treeSize, data.data(), sizeof(unsigned short));
+		const std::string packed = fmt::format("{},", treeSize) + std::string(data.begin() + sizeof(unsigned short), data.end());
+		const std::shared_ptr<Vox::LinearOctree<PhysicsVoxel>> unpackedTree = Vox::LinearOctree<PhysicsVoxel>::FromPacked(packed, CharToPhysicsVoxel);
+		if (!unpackedTree)
+		{
+			VoxLog(Error, Game, "Failure unpacking octree. A node was malformed.");
+			return nullptr;
+		}
+
+		auto root = std::make_shared<CollisionNode>(treeSize);
+		root->tree = std::move(*unpackedTree);
+		return root;
 	}
 
 	PhysicsVoxel::PhysicsVoxel()
@@ -606,4 +264,9 @@ namespace Octree
 		:x(x), y(y), z(z), size(size)
 	{
 	}
+
+	Box::Box(const int x, const int y, const int z, const unsigned int sizeX, const unsigned int sizeY, const unsigned int sizeZ)
+		:x(x), y(y), z(z), sizeX(sizeX), sizeY(sizeY), sizeZ(sizeZ)
+	{
+	}
 }
@@ -1,6 +1,5 @@
 #pragma once
 
-#include <array>
 #include <memory>
 #include <vector>
 
@@ -8,8 +7,9 @@
 #include <Jolt/Jolt.h>
 #include <Jolt/Core/Reference.h>
 #include <Jolt/Physics/Collision/Shape/StaticCompoundShape.h>
-#include <optional>
-#include <variant>
+
+#include "voxel/LinearOctree.h"
+#include "voxel/Voxel.h"
 
 namespace JPH
 {
@@ -26,6 +26,18 @@ namespace Octree
 		unsigned int size;
 	};
 
+	/**
+	 * @brief An axis aligned box of voxels, from merging cubes
+	 */
+	struct Box
+	{
+		Box(int x, int y, int z, unsigned int sizeX, unsigned int sizeY, unsigned int sizeZ);
+
+		// The corner with the lowest coordinates
+		int x, y, z;
+		unsigned int sizeX, sizeY, sizeZ;
+	};
+
 	struct PhysicsVoxel
 	{
 		PhysicsVoxel();
@@ -37,21 +49,27 @@ namespace Octree
 	    bool operator != (const PhysicsVoxel& voxel) const;
 	};
 
+	/**
+	 * @brief The solid voxels of a chunk, for building its collision shape
+	 * Stored as a LinearOctree, so rebuilding the mask reuses one pool of nodes instead of a heap allocation per node
+	 */
 	class CollisionNode
 	{
-		// relevant physics information here
-		enum class State : char
-		{
-			Full,
-			Empty,
-			Partial
-		};
-
-	    using NodeVariant = std::variant<std::unique_ptr<CollisionNode>, std::unique_ptr<PhysicsVoxel>>;
-
 	public:
 		explicit CollisionNode(unsigned int size);
-		CollisionNode(unsigned int size, const PhysicsVoxel& voxel);
+
+		/**
+		 * @brief Build a tree from dense voxels in one bottom-up pass, see LinearOctree
+		 * The tree is the same as one made by calling SetVoxel for every solid voxel
+		 * @param voxels size * size * size voxels, indexed by [x][y][z]
+		 */
+		CollisionNode(unsigned int size, const PhysicsVoxel* voxels);
+
+		/**
+		 * @brief Build a tree from dense chunk voxels, where any voxel with a material is solid
+		 * @param voxels size * size * size voxels, indexed by [x][y][z]
+		 */
+		CollisionNode(unsigned int size, const Voxel* voxels);
 		~CollisionNode();
 
 	    CollisionNode(CollisionNode&& other) noexcept;
@@ -60,7 +78,7 @@ namespace Octree
 
 		[[nodiscard]] unsigned short GetSize() const;
 
-		[[nodiscard]] PhysicsVoxel* GetVoxel(int x, int y, int z) const;
+		[[nodiscard]] const PhysicsVoxel* GetVoxel(int x, int y, int z) const;
 
 		void SetVoxel(int x, int y, int z, const PhysicsVoxel& voxel);
 
@@ -68,26 +86,17 @@ namespace Octree
 
 		[[nodiscard]] std::vector<Cube> GetCubes() const;
 
+		/**
+		 * @brief Cover the solid voxels with boxes, merged greedily along z, then y, then x
+		 * Boxes ignore the octree's node boundaries, so there are usually far fewer of them than cubes
+		 */
+		[[nodiscard]] std::vector<Box> GetBoxes() const;
+
 		[[nodiscard]] std::vector<char> GetPacked() const;
 
 		static std::shared_ptr<CollisionNode> FromPacked(const std::vector<char>& data);
 
 	private:
-		void GenerateCubes(int x, int y, int z, std::vector<Cube>& cubes) const;
-
-		void AccumulatePacked(std::vector<char>& data) const;
-
-		void Unpack(const std::vector<char>& data, size_t& currentIndex);
-
-		static int GetIndex(int x, int y, int z);
-
-		[[nodiscard]] NodeVariant& GetAccessor(int x, int y, int z);
-	    [[nodiscard]] const NodeVariant& GetAccessor(int x, int y, int z) const;
-
-		void CollapseSubnodes(const PhysicsVoxel& voxel);
-
-		std::array<NodeVariant, 8> subNodes;
-		State state;
-		unsigned short size;
+		Vox::LinearOctree<PhysicsVoxel> tree;
 	};
-}
\ No newline at end of file
+}
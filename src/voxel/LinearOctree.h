@@ -0,0 +1,527 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <charconv>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "core/logging/Logging.h"
+#include "core/math/Math.h"
+
+namespace Vox
+{
+    /**
+     * @brief An octree with the same behaviour and packed format as TypedNode, stored as a pool of nodes
+     * Each partial node's children are a block of 8 consecutive nodes in the pool, found by a 32 bit index, and
+     * leaves hold their data inline. Blocks freed when a subtree collapses are reused by the next split, so edits
+     * only allocate when the tree grows past its largest size
+     */
+    template <typename T>
+    class LinearOctree
+    {
+        enum class State : char
+        {
+            Full,
+            Empty,
+            Partial
+        };
+
+        struct Node
+        {
+            // Full nodes, and the voxels of a size 2 partial node
+            T data = T();
+
+            // The first of 8 child nodes, for partial nodes
+            uint32_t children = 0;
+
+            State state = State::Empty;
+        };
+
+        using TypeToChar = std::function<char(const T&)>;
+        using CharToType = std::function<T(char)>;
+
+        public:
+            explicit LinearOctree(unsigned int size);
+
+            /**
+             * @brief Build a tree from dense voxels in one bottom-up pass, visiting them in Z-order
+             * Voxels equal to T() are left unset, so the tree is the same as one made by calling SetData for every
+             * other voxel, without splitting and collapsing nodes along the way
+             * @param voxels size * size * size voxels, indexed by [x][y][z]
+             */
+            LinearOctree(unsigned int size, const T* voxels);
+
+            /**
+             * @brief Build a tree from dense voxels of another type, converting each voxel as it is visited
+             * This is the same bottom-up pass, so callers don't need a converted copy of the voxels first
+             * @param conversionFunction called as T(const Source&)
+             */
+            template <typename Source, typename ConversionFunction>
+            LinearOctree(unsigned int size, const Source* voxels, ConversionFunction conversionFunction);
+
+            [[nodiscard]] unsigned short GetSize() const;
+
+            [[nodiscard]] const T* GetData(int x, int y, int z) const;
+
+            void SetData(int x, int y, int z, const T& data);
+
+            [[nodiscard]] std::string GetPacked(TypeToChar conversionFunction) const;
+
+            /**
+             * @return null if the data is not a valid packed octree
+             */
+            static std::shared_ptr<LinearOctree> FromPacked(const std::string_view& data, CharToType conversionFunction);
+
+            /**
+             * @brief Get how many nodes the pool holds, including free ones
+             */
+            [[nodiscard]] size_t GetPoolSize() const;
+
+            /**
+             * @brief Call a function for every full node and voxel, in Z-order
+             * @param function called as void(unsigned int x, unsigned int y, unsigned int z, unsigned int nodeSize, const T& data),
+             * with the node's lowest corner relative to the tree's lowest corner
+             */
+            template <typename Function>
+            void ForEachFull(Function&& function) const;
+
+        private:
+            /**
+             * @brief Get the node covering a cube of voxels, allocating its children if it's partial
+             */
+            template <typename Source, typename ConversionFunction>
+            Node Build(const Source* voxels, unsigned int x, unsigned int y, unsigned int z, unsigned int nodeSize, ConversionFunction& conversionFunction);
+
+            template <typename Function>
+            void VisitFull(uint32_t node, unsigned int x, unsigned int y, unsigned int z, unsigned int nodeSize, Function& function) const;
+
+            void AccumulatePacked(uint32_t node, unsigned int nodeSize, std::string& data, TypeToChar& conversionFunction) const;
+
+            bool Unpack(uint32_t node, unsigned int nodeSize, const std::string_view& data, size_t& currentIndex, CharToType& conversionFunction);
+
+            /**
+             * @brief Get the child of a node containing a position, with the position relative to the tree's corner
+             */
+            static uint32_t GetChildIndex(unsigned int x, unsigned int y, unsigned int z, unsigned int childSize);
+
+            /**
+             * @return The index of the first of 8 new nodes, each a copy of the given node
+             */
+            uint32_t AllocateChildren(const Node& fill);
+
+            /**
+             * @return The index of the first of 8 new nodes, left as they were
+             */
+            uint32_t AllocateBlock();
+
+            void FreeChildren(uint32_t children);
+
+            // Enough for the largest size GetSize can return
+            static constexpr int maxDepth = 16;
+
+            std::vector<Node> nodes;
+            std::vector<uint32_t> freeBlocks;
+            unsigned short size;
+    };
+
+    template <typename T>
+    LinearOctree<T>::LinearOctree(const unsigned int size)
+        :size(size)
+    {
+        assert(IsPowerOfTwo(size));
+        nodes.emplace_back();
+    }
+
+    template <typename T>
+    LinearOctree<T>::LinearOctree(const unsigned int size, const T* voxels)
+        :LinearOctree(size, voxels, [](const T& voxel) -> const T& { return voxel; })
+    {
+    }
+
+    template <typename T>
+    template <typename Source, typename ConversionFunction>
+    LinearOctree<T>::LinearOctree(const unsigned int size, const Source* voxels, ConversionFunction conversionFunction)
+        :size(size)
+    {
+        assert(IsPowerOfTwo(size) && size >= 2);
+        nodes.emplace_back();
+
+        // Chunks of air are common, and a plain scan finds them faster than building
+        const Source* voxelsEnd = voxels + static_cast<size_t>(size) * size * size;
+        if (std::all_of(voxels, voxelsEnd, [&conversionFunction](const Source& voxel){ return conversionFunction(voxel) == T(); }))
+        {
+            return;
+        }
+        const Node root = Build(voxels, 0, 0, 0, size, conversionFunction);
+        nodes[0] = root;
+    }
+
+    template <typename T>
+    unsigned short LinearOctree<T>::GetSize() const
+    {
+        return size;
+    }
+
+    template <typename T>
+    const T* LinearOctree<T>::GetData(const int x, const int y, const int z) const
+    {
+        const int halfSize = size / 2;
+        assert(x >= -halfSize && x < halfSize && y >= -halfSize && y < halfSize && z >= -halfSize && z < halfSize);
+
+        const auto cornerX = static_cast<unsigned int>(x + halfSize);
+        const auto cornerY = static_cast<unsigned int>(y + halfSize);
+        const auto cornerZ = static_cast<unsigned int>(z + halfSize);
+
+        const Node* node = &nodes[0];
+        unsigned int childSize = size / 2;
+        while (node->state == State::Partial)
+        {
+            node = &nodes[node->children + GetChildIndex(cornerX, cornerY, cornerZ, childSize)];
+            childSize /= 2;
+        }
+
+        return node->state == State::Full ? &node->data : nullptr;
+    }
+
+    template <typename T>
+    void LinearOctree<T>::SetData(const int x, const int y, const int z, const T& data)
+    {
+        const int halfSize = size / 2;
+        assert(x >= -halfSize && x < halfSize && y >= -halfSize && y < halfSize && z >= -halfSize && z < halfSize);
+
+        const auto cornerX = static_cast<unsigned int>(x + halfSize);
+        const auto cornerY = static_cast<unsigned int>(y + halfSize);
+        const auto cornerZ = static_cast<unsigned int>(z + halfSize);
+
+        // Walk down to the voxel, splitting full and empty nodes on the way
+        std::array<uint32_t, maxDepth> path;
+        int depth = 0;
+        uint32_t node = 0;
+        for (unsigned int childSize = size / 2; childSize > 0; childSize /= 2)
+        {
+            switch (nodes[node].state)
+            {
+            case State::Full:
+            {
+                // This wouldn't change the node -- it should still be full
+                if (nodes[node].data == data)
+                {
+                    return;
+                }
+                nodes[node].children = AllocateChildren(nodes[node]);
+                break;
+            }
+            case State::Empty:
+            {
+                // The voxels of a size 2 node are never empty, like TypedNode
+                Node fill;
+                fill.state = childSize == 1 ? State::Full : State::Empty;
+                nodes[node].children = AllocateChildren(fill);
+                break;
+            }
+            case State::Partial:
+                break;
+            }
+            nodes[node].state = State::Partial;
+            path[depth++] = node;
+            node = nodes[node].children + GetChildIndex(cornerX, cornerY, cornerZ, childSize);
+        }
+
+        nodes[node].data = data;
+        nodes[node].state = State::Full;
+
+        // Collapse each parent whose children are now all full of the same data
+        while (depth > 0)
+        {
+            Node& parent = nodes[path[--depth]];
+            for (uint32_t i = 0; i < 8; ++i)
+            {
+                const Node& child = nodes[parent.children + i];
+                if (child.state != State::Full || child.data != data)
+                {
+                    return;
+                }
+            }
+            FreeChildren(parent.children);
+            parent.data = data;
+            parent.state = State::Full;
+        }
+    }
+
+    template <typename T>
+    std::string LinearOctree<T>::GetPacked(TypeToChar conversionFunction) const
+    {
+        std::string result = fmt::format("{},", size);
+        AccumulatePacked(0, size, result, conversionFunction);
+        return result;
+    }
+
+    template <typename T>
+    std::shared_ptr<LinearOctree<T>> LinearOctree<T>::FromPacked(const std::string_view& data, CharToType conversionFunction)
+    {
+        const size_t cursorPosition = data.find(',');
+        if (cursorPosition == std::string_view::npos)
+        {
+            return nullptr;
+        }
+        unsigned int treeSize;
+        const auto [pointer, error] = std::from_chars(data.data(), data.data() + cursorPosition, treeSize);
+        if (error != std::errc() || pointer != data.data() + cursorPosition)
+        {
+            return nullptr;
+        }
+
+        if (treeSize < 2 || treeSize > 1u << (maxDepth - 1) || (treeSize & (treeSize - 1)) != 0)
+        {
+            VoxLog(Error, Game, "Unpacking octree failed: size constant is not a power of 2.");
+            return nullptr;
+        }
+
+        size_t currentIndex = 0;
+        auto root = std::make_shared<LinearOctree>(treeSize);
+        if (!root->Unpack(0, treeSize, data.substr(cursorPosition + 1), currentIndex, conversionFunction))
+        {
+            return nullptr;
+        }
+        return root;
+    }
+
+    template <typename T>
+    size_t LinearOctree<T>::GetPoolSize() const
+    {
+        return nodes.size();
+    }
+
+    template <typename T>
+    template <typename Function>
+    void LinearOctree<T>::ForEachFull(Function&& function) const
+    {
+        VisitFull(0, 0, 0, 0, size, function);
+    }
+
+    template <typename T>
+    template <typename Function>
+    void LinearOctree<T>::VisitFull(const uint32_t node, const unsigned int x, const unsigned int y, const unsigned int z, const unsigned int nodeSize, Function& function) const // NOLINT(*-no-recursion)
+    {
+        const Node& currentNode = nodes[node];
+        switch (currentNode.state)
+        {
+        case State::Empty:
+            return;
+        case State::Full:
+            function(x, y, z, nodeSize, currentNode.data);
+            return;
+        case State::Partial:
+        {
+            const unsigned int childSize = nodeSize / 2;
+            for (uint32_t i = 0; i < 8; ++i)
+            {
+                VisitFull(currentNode.children + i, x + (i & 4 ? childSize : 0), y + (i & 2 ? childSize : 0), z + (i & 1 ? childSize : 0), childSize, function);
+            }
+            return;
+        }
+        }
+    }
+
+    template <typename T>
+    template <typename Source, typename ConversionFunction>
+    typename LinearOctree<T>::Node LinearOctree<T>::Build(const Source* voxels, const unsigned int x, const unsigned int y, const unsigned int z, const unsigned int nodeSize, // NOLINT(*-no-recursion)
+        ConversionFunction& conversionFunction)
+    {
+        // Children are visited in the order of GetChildIndex, which is Z-order
+        const unsigned int childSize = nodeSize / 2;
+        std::array<Node, 8> children;
+        for (uint32_t i = 0; i < 8; ++i)
+        {
+            const unsigned int childX = x + (i & 4 ? childSize : 0);
+            const unsigned int childY = y + (i & 2 ? childSize : 0);
+            const unsigned int childZ = z + (i & 1 ? childSize : 0);
+            if (childSize == 1)
+            {
+                children[i].data = conversionFunction(voxels[(childX * size + childY) * size + childZ]);
+                children[i].state = children[i].data == T() ? State::Empty : State::Full;
+            }
+            else
+            {
+                children[i] = Build(voxels, childX, childY, childZ, childSize, conversionFunction);
+            }
+        }
+
+        bool allEmpty = true;
+        bool allFull = true;
+        for (const Node& child : children)
+        {
+            allEmpty = allEmpty && child.state == State::Empty;
+            allFull = allFull && child.state == State::Full && child.data == children[0].data;
+        }
+
+        Node result;
+        if (allEmpty)
+        {
+            return result;
+        }
+        if (allFull)
+        {
+            result.data = children[0].data;
+            result.state = State::Full;
+            return result;
+        }
+
+        result.children = AllocateBlock();
+        result.state = State::Partial;
+        for (uint32_t i = 0; i < 8; ++i)
+        {
+            nodes[result.children + i] = children[i];
+            // The voxels of a size 2 node are never empty, unset ones hold T()
+            if (childSize == 1)
+            {
+                nodes[result.children + i].state = State::Full;
+            }
+        }
+        return result;
+    }
+
+    template <typename T>
+    void LinearOctree<T>::AccumulatePacked(const uint32_t node, const unsigned int nodeSize, std::string& data, TypeToChar& conversionFunction) const // NOLINT(*-no-recursion)
+    {
+        const Node& currentNode = nodes[node];
+        switch (currentNode.state)
+        {
+        case State::Empty:
+        {
+            data += 'E';
+            return;
+        }
+        case State::Full:
+        {
+            data += 'F';
+            data.push_back(conversionFunction(currentNode.data));
+            return;
+        }
+        case State::Partial:
+        {
+            data += 'P';
+            for (uint32_t i = 0; i < 8; ++i)
+            {
+                // The voxels of a size 2 node are written without a state
+                if (nodeSize == 2)
+                {
+                    data.push_back(conversionFunction(nodes[currentNode.children + i].data));
+                }
+                else
+                {
+                    AccumulatePacked(currentNode.children + i, nodeSize / 2, data, conversionFunction);
+                }
+            }
+            return;
+        }
+        }
+    }
+
+    template <typename T>
+    bool LinearOctree<T>::Unpack(const uint32_t node, const unsigned int nodeSize, const std::string_view& data, size_t& currentIndex, CharToType& conversionFunction) // NOLINT(*-no-recursion)
+    {
+        if (currentIndex >= data.size())
+        {
+            return false;
+        }
+
+        switch (data[currentIndex++])
+        {
+        case 'E':
+        {
+            return true;
+        }
+        case 'F':
+        {
+            if (currentIndex >= data.size())
+            {
+                return false;
+            }
+            nodes[node].data = conversionFunction(data[currentIndex++]);
+            nodes[node].state = State::Full;
+            return true;
+        }
+        case 'P':
+        {
+            Node fill;
+            fill.state = State::Full;
+            const uint32_t children = AllocateChildren(fill);
+            nodes[node].children = children;
+            nodes[node].state = State::Partial;
+            for (uint32_t i = 0; i < 8; ++i)
+            {
+                if (nodeSize == 2)
+                {
+                    if (currentIndex >= data.size())
+                    {
+                        return false;
+                    }
+                    nodes[children + i].data = conversionFunction(data[currentIndex++]);
+                }
+                else
+                {
+                    nodes[children + i].state = State::Empty;
+                    if (!Unpack(children + i, nodeSize / 2, data, currentIndex, conversionFunction))
+                    {
+                        return false;
+                    }
+                }
+            }
+            return true;
+        }
+        default:
+            return false;
+        }
+    }
+
+    template <typename T>
+    uint32_t LinearOctree<T>::GetChildIndex(const unsigned int x, const unsigned int y, const unsigned int z, const unsigned int childSize)
+    {
+        // The same order as TypedNode::GetIndex
+        return (x & childSize ? 4 : 0) | (y & childSize ? 2 : 0) | (z & childSize ? 1 : 0);
+    }
+
+    template <typename T>
+    uint32_t LinearOctree<T>::AllocateChildren(const Node& fill)
+    {
+        // Copy the fill first, the pool may move when it grows
+        const Node fillNode = fill;
+        const uint32_t children = AllocateBlock();
+        for (uint32_t i = 0; i < 8; ++i)
+        {
+            nodes[children + i] = fillNode;
+        }
+        return children;
+    }
+
+    template <typename T>
+    uint32_t LinearOctree<T>::AllocateBlock()
+    {
+        if (!freeBlocks.empty())
+        {
+            const uint32_t children = freeBlocks.back();
+            freeBlocks.pop_back();
+            return children;
+        }
+
+        const auto children = static_cast<uint32_t>(nodes.size());
+        nodes.resize(nodes.size() + 8);
+        return children;
+    }
+
+    template <typename T>
+    void LinearOctree<T>::FreeChildren(const uint32_t children)
+    {
+        // Only called on collapse, when the children are all full and have no children of their own
+        freeBlocks.push_back(children);
+    }
+}
@@ -0,0 +1,267 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <string>
+#include <string_view>
+
+#include <fmt/format.h>
+
+namespace Vox
+{
+    /**
+     * @brief Converts dense voxels to and from the packed format of TypedNode and LinearOctree, for trees of a
+     * size known at compile time
+     * No tree is built in either direction. The recursion is unrolled for each level, the conversion functions
+     * are inlined, and size 2 nodes handle their 8 voxels together
+     * @tparam Size width of the tree, a power of 2
+     */
+    template <typename T, unsigned int Size>
+    class PackedOctree
+    {
+        static_assert(Size >= 2 && (Size & (Size - 1)) == 0, "Octree size must be a power of 2");
+
+        enum class State : char
+        {
+            Full,
+            Empty,
+            Partial
+        };
+
+        // What a packed node turned out to be, so its parent can collapse it
+        struct NodeSummary
+        {
+            State state;
+            T data;
+        };
+
+        public:
+            /**
+             * @brief Pack dense voxels, the same as packing a LinearOctree built from them
+             * @param voxels Size * Size * Size voxels, indexed by [x][y][z]. Voxels equal to T() are unset
+             * @param conversionFunction called as char(const T&)
+             */
+            template <typename TypeToChar>
+            [[nodiscard]] static std::string Pack(const T* voxels, TypeToChar&& conversionFunction);
+
+            /**
+             * @brief Decode packed data straight into dense voxels, in one pass over the data
+             * @param voxelsOut Size * Size * Size voxels, indexed by [x][y][z]. Empty nodes are written as T()
+             * @param conversionFunction called as T(char)
+             * @return false if the data is not a valid packed octree of this size
+             */
+            template <typename CharToType>
+            [[nodiscard]] static bool Unpack(const std::string_view& data, T* voxelsOut, CharToType&& conversionFunction);
+
+        private:
+            template <unsigned int NodeSize, typename TypeToChar>
+            static NodeSummary PackNode(const T* voxels, unsigned int x, unsigned int y, unsigned int z, std::string& data, TypeToChar& conversionFunction);
+
+            template <unsigned int NodeSize, typename CharToType>
+            static bool UnpackNode(const std::string_view& data, size_t& currentIndex, unsigned int x, unsigned int y, unsigned int z,
+                T* voxelsOut, CharToType& conversionFunction);
+
+            template <unsigned int NodeSize>
+            static void Fill(unsigned int x, unsigned int y, unsigned int z, T* voxelsOut, const T& data);
+
+            static constexpr unsigned int GetIndex(const unsigned int x, const unsigned int y, const unsigned int z)
+            {
+                return (x * Size + y) * Size + z;
+            }
+    };
+
+    template <typename T, unsigned int Size>
+    template <typename TypeToChar>
+    std::string PackedOctree<T, Size>::Pack(const T* voxels, TypeToChar&& conversionFunction)
+    {
+        std::string result = fmt::format("{},", Size);
+
+        // Chunks of air are common, and a plain scan finds them faster than packing
+        if (std::all_of(voxels, voxels + Size * Size * Size, [](const T& voxel){ return voxel == T(); }))
+        {
+            result += 'E';
+            return result;
+        }
+        PackNode<Size>(voxels, 0, 0, 0, result, conversionFunction);
+        return result;
+    }
+
+    template <typename T, unsigned int Size>
+    template <typename CharToType>
+    bool PackedOctree<T, Size>::Unpack(const std::string_view& data, T* voxelsOut, CharToType&& conversionFunction)
+    {
+        const size_t cursorPosition = data.find(',');
+        if (cursorPosition == std::string_view::npos)
+        {
+            return false;
+        }
+
+        unsigned int treeSize;
+        const auto [pointer, error] = std::from_chars(data.data(), data.data() + cursorPosition, treeSize);
+        if (error != std::errc() || pointer != data.data() + cursorPosition || treeSize != Size)
+        {
+            return false;
+        }
+
+        size_t currentIndex = cursorPosition + 1;
+        return UnpackNode<Size>(data, currentIndex, 0, 0, 0, voxelsOut, conversionFunction);
+    }
+
+    template <typename T, unsigned int Size>
+    template <unsigned int NodeSize, typename TypeToChar>
+    typename PackedOctree<T, Size>::NodeSummary PackedOctree<T, Size>::PackNode(const T* voxels, const unsigned int x, const unsigned int y, const unsigned int z,
+        std::string& data, TypeToChar& conversionFunction)
+    {
+        if constexpr (NodeSize == 2)
+        {
+            // Children in Z-order, the same as TypedNode::GetIndex
+            const std::array<T, 8> children = {
+                voxels[GetIndex(x, y, z)], voxels[GetIndex(x, y, z + 1)],
+                voxels[GetIndex(x, y + 1, z)], voxels[GetIndex(x, y + 1, z + 1)],
+                voxels[GetIndex(x + 1, y, z)], voxels[GetIndex(x + 1, y, z + 1)],
+                voxels[GetIndex(x + 1, y + 1, z)], voxels[GetIndex(x + 1, y + 1, z + 1)]};
+
+            const bool allSame = std::all_of(children.begin() + 1, children.end(), [&children](const T& child){ return child == children[0]; });
+            if (allSame && children[0] == T())
+            {
+                data += 'E';
+                return {State::Empty, T()};
+            }
+            if (allSame)
+            {
+                const char full[2] = {'F', conversionFunction(children[0])};
+                data.append(full, 2);
+                return {State::Full, children[0]};
+            }
+
+            const char partial[9] = {'P',
+                conversionFunction(children[0]), conversionFunction(children[1]), conversionFunction(children[2]), conversionFunction(children[3]),
+                conversionFunction(children[4]), conversionFunction(children[5]), conversionFunction(children[6]), conversionFunction(children[7])};
+            data.append(partial, 9);
+            return {State::Partial, T()};
+        }
+        else
+        {
+            // Written as partial, and rewound if the children turn out to be uniform
+            constexpr unsigned int childSize = NodeSize / 2;
+            const size_t nodeStart = data.size();
+            data += 'P';
+            std::array<NodeSummary, 8> children;
+            for (unsigned int i = 0; i < 8; ++i)
+            {
+                children[i] = PackNode<childSize>(voxels, x + (i & 4 ? childSize : 0), y + (i & 2 ? childSize : 0), z + (i & 1 ? childSize : 0),
+                    data, conversionFunction);
+            }
+
+            bool allEmpty = true;
+            bool allFull = true;
+            for (const NodeSummary& child : children)
+            {
+                allEmpty = allEmpty && child.state == State::Empty;
+                allFull = allFull && child.state == State::Full && child.data == children[0].data;
+            }
+
+            if (allEmpty)
+            {
+                data.resize(nodeStart);
+                data += 'E';
+                return {State::Empty, T()};
+            }
+            if (allFull)
+            {
+                data.resize(nodeStart);
+                const char full[2] = {'F', conversionFunction(children[0].data)};
+                data.append(full, 2);
+                return {State::Full, children[0].data};
+            }
+            return {State::Partial, T()};
+        }
+    }
+
+    template <typename T, unsigned int Size>
+    template <unsigned int NodeSize, typename CharToType>
+    bool PackedOctree<T, Size>::UnpackNode(const std::string_view& data, size_t& currentIndex, const unsigned int x, const unsigned int y, const unsigned int z,
+        T* voxelsOut, CharToType& conversionFunction)
+    {
+        if (currentIndex >= data.size())
+        {
+            return false;
+        }
+
+        switch (data[currentIndex++])
+        {
+        case 'E':
+        {
+            Fill<NodeSize>(x, y, z, voxelsOut, T());
+            return true;
+        }
+        case 'F':
+        {
+            if (currentIndex >= data.size())
+            {
+                return false;
+            }
+            Fill<NodeSize>(x, y, z, voxelsOut, conversionFunction(data[currentIndex++]));
+            return true;
+        }
+        case 'P':
+        {
+            if constexpr (NodeSize == 2)
+            {
+                if (currentIndex + 8 > data.size())
+                {
+                    return false;
+                }
+                const char* children = data.data() + currentIndex;
+                voxelsOut[GetIndex(x, y, z)] = conversionFunction(children[0]);
+                voxelsOut[GetIndex(x, y, z + 1)] = conversionFunction(children[1]);
+                voxelsOut[GetIndex(x, y + 1, z)] = conversionFunction(children[2]);
+                voxelsOut[GetIndex(x, y + 1, z + 1)] = conversionFunction(children[3]);
+                voxelsOut[GetIndex(x + 1, y, z)] = conversionFunction(children[4]);
+                voxelsOut[GetIndex(x + 1, y, z + 1)] = conversionFunction(children[5]);
+                voxelsOut[GetIndex(x + 1, y + 1, z)] = conversionFunction(children[6]);
+                voxelsOut[GetIndex(x + 1, y + 1, z + 1)] = conversionFunction(children[7]);
+                currentIndex += 8;
+                return true;
+            }
+            else
+            {
+                constexpr unsigned int childSize = NodeSize / 2;
+                for (unsigned int i = 0; i < 8; ++i)
+                {
+                    if (!UnpackNode<childSize>(data, currentIndex, x + (i & 4 ? childSize : 0), y + (i & 2 ? childSize : 0), z + (i & 1 ? childSize : 0),
+                        voxelsOut, conversionFunction))
+                    {
+                        return false;
+                    }
+                }
+                return true;
+            }
+        }
+        default:
+            return false;
+        }
+    }
+
+    template <typename T, unsigned int Size>
+    template <unsigned int NodeSize>
+    void PackedOctree<T, Size>::Fill(const unsigned int x, const unsigned int y, const unsigned int z, T* voxelsOut, const T& data)
+    {
+        // The root covers whole rows along z, so it's one run
+        if constexpr (NodeSize == Size)
+        {
+            std::fill_n(voxelsOut, Size * Size * Size, data);
+        }
+        else
+        {
+            for (unsigned int voxelX = x; voxelX < x + NodeSize; ++voxelX)
+            {
+                for (unsigned int voxelY = y; voxelY < y + NodeSize; ++voxelY)
+                {
+                    std::fill_n(voxelsOut + GetIndex(voxelX, voxelY, z), NodeSize, data);
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,276 @@
+#include "PalettedVoxelStorage.h"
+
+#include <algorithm>
+#include <cassert>
+#include <optional>
+
+namespace Vox
+{
+    PalettedVoxelStorage::PalettedVoxelStorage(const unsigned int volume, const Voxel& fill)
+        :volume(volume)
+    {
+        Fill(fill);
+    }
+
+    Voxel PalettedVoxelStorage::Get(const unsigned int index) const
+    {
+        assert(index < volume);
+        return palette[ReadIndex(index)];
+    }
+
+    void PalettedVoxelStorage::Set(const unsigned int index, const Voxel& voxel)
+    {
+        assert(index < volume);
+        const unsigned int currentPaletteIndex = ReadIndex(index);
+        if (palette[currentPaletteIndex] == voxel)
+        {
+            return;
+        }
+
+        // This has to happen before we release the current entry, otherwise
+        // the current entry could be reused while it is still referenced
+        const unsigned int newPaletteIndex = FindOrAddPaletteEntry(voxel);
+        --paletteCounts[currentPaletteIndex];
+        ++paletteCounts[newPaletteIndex];
+        WriteIndex(index, newPaletteIndex);
+    }
+
+    void PalettedVoxelStorage::Fill(const Voxel& voxel)
+    {
+        palette = {voxel};
+        palette.shrink_to_fit();
+        paletteCounts = {volume};
+        paletteCounts.shrink_to_fit();
+        indices.clear();
+        indices.shrink_to_fit();
+        bitsPerIndex = 0;
+    }
+
+    void PalettedVoxelStorage::Pack(const Voxel* data)
+    {
+        palette.clear();
+        paletteCounts.clear();
+
+        std::vector<unsigned int> denseIndices(volume);
+        unsigned int lastPaletteIndex = 0;
+        for (unsigned int i = 0; i < volume; ++i)
+        {
+            // Neighbouring voxels are usually the same, so check the last match first
+            if (palette.empty() || !(palette[lastPaletteIndex] == data[i]))
+            {
+                const auto existingEntry = std::ranges::find(palette, data[i]);
+                if (existingEntry == palette.end())
+                {
+                    palette.emplace_back(data[i]);
+                    paletteCounts.emplace_back(0);
+                    lastPaletteIndex = static_cast<unsigned int>(palette.size() - 1);
+                }
+                else
+                {
+                    lastPaletteIndex = static_cast<unsigned int>(existingEntry - palette.begin());
+                }
+            }
+            ++paletteCounts[lastPaletteIndex];
+            denseIndices[i] = lastPaletteIndex;
+        }
+
+        bitsPerIndex = GetBitsForPaletteSize(palette.size());
+        indices.assign(bitsPerIndex == 0 ? 0 : (static_cast<size_t>(volume) * bitsPerIndex + 63) / 64, 0);
+        indices.shrink_to_fit();
+        if (bitsPerIndex == 0)
+        {
+            return;
+        }
+
+        for (unsigned int i = 0; i < volume; ++i)
+        {
+            WriteIndex(i, denseIndices[i]);
+        }
+    }
+
+    void PalettedVoxelStorage::Unpack(Voxel* dataOut) const
+    {
+        if (bitsPerIndex == 0)
+        {
+            std::fill_n(dataOut, volume, palette[0]);
+            return;
+        }
+
+        // Decode a whole word at a time, rather than recalculating the word for every voxel
+        const unsigned int indicesPerWord = 64 / bitsPerIndex;
+        const uint64_t mask = (uint64_t{1} << bitsPerIndex) - 1;
+        unsigned int voxelIndex = 0;
+        for (uint64_t word : indices)
+        {
+            for (unsigned int i = 0; i < indicesPerWord && voxelIndex < volume; ++i, ++voxelIndex)
+            {
+                dataOut[voxelIndex] = palette[word & mask];
+                word >>= bitsPerIndex;
+            }
+        }
+    }
+
+    void PalettedVoxelStorage::Compact()
+    {
+        if (std::ranges::find(paletteCounts, 0u) == paletteCounts.end())
+        {
+            // The index width only grows when the palette does, so it's already as small as it can be
+            return;
+        }
+
+        std::vector<unsigned int> remap(palette.size(), 0);
+        std::vector<Voxel> newPalette;
+        std::vector<unsigned int> newPaletteCounts;
+        for (size_t i = 0; i < palette.size(); ++i)
+        {
+            if (paletteCounts[i] == 0)
+            {
+                continue;
+            }
+
+            remap[i] = static_cast<unsigned int>(newPalette.size());
+            newPalette.emplace_back(palette[i]);
+            newPaletteCounts.emplace_back(paletteCounts[i]);
+        }
+
+        Repack(GetBitsForPaletteSize(newPalette.size()), remap);
+        palette = std::move(newPalette);
+        paletteCounts = std::move(newPaletteCounts);
+    }
+
+    bool PalettedVoxelStorage::IsUniform() const
+    {
+        return bitsPerIndex == 0;
+    }
+
+    unsigned int PalettedVoxelStorage::GetVolume() const
+    {
+        return volume;
+    }
+
+    unsigned int PalettedVoxelStorage::GetBitsPerIndex() const
+    {
+        return bitsPerIndex;
+    }
+
+    size_t PalettedVoxelStorage::GetPaletteSize() const
+    {
+        return palette.size();
+    }
+
+    const std::vector<Voxel>& PalettedVoxelStorage::GetPalette() const
+    {
+        return palette;
+    }
+
+    size_t PalettedVoxelStorage::GetMemoryUsage() const
+    {
+        return sizeof(PalettedVoxelStorage) +
+            palette.capacity() * sizeof(Voxel) +
+            paletteCounts.capacity() * sizeof(unsigned int) +
+            indices.capacity() * sizeof(uint64_t);
+    }
+
+    unsigned int PalettedVoxelStorage::ReadIndex(const unsigned int index) const
+    {
+        if (bitsPerIndex == 0)
+        {
+            return 0;
+        }
+
+        const unsigned int indicesPerWord = 64 / bitsPerIndex;
+        const unsigned int shift = (index % indicesPerWord) * bitsPerIndex;
+        const uint64_t mask = (uint64_t{1} << bitsPerIndex) - 1;
+        return static_cast<unsigned int>((indices[index / indicesPerWord] >> shift) & mask);
+    }
+
+    void PalettedVoxelStorage::WriteIndex(const unsigned int index, const unsigned int paletteIndex)
+    {
+        assert(bitsPerIndex != 0 || paletteIndex == 0);
+        if (bitsPerIndex == 0)
+        {
+            return;
+        }
+
+        const unsigned int indicesPerWord = 64 / bitsPerIndex;
+        const unsigned int shift = (index % indicesPerWord) * bitsPerIndex;
+        const uint64_t mask = (uint64_t{1} << bitsPerIndex) - 1;
+        uint64_t& word = indices[index / indicesPerWord];
+        word = (word & ~(mask << shift)) | (static_cast<uint64_t>(paletteIndex) << shift);
+    }
+
+    unsigned int PalettedVoxelStorage::FindOrAddPaletteEntry(const Voxel& voxel)
+    {
+        std::optional<unsigned int> unusedEntry;
+        for (unsigned int i = 0; i < palette.size(); ++i)
+        {
+            if (palette[i] == voxel)
+            {
+                return i;
+            }
+
+            if (!unusedEntry && paletteCounts[i] == 0)
+            {
+                unusedEntry = i;
+            }
+        }
+
+        if (unusedEntry)
+        {
+            palette[*unusedEntry] = voxel;
+            return *unusedEntry;
+        }
+
+        palette.emplace_back(voxel);
+        paletteCounts.emplace_back(0);
+        if (const unsigned int requiredBits = GetBitsForPaletteSize(palette.size()); requiredBits != bitsPerIndex)
+        {
+            Repack(requiredBits, {});
+        }
+        return static_cast<unsigned int>(palette.size() - 1);
+    }
+
+    void PalettedVoxelStorage::Repack(const unsigned int newBitsPerIndex, const std::vector<unsigned int>& remap)
+    {
+        std::vector<uint64_t> newIndices(newBitsPerIndex == 0 ? 0 : (static_cast<size_t>(volume) * newBitsPerIndex + 63) / 64, 0);
+        if (newBitsPerIndex != 0)
+        {
+            const unsigned int indicesPerWord = 64 / newBitsPerIndex;
+            for (unsigned int i = 0; i < volume; ++i)
+            {
+                const unsigned int paletteIndex = remap.empty() ? ReadIndex(i) : remap[ReadIndex(i)];
+                newIndices[i / indicesPerWord] |= static_cast<uint64_t>(paletteIndex) << ((i % indicesPerWord) * newBitsPerIndex);
+            }
+        }
+
+        indices = std::move(newIndices);
+        bitsPerIndex = newBitsPerIndex;
+    }
+
+    unsigned int PalettedVoxelStorage::GetBitsForPaletteSize(const size_t paletteSize)
+    {
+        // Index widths always divide evenly into a word, so indices never straddle two words
+        assert(paletteSize <= 65536);
+        if (paletteSize <= 1)
+        {
+            return 0;
+        }
+        if (paletteSize <= 2)
+        {
+            return 1;
+        }
+        if (paletteSize <= 4)
+        {
+            return 2;
+        }
+        if (paletteSize <= 16)
+        {
+            return 4;
+        }
+        if (paletteSize <= 256)
+        {
+            return 8;
+        }
+        return 16;
+    }
+}
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "voxel/Voxel.h"
+
+namespace Vox
+{
+    /**
+     * @brief Bit-packed voxel storage, using a per-storage palette of unique voxels
+     * Each voxel is stored as an index into the palette, packed into 64-bit words.
+     * A storage containing only one kind of voxel uses 0-bit indices and allocates no index data
+     */
+    class PalettedVoxelStorage
+    {
+    public:
+        explicit PalettedVoxelStorage(unsigned int volume, const Voxel& fill = Voxel());
+
+        [[nodiscard]] Voxel Get(unsigned int index) const;
+
+        void Set(unsigned int index, const Voxel& voxel);
+
+        /**
+         * @brief Replace every voxel in the storage, collapsing it to the uniform representation
+         */
+        void Fill(const Voxel& voxel);
+
+        /**
+         * @brief Rebuild the storage from a dense buffer of 'volume' voxels
+         */
+        void Pack(const Voxel* data);
+
+        /**
+         * @brief Write every voxel into a dense buffer of 'volume' voxels
+         */
+        void Unpack(Voxel* dataOut) const;
+
+        /**
+         * @brief Remove unused palette entries, and shrink the index width if possible
+         */
+        void Compact();
+
+        [[nodiscard]] bool IsUniform() const;
+
+        [[nodiscard]] unsigned int GetVolume() const;
+
+        [[nodiscard]] unsigned int GetBitsPerIndex() const;
+
+        [[nodiscard]] size_t GetPaletteSize() const;
+
+        /**
+         * @brief Get the palette entries. This can include entries that are no longer used, until Compact is called
+         */
+        [[nodiscard]] const std::vector<Voxel>& GetPalette() const;
+
+        /**
+         * @brief Get the approximate number of bytes used by this storage, including heap allocations
+         */
+        [[nodiscard]] size_t GetMemoryUsage() const;
+
+    private:
+        [[nodiscard]] unsigned int ReadIndex(unsigned int index) const;
+
+        void WriteIndex(unsigned int index, unsigned int paletteIndex);
+
+        unsigned int FindOrAddPaletteEntry(const Voxel& voxel);
+
+        void Repack(unsigned int newBitsPerIndex, const std::vector<unsigned int>& remap);
+
+        static unsigned int GetBitsForPaletteSize(size_t paletteSize);
+
+        std::vector<Voxel> palette;
+
+        // Number of voxels referencing each palette entry, entries with a count of 0 can be reused
+        std::vector<unsigned int> paletteCounts;
+
+        std::vector<uint64_t> indices;
+
+        unsigned int volume;
+
+        unsigned int bitsPerIndex = 0;
+    };
+}
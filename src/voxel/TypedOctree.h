@@ -248,7 +248,7 @@ namespace Vox
 		case State::Full:
 		{
 			// The same as empty, but delete our "Full" node representation
-			const T& fullVoxel = *std::get<std::unique_ptr<T>>(subNodes[0]);
+			const T fullVoxel = *std::get<std::unique_ptr<T>>(subNodes[0]);
 
 			// This wouldn't change the node -- it should still be full
 			if (fullVoxel == data)
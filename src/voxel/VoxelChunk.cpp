@@ -1,149 +1,398 @@
 #include "VoxelChunk.h"
 
+#include <algorithm>
+#include <charconv>
+
 #include <fmt/format.h>
 
-#include "TypedOctree.h"
 #include "core/math/Formatting.h"
 #include "core/objects/world/World.h"
 #include "voxel/Octree.h"
+#include "voxel/PackedOctree.h"
 #include "rendering/Renderer.h"
 #include "physics/PhysicsServer.h"
 #include "rendering/SceneRenderer.h"
 
 namespace Vox
 {
-	VoxelChunk::VoxelChunk(const glm::ivec2 chunkLocation, const World* world)
-		:chunkLocation(chunkLocation)
+    namespace
+    {
+        /**
+         * @brief Call a function with the local position of each voxel in the layer of a chunk facing a neighbour
+         */
+        template <typename Function>
+        void ForEachBorderVoxel(const VoxelChunk::Neighbour neighbour, const Function& function)
+        {
+            const glm::ivec3 offset = VoxelChunk::GetNeighbourOffset(neighbour);
+            const int axis = offset.x != 0 ? 0 : offset.y != 0 ? 1 : 2;
+            glm::ivec3 position;
+            position[axis] = offset[axis] < 0 ? 0 : VoxelChunk::chunkSize - 1;
+            for (int u = 0; u < VoxelChunk::chunkSize; ++u)
+            {
+                for (int v = 0; v < VoxelChunk::chunkSize; ++v)
+                {
+                    position[(axis + 1) % 3] = u;
+                    position[(axis + 2) % 3] = v;
+                    function(position);
+                }
+            }
+        }
+    }
+
+	VoxelChunk::VoxelChunk(const glm::ivec3 chunkLocation, const World* world)
+		:chunkLocation(chunkLocation), world(world)
 	{
 		mesh = world->GetRenderer()->CreateVoxelMesh(chunkLocation);
-		body = world->GetPhysicsServer()->CreateVoxelBody();
-	    body->chunkPosition = chunkLocation;
-		voxels = std::make_unique<std::array<std::array<std::array<Voxel, chunkSize>, chunkSize>, chunkSize>>();
+		body = world->GetPhysicsServer()->CreateVoxelBody(chunkLocation);
 	}
 
-    VoxelChunk::VoxelChunk(const std::string_view& chunkData, const World* world)
-        :chunkLocation()
+    VoxelChunk::VoxelChunk(DecodedChunk&& decodedChunk, const World* world)
+        :chunkLocation(decodedChunk.location), world(world), voxels(std::move(decodedChunk.voxels))
     {
-	    voxels = std::make_unique<std::array<std::array<std::array<Voxel, chunkSize>, chunkSize>, chunkSize>>();
-	    size_t cursorPositionR = chunkData.find(',');
-	    size_t cursorPositionL = 1;
-	    const int chunkX = std::stoi(std::string(chunkData.substr(cursorPositionL, cursorPositionR - cursorPositionL)));
-
-	    cursorPositionL = cursorPositionR + 1;
-	    cursorPositionR = chunkData.find(')', cursorPositionL);
-	    std::string tempString(chunkData.substr(cursorPositionL, cursorPositionR - cursorPositionL));
-	    const int chunkY = std::stoi(tempString);
-
-	    chunkLocation = {chunkX, chunkY};
-
 	    mesh = world->GetRenderer()->CreateVoxelMesh(chunkLocation);
-	    body = world->GetPhysicsServer()->CreateVoxelBody();
-	    body->chunkPosition = chunkLocation;
-	    voxels = std::make_unique<std::array<std::array<std::array<Voxel, chunkSize>, chunkSize>, chunkSize>>();
-
-	    cursorPositionL = cursorPositionR + 1;
-	    cursorPositionR = chunkData.find(':', cursorPositionL);
-
-	    const int chunkDataSize = std::stoi(std::string(chunkData.substr(cursorPositionL, cursorPositionR - cursorPositionL)));
-	    std::string_view chunkString = chunkData.substr(cursorPositionR + 1, chunkDataSize);
-        std::shared_ptr<TypedNode<Voxel>> voxelOctree = TypedNode<Voxel>::FromPacked(chunkString, [](const char c)
-        {
-            Voxel result;
-            result.materialId = c - 48;
-            return result;
-        });
-
-	    for (int x = 0; x < chunkSize; ++x)
-	    {
-	        for (int y = 0; y < chunkSize; ++y)
-	        {
-	            for (int z = 0; z < chunkSize; ++z)
-	            {
-	                if (Voxel* voxel = voxelOctree->GetData(x - chunkHalfSize, y - chunkHalfSize, z - chunkHalfSize))
-	                {
-	                    SetVoxel({x, y, z}, *voxel);
-	                }
-	            }
-	        }
-	    }
+	    body = world->GetPhysicsServer()->CreateVoxelBody(chunkLocation);
+	    world->GetPhysicsServer()->SetVoxelBodyCollision(body, std::move(decodedChunk.collisionMask));
 	    FinalizeUpdate();
     }
 
+    VoxelChunk::~VoxelChunk()
+    {
+	    // The mesh geometry is freed right away, the body is removed on the next physics step
+	    world->GetRenderer()->DestroyVoxelMesh(mesh);
+	    world->GetPhysicsServer()->DestroyVoxelBody(body);
+    }
+
     void VoxelChunk::SetVoxel(const glm::uvec3 voxelPosition, const Voxel voxel)
 	{
 		assert(voxelPosition.x < chunkSize && voxelPosition.y < chunkSize && voxelPosition.z < chunkSize);
 
-		if (voxel == voxels->at(voxelPosition.x)[voxelPosition.y][voxelPosition.z])
+	    const unsigned int voxelIndex = GetVoxelIndex(voxelPosition);
+	    const Voxel currentVoxel = voxels.Get(voxelIndex);
+		if (voxel == currentVoxel)
 		{
 			return;
 		}
 
-		if (voxel.materialId == 0 && voxels->at(voxelPosition.x)[voxelPosition.y][voxelPosition.z].materialId != 0)
+		if ((voxel.materialId == 0) != (currentVoxel.materialId == 0))
 		{
-			body->EraseVoxel(voxelPosition);
+			collisionRebuildPending = true;
 		}
-		else if (voxel.materialId != 0 && voxels->at(voxelPosition.x)[voxelPosition.y][voxelPosition.z].materialId == 0)
+
+		for (int i = 0; i < neighbourCount; ++i)
 		{
-			body->CreateVoxel(voxelPosition);
+		    const glm::ivec3 offset = GetNeighbourOffset(static_cast<Neighbour>(i));
+		    const int axis = offset.x != 0 ? 0 : offset.y != 0 ? 1 : 2;
+		    if (static_cast<int>(voxelPosition[axis]) == (offset[axis] < 0 ? 0 : chunkSize - 1))
+		    {
+		        modifiedBorders |= 1 << i;
+		    }
 		}
 
-	    // Emplace unique
-	    if (std::ranges::find(modifiedMaterialIds, voxel.materialId) == modifiedMaterialIds.end())
-	    {
-	        modifiedMaterialIds.emplace_back(voxel.materialId);
-	    }
-
-		voxels->at(voxelPosition.x)[voxelPosition.y][voxelPosition.z] = voxel;
+		voxels.Set(voxelIndex, voxel);
+	    pendingUpdate = true;
+	    modifiedSinceSave = true;
 	}
 
 	Voxel VoxelChunk::GetVoxel(const glm::uvec3 voxelPosition) const
 	{
 		assert(voxelPosition.x < chunkSize && voxelPosition.y < chunkSize && voxelPosition.z < chunkSize);
-		return voxels->at(voxelPosition.x)[voxelPosition.y][voxelPosition.z];
+		return voxels.Get(GetVoxelIndex(voxelPosition));
 	}
 
+    std::optional<Voxel> VoxelChunk::GetVoxelOrNeighbour(const glm::ivec3& voxelPosition) const
+    {
+	    // Step through at most one neighbour per axis, positions further out than that aren't supported
+	    const VoxelChunk* chunk = this;
+	    glm::ivec3 localPosition = voxelPosition;
+	    auto stepAxis = [&chunk](int& position, const Neighbour lower, const Neighbour upper)
+	    {
+	        if (!chunk || (position >= 0 && position < chunkSize))
+	        {
+	            return;
+	        }
+
+	        chunk = chunk->neighbours[static_cast<int>(position < 0 ? lower : upper)];
+	        position += position < 0 ? chunkSize : -chunkSize;
+	    };
+	    stepAxis(localPosition.x, Neighbour::Left, Neighbour::Right);
+	    stepAxis(localPosition.y, Neighbour::Down, Neighbour::Up);
+	    stepAxis(localPosition.z, Neighbour::Back, Neighbour::Front);
+
+	    if (!chunk)
+	    {
+	        return std::nullopt;
+	    }
+
+	    assert(localPosition.x >= 0 && localPosition.x < chunkSize && localPosition.y >= 0 && localPosition.y < chunkSize &&
+	        localPosition.z >= 0 && localPosition.z < chunkSize);
+	    return chunk->GetVoxel(glm::uvec3(localPosition));
+    }
+
 	void VoxelChunk::FinalizeUpdate()
 	{
-		mesh->UpdateData(voxels.get(), modifiedMaterialIds);
-	    modifiedMaterialIds.clear();
-		mesh.MarkDirty();
-		body.MarkDirty();
+	    // Palette entries can be left unused after edits, shrink back down once the edits are done
+	    voxels.Compact();
+
+	    if (collisionRebuildPending)
+	    {
+	        // The physics thread may be reading the body's current mask, so a new one is handed over instead of editing it
+	        const auto denseVoxels = std::make_unique<VoxelArray>();
+	        UnpackVoxels(*denseVoxels);
+	        world->GetPhysicsServer()->SetVoxelBodyCollision(body, VoxelBody::BuildCollisionMask(*denseVoxels));
+	        collisionRebuildPending = false;
+	    }
+	    world->GetPhysicsServer()->MarkVoxelBodyDirty(body);
+
+	    // Meshes are updated afterwards, so a chunk that is flagged by several edits is only unpacked once
+	    meshUpdatePending = true;
+	    for (int i = 0; i < neighbourCount; ++i)
+	    {
+	        if (neighbours[i] && (modifiedBorders & 1 << i))
+	        {
+	            neighbours[i]->meshUpdatePending = true;
+	        }
+	    }
+	    modifiedBorders = 0;
+	    pendingUpdate = false;
 	}
 
-    glm::vec3 VoxelChunk::CalculatePosition(const glm::ivec2& position)
+    void VoxelChunk::UpdateMesh()
     {
-	    return {
-	        position.x * chunkSize - chunkHalfSize,
-            -chunkHalfSize,
-            position.y * chunkSize - chunkHalfSize
-	    };
+	    // The mesh generation shader expects a dense array, the mesh keeps its own copy until it is regenerated
+	    const auto paddedVoxels = std::make_unique<PaddedVoxelArray>();
+	    UnpackPaddedVoxels(*paddedVoxels);
+	    mesh->UpdateData(paddedVoxels.get());
+	    mesh.MarkDirty();
+	    meshUpdatePending = false;
+    }
+
+    bool VoxelChunk::HasPendingMeshUpdate() const
+    {
+	    return meshUpdatePending;
+    }
+
+    void VoxelChunk::EditVoxels(const std::function<void(VoxelArray&)>& editFunction)
+    {
+	    const auto denseVoxels = std::make_unique<VoxelArray>();
+	    UnpackVoxels(*denseVoxels);
+	    editFunction(*denseVoxels);
+	    modifiedBorders |= GetModifiedBorders(*denseVoxels);
+	    voxels.Pack(denseVoxels->at(0).at(0).data());
+	    collisionRebuildPending = true;
+	    pendingUpdate = true;
+	    modifiedSinceSave = true;
+    }
+
+    void VoxelChunk::FillVoxels(const Voxel& voxel)
+    {
+	    voxels.Fill(voxel);
+	    modifiedBorders = (1 << neighbourCount) - 1;
+	    collisionRebuildPending = true;
+	    pendingUpdate = true;
+	    modifiedSinceSave = true;
+    }
+
+    bool VoxelChunk::HasPendingUpdate() const
+    {
+	    return pendingUpdate;
+    }
+
+    bool VoxelChunk::IsModifiedSinceSave() const
+    {
+	    return modifiedSinceSave;
+    }
+
+    void VoxelChunk::MarkSaved()
+    {
+	    modifiedSinceSave = false;
+    }
+
+    void VoxelChunk::MarkUnsaved()
+    {
+	    modifiedSinceSave = true;
+    }
+
+    VoxelChunk* VoxelChunk::GetNeighbour(const Neighbour neighbour) const
+    {
+	    return neighbours[static_cast<int>(neighbour)];
     }
 
-    glm::ivec2 VoxelChunk::GetChunkLocation() const
+    glm::ivec3 VoxelChunk::GetNeighbourOffset(const Neighbour neighbour)
+    {
+	    switch (neighbour)
+	    {
+	    case Neighbour::Left:
+	        return {-1, 0, 0};
+	    case Neighbour::Right:
+	        return {1, 0, 0};
+	    case Neighbour::Back:
+	        return {0, 0, -1};
+	    case Neighbour::Front:
+	        return {0, 0, 1};
+	    case Neighbour::Down:
+	        return {0, -1, 0};
+	    case Neighbour::Up:
+	        return {0, 1, 0};
+	    }
+	    return {0, 0, 0};
+    }
+
+    VoxelChunk::Neighbour VoxelChunk::GetOppositeNeighbour(const Neighbour neighbour)
+    {
+	    // Neighbours are stored in opposing pairs
+	    return static_cast<Neighbour>(static_cast<int>(neighbour) ^ 1);
+    }
+
+    glm::vec3 VoxelChunk::CalculatePosition(const glm::ivec3& position)
+    {
+	    return glm::vec3(position * chunkSize - chunkHalfSize);
+    }
+
+    glm::ivec3 VoxelChunk::GetChunkLocation() const
     {
         return chunkLocation;
     }
 
     std::string VoxelChunk::WriteString() const
     {
-        TypedNode<Voxel> octree(chunkSize);
-	    for (int x = 0 ; x < chunkSize; ++x)
+	    const auto denseVoxels = std::make_unique<VoxelArray>();
+	    UnpackVoxels(*denseVoxels);
+	    const std::string chunk = PackedOctree<Voxel, chunkSize>::Pack((*denseVoxels)[0][0].data(), [](const Voxel& voxel)
+	    {
+	        return static_cast<char>(voxel.materialId + 48);
+	    });
+	    return fmt::format("({},{},{}){}:{}", chunkLocation.x, chunkLocation.y, chunkLocation.z, chunk.size(), chunk);
+    }
+
+    bool VoxelChunk::ParseString(const std::string_view chunkData, glm::ivec3& locationOut, VoxelArray& voxelsOut)
+    {
+	    // Chunks are written as '(x,y,z)size:packedOctree'. Older worlds only had one layer of chunks, written as '(x,z)size:packedOctree'
+	    auto parseInt = [&chunkData](const size_t start, const char terminator, int& valueOut, size_t& endOut)
+	    {
+	        endOut = chunkData.find(terminator, start);
+	        if (endOut == std::string_view::npos)
+	        {
+	            return false;
+	        }
+	        const auto [pointer, error] = std::from_chars(chunkData.data() + start, chunkData.data() + endOut, valueOut);
+	        return error == std::errc() && pointer == chunkData.data() + endOut;
+	    };
+
+	    size_t cursor;
+	    if (chunkData.empty() || chunkData[0] != '(' || !parseInt(1, ',', locationOut.x, cursor))
+	    {
+	        return false;
+	    }
+
+	    const size_t closeBracket = chunkData.find(')', cursor + 1);
+	    if (const size_t comma = chunkData.find(',', cursor + 1); comma < closeBracket)
+	    {
+	        if (!parseInt(cursor + 1, ',', locationOut.y, cursor) || !parseInt(cursor + 1, ')', locationOut.z, cursor))
+	        {
+	            return false;
+	        }
+	    }
+	    else
+	    {
+	        locationOut.y = 0;
+	        if (!parseInt(cursor + 1, ')', locationOut.z, cursor))
+	        {
+	            return false;
+	        }
+	    }
+
+	    int chunkDataSize;
+	    if (!parseInt(cursor + 1, ':', chunkDataSize, cursor) ||
+	        chunkDataSize < 0 || cursor + 1 + chunkDataSize > chunkData.size())
+	    {
+	        return false;
+	    }
+
+	    const std::string_view chunkString = chunkData.substr(cursor + 1, chunkDataSize);
+
+	    // Fails quietly on a bad chunk, as this runs on worker threads
+	    return PackedOctree<Voxel, chunkSize>::Unpack(chunkString, voxelsOut[0][0].data(), [](const char c)
+	    {
+	        Voxel result;
+	        result.materialId = c - 48;
+	        return result;
+	    });
+    }
+
+    VoxelChunk::DecodedChunk VoxelChunk::Decode(const glm::ivec3& location, const VoxelArray& voxels)
+    {
+	    DecodedChunk result;
+	    result.location = location;
+	    result.voxels.Pack(voxels[0][0].data());
+	    result.collisionMask = VoxelBody::BuildCollisionMask(voxels);
+	    return result;
+    }
+
+    void VoxelChunk::UnpackVoxels(VoxelArray& voxelsOut) const
+    {
+	    static_assert(sizeof(VoxelArray) == sizeof(Voxel) * chunkVolume);
+	    voxels.Unpack(voxelsOut[0][0].data());
+    }
+
+    void VoxelChunk::UnpackPaddedVoxels(PaddedVoxelArray& voxelsOut) const
+    {
+	    voxelsOut = {};
+	    const auto denseVoxels = std::make_unique<VoxelArray>();
+	    UnpackVoxels(*denseVoxels);
+	    for (int x = 0; x < chunkSize; ++x)
 	    {
 	        for (int y = 0; y < chunkSize; ++y)
 	        {
-	            for (int z = 0; z < chunkSize; ++z)
+	            std::ranges::copy((*denseVoxels)[x][y], voxelsOut[x + 1][y + 1].begin() + 1);
+	        }
+	    }
+
+	    // Each face of the apron is the neighbour's border on the side facing this chunk
+	    for (int i = 0; i < neighbourCount; ++i)
+	    {
+	        const VoxelChunk* neighbour = neighbours[i];
+	        if (!neighbour)
+	        {
+	            continue;
+	        }
+
+	        const glm::ivec3 apronOffset = GetNeighbourOffset(static_cast<Neighbour>(i)) * chunkSize + 1;
+	        ForEachBorderVoxel(GetOppositeNeighbour(static_cast<Neighbour>(i)), [&](const glm::ivec3& position)
+	        {
+	            const glm::ivec3 paddedPosition = position + apronOffset;
+	            voxelsOut[paddedPosition.x][paddedPosition.y][paddedPosition.z] = neighbour->voxels.Get(GetVoxelIndex(glm::uvec3(position)));
+	        });
+	    }
+    }
+
+    const PalettedVoxelStorage& VoxelChunk::GetVoxelStorage() const
+    {
+	    return voxels;
+    }
+
+    size_t VoxelChunk::GetMeshMemoryUsage() const
+    {
+	    return mesh->GetGpuMemoryUsage();
+    }
+
+    unsigned int VoxelChunk::GetVoxelIndex(const glm::uvec3 voxelPosition)
+    {
+	    return (voxelPosition.x * chunkSize + voxelPosition.y) * chunkSize + voxelPosition.z;
+    }
+
+    uint8_t VoxelChunk::GetModifiedBorders(const VoxelArray& editedVoxels) const
+    {
+	    uint8_t result = 0;
+	    for (int i = 0; i < neighbourCount; ++i)
+	    {
+	        ForEachBorderVoxel(static_cast<Neighbour>(i), [&](const glm::ivec3& position)
+	        {
+	            if (editedVoxels[position.x][position.y][position.z] != voxels.Get(GetVoxelIndex(glm::uvec3(position))))
 	            {
-	                const Voxel& voxel = voxels->at(x).at(y).at(z);
-	                if (voxel.materialId == 0)
-	                {
-	                    continue;
-	                }
-	                octree.SetData(x - chunkHalfSize, y - chunkHalfSize, z - chunkHalfSize, voxel);
+	                result |= 1 << i;
 	            }
-	        }
+	        });
 	    }
-	    const std::string data = octree.GetPacked([](const Voxel& voxel){ return voxel.materialId + 48; });
-	    const std::string chunk = {data.begin(), data.end()};
-	    return fmt::format("({},{}){}:{}", chunkLocation.x, chunkLocation.y, chunk.size(), chunk);
+	    return result;
     }
 }
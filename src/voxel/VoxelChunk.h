@@ -1,13 +1,17 @@
 #pragma once
 
 #include <array>
+#include <cstdint>
+#include <functional>
 #include <memory>
+#include <optional>
 
 #include <glm/glm.hpp>
 
 #include "core/datatypes/DynamicRef.h"
 #include "physics/VoxelBody.h"
 #include "voxel/CollisionOctree.h"
+#include "voxel/PalettedVoxelStorage.h"
 #include "voxel/Voxel.h"
 
 namespace Vox
@@ -24,36 +28,192 @@ namespace Vox
 
 	class VoxelChunk
 	{
+	    friend class VoxelChunkMap;
+
 	public:
-		VoxelChunk(glm::ivec2 chunkLocation, const World* world);
+	    enum class Neighbour : char
+	    {
+	        Left,
+	        Right,
+	        Back,
+	        Front,
+	        Down,
+	        Up
+	    };
+
+	    static constexpr int neighbourCount = 6;
 
-	    VoxelChunk(const std::string_view& chunkData, const World* world);
+		static constexpr int chunkSize = 32;
+	    static constexpr int chunkHalfSize = chunkSize / 2;
+	    static constexpr int chunkVolume = chunkSize * chunkSize * chunkSize;
+
+	    using VoxelArray = std::array<std::array<std::array<Voxel, chunkSize>, chunkSize>, chunkSize>;
+
+	    static constexpr int paddedChunkSize = chunkSize + 2;
+
+	    /**
+	     * @brief A chunk's voxels with a one voxel apron copied from its neighbours, indexed by [x + 1][y + 1][z + 1]
+	     * Only the six faces of the apron are filled, its edges and corners are always empty
+	     */
+	    using PaddedVoxelArray = std::array<std::array<std::array<Voxel, paddedChunkSize>, paddedChunkSize>, paddedChunkSize>;
+
+		VoxelChunk(glm::ivec3 chunkLocation, const World* world);
+
+	    /**
+	     * @brief Chunk contents that have been decoded and packed, but have no GPU or physics resources yet
+	     * Decoding only touches this struct, so it can run on worker threads
+	     */
+	    struct DecodedChunk
+	    {
+	        glm::ivec3 location = {0, 0, 0};
+	        PalettedVoxelStorage voxels = PalettedVoxelStorage(chunkVolume);
+	        std::unique_ptr<Octree::CollisionNode> collisionMask;
+	    };
+
+	    /**
+	     * @brief Create a chunk from decoded contents. This creates the mesh and body, so it has to run on the main thread
+	     * The mesh is only filled in by UpdateMesh, once the chunk has been linked to its neighbours
+	     */
+	    VoxelChunk(DecodedChunk&& decodedChunk, const World* world);
+
+	    /**
+	     * @brief Releases the mesh and physics body of this chunk
+	     */
+	    ~VoxelChunk();
+
+	    // Neighbouring chunks hold pointers to this chunk, so it has to stay in place
+	    VoxelChunk(VoxelChunk&&) = delete;
+	    VoxelChunk(const VoxelChunk&) = delete;
+	    VoxelChunk& operator=(VoxelChunk&&) = delete;
+	    VoxelChunk& operator=(const VoxelChunk&) = delete;
 
 		void SetVoxel(glm::uvec3 voxelPosition, Voxel voxel);
 
 		[[nodiscard]] Voxel GetVoxel(glm::uvec3 voxelPosition) const;
 
+	    /**
+	     * @brief Get a voxel relative to this chunk, reading from a neighbouring chunk if the position is just outside it
+	     * @return The voxel, or nullopt if the neighbour isn't loaded
+	     */
+	    [[nodiscard]] std::optional<Voxel> GetVoxelOrNeighbour(const glm::ivec3& voxelPosition) const;
+
+	    /**
+	     * @brief Edit the voxels of this chunk in bulk, through a dense array
+	     * The collision mask is rebuilt once on the next FinalizeUpdate, rather than per voxel
+	     * @param editFunction function that modifies the dense voxel array, indexed by [x][y][z]
+	     */
+	    void EditVoxels(const std::function<void(VoxelArray&)>& editFunction);
+
+	    /**
+	     * @brief Replace every voxel in this chunk
+	     */
+	    void FillVoxels(const Voxel& voxel);
+
+	    /**
+	     * @brief Apply the edits made since the last call to the collision, and flag this chunk's mesh for an update
+	     * Neighbours are flagged too when a voxel on the border they share changed, since it hides or reveals their faces
+	     */
 		void FinalizeUpdate();
 
-		static constexpr int chunkSize = 32;
-	    static constexpr int chunkHalfSize = chunkSize / 2;
+	    /**
+	     * @brief Send the voxels and their apron to the mesh, to be regenerated
+	     */
+	    void UpdateMesh();
+
+	    /**
+	     * @brief Whether the mesh is out of date, after an update to this chunk or to a border of a neighbour
+	     */
+	    [[nodiscard]] bool HasPendingMeshUpdate() const;
+
+	    /**
+	     * @brief Whether this chunk has been modified since the last FinalizeUpdate
+	     */
+	    [[nodiscard]] bool HasPendingUpdate() const;
 
-	    static glm::vec3 CalculatePosition(const glm::ivec2& position);
+	    /**
+	     * @brief Whether this chunk has been modified since it was last saved or loaded
+	     */
+	    [[nodiscard]] bool IsModifiedSinceSave() const;
 
-	    [[nodiscard]] glm::ivec2 GetChunkLocation() const;
+	    void MarkSaved();
+
+	    /**
+	     * @brief Flag this chunk to be written by the next save, e.g. when its contents didn't come from the saved file
+	     */
+	    void MarkUnsaved();
+
+	    [[nodiscard]] VoxelChunk* GetNeighbour(Neighbour neighbour) const;
+
+	    [[nodiscard]] static glm::ivec3 GetNeighbourOffset(Neighbour neighbour);
+
+	    [[nodiscard]] static Neighbour GetOppositeNeighbour(Neighbour neighbour);
+
+	    static glm::vec3 CalculatePosition(const glm::ivec3& position);
+
+	    [[nodiscard]] glm::ivec3 GetChunkLocation() const;
 
 	    [[nodiscard]] std::string WriteString() const;
 
+	    /**
+	     * @brief Parse a chunk written by WriteString
+	     * @return false if the chunk string is malformed
+	     */
+	    [[nodiscard]] static bool ParseString(std::string_view chunkData, glm::ivec3& locationOut, VoxelArray& voxelsOut);
+
+	    /**
+	     * @brief Pack dense voxels and build their collision mask, without creating any resources
+	     */
+	    [[nodiscard]] static DecodedChunk Decode(const glm::ivec3& location, const VoxelArray& voxels);
+
+	    /**
+	     * @brief Decompress the voxels into a dense array, indexed by [x][y][z]
+	     */
+	    void UnpackVoxels(VoxelArray& voxelsOut) const;
+
+	    /**
+	     * @brief Decompress the voxels, along with the borders of the loaded neighbours. Missing neighbours are left empty
+	     */
+	    void UnpackPaddedVoxels(PaddedVoxelArray& voxelsOut) const;
+
+	    [[nodiscard]] const PalettedVoxelStorage& GetVoxelStorage() const;
+
+	    /**
+	     * @brief Bytes of the voxel geometry arena taken by this chunk's mesh
+	     */
+	    [[nodiscard]] size_t GetMeshMemoryUsage() const;
+
 	private:
-		glm::ivec2 chunkLocation;
+	    static unsigned int GetVoxelIndex(glm::uvec3 voxelPosition);
+
+	    /**
+	     * @brief Get the borders that differ between the stored voxels and an edited copy of them
+	     * @return A mask with bit n set for Neighbour n
+	     */
+	    [[nodiscard]] uint8_t GetModifiedBorders(const VoxelArray& editedVoxels) const;
+
+		glm::ivec3 chunkLocation;
+
+	    const World* world;
 
 		DynamicRef<VoxelMesh> mesh;
 
 		DynamicRef<VoxelBody> body;
 
-		std::unique_ptr<std::array<std::array<std::array<Voxel, chunkSize>, chunkSize>, chunkSize>> voxels;
+		PalettedVoxelStorage voxels = PalettedVoxelStorage(chunkVolume);
+
+	    std::array<VoxelChunk*, neighbourCount> neighbours = {};
+
+	    bool pendingUpdate = false;
+
+	    bool meshUpdatePending = false;
+
+	    // Borders touched by edits since the last FinalizeUpdate, with bit n set for Neighbour n
+	    uint8_t modifiedBorders = 0;
+
+	    bool modifiedSinceSave = false;
 
-	    std::vector<int> modifiedMaterialIds;
+	    // Set by edits that change which voxels are solid, the collision mask is rebuilt once in FinalizeUpdate
+	    bool collisionRebuildPending = false;
 
 		Octree::CollisionNode voxelCollisionMask = Octree::CollisionNode(chunkSize);
 	};
@@ -0,0 +1,199 @@
+#include "VoxelChunkMap.h"
+
+#include <algorithm>
+#include <cassert>
+
+#include "core/logging/Logging.h"
+#include "core/math/Formatting.h"
+#include "voxel/VoxelChunk.h"
+
+namespace Vox
+{
+    VoxelChunkMap::VoxelChunkMap()
+    {
+        constexpr size_t initialSlotCount = 64;
+        slots.resize(initialSlotCount);
+    }
+
+    VoxelChunkMap::~VoxelChunkMap()
+    = default;
+
+    VoxelChunk* VoxelChunkMap::Find(const glm::ivec3& chunkLocation) const
+    {
+        const Slot& slot = slots[FindSlot(PackKey(chunkLocation))];
+        return slot.chunkIndex == emptySlot ? nullptr : chunks[slot.chunkIndex].get();
+    }
+
+    VoxelChunk& VoxelChunkMap::Insert(std::unique_ptr<VoxelChunk> chunk)
+    {
+        assert(chunk);
+        const uint64_t key = PackKey(chunk->GetChunkLocation());
+        if (const Slot& existingSlot = slots[FindSlot(key)]; existingSlot.chunkIndex != emptySlot)
+        {
+            VoxLog(Warning, Game, "Chunk at '{}' was already loaded. The new chunk will be discarded.", chunk->GetChunkLocation());
+            return *chunks[existingSlot.chunkIndex];
+        }
+
+        if ((chunks.size() + 1) * 2 > slots.size())
+        {
+            Grow();
+        }
+
+        Slot& slot = slots[FindSlot(key)];
+        slot.key = key;
+        slot.chunkIndex = static_cast<uint32_t>(chunks.size());
+
+        VoxelChunk& result = *chunks.emplace_back(std::move(chunk));
+        LinkNeighbours(result);
+        return result;
+    }
+
+    std::unique_ptr<VoxelChunk> VoxelChunkMap::Erase(const glm::ivec3& chunkLocation)
+    {
+        size_t slotIndex = FindSlot(PackKey(chunkLocation));
+        const uint32_t chunkIndex = slots[slotIndex].chunkIndex;
+        if (chunkIndex == emptySlot)
+        {
+            return nullptr;
+        }
+
+        // Backward shift deletion, so lookups never need tombstones
+        const size_t mask = slots.size() - 1;
+        size_t nextIndex = slotIndex;
+        while (true)
+        {
+            nextIndex = (nextIndex + 1) & mask;
+            if (slots[nextIndex].chunkIndex == emptySlot)
+            {
+                break;
+            }
+
+            // Only move the entry back if its home slot is not between the hole and its current slot
+            const size_t homeIndex = GetHomeSlot(slots[nextIndex].key);
+            if (((nextIndex - homeIndex) & mask) >= ((nextIndex - slotIndex) & mask))
+            {
+                slots[slotIndex] = slots[nextIndex];
+                slotIndex = nextIndex;
+            }
+        }
+        slots[slotIndex] = Slot();
+
+        std::unique_ptr<VoxelChunk> result = std::move(chunks[chunkIndex]);
+        UnlinkNeighbours(*result);
+
+        // Swap the last chunk into the hole
+        if (chunkIndex != chunks.size() - 1)
+        {
+            chunks[chunkIndex] = std::move(chunks.back());
+            slots[FindSlot(PackKey(chunks[chunkIndex]->GetChunkLocation()))].chunkIndex = chunkIndex;
+        }
+        chunks.pop_back();
+
+        return result;
+    }
+
+    void VoxelChunkMap::Clear()
+    {
+        for (const std::unique_ptr<VoxelChunk>& chunk : chunks)
+        {
+            chunk->neighbours = {};
+        }
+        chunks.clear();
+        std::ranges::fill(slots, Slot());
+    }
+
+    size_t VoxelChunkMap::size() const
+    {
+        return chunks.size();
+    }
+
+    const std::vector<std::unique_ptr<VoxelChunk>>& VoxelChunkMap::GetChunks() const
+    {
+        return chunks;
+    }
+
+    uint64_t VoxelChunkMap::PackKey(const glm::ivec3& chunkLocation)
+    {
+        assert(chunkLocation.x >= -(1 << 23) && chunkLocation.x < 1 << 23);
+        assert(chunkLocation.y >= -(1 << 15) && chunkLocation.y < 1 << 15);
+        assert(chunkLocation.z >= -(1 << 23) && chunkLocation.z < 1 << 23);
+        return (static_cast<uint64_t>(static_cast<uint32_t>(chunkLocation.x) & 0xFFFFFF) << 40) |
+            (static_cast<uint64_t>(static_cast<uint16_t>(chunkLocation.y)) << 24) |
+            (static_cast<uint32_t>(chunkLocation.z) & 0xFFFFFF);
+    }
+
+    glm::ivec3 VoxelChunkMap::UnpackKey(const uint64_t key)
+    {
+        // Shift each field to the top of the word, then arithmetic shift back down to sign extend it
+        return {
+            static_cast<int32_t>(static_cast<uint32_t>(key >> 40) << 8) >> 8,
+            static_cast<int16_t>(static_cast<uint16_t>(key >> 24)),
+            static_cast<int32_t>(static_cast<uint32_t>(key & 0xFFFFFF) << 8) >> 8
+        };
+    }
+
+    size_t VoxelChunkMap::FindSlot(const uint64_t key) const
+    {
+        const size_t mask = slots.size() - 1;
+        size_t slotIndex = GetHomeSlot(key);
+        while (slots[slotIndex].chunkIndex != emptySlot && slots[slotIndex].key != key)
+        {
+            slotIndex = (slotIndex + 1) & mask;
+        }
+        return slotIndex;
+    }
+
+    size_t VoxelChunkMap::GetHomeSlot(uint64_t key) const
+    {
+        // splitmix64 finalizer, neighbouring chunk coordinates should land far apart
+        key ^= key >> 30;
+        key *= 0xbf58476d1ce4e5b9ull;
+        key ^= key >> 27;
+        key *= 0x94d049bb133111ebull;
+        key ^= key >> 31;
+        return static_cast<size_t>(key) & (slots.size() - 1);
+    }
+
+    void VoxelChunkMap::Grow()
+    {
+        const std::vector<Slot> oldSlots = std::move(slots);
+        slots = std::vector<Slot>(oldSlots.size() * 2);
+        for (const Slot& slot : oldSlots)
+        {
+            if (slot.chunkIndex != emptySlot)
+            {
+                slots[FindSlot(slot.key)] = slot;
+            }
+        }
+    }
+
+    void VoxelChunkMap::LinkNeighbours(VoxelChunk& chunk) const
+    {
+        for (int i = 0; i < VoxelChunk::neighbourCount; ++i)
+        {
+            const auto direction = static_cast<VoxelChunk::Neighbour>(i);
+            VoxelChunk* neighbour = Find(chunk.GetChunkLocation() + VoxelChunk::GetNeighbourOffset(direction));
+            chunk.neighbours[i] = neighbour;
+            if (neighbour)
+            {
+                neighbour->neighbours[static_cast<int>(VoxelChunk::GetOppositeNeighbour(direction))] = &chunk;
+
+                // The new chunk can hide faces on the neighbour's border
+                neighbour->meshUpdatePending = true;
+            }
+        }
+    }
+
+    void VoxelChunkMap::UnlinkNeighbours(VoxelChunk& chunk)
+    {
+        for (int i = 0; i < VoxelChunk::neighbourCount; ++i)
+        {
+            if (VoxelChunk* neighbour = chunk.neighbours[i])
+            {
+                neighbour->neighbours[static_cast<int>(VoxelChunk::GetOppositeNeighbour(static_cast<VoxelChunk::Neighbour>(i)))] = nullptr;
+                neighbour->meshUpdatePending = true;
+            }
+            chunk.neighbours[i] = nullptr;
+        }
+    }
+}
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include <glm/vec3.hpp>
+
+namespace Vox
+{
+    class VoxelChunk;
+
+    /**
+     * @brief Open-addressing hash index of voxel chunks, keyed on packed chunk coordinates
+     * Chunks are heap allocated so their addresses stay stable, which lets each
+     * chunk keep direct pointers to its neighbours. The map keeps those links up to date.
+     */
+    class VoxelChunkMap
+    {
+        static constexpr uint32_t emptySlot = UINT32_MAX;
+
+        struct Slot
+        {
+            uint64_t key = 0;
+            uint32_t chunkIndex = emptySlot;
+        };
+
+    public:
+        VoxelChunkMap();
+        ~VoxelChunkMap();
+
+        VoxelChunkMap(VoxelChunkMap&&) = delete;
+        VoxelChunkMap(const VoxelChunkMap&) = delete;
+        VoxelChunkMap& operator=(VoxelChunkMap&&) = delete;
+        VoxelChunkMap& operator=(const VoxelChunkMap&) = delete;
+
+        [[nodiscard]] VoxelChunk* Find(const glm::ivec3& chunkLocation) const;
+
+        /**
+         * @brief Add a chunk to the map, and link it with any loaded neighbours
+         * The neighbours are flagged for a mesh update, since their borders may now be hidden
+         * @return The chunk in the map. If a chunk already exists at that location, the existing chunk is kept
+         */
+        VoxelChunk& Insert(std::unique_ptr<VoxelChunk> chunk);
+
+        /**
+         * @brief Remove a chunk from the map, and unlink it from its neighbours
+         * The neighbours are flagged for a mesh update, since their borders are no longer hidden
+         * @return The removed chunk, or nullptr if no chunk exists at that location
+         */
+        std::unique_ptr<VoxelChunk> Erase(const glm::ivec3& chunkLocation);
+
+        void Clear();
+
+        [[nodiscard]] size_t size() const;
+
+        [[nodiscard]] const std::vector<std::unique_ptr<VoxelChunk>>& GetChunks() const;
+
+        /**
+         * @brief Pack chunk coordinates into a single key, 24 bits for x and z and 16 bits for y
+         * Chunks have to stay within those ranges, which is roughly 268 million voxels horizontally and 2 million vertically
+         */
+        [[nodiscard]] static uint64_t PackKey(const glm::ivec3& chunkLocation);
+
+        [[nodiscard]] static glm::ivec3 UnpackKey(uint64_t key);
+
+    private:
+        [[nodiscard]] size_t FindSlot(uint64_t key) const;
+
+        [[nodiscard]] size_t GetHomeSlot(uint64_t key) const;
+
+        void Grow();
+
+        void LinkNeighbours(VoxelChunk& chunk) const;
+
+        static void UnlinkNeighbours(VoxelChunk& chunk);
+
+        // Always a power of two, and kept at most half full
+        std::vector<Slot> slots;
+
+        std::vector<std::unique_ptr<VoxelChunk>> chunks;
+    };
+}
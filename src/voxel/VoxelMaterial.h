@@ -22,5 +22,7 @@ namespace Vox
         uint top;
         uint bottom;
     };
+    // Uploaded as is to the material table in voxelGeneration.comp, which uses the std430 layout
+    static_assert(sizeof(VoxelMaterial) == 6 * sizeof(unsigned int));
 
 } // Vox
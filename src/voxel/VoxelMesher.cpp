@@ -0,0 +1,277 @@
+#include "VoxelMesher.h"
+
+#include <bit>
+#include <cstddef>
+
+namespace Vox
+{
+    namespace
+    {
+        struct FaceLayout
+        {
+            glm::ivec3 offset;
+            glm::ivec3 widthAxis;
+            glm::ivec3 heightAxis;
+
+            // The shader writes some faces back to front, to keep them facing outwards
+            bool reversed;
+        };
+
+        // Indexed by VoxelFace, copied from the atomicInsertQuad functions in voxelGeneration.comp
+        const std::array<FaceLayout, voxelFaceCount> faceLayouts = {{
+            {{0, 1, 0}, {1, 0, 0}, {0, 0, 1}, true},
+            {{0, 0, 0}, {1, 0, 0}, {0, 0, 1}, false},
+            {{0, 0, 0}, {0, 0, 1}, {0, 1, 0}, false},
+            {{1, 0, 0}, {0, 0, 1}, {0, 1, 0}, true},
+            {{0, 0, 1}, {1, 0, 0}, {0, 1, 0}, false},
+            {{0, 0, 0}, {1, 0, 0}, {0, 1, 0}, true}
+        }};
+
+        // Two triangles per quad, as fractions of the quad's width and height
+        constexpr std::array<glm::ivec2, 6> quadCorners = {{{0, 0}, {1, 0}, {0, 1}, {1, 1}, {0, 1}, {1, 0}}};
+
+        unsigned int GetFaceTexture(const VoxelMaterial& material, const VoxelFace face)
+        {
+            switch (face)
+            {
+            case VoxelFace::Top:
+                return material.top;
+            case VoxelFace::Bottom:
+                return material.bottom;
+            case VoxelFace::Left:
+                return material.left;
+            case VoxelFace::Right:
+                return material.right;
+            case VoxelFace::Front:
+                return material.front;
+            case VoxelFace::Back:
+                return material.back;
+            }
+            return 0;
+        }
+    }
+
+    void VoxelMesher::GenerateMesh(const VoxelChunk::PaddedVoxelArray& voxels, const std::vector<VoxelMaterial>& materials,
+        std::vector<VoxelVertex>& verticesOut)
+    {
+        verticesOut.clear();
+
+        // Every voxel with a material hides the faces next to it, but only materials in the table are meshed
+        // Solid rows include the apron, indexed by [x + 1][y + 1], with the apron's z ends kept separately
+        std::array<std::array<uint32_t, size + 2>, size + 2> solidRows = {};
+        RowVolume solidBefore = {};
+        RowVolume solidAfter = {};
+        RowVolume meshedRows = {};
+        for (int x = 0; x < size + 2; ++x)
+        {
+            for (int y = 0; y < size + 2; ++y)
+            {
+                for (int z = 0; z < size; ++z)
+                {
+                    solidRows[x][y] |= voxels[x][y][z + 1].materialId != 0 ? 1u << z : 0u;
+                }
+            }
+        }
+        for (int x = 0; x < size; ++x)
+        {
+            for (int y = 0; y < size; ++y)
+            {
+                solidBefore[x][y] = voxels[x + 1][y + 1][0].materialId != 0 ? 1u : 0u;
+                solidAfter[x][y] = voxels[x + 1][y + 1][size + 1].materialId != 0 ? 1u << (size - 1) : 0u;
+                for (int z = 0; z < size; ++z)
+                {
+                    const unsigned int materialId = voxels[x + 1][y + 1][z + 1].materialId;
+                    meshedRows[x][y] |= materialId != 0 && materialId <= materials.size() ? 1u << z : 0u;
+                }
+            }
+        }
+
+        // A face is exposed where a voxel is next to air, in this chunk or in the apron
+        for (int faceIndex = 0; faceIndex < voxelFaceCount; ++faceIndex)
+        {
+            const auto face = static_cast<VoxelFace>(faceIndex);
+            RowVolume faceRows;
+            for (int x = 0; x < size; ++x)
+            {
+                for (int y = 0; y < size; ++y)
+                {
+                    uint32_t coveredRow = 0;
+                    switch (face)
+                    {
+                    case VoxelFace::Top:
+                        coveredRow = solidRows[x + 1][y + 2];
+                        break;
+                    case VoxelFace::Bottom:
+                        coveredRow = solidRows[x + 1][y];
+                        break;
+                    case VoxelFace::Left:
+                        coveredRow = solidRows[x][y + 1];
+                        break;
+                    case VoxelFace::Right:
+                        coveredRow = solidRows[x + 2][y + 1];
+                        break;
+                    case VoxelFace::Front:
+                        coveredRow = solidRows[x + 1][y + 1] >> 1 | solidAfter[x][y];
+                        break;
+                    case VoxelFace::Back:
+                        coveredRow = solidRows[x + 1][y + 1] << 1 | solidBefore[x][y];
+                        break;
+                    }
+                    faceRows[x][y] = meshedRows[x][y] & ~coveredRow;
+                }
+            }
+            AppendFaces(face, faceRows, voxels, materials, verticesOut);
+        }
+    }
+
+    void VoxelMesher::AppendFaces(const VoxelFace face, const RowVolume& faceRows, const VoxelChunk::PaddedVoxelArray& voxels,
+        const std::vector<VoxelMaterial>& materials, std::vector<VoxelVertex>& verticesOut)
+    {
+        const auto appendQuad = [&](const glm::ivec3& origin, const int width, const int height, const unsigned int materialId)
+        {
+            AppendQuad(face, origin, width, height, GetFaceTexture(materials[materialId - 1], face), verticesOut);
+        };
+
+        // Each face direction is sliced along its normal, with rows and bits in the shader's scan order
+        switch (face)
+        {
+        case VoxelFace::Top:
+        case VoxelFace::Bottom:
+            for (int y = 0; y < size; ++y)
+            {
+                // Rows of z, with a bit per x
+                Rows slice;
+                for (int x = 0; x < size; ++x)
+                {
+                    slice[x] = faceRows[x][y];
+                }
+                Transpose(slice);
+                MergeSlice(slice, [&](const int z, const int x)
+                {
+                    return voxels[x + 1][y + 1][z + 1].materialId;
+                }, [&](const int x, const int z, const int width, const int height, const unsigned int materialId)
+                {
+                    appendQuad({x, y, z}, width, height, materialId);
+                });
+            }
+            break;
+        case VoxelFace::Left:
+        case VoxelFace::Right:
+            for (int x = 0; x < size; ++x)
+            {
+                // Rows of y, with a bit per z
+                Rows slice = faceRows[x];
+                MergeSlice(slice, [&](const int y, const int z)
+                {
+                    return voxels[x + 1][y + 1][z + 1].materialId;
+                }, [&](const int z, const int y, const int width, const int height, const unsigned int materialId)
+                {
+                    appendQuad({x, y, z}, width, height, materialId);
+                });
+            }
+            break;
+        case VoxelFace::Front:
+        case VoxelFace::Back:
+        {
+            // Indexed by [z][y], with a bit per x
+            RowVolume slices;
+            for (int y = 0; y < size; ++y)
+            {
+                Rows column;
+                for (int x = 0; x < size; ++x)
+                {
+                    column[x] = faceRows[x][y];
+                }
+                Transpose(column);
+                for (int z = 0; z < size; ++z)
+                {
+                    slices[z][y] = column[z];
+                }
+            }
+
+            for (int z = 0; z < size; ++z)
+            {
+                MergeSlice(slices[z], [&](const int y, const int x)
+                {
+                    return voxels[x + 1][y + 1][z + 1].materialId;
+                }, [&](const int x, const int y, const int width, const int height, const unsigned int materialId)
+                {
+                    appendQuad({x, y, z}, width, height, materialId);
+                });
+            }
+            break;
+        }
+        }
+    }
+
+    template <typename MaterialFunction, typename QuadFunction>
+    void VoxelMesher::MergeSlice(Rows& rows, const MaterialFunction& getMaterial, const QuadFunction& function)
+    {
+        // Bits of a row that have the given material, limited to the bits that are set in the row
+        const auto matchingBits = [&](const int row, const uint32_t bits, const unsigned int materialId)
+        {
+            uint32_t result = 0;
+            for (uint32_t remaining = bits; remaining != 0; remaining &= remaining - 1)
+            {
+                const int bit = std::countr_zero(remaining);
+                result |= getMaterial(row, bit) == materialId ? 1u << bit : 0u;
+            }
+            return result;
+        };
+
+        for (int row = 0; row < size; ++row)
+        {
+            while (rows[row] != 0)
+            {
+                const int start = std::countr_zero(rows[row]);
+                const unsigned int materialId = getMaterial(row, start);
+
+                // Quads only grow over exposed faces of the same material
+                const uint32_t runBits = rows[row] >> start;
+                const int runWidth = std::countr_one(runBits);
+                const uint32_t runMask = (runWidth == size ? UINT32_MAX : (1u << runWidth) - 1) << start;
+                const int width = std::countr_one(matchingBits(row, rows[row] & runMask, materialId) >> start);
+                const uint32_t quadBits = (width == size ? UINT32_MAX : (1u << width) - 1) << start;
+                rows[row] &= ~quadBits;
+
+                int height = 1;
+                for (; row + height < size && (rows[row + height] & quadBits) == quadBits &&
+                    matchingBits(row + height, quadBits, materialId) == quadBits; ++height)
+                {
+                    rows[row + height] &= ~quadBits;
+                }
+                function(start, row, width, height, materialId);
+            }
+        }
+    }
+
+    void VoxelMesher::Transpose(Rows& rows)
+    {
+        // Swap progressively smaller blocks across the diagonal, 16x16 first and 1x1 last
+        uint32_t mask = 0x0000FFFF;
+        for (int blockSize = 16; blockSize != 0; blockSize >>= 1, mask ^= mask << blockSize)
+        {
+            for (int row = 0; row < size; row = (row + blockSize + 1) & ~blockSize)
+            {
+                const uint32_t swapped = ((rows[row] >> blockSize) ^ rows[row + blockSize]) & mask;
+                rows[row] ^= swapped << blockSize;
+                rows[row + blockSize] ^= swapped;
+            }
+        }
+    }
+
+    void VoxelMesher::AppendQuad(const VoxelFace face, const glm::ivec3& origin, const int width, const int height,
+        const unsigned int texture, std::vector<VoxelVertex>& verticesOut)
+    {
+        const FaceLayout& layout = faceLayouts[static_cast<int>(face)];
+        const size_t firstIndex = verticesOut.size();
+        verticesOut.resize(firstIndex + quadCorners.size());
+        for (size_t i = 0; i < quadCorners.size(); ++i)
+        {
+            const glm::ivec2 texCoord = quadCorners[i] * glm::ivec2(width, height);
+            const glm::ivec3 position = origin + layout.offset + layout.widthAxis * texCoord.x + layout.heightAxis * texCoord.y;
+            verticesOut[firstIndex + (layout.reversed ? quadCorners.size() - 1 - i : i)] =
+                VoxelVertex::Pack(glm::uvec3(position), face, glm::uvec2(texCoord), texture);
+        }
+    }
+}
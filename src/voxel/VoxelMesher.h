@@ -0,0 +1,67 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include <glm/vec3.hpp>
+
+#include "voxel/VoxelChunk.h"
+#include "voxel/VoxelMaterial.h"
+#include "voxel/VoxelVertex.h"
+
+namespace Vox
+{
+    /**
+     * @brief Greedy mesher that runs on the CPU, producing the same quads as voxelGeneration.comp
+     * Faces are found with bitwise operations on 32-bit occupancy rows, one bit per voxel, and each
+     * slice is merged with the same scan order as the shader. Every material is meshed in the same pass,
+     * so the cost depends on the chunk's contents rather than on the number of materials. Doesn't touch
+     * any GL or shared state, so chunks can be meshed on worker threads
+     */
+    class VoxelMesher
+    {
+    public:
+        /**
+         * @brief Build the mesh for a chunk, in the same vertex layout and winding as voxelGeneration.comp
+         * Quads are ordered by face, then slice. The shader appends them in whatever order its invocations finish
+         * @param voxels chunk voxels with the apron from its neighbours, see VoxelChunk::UnpackPaddedVoxels.
+         * Faces hidden by a neighbouring chunk are culled, the apron itself isn't meshed
+         * @param materials voxel materials, where material id n uses materials[n - 1]. Voxels without a material aren't meshed
+         * @param verticesOut cleared, then filled with 6 vertices per quad
+         */
+        static void GenerateMesh(const VoxelChunk::PaddedVoxelArray& voxels, const std::vector<VoxelMaterial>& materials,
+            std::vector<VoxelVertex>& verticesOut);
+
+    private:
+        static constexpr int size = VoxelChunk::chunkSize;
+
+        // One bit per voxel along the row, bit n is set if the voxel at n is included
+        using Rows = std::array<uint32_t, size>;
+
+        // Rows of a whole chunk, indexed by [x][y], with one bit per z
+        using RowVolume = std::array<Rows, size>;
+
+        static void AppendFaces(VoxelFace face, const RowVolume& faceRows, const VoxelChunk::PaddedVoxelArray& voxels,
+            const std::vector<VoxelMaterial>& materials, std::vector<VoxelVertex>& verticesOut);
+
+        /**
+         * @brief Merge the set bits of a slice into quads, in the same order as the shader
+         * The slice is scanned row by row, and each quad is grown along its row first, then across rows,
+         * as long as every voxel it covers has the same material as its first one
+         * @param rows the slice, cleared as quads are found
+         * @param getMaterial called with a row index and row bit, returns the material id of that voxel
+         * @param function called with the row bit, row index, width, height and material id of each quad
+         */
+        template <typename MaterialFunction, typename QuadFunction>
+        static void MergeSlice(Rows& rows, const MaterialFunction& getMaterial, const QuadFunction& function);
+
+        /**
+         * @brief Transpose a 32x32 bit matrix, so bit j of row i moves to bit i of row j
+         */
+        static void Transpose(Rows& rows);
+
+        static void AppendQuad(VoxelFace face, const glm::ivec3& origin, int width, int height, unsigned int texture,
+            std::vector<VoxelVertex>& verticesOut);
+    };
+}
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <cstddef>
+
+namespace Vox
+{
+    /**
+     * @brief Controls which voxel chunks stay loaded around the focus point, see VoxelWorld::UpdateStreaming
+     * Radii are measured in chunks
+     */
+    struct VoxelStreamingSettings
+    {
+        // When disabled, every chunk in the file is loaded up front and kept loaded
+        bool enabled = false;
+
+        int loadRadius = 8;
+
+        // Chunks are only unloaded once they are this far away, so chunks on the load radius don't reload every frame
+        int unloadRadius = 10;
+
+        // Once loaded chunks use more than this, the least recently used chunks outside the load radius are unloaded early
+        size_t memoryBudgetMiB = 2048;
+
+        // Limits on the work done each frame
+        int maxPendingLoads = 32;
+        int maxChunksCreatedPerFrame = 4;
+    };
+}
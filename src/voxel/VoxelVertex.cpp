@@ -0,0 +1,63 @@
+#include "VoxelVertex.h"
+
+#include <cassert>
+
+namespace Vox
+{
+    VoxelVertex VoxelVertex::Pack(const glm::uvec3& position, const VoxelFace face, const glm::uvec2& texCoord, const unsigned int texture)
+    {
+        assert(position.x <= maxAxisValue && position.y <= maxAxisValue && position.z <= maxAxisValue);
+        assert(texCoord.x <= maxAxisValue && texCoord.y <= maxAxisValue);
+        assert(texture <= maxTexture);
+
+        VoxelVertex result;
+        result.positionFace = position.x | position.y << axisBits | position.z << 2 * axisBits |
+            static_cast<uint32_t>(face) << 3 * axisBits;
+        result.texCoordTexture = texCoord.x | texCoord.y << axisBits | texture << 2 * axisBits;
+        return result;
+    }
+
+    glm::uvec3 VoxelVertex::GetPosition() const
+    {
+        return {
+            positionFace & maxAxisValue,
+            positionFace >> axisBits & maxAxisValue,
+            positionFace >> 2 * axisBits & maxAxisValue
+        };
+    }
+
+    VoxelFace VoxelVertex::GetFace() const
+    {
+        return static_cast<VoxelFace>(positionFace >> 3 * axisBits & ((1u << faceBits) - 1));
+    }
+
+    glm::vec3 VoxelVertex::GetNormal() const
+    {
+        switch (GetFace())
+        {
+        case VoxelFace::Top:
+            return {0.0f, 1.0f, 0.0f};
+        case VoxelFace::Bottom:
+            return {0.0f, -1.0f, 0.0f};
+        case VoxelFace::Left:
+            return {-1.0f, 0.0f, 0.0f};
+        case VoxelFace::Right:
+            return {1.0f, 0.0f, 0.0f};
+        case VoxelFace::Front:
+            return {0.0f, 0.0f, 1.0f};
+        case VoxelFace::Back:
+            return {0.0f, 0.0f, -1.0f};
+        }
+        return {0.0f, 0.0f, 0.0f};
+    }
+
+    glm::uvec2 VoxelVertex::GetTexCoord() const
+    {
+        return {texCoordTexture & maxAxisValue, texCoordTexture >> axisBits & maxAxisValue};
+    }
+
+    unsigned int VoxelVertex::GetTexture() const
+    {
+        return texCoordTexture >> 2 * axisBits;
+    }
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <cstdint>
+
+#include <glm/vec2.hpp>
+#include <glm/vec3.hpp>
+
+namespace Vox
+{
+    /**
+     * @brief The side of a voxel a face points out of. The order matches the normals in gBufferVoxel.vert
+     */
+    enum class VoxelFace : char
+    {
+        Top,
+        Bottom,
+        Left,
+        Right,
+        Front,
+        Back
+    };
+
+    constexpr int voxelFaceCount = 6;
+
+    /**
+     * @brief A voxel mesh vertex, packed into 8 bytes. Shared by voxelGeneration.comp, VoxelMesher and gBufferVoxel.vert
+     * Positions are relative to the chunk, and texture coordinates are at most the size of a quad, so both fit in 6 bits per axis
+     */
+    struct VoxelVertex
+    {
+        static constexpr unsigned int axisBits = 6;
+        static constexpr unsigned int faceBits = 3;
+        static constexpr unsigned int textureBits = 32 - 2 * axisBits;
+        static constexpr unsigned int maxAxisValue = (1u << axisBits) - 1;
+        static constexpr unsigned int maxTexture = (1u << textureBits) - 1;
+
+        [[nodiscard]] static VoxelVertex Pack(const glm::uvec3& position, VoxelFace face, const glm::uvec2& texCoord, unsigned int texture);
+
+        [[nodiscard]] glm::uvec3 GetPosition() const;
+
+        [[nodiscard]] VoxelFace GetFace() const;
+
+        [[nodiscard]] glm::vec3 GetNormal() const;
+
+        [[nodiscard]] glm::uvec2 GetTexCoord() const;
+
+        [[nodiscard]] unsigned int GetTexture() const;
+
+        bool operator==(const VoxelVertex&) const = default;
+
+        // x, y and z in the lowest 18 bits, then the face
+        uint32_t positionFace;
+
+        // u and v in the lowest 12 bits, then the texture layer
+        uint32_t texCoordTexture;
+    };
+    static_assert(sizeof(VoxelVertex) == 8);
+}
@@ -1,5 +1,8 @@
 #include "VoxelWorld.h"
 
+#include <algorithm>
+#include <chrono>
+
 #include "Octree.h"
 #include "core/logging/Logging.h"
 #include "core/math/Formatting.h"
@@ -9,6 +12,7 @@
 #include "core/services/FileIOService.h"
 #include "core/services/InputService.h"
 #include "core/services/ServiceLocator.h"
+#include "core/services/ThreadPool.h"
 #include "editor/EditorViewport.h"
 #include "physics/PhysicsServer.h"
 #include "physics/TypeConversions.h"
@@ -22,79 +26,422 @@ namespace Vox
     {
     }
 
-    VoxelWorld::VoxelWorld(const World* world, const std::string& filename)
+    VoxelWorld::VoxelWorld(const World* world, const std::string& filename, const VoxelStreamingSettings& streamingSettings)
         :VoxelWorld(world)
     {
-        const std::string data = ServiceLocator::GetFileIoService()->LoadFile(fmt::format("worlds/{}.vox", filename));
+        this->streamingSettings = streamingSettings;
 
-        size_t cursorPosition = data.find('\n');
-        while (cursorPosition != std::string::npos)
+        // Prefer the binary format, the ASCII format is only used to import older worlds
+        const std::string binaryFilepath = ServiceLocator::GetFileIoService()->GetAssetPath() + fmt::format("worlds/{}.voxb", filename);
+        if (const VoxelWorldFile file(binaryFilepath); file.IsValid())
         {
-            VoxelChunk newChunk(data.substr(0, data.find('\n')), world);
-            voxelChunks.emplace(newChunk.GetChunkLocation(), std::move(newChunk));
-            cursorPosition = data.find('\n', cursorPosition + 1);
+            // When streaming, chunks are read from the file as they come into range instead
+            if (streamingSettings.enabled)
+            {
+                VoxLog(Display, FileSystem, "Streaming voxel world '{}', {} chunks in file.", binaryFilepath, file.GetChunkCount());
+            }
+            else
+            {
+                LoadBinary(file);
+            }
+            store.SetSourceFile(binaryFilepath, file.GetChunkTable());
         }
+        else
+        {
+            LoadAscii(ServiceLocator::GetFileIoService()->LoadFile(fmt::format("worlds/{}.vox", filename)));
+
+            // None of these chunks are in the binary file yet
+            for (const std::unique_ptr<VoxelChunk>& chunk : voxelChunks.GetChunks())
+            {
+                chunk->MarkUnsaved();
+            }
+        }
+        lastSaveFilepath = binaryFilepath;
+        LogMemoryReport();
     }
 
     VoxelWorld::~VoxelWorld()
-    = default;
+    {
+        store.Wait();
+        LogFinishedSaves();
+    }
 
     std::optional<Voxel> VoxelWorld::GetVoxel(const glm::ivec3& position) const
     {
         auto [chunkPosition, voxelPosition] = GetChunkCoords(position);
-        const auto chunkIterator = voxelChunks.find({chunkPosition.x, chunkPosition.y});
-        if (chunkIterator == voxelChunks.end())
+        const VoxelChunk* chunk = voxelChunks.Find(chunkPosition);
+        if (!chunk)
         {
             return std::nullopt;
         }
 
-        return chunkIterator->second.GetVoxel({voxelPosition.x, position.y, voxelPosition.y});
+        return chunk->GetVoxel(voxelPosition);
     }
 
     void VoxelWorld::SetVoxel(const glm::ivec3& position, const Voxel& voxel)
     {
         auto [chunkPosition, voxelPosition] = GetChunkCoords(position);
-        const auto chunkIterator = voxelChunks.find({chunkPosition.x, chunkPosition.y});
-        if (chunkIterator == voxelChunks.end())
+        if (voxel.materialId == 0 && !FindOrLoadChunk(chunkPosition))
+        {
+            // Empty space has no chunk, so there is nothing to clear
+            return;
+        }
+
+        VoxelChunk& chunk = FindOrCreateChunk(chunkPosition);
+        const bool alreadyModified = chunk.HasPendingUpdate();
+        chunk.SetVoxel(voxelPosition, voxel);
+        TrackModifiedChunk(chunk, alreadyModified);
+    }
+
+    void VoxelWorld::SetVoxels(const std::span<const std::pair<glm::ivec3, Voxel>> voxels)
+    {
+        // Sort the edits by chunk, keeping their original order within a chunk so later edits still win
+        std::vector<std::pair<uint64_t, size_t>> sortedEdits;
+        sortedEdits.reserve(voxels.size());
+        for (size_t i = 0; i < voxels.size(); ++i)
+        {
+            sortedEdits.emplace_back(VoxelChunkMap::PackKey(GetChunkCoords(voxels[i].first).first), i);
+        }
+        std::ranges::sort(sortedEdits);
+
+        for (auto chunkStart = sortedEdits.begin(); chunkStart != sortedEdits.end();)
         {
-            // If the chunk doesn't exist, allocate a new one
-            const auto [iterator, success] = voxelChunks.emplace(
-                chunkPosition,
-                VoxelChunk(chunkPosition, world)
-            );
-            VoxLog(Display, Game, "Allocating new voxel at coords '{}'", chunkPosition);
-            iterator->second.SetVoxel({voxelPosition.x, position.y, voxelPosition.y}, voxel);
+            const auto chunkEnd = std::ranges::find_if(chunkStart, sortedEdits.end(),
+                [chunkStart](const std::pair<uint64_t, size_t>& edit) { return edit.first != chunkStart->first; });
 
-            if (std::ranges::find(modifiedChunks, iterator) == modifiedChunks.end())
+            const glm::ivec3 chunkPosition = GetChunkCoords(voxels[chunkStart->second].first).first;
+            if (std::all_of(chunkStart, chunkEnd,
+                [&voxels](const std::pair<uint64_t, size_t>& edit) { return voxels[edit.second].second.materialId == 0; }) && !FindOrLoadChunk(chunkPosition))
             {
-                modifiedChunks.push_back(iterator);
+                chunkStart = chunkEnd;
+                continue;
             }
-            return;
+
+            VoxelChunk& chunk = FindOrCreateChunk(chunkPosition);
+            const bool alreadyModified = chunk.HasPendingUpdate();
+            chunk.EditVoxels([&](VoxelChunk::VoxelArray& chunkVoxels)
+            {
+                for (auto edit = chunkStart; edit != chunkEnd; ++edit)
+                {
+                    const auto& [position, voxel] = voxels[edit->second];
+                    const glm::ivec3 voxelPosition = GetChunkCoords(position).second;
+                    chunkVoxels[voxelPosition.x][voxelPosition.y][voxelPosition.z] = voxel;
+                }
+            });
+            TrackModifiedChunk(chunk, alreadyModified);
+            chunkStart = chunkEnd;
         }
+    }
 
-        chunkIterator->second.SetVoxel({voxelPosition.x, position.y, voxelPosition.y}, voxel);
+    void VoxelWorld::FillBox(const glm::ivec3& min, const glm::ivec3& max, const Voxel& voxel)
+    {
+        ForEachChunkInBox(min, max, [&](const glm::ivec3& chunkPosition, const glm::ivec3& localMin, const glm::ivec3& localMax)
+        {
+            if (voxel.materialId == 0 && !FindOrLoadChunk(chunkPosition))
+            {
+                return;
+            }
 
-        if (std::ranges::find(modifiedChunks, chunkIterator) == modifiedChunks.end())
+            VoxelChunk& chunk = FindOrCreateChunk(chunkPosition);
+            const bool alreadyModified = chunk.HasPendingUpdate();
+            if (localMin == glm::ivec3(0) && localMax == glm::ivec3(VoxelChunk::chunkSize))
+            {
+                // The whole chunk is covered, so skip the dense pass entirely
+                chunk.FillVoxels(voxel);
+            }
+            else
+            {
+                chunk.EditVoxels([&](VoxelChunk::VoxelArray& chunkVoxels)
+                {
+                    for (int x = localMin.x; x < localMax.x; ++x)
+                    {
+                        for (int y = localMin.y; y < localMax.y; ++y)
+                        {
+                            std::fill(chunkVoxels[x][y].begin() + localMin.z, chunkVoxels[x][y].begin() + localMax.z, voxel);
+                        }
+                    }
+                });
+            }
+            TrackModifiedChunk(chunk, alreadyModified);
+        });
+    }
+
+    void VoxelWorld::FillSphere(const glm::ivec3& center, const int radius, const Voxel& voxel)
+    {
+        const int radiusSquared = radius * radius;
+        EditBox(center - radius, center + radius + 1, [&](VoxelChunk::VoxelArray& chunkVoxels,
+            const glm::ivec3& localMin, const glm::ivec3& localMax, const glm::ivec3& chunkOrigin)
         {
-            modifiedChunks.push_back(chunkIterator);
-        }
+            for (int x = localMin.x; x < localMax.x; ++x)
+            {
+                for (int y = localMin.y; y < localMax.y; ++y)
+                {
+                    for (int z = localMin.z; z < localMax.z; ++z)
+                    {
+                        const glm::ivec3 offset = chunkOrigin + glm::ivec3(x, y, z) - center;
+                        if (offset.x * offset.x + offset.y * offset.y + offset.z * offset.z <= radiusSquared)
+                        {
+                            chunkVoxels[x][y][z] = voxel;
+                        }
+                    }
+                }
+            }
+        });
+    }
+
+    VoxelRegion VoxelWorld::CopyRegion(const glm::ivec3& min, const glm::ivec3& max) const
+    {
+        VoxelRegion result;
+        result.size = glm::max(max - min, glm::ivec3(0));
+        result.voxels.resize(static_cast<size_t>(result.size.x) * result.size.y * result.size.z);
+
+        const auto denseVoxels = std::make_unique<VoxelChunk::VoxelArray>();
+        ForEachChunkInBox(min, max, [&](const glm::ivec3& chunkPosition, const glm::ivec3& localMin, const glm::ivec3& localMax)
+        {
+            const VoxelChunk* chunk = voxelChunks.Find(chunkPosition);
+            if (!chunk)
+            {
+                return;
+            }
+
+            chunk->UnpackVoxels(*denseVoxels);
+            const glm::ivec3 regionOffset = chunkPosition * VoxelChunk::chunkSize - min;
+            for (int x = localMin.x; x < localMax.x; ++x)
+            {
+                for (int y = localMin.y; y < localMax.y; ++y)
+                {
+                    const glm::ivec3 regionPosition = regionOffset + glm::ivec3(x, y, localMin.z);
+                    const size_t regionIndex = (static_cast<size_t>(regionPosition.x) * result.size.y + regionPosition.y) * result.size.z + regionPosition.z;
+                    std::copy((*denseVoxels)[x][y].begin() + localMin.z, (*denseVoxels)[x][y].begin() + localMax.z, result.voxels.begin() + regionIndex);
+                }
+            }
+        });
+        return result;
+    }
+
+    void VoxelWorld::PasteRegion(const VoxelRegion& region, const glm::ivec3& origin)
+    {
+        EditBox(origin, origin + region.size, [&](VoxelChunk::VoxelArray& chunkVoxels,
+            const glm::ivec3& localMin, const glm::ivec3& localMax, const glm::ivec3& chunkOrigin)
+        {
+            const glm::ivec3 regionOffset = chunkOrigin - origin;
+            for (int x = localMin.x; x < localMax.x; ++x)
+            {
+                for (int y = localMin.y; y < localMax.y; ++y)
+                {
+                    const glm::ivec3 regionPosition = regionOffset + glm::ivec3(x, y, localMin.z);
+                    const size_t regionIndex = (static_cast<size_t>(regionPosition.x) * region.size.y + regionPosition.y) * region.size.z + regionPosition.z;
+                    std::copy_n(region.voxels.begin() + regionIndex, localMax.z - localMin.z, chunkVoxels[x][y].begin() + localMin.z);
+                }
+            }
+        });
     }
 
     // ReSharper disable once CppMemberFunctionMayBeConst
     void VoxelWorld::FinalizeUpdate()
     {
-        for (const auto& modifiedChunk : modifiedChunks)
+        for (VoxelChunk* modifiedChunk : modifiedChunks)
         {
-            modifiedChunk->second.FinalizeUpdate();
+            modifiedChunk->FinalizeUpdate();
         }
         modifiedChunks.clear();
+        UpdateChunkMeshes();
+    }
+
+    void VoxelWorld::UpdateStreaming(const glm::vec3& focusPosition)
+    {
+        if (!streamingSettings.enabled)
+        {
+            return;
+        }
+
+        ++streamingFrame;
+        // Voxel coordinates are offset by half a chunk from world space, see VoxelChunk::CalculatePosition
+        const glm::ivec3 focusChunk = GetChunkCoords(glm::ivec3(glm::floor(focusPosition)) + VoxelChunk::chunkHalfSize).first;
+        auto distanceSquared = [focusChunk](const glm::ivec3& chunkPosition)
+        {
+            const glm::ivec3 offset = chunkPosition - focusChunk;
+            return offset.x * offset.x + offset.y * offset.y + offset.z * offset.z;
+        };
+        const int loadRadiusSquared = streamingSettings.loadRadius * streamingSettings.loadRadius;
+        const int unloadRadiusSquared = streamingSettings.unloadRadius * streamingSettings.unloadRadius;
+
+        CreateLoadedChunks(focusChunk);
+
+        // Unload chunks that are out of range, and find which of the remaining chunks could be evicted
+        struct EvictionCandidate
+        {
+            uint64_t lastUsedFrame;
+            glm::ivec3 chunkPosition;
+            size_t memoryUsage;
+        };
+        std::vector<EvictionCandidate> evictionCandidates;
+        std::vector<glm::ivec3> outOfRangeChunks;
+        size_t residentBytes = 0;
+        for (const std::unique_ptr<VoxelChunk>& chunk : voxelChunks.GetChunks())
+        {
+            const glm::ivec3 chunkPosition = chunk->GetChunkLocation();
+            const int chunkDistanceSquared = distanceSquared(chunkPosition);
+            if (chunkDistanceSquared > unloadRadiusSquared)
+            {
+                outOfRangeChunks.emplace_back(chunkPosition);
+                continue;
+            }
+
+            const size_t memoryUsage = GetChunkMemoryUsage(*chunk);
+            residentBytes += memoryUsage;
+            uint64_t& lastUsedFrame = chunkLastUsedFrames[VoxelChunkMap::PackKey(chunkPosition)];
+            if (chunkDistanceSquared <= loadRadiusSquared)
+            {
+                lastUsedFrame = streamingFrame;
+            }
+            else
+            {
+                evictionCandidates.emplace_back(lastUsedFrame, chunkPosition, memoryUsage);
+            }
+        }
+
+        for (const glm::ivec3& chunkPosition : outOfRangeChunks)
+        {
+            UnloadChunk(chunkPosition);
+        }
+
+        // Chunks inside the load radius are never evicted, so the budget can still be exceeded by them alone
+        const size_t memoryBudget = streamingSettings.memoryBudgetMiB * 1024 * 1024;
+        if (residentBytes > memoryBudget)
+        {
+            std::ranges::sort(evictionCandidates, {}, &EvictionCandidate::lastUsedFrame);
+            for (const EvictionCandidate& candidate : evictionCandidates)
+            {
+                if (residentBytes <= memoryBudget)
+                {
+                    break;
+                }
+                UnloadChunk(candidate.chunkPosition);
+                residentBytes -= candidate.memoryUsage;
+            }
+        }
+
+        std::erase_if(absentChunks, [&](const uint64_t key)
+        {
+            return distanceSquared(VoxelChunkMap::UnpackKey(key)) > unloadRadiusSquared;
+        });
+
+        // Created and unloaded chunks change what their neighbours can see
+        UpdateChunkMeshes();
+
+        if (residentBytes >= memoryBudget)
+        {
+            if (!overMemoryBudget)
+            {
+                VoxLog(Warning, Game, "Voxel chunks within the load radius use {} MiB, more than the budget of {} MiB. No more chunks will be loaded.",
+                    residentBytes / (1024 * 1024), streamingSettings.memoryBudgetMiB);
+            }
+            overMemoryBudget = true;
+            return;
+        }
+        overMemoryBudget = false;
+
+        // Request the nearest missing chunks first
+        const int maxNewLoads = streamingSettings.maxPendingLoads - static_cast<int>(pendingLoads.size());
+        if (maxNewLoads <= 0)
+        {
+            return;
+        }
+
+        std::vector<std::pair<int, glm::ivec3>> missingChunks;
+        for (int x = -streamingSettings.loadRadius; x <= streamingSettings.loadRadius; ++x)
+        {
+            for (int y = -streamingSettings.loadRadius; y <= streamingSettings.loadRadius; ++y)
+            {
+                for (int z = -streamingSettings.loadRadius; z <= streamingSettings.loadRadius; ++z)
+                {
+                    const glm::ivec3 chunkPosition = focusChunk + glm::ivec3(x, y, z);
+                    const uint64_t key = VoxelChunkMap::PackKey(chunkPosition);
+                    const int chunkDistanceSquared = x * x + y * y + z * z;
+                    if (chunkDistanceSquared > loadRadiusSquared || pendingLoads.contains(key) || absentChunks.contains(key) || voxelChunks.Find(chunkPosition))
+                    {
+                        continue;
+                    }
+                    missingChunks.emplace_back(chunkDistanceSquared, chunkPosition);
+                }
+            }
+        }
+
+        const size_t loadCount = std::min(missingChunks.size(), static_cast<size_t>(maxNewLoads));
+        std::ranges::partial_sort(missingChunks, missingChunks.begin() + static_cast<std::ptrdiff_t>(loadCount), {},
+            &std::pair<int, glm::ivec3>::first);
+        for (size_t i = 0; i < loadCount; ++i)
+        {
+            pendingLoads.emplace(VoxelChunkMap::PackKey(missingChunks[i].second));
+            store.Load(missingChunks[i].second);
+        }
+    }
+
+    void VoxelWorld::SaveToFile(const std::string& filename)
+    {
+        LogFinishedSaves();
+
+        // A new file needs every loaded chunk, anything that isn't loaded is copied over from the previous file
+        const std::string filepath = ServiceLocator::GetFileIoService()->GetAssetPath() + fmt::format("worlds/{}.voxb", filename);
+        const bool saveAllChunks = filepath != lastSaveFilepath;
+        lastSaveFilepath = filepath;
+
+        std::vector<VoxelWorldFile::ChunkSnapshot> modifiedChunks;
+        for (const std::unique_ptr<VoxelChunk>& chunk : voxelChunks.GetChunks())
+        {
+            if (saveAllChunks || chunk->IsModifiedSinceSave())
+            {
+                modifiedChunks.emplace_back(chunk->GetChunkLocation(), chunk->GetVoxelStorage());
+                chunk->MarkSaved();
+            }
+        }
+
+        if (modifiedChunks.empty() && !saveAllChunks)
+        {
+            VoxLog(Verbose, FileSystem, "No voxel chunks were modified since the last save.");
+            return;
+        }
+        store.Save(filepath, std::move(modifiedChunks));
+    }
+
+    void VoxelWorld::LogFinishedSaves()
+    {
+        store.LogFinishedSaves();
+    }
+
+    VoxelSaveStatus VoxelWorld::GetSaveStatus() const
+    {
+        return store.GetStatus();
     }
 
-    void VoxelWorld::SaveToFile(const std::string& filename) const
+    void VoxelWorld::ExportToAsciiFile(const std::string& filename) const
     {
         ServiceLocator::GetFileIoService()->WriteToFile(fmt::format("worlds/{}.vox", filename), WriteString());
     }
 
+    VoxelMemoryReport VoxelWorld::GetMemoryReport() const
+    {
+        VoxelMemoryReport result;
+        for (const std::unique_ptr<VoxelChunk>& chunk : voxelChunks.GetChunks())
+        {
+            const PalettedVoxelStorage& storage = chunk->GetVoxelStorage();
+            ++result.chunkCount;
+            result.uniformChunkCount += storage.IsUniform() ? 1 : 0;
+            result.residentBytes += storage.GetMemoryUsage();
+            result.denseBytes += sizeof(VoxelChunk::VoxelArray);
+            result.meshBytes += chunk->GetMeshMemoryUsage();
+        }
+        return result;
+    }
+
+    void VoxelWorld::LogMemoryReport() const
+    {
+        const VoxelMemoryReport report = GetMemoryReport();
+        VoxLog(Display, Game, "Voxel world memory: {} chunks ({} uniform), {} KiB resident, {} KiB dense equivalent, {} KiB mesh buffers.",
+            report.chunkCount, report.uniformChunkCount, report.residentBytes / 1024, report.denseBytes / 1024, report.meshBytes / 1024);
+    }
+
     std::optional<VoxelRaycastResult> VoxelWorld::CastScreenSpaceRay(const glm::ivec2& screenSpace) const
     {
         float xViewport, yViewport;
@@ -124,10 +471,6 @@ namespace Vox
                 VoxLog(Display, Game, "Clicked voxel at '{}'", voxelPosition);
 
                 const glm::ivec3 clickedVoxel = voxelPosition + 16;
-                if (clickedVoxel.y >= 32 || clickedVoxel.y <= 0)
-                {
-                    return std::nullopt;
-                }
                 const glm::ivec3 voxelNormal = {
                     std::round(raycastResult.impactNormal.GetX()),
                     std::round(raycastResult.impactNormal.GetY()),
@@ -140,33 +483,292 @@ namespace Vox
         return std::nullopt;
     }
 
-    std::pair<glm::ivec2, glm::ivec2> VoxelWorld::GetChunkCoords(const glm::ivec3& position)
+    std::pair<glm::ivec3, glm::ivec3> VoxelWorld::GetChunkCoords(const glm::ivec3& position)
+    {
+        glm::ivec3 chunkPosition, voxelPosition;
+        for (int axis = 0; axis < 3; ++axis)
+        {
+            auto [chunk, voxel] = std::div(position[axis], VoxelChunk::chunkSize);
+            if (voxel < 0)
+            {
+                voxel += VoxelChunk::chunkSize;
+                --chunk;
+            }
+            chunkPosition[axis] = chunk;
+            voxelPosition[axis] = voxel;
+        }
+
+        return {chunkPosition, voxelPosition};
+    }
+
+    VoxelChunk* VoxelWorld::FindOrLoadChunk(const glm::ivec3& chunkPosition)
     {
-        auto [chunkX, voxelX] = std::div(position.x, VoxelChunk::chunkSize);
-        auto [chunkY, voxelY] = std::div(position.z, VoxelChunk::chunkSize);
-        if (voxelX < 0)
+        if (VoxelChunk* chunk = voxelChunks.Find(chunkPosition))
         {
-            voxelX += VoxelChunk::chunkSize;
-            --chunkX;
+            return chunk;
         }
 
-        if (voxelY < 0)
+        // Without streaming every chunk in the file is resident, so a missing chunk is empty space
+        const uint64_t key = VoxelChunkMap::PackKey(chunkPosition);
+        if (!streamingSettings.enabled || absentChunks.contains(key))
         {
-            voxelY += VoxelChunk::chunkSize;
-            --chunkY;
+            return nullptr;
         }
 
-        return {{chunkX, chunkY}, {voxelX, voxelY}};
+        // The chunk may still be in the file, or held unsaved by the store. An edit has to start from those contents,
+        // otherwise the blank chunk it creates would overwrite them on the next save
+        VoxelWorldStore::LoadedChunk loadedChunk = store.LoadImmediately(chunkPosition);
+        if (loadedChunk.malformed)
+        {
+            VoxLog(Error, FileSystem, "Voxel chunk at '{}' is malformed, and was skipped.", chunkPosition);
+        }
+
+        if (!loadedChunk.chunk)
+        {
+            absentChunks.emplace(key);
+            return nullptr;
+        }
+
+        VoxelChunk& chunk = voxelChunks.Insert(std::make_unique<VoxelChunk>(std::move(*loadedChunk.chunk), world));
+        if (loadedChunk.unsaved)
+        {
+            chunk.MarkUnsaved();
+        }
+        return &chunk;
+    }
+
+    VoxelChunk& VoxelWorld::FindOrCreateChunk(const glm::ivec3& chunkPosition)
+    {
+        if (VoxelChunk* chunk = FindOrLoadChunk(chunkPosition))
+        {
+            return *chunk;
+        }
+
+        // If the chunk doesn't exist, allocate a new one
+        VoxLog(Display, Game, "Allocating new voxel at coords '{}'", chunkPosition);
+        return voxelChunks.Insert(std::make_unique<VoxelChunk>(chunkPosition, world));
+    }
+
+    void VoxelWorld::ForEachChunkInBox(const glm::ivec3& min, const glm::ivec3& max,
+        const std::function<void(const glm::ivec3& chunkPosition, const glm::ivec3& localMin, const glm::ivec3& localMax)>& function) const
+    {
+        if (min.x >= max.x || min.y >= max.y || min.z >= max.z)
+        {
+            return;
+        }
+
+        const glm::ivec3 minChunk = GetChunkCoords(min).first;
+        const glm::ivec3 maxChunk = GetChunkCoords(max - 1).first;
+        for (int chunkX = minChunk.x; chunkX <= maxChunk.x; ++chunkX)
+        {
+            for (int chunkY = minChunk.y; chunkY <= maxChunk.y; ++chunkY)
+            {
+                for (int chunkZ = minChunk.z; chunkZ <= maxChunk.z; ++chunkZ)
+                {
+                    const glm::ivec3 chunkPosition = {chunkX, chunkY, chunkZ};
+                    const glm::ivec3 chunkOrigin = chunkPosition * VoxelChunk::chunkSize;
+                    const glm::ivec3 localMin = glm::max(min - chunkOrigin, glm::ivec3(0));
+                    const glm::ivec3 localMax = glm::min(max - chunkOrigin, glm::ivec3(VoxelChunk::chunkSize));
+                    function(chunkPosition, localMin, localMax);
+                }
+            }
+        }
+    }
+
+    void VoxelWorld::EditBox(const glm::ivec3& min, const glm::ivec3& max,
+        const std::function<void(VoxelChunk::VoxelArray&, const glm::ivec3& localMin, const glm::ivec3& localMax, const glm::ivec3& chunkOrigin)>& editFunction)
+    {
+        ForEachChunkInBox(min, max, [&](const glm::ivec3& chunkPosition, const glm::ivec3& localMin, const glm::ivec3& localMax)
+        {
+            const glm::ivec3 chunkOrigin = chunkPosition * VoxelChunk::chunkSize;
+            if (!FindOrLoadChunk(chunkPosition))
+            {
+                // Run the edit on empty space first, so edits that leave the space empty don't allocate a chunk
+                const auto emptyVoxels = std::make_unique<VoxelChunk::VoxelArray>();
+                editFunction(*emptyVoxels, localMin, localMax, chunkOrigin);
+                const Voxel* firstVoxel = (*emptyVoxels)[0][0].data();
+                if (std::all_of(firstVoxel, firstVoxel + VoxelChunk::chunkVolume, [](const Voxel& voxel) { return voxel.materialId == 0; }))
+                {
+                    return;
+                }
+            }
+
+            VoxelChunk& chunk = FindOrCreateChunk(chunkPosition);
+            const bool alreadyModified = chunk.HasPendingUpdate();
+            chunk.EditVoxels([&](VoxelChunk::VoxelArray& chunkVoxels)
+            {
+                editFunction(chunkVoxels, localMin, localMax, chunkOrigin);
+            });
+            TrackModifiedChunk(chunk, alreadyModified);
+        });
+    }
+
+    void VoxelWorld::TrackModifiedChunk(VoxelChunk& chunk, const bool alreadyModified)
+    {
+        if (!alreadyModified && chunk.HasPendingUpdate())
+        {
+            modifiedChunks.push_back(&chunk);
+        }
+    }
+
+    void VoxelWorld::CreateLoadedChunks(const glm::ivec3& focusChunk)
+    {
+        for (VoxelWorldStore::LoadedChunk& loadedChunk : store.TakeLoadedChunks())
+        {
+            loadedChunks.emplace_back(std::move(loadedChunk));
+        }
+
+        // Creating the mesh and body is the expensive part left on this thread, so only do a few each frame
+        const int unloadRadiusSquared = streamingSettings.unloadRadius * streamingSettings.unloadRadius;
+        int createdCount = 0;
+        while (!loadedChunks.empty() && createdCount < streamingSettings.maxChunksCreatedPerFrame)
+        {
+            VoxelWorldStore::LoadedChunk loadedChunk = std::move(loadedChunks.front());
+            loadedChunks.pop_front();
+
+            const uint64_t key = VoxelChunkMap::PackKey(loadedChunk.location);
+            pendingLoads.erase(key);
+            if (loadedChunk.malformed)
+            {
+                VoxLog(Error, FileSystem, "Voxel chunk at '{}' is malformed, and was skipped.", loadedChunk.location);
+            }
+
+            if (!loadedChunk.chunk)
+            {
+                absentChunks.emplace(key);
+                continue;
+            }
+
+            // The focus may have moved away while the chunk was loading, in which case any unsaved contents are still held
+            // by the store. Or an edit may have loaded the chunk already, and the resident chunk is at least as new as this read
+            const glm::ivec3 offset = loadedChunk.location - focusChunk;
+            if (offset.x * offset.x + offset.y * offset.y + offset.z * offset.z > unloadRadiusSquared || voxelChunks.Find(loadedChunk.location))
+            {
+                continue;
+            }
+
+            VoxelChunk& chunk = voxelChunks.Insert(std::make_unique<VoxelChunk>(std::move(*loadedChunk.chunk), world));
+            if (loadedChunk.unsaved)
+            {
+                chunk.MarkUnsaved();
+            }
+            ++createdCount;
+        }
+    }
+
+    void VoxelWorld::UnloadChunk(const glm::ivec3& chunkPosition)
+    {
+        const std::unique_ptr<VoxelChunk> chunk = voxelChunks.Erase(chunkPosition);
+        if (!chunk)
+        {
+            return;
+        }
+
+        const uint64_t key = VoxelChunkMap::PackKey(chunkPosition);
+        std::erase(modifiedChunks, chunk.get());
+        chunkLastUsedFrames.erase(key);
+
+        // The chunk may have been created by an edit where the file had none, so it has to be requested again
+        absentChunks.erase(key);
+        if (chunk->IsModifiedSinceSave())
+        {
+            store.Unload({chunkPosition, chunk->GetVoxelStorage()});
+        }
+    }
+
+    // ReSharper disable once CppMemberFunctionMayBeConst
+    void VoxelWorld::UpdateChunkMeshes()
+    {
+        for (const std::unique_ptr<VoxelChunk>& chunk : voxelChunks.GetChunks())
+        {
+            if (chunk->HasPendingMeshUpdate())
+            {
+                chunk->UpdateMesh();
+            }
+        }
+    }
+
+    size_t VoxelWorld::GetChunkMemoryUsage(const VoxelChunk& chunk)
+    {
+        return chunk.GetVoxelStorage().GetMemoryUsage() + chunk.GetMeshMemoryUsage();
     }
 
     std::string VoxelWorld::WriteString() const
     {
         std::string result;
-        for (const auto& chunk : voxelChunks | std::views::values)
+        for (const std::unique_ptr<VoxelChunk>& chunk : voxelChunks.GetChunks())
         {
-            result.append(chunk.WriteString());
+            result.append(chunk->WriteString());
             result += "\n";
         }
         return result;
     }
+
+    void VoxelWorld::LoadBinary(const VoxelWorldFile& file)
+    {
+        LoadChunks(file.GetChunkCount(), [&file](const size_t chunkIndex, VoxelChunk::VoxelArray& voxelsOut, glm::ivec3& locationOut)
+        {
+            locationOut = file.GetChunkLocation(chunkIndex);
+            return file.DecodeChunk(chunkIndex, voxelsOut);
+        });
+    }
+
+    void VoxelWorld::LoadAscii(const std::string_view data)
+    {
+        std::vector<std::string_view> lines;
+        size_t lineStart = 0;
+        for (size_t lineEnd = data.find('\n'); lineEnd != std::string_view::npos; lineEnd = data.find('\n', lineStart))
+        {
+            lines.emplace_back(data.substr(lineStart, lineEnd - lineStart));
+            lineStart = lineEnd + 1;
+        }
+
+        LoadChunks(lines.size(), [&lines](const size_t chunkIndex, VoxelChunk::VoxelArray& voxelsOut, glm::ivec3& locationOut)
+        {
+            return VoxelChunk::ParseString(lines[chunkIndex], locationOut, voxelsOut);
+        });
+    }
+
+    void VoxelWorld::LoadChunks(const size_t chunkCount, const std::function<bool(size_t, VoxelChunk::VoxelArray&, glm::ivec3&)>& decodeFunction)
+    {
+        using Clock = std::chrono::steady_clock;
+        const Clock::time_point loadStart = Clock::now();
+
+        // Decoding is independent per chunk, so it fans out to the thread pool
+        // Only the GL and physics resources have to be created here, on the main thread
+        std::vector<std::optional<VoxelChunk::DecodedChunk>> decodedChunks(chunkCount);
+        ThreadPool* threadPool = ServiceLocator::GetThreadPool();
+        threadPool->ParallelFor(chunkCount, [&decodedChunks, &decodeFunction](const size_t chunkIndex)
+        {
+            const auto denseVoxels = std::make_unique<VoxelChunk::VoxelArray>();
+            if (glm::ivec3 location; decodeFunction(chunkIndex, *denseVoxels, location))
+            {
+                decodedChunks[chunkIndex] = VoxelChunk::Decode(location, *denseVoxels);
+            }
+        });
+        const Clock::time_point decodeEnd = Clock::now();
+
+        size_t loadedCount = 0;
+        for (size_t i = 0; i < chunkCount; ++i)
+        {
+            if (!decodedChunks[i])
+            {
+                VoxLog(Error, FileSystem, "Chunk {} of the voxel world is malformed, and was skipped.", i);
+                continue;
+            }
+
+            voxelChunks.Insert(std::make_unique<VoxelChunk>(std::move(*decodedChunks[i]), world));
+            ++loadedCount;
+        }
+
+        // Meshes are only filled in once every chunk is linked, so each one is unpacked once with its whole apron
+        UpdateChunkMeshes();
+        const Clock::time_point loadEnd = Clock::now();
+
+        using Milliseconds = std::chrono::duration<double, std::milli>;
+        const double totalMs = Milliseconds(loadEnd - loadStart).count();
+        VoxLog(Display, FileSystem, "Loaded {} voxel chunks in {:.1f} ms ({:.0f} chunks/s) on {} threads. Decode: {:.1f} ms, resource creation: {:.1f} ms.",
+            loadedCount, totalMs, totalMs > 0.0 ? loadedCount * 1000.0 / totalMs : 0.0, threadPool->GetThreadCount() + 1,
+            Milliseconds(decodeEnd - loadStart).count(), Milliseconds(loadEnd - decodeEnd).count());
+    }
 }
@@ -1,11 +1,19 @@
 #pragma once
 
-#include <map>
+#include <deque>
+#include <functional>
+#include <span>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
 
-// ReSharper disable once CppUnusedIncludeDirective
-#include "core/math/Comparators.h"
 #include "voxel/Voxel.h"
 #include "voxel/VoxelChunk.h"
+#include "voxel/VoxelChunkMap.h"
+#include "voxel/VoxelStreamingSettings.h"
+#include "voxel/VoxelWorldFile.h"
+#include "voxel/VoxelWorldStore.h"
 
 namespace Vox
 {
@@ -17,12 +25,38 @@ namespace Vox
         glm::ivec3 voxelNormal;
     };
 
+    struct VoxelMemoryReport
+    {
+        size_t chunkCount = 0;
+        size_t uniformChunkCount = 0;
+
+        // Bytes used by the palette storage of every chunk
+        size_t residentBytes = 0;
+
+        // Bytes the same chunks would use as dense voxel arrays
+        size_t denseBytes = 0;
+
+        // Bytes of the voxel geometry arena taken by the chunk meshes
+        size_t meshBytes = 0;
+    };
+
+    /**
+     * @brief A box of voxels copied out of a VoxelWorld
+     */
+    struct VoxelRegion
+    {
+        glm::ivec3 size = {0, 0, 0};
+
+        // Indexed by (x * size.y + y) * size.z + z, the same ordering as the chunks
+        std::vector<Voxel> voxels;
+    };
+
     class VoxelWorld
 	{
 	public:
-        using MapType = std::map<glm::ivec2, VoxelChunk>;
+        using MapType = VoxelChunkMap;
 	    explicit VoxelWorld(const World* world);
-        VoxelWorld(const World* world, const std::string& filename);
+        VoxelWorld(const World* world, const std::string& filename, const VoxelStreamingSettings& streamingSettings = {});
         ~VoxelWorld();
 
         VoxelWorld(VoxelWorld&&) = delete;
@@ -34,29 +68,159 @@ namespace Vox
 
         void SetVoxel(const glm::ivec3& position, const Voxel& voxel);
 
+        /**
+         * @brief Set many voxels at once. The edits are grouped by chunk, and each chunk is written in a single pass
+         */
+        void SetVoxels(std::span<const std::pair<glm::ivec3, Voxel>> voxels);
+
+        /**
+         * @brief Fill a box of voxels, creating any chunks it touches unless the fill is empty
+         * @param min The first corner of the box, inclusive
+         * @param max The second corner of the box, exclusive
+         */
+        void FillBox(const glm::ivec3& min, const glm::ivec3& max, const Voxel& voxel);
+
+        /**
+         * @brief Fill every voxel within radius of center, creating any chunks it touches unless the fill is empty
+         */
+        void FillSphere(const glm::ivec3& center, int radius, const Voxel& voxel);
+
+        /**
+         * @brief Copy a box of voxels. Voxels in unloaded chunks are copied as empty
+         * @param min The first corner of the box, inclusive
+         * @param max The second corner of the box, exclusive
+         */
+        [[nodiscard]] VoxelRegion CopyRegion(const glm::ivec3& min, const glm::ivec3& max) const;
+
+        /**
+         * @brief Write a copied region back into the world, with its first corner at origin
+         */
+        void PasteRegion(const VoxelRegion& region, const glm::ivec3& origin);
+
         /**
          * @brief Propagates updates to modified chunks
          */
         void FinalizeUpdate();
 
-        void SaveToFile(const std::string& filename) const;
+        /**
+         * @brief Load and unload chunks around a focus point, if streaming is enabled. Should be called every frame
+         * Chunks are read and decoded on the thread pool, only their resources are created here
+         */
+        void UpdateStreaming(const glm::vec3& focusPosition);
+
+        /**
+         * @brief Save the world in the binary format, see VoxelWorldFile
+         * Only chunks modified since the last save are written, including modified chunks that were unloaded.
+         * The write happens on the thread pool, from a copy of those chunks, so editing can continue while it runs
+         */
+        void SaveToFile(const std::string& filename);
+
+        /**
+         * @brief Log the results of any background saves that have finished
+         */
+        void LogFinishedSaves();
+
+        [[nodiscard]] VoxelSaveStatus GetSaveStatus() const;
+
+        /**
+         * @brief Save the world in the ASCII format, one packed octree per line
+         */
+        void ExportToAsciiFile(const std::string& filename) const;
+
+        [[nodiscard]] VoxelMemoryReport GetMemoryReport() const;
+
+        void LogMemoryReport() const;
 
         [[nodiscard]] std::optional<VoxelRaycastResult> CastScreenSpaceRay(const glm::ivec2& screenSpace) const;
 
     private:
         /**
-         * @brief Get voxel chunk position and voxel position with that chunk
-         * @param position Voxel global position (y is ignored)
-         * @return A pair of integer vec2's
+         * @brief Get voxel chunk position and voxel position within that chunk
+         * @param position Voxel global position
+         * @return The chunk position, and the voxel position within that chunk
          */
-        [[nodiscard]] static std::pair<glm::ivec2, glm::ivec2> GetChunkCoords(const glm::ivec3& position);
+        [[nodiscard]] static std::pair<glm::ivec3, glm::ivec3> GetChunkCoords(const glm::ivec3& position);
 
         [[nodiscard]] std::string WriteString() const;
 
+        void LoadBinary(const VoxelWorldFile& file);
+
+        void LoadAscii(std::string_view data);
+
+        /**
+         * @brief Decode chunks on the thread pool, then create their resources and insert them on this thread
+         * @param decodeFunction decodes the chunk at an index into a dense array and its location, returning false on failure
+         */
+        void LoadChunks(size_t chunkCount, const std::function<bool(size_t, VoxelChunk::VoxelArray&, glm::ivec3&)>& decodeFunction);
+
+        /**
+         * @brief Find a resident chunk. When streaming, a chunk that isn't resident is read from the store right away,
+         * unless it is known to be absent
+         * @return The chunk, or nullptr if there is no chunk at that position
+         */
+        VoxelChunk* FindOrLoadChunk(const glm::ivec3& chunkPosition);
+
+        /**
+         * @brief Find or load a chunk, creating an empty one only if there is no chunk at that position
+         */
+        VoxelChunk& FindOrCreateChunk(const glm::ivec3& chunkPosition);
+
+        /**
+         * @brief Call a function for every chunk overlapping a box, with the part of the box inside that chunk
+         * Local bounds are relative to the chunk, min inclusive and max exclusive
+         */
+        void ForEachChunkInBox(const glm::ivec3& min, const glm::ivec3& max,
+            const std::function<void(const glm::ivec3& chunkPosition, const glm::ivec3& localMin, const glm::ivec3& localMax)>& function) const;
+
+        /**
+         * @brief Bulk edit the overlap of a box with every chunk it touches, and track the modified chunks
+         * Chunks that don't exist yet are only created if the edit leaves something solid in them
+         * @param editFunction called with the dense chunk voxels, the local bounds, and the world position of the chunk origin
+         */
+        void EditBox(const glm::ivec3& min, const glm::ivec3& max,
+            const std::function<void(VoxelChunk::VoxelArray&, const glm::ivec3& localMin, const glm::ivec3& localMax, const glm::ivec3& chunkOrigin)>& editFunction);
+
+        void TrackModifiedChunk(VoxelChunk& chunk, bool alreadyModified);
+
+        /**
+         * @brief Create chunks from finished loads, up to the per-frame limit
+         */
+        void CreateLoadedChunks(const glm::ivec3& focusChunk);
+
+        /**
+         * @brief Remove a chunk and release its resources. Unsaved changes are kept by the store until the next save
+         */
+        void UnloadChunk(const glm::ivec3& chunkPosition);
+
+        /**
+         * @brief Send the voxels of every chunk flagged for a mesh update to its mesh
+         */
+        void UpdateChunkMeshes();
+
+        [[nodiscard]] static size_t GetChunkMemoryUsage(const VoxelChunk& chunk);
+
         MapType voxelChunks;
 
         const World* world;
 
-        std::vector<MapType::iterator> modifiedChunks;
+        // Chunks are only added once, when they are first modified, see VoxelChunk::HasPendingUpdate
+        std::vector<VoxelChunk*> modifiedChunks;
+
+        VoxelWorldStore store;
+
+        // The file the last save was requested for, or the file that was loaded
+        std::string lastSaveFilepath;
+
+        VoxelStreamingSettings streamingSettings;
+
+        // Streaming state, keyed by VoxelChunkMap::PackKey
+        std::unordered_set<uint64_t> pendingLoads;
+        std::unordered_set<uint64_t> absentChunks;
+        std::unordered_map<uint64_t, uint64_t> chunkLastUsedFrames;
+        std::deque<VoxelWorldStore::LoadedChunk> loadedChunks;
+
+        uint64_t streamingFrame = 0;
+
+        bool overMemoryBudget = false;
 	};
 }
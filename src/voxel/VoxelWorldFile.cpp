@@ -0,0 +1,455 @@
+#include "VoxelWorldFile.h"
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+
+#include <fmt/format.h>
+#include <SDL3/SDL_iostream.h>
+
+#include "core/logging/Logging.h"
+#include "core/math/Formatting.h"
+#include "voxel/VoxelChunkMap.h"
+
+namespace Vox
+{
+    namespace
+    {
+        constexpr char fileMagic[4] = {'V', 'O', 'X', 'B'};
+
+        void WriteVarInt(uint32_t value, std::string& dataOut)
+        {
+            while (value >= 0x80)
+            {
+                dataOut.push_back(static_cast<char>((value & 0x7F) | 0x80));
+                value >>= 7;
+            }
+            dataOut.push_back(static_cast<char>(value));
+        }
+
+        bool ReadVarInt(const char*& cursor, const char* end, uint32_t& valueOut)
+        {
+            valueOut = 0;
+            for (int shift = 0; shift < 32; shift += 7)
+            {
+                if (cursor == end)
+                {
+                    return false;
+                }
+
+                const auto byte = static_cast<uint8_t>(*cursor++);
+                valueOut |= static_cast<uint32_t>(byte & 0x7F) << shift;
+                if (!(byte & 0x80))
+                {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        template <typename T>
+        void WriteValue(const T& value, std::string& dataOut)
+        {
+            dataOut.append(reinterpret_cast<const char*>(&value), sizeof(T));
+        }
+    }
+
+    VoxelWorldFile::VoxelWorldFile(const std::string& filepath)
+        :file(filepath)
+    {
+        if (!file.IsValid())
+        {
+            if (std::error_code error; std::filesystem::exists(filepath, error))
+            {
+                VoxLog(Error, FileSystem, "Failed to map world file '{}'.", filepath);
+            }
+            return;
+        }
+
+        Header header;
+        if (file.GetSize() < sizeof(Header))
+        {
+            VoxLog(Error, FileSystem, "World file '{}' is too small to contain a header.", filepath);
+            return;
+        }
+        std::memcpy(&header, file.GetData(), sizeof(Header));
+
+        if (std::memcmp(header.magic, fileMagic, sizeof(fileMagic)) != 0)
+        {
+            VoxLog(Error, FileSystem, "World file '{}' is not a binary world file.", filepath);
+            return;
+        }
+
+        if (header.version < minimumVersion || header.version > currentVersion)
+        {
+            VoxLog(Error, FileSystem, "World file '{}' has unsupported version {}, expected {} to {}.", filepath, header.version, minimumVersion, currentVersion);
+            return;
+        }
+
+        if (header.chunkSize != VoxelChunk::chunkSize)
+        {
+            VoxLog(Error, FileSystem, "World file '{}' has chunk size {}, expected {}.", filepath, header.chunkSize, VoxelChunk::chunkSize);
+            return;
+        }
+
+        if (header.tableOffset > file.GetSize() || (file.GetSize() - header.tableOffset) / sizeof(ChunkEntry) < header.chunkCount)
+        {
+            VoxLog(Error, FileSystem, "World file '{}' chunk table is truncated.", filepath);
+            return;
+        }
+
+        table.resize(header.chunkCount);
+        std::memcpy(table.data(), file.GetData() + header.tableOffset, table.size() * sizeof(ChunkEntry));
+        for (ChunkEntry& entry : table)
+        {
+            if (header.version < 3)
+            {
+                entry.y = 0;
+            }
+
+            if (entry.offset > file.GetSize() || entry.size > file.GetSize() - entry.offset)
+            {
+                VoxLog(Error, FileSystem, "World file '{}' chunk '{}' points outside the file.", filepath, glm::ivec3(entry.x, entry.y, entry.z));
+                table.clear();
+                return;
+            }
+        }
+
+        // Older tables are sorted by a different key
+        auto entryKey = [](const ChunkEntry& entry) { return VoxelChunkMap::PackKey({entry.x, entry.y, entry.z}); };
+        if (!std::ranges::is_sorted(table, {}, entryKey))
+        {
+            std::ranges::sort(table, {}, entryKey);
+        }
+        valid = true;
+    }
+
+    bool VoxelWorldFile::IsValid() const
+    {
+        return valid;
+    }
+
+    size_t VoxelWorldFile::GetChunkCount() const
+    {
+        return table.size();
+    }
+
+    glm::ivec3 VoxelWorldFile::GetChunkLocation(const size_t chunkIndex) const
+    {
+        const ChunkEntry& entry = table[chunkIndex];
+        return {entry.x, entry.y, entry.z};
+    }
+
+    const VoxelWorldFile::ChunkTable& VoxelWorldFile::GetChunkTable() const
+    {
+        return table;
+    }
+
+    std::optional<size_t> VoxelWorldFile::FindChunk(const glm::ivec3& chunkLocation) const
+    {
+        if (const ChunkEntry* entry = FindEntry(table, chunkLocation))
+        {
+            return entry - table.data();
+        }
+        return std::nullopt;
+    }
+
+    bool VoxelWorldFile::DecodeChunk(const size_t chunkIndex, VoxelChunk::VoxelArray& voxelsOut) const
+    {
+        const ChunkEntry& entry = table[chunkIndex];
+        return DecodePayload(std::string_view(file.GetData() + entry.offset, entry.size), voxelsOut);
+    }
+
+    bool VoxelWorldFile::DecodePayload(const std::string_view payload, VoxelChunk::VoxelArray& voxelsOut)
+    {
+        const char* cursor = payload.data();
+        const char* end = cursor + payload.size();
+
+        uint32_t paletteSize;
+        if (!ReadVarInt(cursor, end, paletteSize) || paletteSize == 0 || paletteSize > VoxelChunk::chunkVolume)
+        {
+            return false;
+        }
+
+        std::vector<Voxel> palette(paletteSize);
+        for (Voxel& voxel : palette)
+        {
+            if (!ReadVarInt(cursor, end, voxel.materialId))
+            {
+                return false;
+            }
+        }
+
+        Voxel* voxelData = voxelsOut[0][0].data();
+        uint32_t voxelIndex = 0;
+        while (voxelIndex < VoxelChunk::chunkVolume)
+        {
+            uint32_t runLength, paletteIndex;
+            if (!ReadVarInt(cursor, end, runLength) || !ReadVarInt(cursor, end, paletteIndex) ||
+                runLength == 0 || runLength > VoxelChunk::chunkVolume - voxelIndex || paletteIndex >= paletteSize)
+            {
+                return false;
+            }
+
+            std::fill_n(voxelData + voxelIndex, runLength, palette[paletteIndex]);
+            voxelIndex += runLength;
+        }
+        return cursor == end;
+    }
+
+    const VoxelWorldFile::ChunkEntry* VoxelWorldFile::FindEntry(const ChunkTable& table, const glm::ivec3& chunkLocation)
+    {
+        const uint64_t key = VoxelChunkMap::PackKey(chunkLocation);
+        const auto entry = std::ranges::lower_bound(table, key, {}, [](const ChunkEntry& tableEntry)
+        {
+            return VoxelChunkMap::PackKey({tableEntry.x, tableEntry.y, tableEntry.z});
+        });
+        return entry != table.end() && glm::ivec3(entry->x, entry->y, entry->z) == chunkLocation ? &*entry : nullptr;
+    }
+
+    bool VoxelWorldFile::ReadPayload(const std::string& filepath, const ChunkEntry& entry, std::string& payloadOut)
+    {
+        SDL_IOStream* fileStream = SDL_IOFromFile(filepath.c_str(), "rb");
+        if (!fileStream)
+        {
+            return false;
+        }
+
+        payloadOut.resize(entry.size);
+        const bool succeeded = SDL_SeekIO(fileStream, static_cast<Sint64>(entry.offset), SDL_IO_SEEK_SET) == static_cast<Sint64>(entry.offset) &&
+            SDL_ReadIO(fileStream, payloadOut.data(), payloadOut.size()) == payloadOut.size();
+        SDL_CloseIO(fileStream);
+        return succeeded;
+    }
+
+    VoxelWorldFile::SaveResult VoxelWorldFile::Save(const std::string& filepath, const std::string& sourceFilepath,
+        const std::vector<ChunkSnapshot>& modifiedChunks, ChunkTable& table)
+    {
+        SaveResult result;
+        result.savedChunkCount = modifiedChunks.size();
+
+        // Encode the modified chunks, with offsets relative to the start of the payloads for now
+        std::string payloads;
+        ChunkTable modifiedEntries;
+        modifiedEntries.reserve(modifiedChunks.size());
+        for (const ChunkSnapshot& snapshot : modifiedChunks)
+        {
+            ChunkEntry& entry = modifiedEntries.emplace_back();
+            entry.x = snapshot.location.x;
+            entry.y = snapshot.location.y;
+            entry.z = snapshot.location.z;
+            entry.offset = payloads.size();
+            EncodeChunk(snapshot.voxels, payloads);
+            entry.size = static_cast<uint32_t>(payloads.size() - entry.offset);
+        }
+
+        auto entryKey = [](const ChunkEntry& entry) { return VoxelChunkMap::PackKey({entry.x, entry.y, entry.z}); };
+        std::ranges::stable_sort(modifiedEntries, {}, entryKey);
+
+        // If a chunk was snapshotted more than once, only the latest copy is kept
+        const auto duplicates = std::ranges::unique(modifiedEntries.rbegin(), modifiedEntries.rend(), {}, entryKey);
+        modifiedEntries.erase(modifiedEntries.begin(), duplicates.begin().base());
+
+        // Merge the modified entries into the table, keeping it sorted
+        ChunkTable mergedTable;
+        std::vector<bool> entryModified;
+        mergedTable.reserve(table.size() + modifiedEntries.size());
+        auto tableEntry = table.begin();
+        for (const ChunkEntry& modifiedEntry : modifiedEntries)
+        {
+            for (; tableEntry != table.end() && entryKey(*tableEntry) < entryKey(modifiedEntry); ++tableEntry)
+            {
+                mergedTable.emplace_back(*tableEntry);
+                entryModified.emplace_back(false);
+            }
+            if (tableEntry != table.end() && entryKey(*tableEntry) == entryKey(modifiedEntry))
+            {
+                ++tableEntry;
+            }
+            mergedTable.emplace_back(modifiedEntry);
+            entryModified.emplace_back(true);
+        }
+        for (; tableEntry != table.end(); ++tableEntry)
+        {
+            mergedTable.emplace_back(*tableEntry);
+            entryModified.emplace_back(false);
+        }
+
+        std::error_code error;
+        const uint64_t fileSize = !sourceFilepath.empty() && filepath == sourceFilepath ? std::filesystem::file_size(filepath, error) : 0;
+        bool append = fileSize > 0 && !error;
+        if (append)
+        {
+            // Rewrite once more than half of the file would be unused payloads
+            constexpr uint64_t minimumRewriteSize = 1024 * 1024;
+            uint64_t usedSize = sizeof(Header) + mergedTable.size() * sizeof(ChunkEntry);
+            for (const ChunkEntry& entry : mergedTable)
+            {
+                usedSize += entry.size;
+            }
+            const uint64_t newFileSize = fileSize + payloads.size() + mergedTable.size() * sizeof(ChunkEntry);
+            append = newFileSize - usedSize <= std::max(usedSize, minimumRewriteSize);
+        }
+
+        const bool succeeded = append ?
+            AppendToFile(filepath, fileSize, payloads, entryModified, mergedTable, result) :
+            RewriteFile(filepath, sourceFilepath, payloads, entryModified, mergedTable, result);
+        if (succeeded)
+        {
+            table = std::move(mergedTable);
+        }
+        return result;
+    }
+
+    void VoxelWorldFile::EncodeChunk(const PalettedVoxelStorage& voxels, std::string& dataOut)
+    {
+        std::vector<Voxel> denseVoxels(voxels.GetVolume());
+        voxels.Unpack(denseVoxels.data());
+        const Voxel* voxelData = denseVoxels.data();
+
+        // Build the palette in order of first use, so the runs can be written in one pass
+        std::vector<Voxel> palette;
+        std::vector<std::pair<uint32_t, uint32_t>> runs;
+        for (uint32_t i = 0; i < voxels.GetVolume(); ++i)
+        {
+            if (!runs.empty() && palette[runs.back().second] == voxelData[i])
+            {
+                ++runs.back().first;
+                continue;
+            }
+
+            auto paletteEntry = std::ranges::find(palette, voxelData[i]);
+            if (paletteEntry == palette.end())
+            {
+                paletteEntry = palette.insert(palette.end(), voxelData[i]);
+            }
+            runs.emplace_back(1, static_cast<uint32_t>(paletteEntry - palette.begin()));
+        }
+
+        WriteVarInt(static_cast<uint32_t>(palette.size()), dataOut);
+        for (const Voxel& voxel : palette)
+        {
+            WriteVarInt(voxel.materialId, dataOut);
+        }
+        for (const auto& [runLength, paletteIndex] : runs)
+        {
+            WriteVarInt(runLength, dataOut);
+            WriteVarInt(paletteIndex, dataOut);
+        }
+    }
+
+    bool VoxelWorldFile::AppendToFile(const std::string& filepath, const uint64_t fileSize, const std::string& payloads,
+        const std::vector<bool>& entryModified, ChunkTable& table, SaveResult& resultOut)
+    {
+        SDL_IOStream* fileStream = SDL_IOFromFile(filepath.c_str(), "r+b");
+        if (!fileStream)
+        {
+            resultOut.error = fmt::format("Failed to open '{}' for writing.", filepath);
+            return false;
+        }
+
+        for (size_t i = 0; i < table.size(); ++i)
+        {
+            if (entryModified[i])
+            {
+                table[i].offset += fileSize;
+            }
+        }
+
+        Header header;
+        std::memcpy(header.magic, fileMagic, sizeof(fileMagic));
+        header.version = currentVersion;
+        header.chunkCount = static_cast<uint32_t>(table.size());
+        header.chunkSize = VoxelChunk::chunkSize;
+        header.tableOffset = fileSize + payloads.size();
+
+        // The header is written last, so the old table stays valid until everything else is on disk
+        const size_t tableSize = table.size() * sizeof(ChunkEntry);
+        bool succeeded = SDL_SeekIO(fileStream, static_cast<Sint64>(fileSize), SDL_IO_SEEK_SET) == static_cast<Sint64>(fileSize) &&
+            SDL_WriteIO(fileStream, payloads.data(), payloads.size()) == payloads.size() &&
+            SDL_WriteIO(fileStream, table.data(), tableSize) == tableSize &&
+            SDL_FlushIO(fileStream) &&
+            SDL_SeekIO(fileStream, 0, SDL_IO_SEEK_SET) == 0 &&
+            SDL_WriteIO(fileStream, &header, sizeof(Header)) == sizeof(Header);
+        succeeded = SDL_CloseIO(fileStream) && succeeded;
+
+        if (!succeeded)
+        {
+            resultOut.error = fmt::format("Failed to append to '{}': {}", filepath, SDL_GetError());
+            return false;
+        }
+        resultOut.bytesWritten = payloads.size() + tableSize + sizeof(Header);
+        return true;
+    }
+
+    bool VoxelWorldFile::RewriteFile(const std::string& filepath, const std::string& sourceFilepath, const std::string& payloads,
+        const std::vector<bool>& entryModified, ChunkTable& table, SaveResult& resultOut)
+    {
+        std::string data(sizeof(Header), '\0');
+        {
+            const MappedFile sourceFile = sourceFilepath.empty() ? MappedFile() : MappedFile(sourceFilepath);
+            for (size_t i = 0; i < table.size(); ++i)
+            {
+                ChunkEntry& entry = table[i];
+                if (entryModified[i])
+                {
+                    const uint64_t payloadOffset = entry.offset;
+                    entry.offset = data.size();
+                    data.append(payloads, payloadOffset, entry.size);
+                    continue;
+                }
+
+                // Unmodified chunks are copied as they are, they may not even be loaded
+                if (!sourceFile.IsValid() || entry.offset > sourceFile.GetSize() || entry.size > sourceFile.GetSize() - entry.offset)
+                {
+                    resultOut.error = fmt::format("Chunk '{}' could not be copied from '{}'.", glm::ivec3(entry.x, entry.y, entry.z), sourceFilepath);
+                    return false;
+                }
+                const uint64_t sourceOffset = entry.offset;
+                entry.offset = data.size();
+                data.append(sourceFile.GetData() + sourceOffset, entry.size);
+            }
+            // The source mapping has to be released before the source file can be replaced
+        }
+
+        Header header;
+        std::memcpy(header.magic, fileMagic, sizeof(fileMagic));
+        header.version = currentVersion;
+        header.chunkCount = static_cast<uint32_t>(table.size());
+        header.chunkSize = VoxelChunk::chunkSize;
+        header.tableOffset = data.size();
+        std::memcpy(data.data(), &header, sizeof(Header));
+        for (const ChunkEntry& entry : table)
+        {
+            WriteValue(entry, data);
+        }
+
+        // Write to a temporary file first, so a failed save never leaves a half written world behind
+        const std::string temporaryFilepath = filepath + ".tmp";
+        SDL_IOStream* fileStream = SDL_IOFromFile(temporaryFilepath.c_str(), "wb");
+        if (!fileStream)
+        {
+            resultOut.error = fmt::format("Failed to create '{}'.", temporaryFilepath);
+            return false;
+        }
+
+        bool succeeded = SDL_WriteIO(fileStream, data.data(), data.size()) == data.size();
+        succeeded = SDL_CloseIO(fileStream) && succeeded;
+
+        std::error_code error;
+        if (succeeded)
+        {
+            std::filesystem::rename(temporaryFilepath, filepath, error);
+        }
+
+        if (!succeeded || error)
+        {
+            resultOut.error = fmt::format("Failed to write '{}'.", filepath);
+            std::filesystem::remove(temporaryFilepath, error);
+            return false;
+        }
+        resultOut.bytesWritten = data.size();
+        resultOut.rewritten = true;
+        return true;
+    }
+}
@@ -0,0 +1,149 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <glm/vec3.hpp>
+
+#include "core/datatypes/MappedFile.h"
+#include "voxel/PalettedVoxelStorage.h"
+#include "voxel/VoxelChunk.h"
+
+namespace Vox
+{
+    /**
+     * @brief Reader and writer for the binary voxel world format (.voxb)
+     * The file starts with a header, which points at a table of chunk entries sorted by
+     * packed chunk coordinate. Each chunk payload is a palette followed by run-length
+     * encoded palette indices, in [x][y][z] order.
+     * Files are memory mapped, and chunks are decoded straight from the mapping,
+     * so any chunk can be read without touching the others. Only chunks that exist are stored,
+     * so empty space above and below the terrain takes no room in the file.
+     * Saves append the modified payloads and a new table to the end of the file, then
+     * point the header at the new table. The file is rewritten once too much of it is unused.
+     */
+    class VoxelWorldFile
+    {
+    public:
+        static constexpr uint32_t currentVersion = 3;
+
+        // Version 2 files only had one layer of chunks, and are read with every chunk at y = 0
+        static constexpr uint32_t minimumVersion = 2;
+
+        struct ChunkEntry
+        {
+            int32_t x;
+            int32_t z;
+            uint64_t offset;
+            uint32_t size;
+
+            // Added in version 3, in a field that version 2 always wrote as 0
+            int32_t y;
+        };
+
+        // Sorted by packed chunk coordinate
+        using ChunkTable = std::vector<ChunkEntry>;
+
+        /**
+         * @brief A copy of a chunk's voxels, taken on the main thread so it can be encoded on another
+         */
+        struct ChunkSnapshot
+        {
+            glm::ivec3 location;
+            PalettedVoxelStorage voxels;
+        };
+
+        struct SaveResult
+        {
+            size_t savedChunkCount = 0;
+            size_t bytesWritten = 0;
+            bool rewritten = false;
+
+            // Empty if the save succeeded
+            std::string error;
+        };
+
+        /**
+         * @brief Map a world file, and validate its header and chunk table
+         * @param filepath absolute path to the file
+         */
+        explicit VoxelWorldFile(const std::string& filepath);
+
+        [[nodiscard]] bool IsValid() const;
+
+        [[nodiscard]] size_t GetChunkCount() const;
+
+        [[nodiscard]] glm::ivec3 GetChunkLocation(size_t chunkIndex) const;
+
+        [[nodiscard]] const ChunkTable& GetChunkTable() const;
+
+        /**
+         * @brief Find the table index of a chunk, using a binary search of the chunk table
+         */
+        [[nodiscard]] std::optional<size_t> FindChunk(const glm::ivec3& chunkLocation) const;
+
+        /**
+         * @brief Decode a chunk payload into a dense voxel array
+         * @return false if the payload is malformed, in which case voxelsOut is left partially written
+         */
+        bool DecodeChunk(size_t chunkIndex, VoxelChunk::VoxelArray& voxelsOut) const;
+
+        /**
+         * @brief Decode a single chunk payload into a dense voxel array
+         * @return false if the payload is malformed
+         */
+        static bool DecodePayload(std::string_view payload, VoxelChunk::VoxelArray& voxelsOut);
+
+        /**
+         * @brief Find a chunk in a table, using a binary search
+         * @return The entry, or nullptr if the chunk isn't in the table
+         */
+        [[nodiscard]] static const ChunkEntry* FindEntry(const ChunkTable& table, const glm::ivec3& chunkLocation);
+
+        /**
+         * @brief Read a single chunk payload from a world file, without mapping the whole file
+         * This doesn't log, so it can run on worker threads
+         */
+        static bool ReadPayload(const std::string& filepath, const ChunkEntry& entry, std::string& payloadOut);
+
+        /**
+         * @brief Write modified chunks into a world file. This doesn't log, so it can run on worker threads
+         * @param filepath absolute path to write to
+         * @param sourceFilepath absolute path of the file that table describes, empty if there is none.
+         * If this is the same file, the modified chunks are appended to it. Otherwise, a new file is
+         * written, copying the unmodified chunk payloads from the source file
+         * @param modifiedChunks chunks to encode, any chunk not in this list keeps its entry in the table
+         * @param table the chunk table of the source file, updated to describe the new file
+         */
+        static SaveResult Save(const std::string& filepath, const std::string& sourceFilepath,
+            const std::vector<ChunkSnapshot>& modifiedChunks, ChunkTable& table);
+
+    private:
+        struct Header
+        {
+            char magic[4];
+            uint32_t version;
+            uint32_t chunkCount;
+            uint32_t chunkSize;
+            uint64_t tableOffset;
+        };
+
+        static void EncodeChunk(const PalettedVoxelStorage& voxels, std::string& dataOut);
+
+        static bool AppendToFile(const std::string& filepath, uint64_t fileSize, const std::string& payloads,
+            const std::vector<bool>& entryModified, ChunkTable& table, SaveResult& resultOut);
+
+        static bool RewriteFile(const std::string& filepath, const std::string& sourceFilepath, const std::string& payloads,
+            const std::vector<bool>& entryModified, ChunkTable& table, SaveResult& resultOut);
+
+        MappedFile file;
+
+        // Copied out of the file, so tables from older versions can be sorted by the current key
+        ChunkTable table;
+
+        bool valid = false;
+    };
+}
@@ -0,0 +1,228 @@
+#include "VoxelWorldStore.h"
+
+#include <chrono>
+
+#include "core/logging/Logging.h"
+#include "core/services/ServiceLocator.h"
+#include "core/services/ThreadPool.h"
+#include "voxel/VoxelChunkMap.h"
+
+namespace Vox
+{
+    VoxelWorldStore::~VoxelWorldStore()
+    {
+        Wait();
+    }
+
+    void VoxelWorldStore::SetSourceFile(const std::string& filepath, VoxelWorldFile::ChunkTable table)
+    {
+        std::scoped_lock lock(fileMutex);
+        sourceFilepath = filepath;
+        chunkTable = std::move(table);
+    }
+
+    void VoxelWorldStore::Save(const std::string& filepath, std::vector<VoxelWorldFile::ChunkSnapshot> modifiedChunks)
+    {
+        Submit({RequestType::Save, filepath, std::move(modifiedChunks)});
+    }
+
+    void VoxelWorldStore::Load(const glm::ivec3& location)
+    {
+        Submit({RequestType::Load, {}, {}, location});
+    }
+
+    VoxelWorldStore::LoadedChunk VoxelWorldStore::LoadImmediately(const glm::ivec3& location)
+    {
+        // Queued unloads and saves change what the chunk reads as, so they have to land first
+        Wait();
+        std::unique_lock fileLock(fileMutex);
+        return ReadChunk(location, fileLock);
+    }
+
+    void VoxelWorldStore::Unload(VoxelWorldFile::ChunkSnapshot unsavedChunk)
+    {
+        std::vector<VoxelWorldFile::ChunkSnapshot> chunks;
+        chunks.emplace_back(std::move(unsavedChunk));
+        Submit({RequestType::Unload, {}, std::move(chunks)});
+    }
+
+    std::vector<VoxelWorldStore::LoadedChunk> VoxelWorldStore::TakeLoadedChunks()
+    {
+        std::scoped_lock lock(queueMutex);
+        std::vector<LoadedChunk> result = std::move(loadedChunks);
+        loadedChunks.clear();
+        return result;
+    }
+
+    void VoxelWorldStore::Wait()
+    {
+        std::unique_lock lock(queueMutex);
+        requestsFinished.wait(lock, [this] { return pendingRequestCount == 0; });
+    }
+
+    void VoxelWorldStore::LogFinishedSaves()
+    {
+        std::vector<FinishedSave> saves;
+        {
+            std::scoped_lock lock(queueMutex);
+            saves = std::move(finishedSaves);
+            finishedSaves.clear();
+        }
+
+        for (const FinishedSave& save : saves)
+        {
+            if (!save.result.error.empty())
+            {
+                VoxLog(Error, FileSystem, "Failed to save voxel world: {}", save.result.error);
+                continue;
+            }
+
+            VoxLog(Display, FileSystem, "Saved {} modified voxel chunks to '{}' in {:.1f} ms, {} KiB written{}.",
+                save.result.savedChunkCount, save.filepath, save.saveMs, save.result.bytesWritten / 1024,
+                save.result.rewritten ? ", file rewritten" : "");
+        }
+    }
+
+    VoxelSaveStatus VoxelWorldStore::GetStatus() const
+    {
+        std::scoped_lock lock(queueMutex);
+        VoxelSaveStatus result = status;
+        result.pendingSaveCount = pendingSaveCount;
+        return result;
+    }
+
+    void VoxelWorldStore::Submit(PendingRequest request)
+    {
+        {
+            std::scoped_lock lock(queueMutex);
+            pendingSaveCount += request.type == RequestType::Save ? 1 : 0;
+            pendingRequests.emplace_back(std::move(request));
+            ++pendingRequestCount;
+        }
+
+        // Each task handles whichever request is at the front of the queue, so requests are handled in order
+        // even if the pool picks up the tasks out of order
+        ServiceLocator::GetThreadPool()->Submit([this] { HandleNextRequest(); });
+    }
+
+    void VoxelWorldStore::HandleNextRequest()
+    {
+        std::unique_lock fileLock(fileMutex);
+
+        PendingRequest request;
+        {
+            std::scoped_lock lock(queueMutex);
+            request = std::move(pendingRequests.front());
+            pendingRequests.pop_front();
+        }
+
+        switch (request.type)
+        {
+        case RequestType::Save:
+            WriteSave(request, fileLock);
+            break;
+        case RequestType::Load:
+        {
+            LoadedChunk loadedChunk = ReadChunk(request.location, fileLock);
+            std::scoped_lock lock(queueMutex);
+            loadedChunks.emplace_back(std::move(loadedChunk));
+            break;
+        }
+        case RequestType::Unload:
+            for (VoxelWorldFile::ChunkSnapshot& chunk : request.chunks)
+            {
+                unsavedChunks.insert_or_assign(VoxelChunkMap::PackKey(chunk.location), std::move(chunk));
+            }
+            break;
+        }
+
+        // Notify while holding the lock, a waiting destructor could otherwise destroy the condition variable first
+        std::scoped_lock lock(queueMutex);
+        pendingSaveCount -= request.type == RequestType::Save ? 1 : 0;
+        --pendingRequestCount;
+        requestsFinished.notify_all();
+    }
+
+    void VoxelWorldStore::WriteSave(PendingRequest& save, std::unique_lock<std::mutex>& fileLock)
+    {
+        // Unsaved chunks are no longer loaded, or no longer marked as modified, so carry them into this save
+        for (const VoxelWorldFile::ChunkSnapshot& snapshot : save.chunks)
+        {
+            unsavedChunks.erase(VoxelChunkMap::PackKey(snapshot.location));
+        }
+        for (auto& [key, snapshot] : unsavedChunks)
+        {
+            save.chunks.emplace_back(std::move(snapshot));
+        }
+        unsavedChunks.clear();
+
+        using Clock = std::chrono::steady_clock;
+        const Clock::time_point saveStart = Clock::now();
+        VoxelWorldFile::SaveResult result = VoxelWorldFile::Save(save.filepath, sourceFilepath, save.chunks, chunkTable);
+        const double saveMs = std::chrono::duration<double, std::milli>(Clock::now() - saveStart).count();
+        if (result.error.empty())
+        {
+            sourceFilepath = save.filepath;
+        }
+        else
+        {
+            for (VoxelWorldFile::ChunkSnapshot& snapshot : save.chunks)
+            {
+                unsavedChunks.insert_or_assign(VoxelChunkMap::PackKey(snapshot.location), std::move(snapshot));
+            }
+        }
+        fileLock.unlock();
+
+        std::scoped_lock lock(queueMutex);
+        if (result.error.empty())
+        {
+            status.lastSavedChunkCount = result.savedChunkCount;
+            status.lastBytesWritten = result.bytesWritten;
+            status.lastSaveMs = saveMs;
+            status.lastSaveRewroteFile = result.rewritten;
+        }
+        finishedSaves.emplace_back(std::move(save.filepath), std::move(result), saveMs);
+    }
+
+    VoxelWorldStore::LoadedChunk VoxelWorldStore::ReadChunk(const glm::ivec3& location, std::unique_lock<std::mutex>& fileLock)
+    {
+        LoadedChunk result;
+        result.location = location;
+
+        // Only the read has to hold the file, decoding can overlap with the next request
+        std::optional<PalettedVoxelStorage> unsavedVoxels;
+        std::string payload;
+        bool payloadRead = false;
+        if (const auto unsavedChunk = unsavedChunks.find(VoxelChunkMap::PackKey(location)); unsavedChunk != unsavedChunks.end())
+        {
+            unsavedVoxels = unsavedChunk->second.voxels;
+        }
+        else if (const VoxelWorldFile::ChunkEntry* entry = VoxelWorldFile::FindEntry(chunkTable, location))
+        {
+            payloadRead = VoxelWorldFile::ReadPayload(sourceFilepath, *entry, payload);
+            result.malformed = !payloadRead;
+        }
+        fileLock.unlock();
+
+        if (unsavedVoxels || payloadRead)
+        {
+            const auto denseVoxels = std::make_unique<VoxelChunk::VoxelArray>();
+            if (unsavedVoxels)
+            {
+                unsavedVoxels->Unpack((*denseVoxels)[0][0].data());
+                result.unsaved = true;
+            }
+            else if (!VoxelWorldFile::DecodePayload(payload, *denseVoxels))
+            {
+                result.malformed = true;
+            }
+
+            if (!result.malformed)
+            {
+                result.chunk = VoxelChunk::Decode(location, *denseVoxels);
+            }
+        }
+
+        return result;
+    }
+}
@@ -0,0 +1,156 @@
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "voxel/VoxelChunk.h"
+#include "voxel/VoxelWorldFile.h"
+
+namespace Vox
+{
+    struct VoxelSaveStatus
+    {
+        size_t pendingSaveCount = 0;
+
+        size_t lastSavedChunkCount = 0;
+        size_t lastBytesWritten = 0;
+        double lastSaveMs = 0.0;
+        bool lastSaveRewroteFile = false;
+    };
+
+    /**
+     * @brief Reads and writes voxel world files on the thread pool
+     * Requests are handled one at a time and in the order they were made, so a chunk that is loaded
+     * after it was saved or unloaded always sees those changes. Keeps the chunk table of the current file,
+     * so saves only need the modified chunks, and single chunks can be read without loading the whole file
+     */
+    class VoxelWorldStore
+    {
+    public:
+        struct LoadedChunk
+        {
+            glm::ivec3 location = {0, 0, 0};
+
+            // Empty if the chunk doesn't exist, or couldn't be decoded
+            std::optional<VoxelChunk::DecodedChunk> chunk;
+
+            // The chunk was unloaded with changes that haven't been saved yet
+            bool unsaved = false;
+
+            bool malformed = false;
+        };
+
+        VoxelWorldStore() = default;
+
+        /**
+         * @brief Waits for any pending requests to finish
+         */
+        ~VoxelWorldStore();
+
+        VoxelWorldStore(VoxelWorldStore&&) = delete;
+        VoxelWorldStore(const VoxelWorldStore&) = delete;
+        VoxelWorldStore& operator=(VoxelWorldStore&&) = delete;
+        VoxelWorldStore& operator=(const VoxelWorldStore&) = delete;
+
+        /**
+         * @brief Set the file that loads read from and saves start from
+         */
+        void SetSourceFile(const std::string& filepath, VoxelWorldFile::ChunkTable table);
+
+        /**
+         * @brief Queue a save of the modified chunks. Should only be called from the main thread
+         * Chunks that were unloaded with unsaved changes are written as well
+         * @param filepath absolute path to save to
+         */
+        void Save(const std::string& filepath, std::vector<VoxelWorldFile::ChunkSnapshot> modifiedChunks);
+
+        /**
+         * @brief Queue a chunk to be read and decoded. The result is returned from TakeLoadedChunks
+         */
+        void Load(const glm::ivec3& location);
+
+        /**
+         * @brief Read and decode a chunk on the calling thread, once every queued request has finished
+         * Used when a chunk has to be resident right away, such as when it is edited before its load arrives
+         */
+        [[nodiscard]] LoadedChunk LoadImmediately(const glm::ivec3& location);
+
+        /**
+         * @brief Keep the contents of an unloaded chunk that hasn't been saved, until the next save writes it
+         * Later loads of the chunk return these contents instead of the file's
+         */
+        void Unload(VoxelWorldFile::ChunkSnapshot unsavedChunk);
+
+        /**
+         * @brief Take the results of any loads that finished since the last call
+         */
+        [[nodiscard]] std::vector<LoadedChunk> TakeLoadedChunks();
+
+        /**
+         * @brief Block until every queued request has finished
+         */
+        void Wait();
+
+        /**
+         * @brief Log the results of any saves that finished since the last call. Should only be called from the main thread
+         */
+        void LogFinishedSaves();
+
+        [[nodiscard]] VoxelSaveStatus GetStatus() const;
+
+    private:
+        enum class RequestType : char
+        {
+            Save,
+            Load,
+            Unload
+        };
+
+        struct PendingRequest
+        {
+            RequestType type;
+            std::string filepath;
+            std::vector<VoxelWorldFile::ChunkSnapshot> chunks;
+            glm::ivec3 location = {0, 0, 0};
+        };
+
+        struct FinishedSave
+        {
+            std::string filepath;
+            VoxelWorldFile::SaveResult result;
+            double saveMs;
+        };
+
+        void Submit(PendingRequest request);
+
+        void HandleNextRequest();
+
+        void WriteSave(PendingRequest& save, std::unique_lock<std::mutex>& fileLock);
+
+        [[nodiscard]] LoadedChunk ReadChunk(const glm::ivec3& location, std::unique_lock<std::mutex>& fileLock);
+
+        // Held while reading or writing the file, so requests never overlap
+        std::mutex fileMutex;
+
+        // Only accessed while holding fileMutex
+        std::string sourceFilepath;
+        VoxelWorldFile::ChunkTable chunkTable;
+
+        // Chunks that aren't in the file yet, either unloaded without saving or from a failed save. Keyed by VoxelChunkMap::PackKey
+        std::unordered_map<uint64_t, VoxelWorldFile::ChunkSnapshot> unsavedChunks;
+
+        mutable std::mutex queueMutex;
+        std::condition_variable requestsFinished;
+        std::deque<PendingRequest> pendingRequests;
+        size_t pendingRequestCount = 0;
+        size_t pendingSaveCount = 0;
+        std::vector<FinishedSave> finishedSaves;
+        std::vector<LoadedChunk> loadedChunks;
+        VoxelSaveStatus status;
+    };
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <vector>
+
+namespace Vox::Test
+{
+    using TestFunction = void(*)();
+
+    struct TestCase
+    {
+        const char* name;
+        TestFunction function;
+    };
+
+    [[nodiscard]] std::vector<TestCase>& GetTests();
+
+    /**
+     * @brief Record a failed check against the test that is running
+     */
+    void ReportFailure(const char* file, int line, const char* expression);
+
+    struct TestRegistrar
+    {
+        TestRegistrar(const char* name, TestFunction function);
+    };
+}
+
+/**
+ * @brief Define a test, registered with the test runner when the program starts
+ */
+#define VOX_TEST(name) \
+    static void name(); \
+    static const Vox::Test::TestRegistrar name##Registrar(#name, name); \
+    static void name()
+
+/**
+ * @brief Fail the test if the expression is false, and keep running it
+ */
+#define VOX_CHECK(expression) \
+    do { if (!(expression)) { Vox::Test::ReportFailure(__FILE__, __LINE__, #expression); } } while (false)
+
+/**
+ * @brief Fail the test and stop it if the expression is false, for checks that later ones depend on
+ */
+#define VOX_REQUIRE(expression) \
+    do { if (!(expression)) { Vox::Test::ReportFailure(__FILE__, __LINE__, #expression); return; } } while (false)
@@ -0,0 +1,60 @@
+#include <string_view>
+
+#include <fmt/format.h>
+
+#include "Test.h"
+
+namespace Vox::Test
+{
+    namespace
+    {
+        int currentFailureCount = 0;
+    }
+
+    std::vector<TestCase>& GetTests()
+    {
+        // Built on first use, so registrars in other files can run before main
+        static std::vector<TestCase> tests;
+        return tests;
+    }
+
+    void ReportFailure(const char* file, const int line, const char* expression)
+    {
+        fmt::print("    {}:{}: check failed: {}\n", file, line, expression);
+        ++currentFailureCount;
+    }
+
+    TestRegistrar::TestRegistrar(const char* name, const TestFunction function)
+    {
+        GetTests().emplace_back(name, function);
+    }
+}
+
+/**
+ * @brief Run every test, or only the tests whose name contains the first argument
+ * @return The number of failed tests
+ */
+int main(const int argc, char** argv)
+{
+    using namespace Vox::Test;
+    const std::string_view filter = argc > 1 ? argv[1] : "";
+
+    int failedCount = 0;
+    int runCount = 0;
+    for (const TestCase& test : GetTests())
+    {
+        if (!filter.empty() && std::string_view(test.name).find(filter) == std::string_view::npos)
+        {
+            continue;
+        }
+
+        currentFailureCount = 0;
+        test.function();
+        ++runCount;
+        fmt::print("[{}] {}\n", currentFailureCount == 0 ? " ok " : "FAIL", test.name);
+        failedCount += currentFailureCount == 0 ? 0 : 1;
+    }
+
+    fmt::print("{} of {} tests passed.\n", runCount - failedCount, runCount);
+    return failedCount;
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <string_view>
+#include <vector>
+
+namespace Vox::Benchmark
+{
+    using BenchmarkFunction = void(*)();
+
+    struct BenchmarkCase
+    {
+        const char* name;
+        BenchmarkFunction function;
+    };
+
+    [[nodiscard]] std::vector<BenchmarkCase>& GetBenchmarks();
+
+    struct BenchmarkRegistrar
+    {
+        BenchmarkRegistrar(const char* name, BenchmarkFunction function);
+    };
+
+    /**
+     * @brief Keep a result alive, so the work that produced it isn't optimized out
+     */
+    void Consume(size_t value);
+
+    /**
+     * @brief Print one result line, in milliseconds per repetition
+     */
+    void Report(std::string_view label, double milliseconds);
+
+    /**
+     * @brief Time a function, after one untimed run to warm up caches and allocations
+     * @return The average time of one repetition, in milliseconds
+     */
+    template <typename Function>
+    double Measure(const int repetitions, Function&& function)
+    {
+        using Clock = std::chrono::steady_clock;
+        function();
+        const Clock::time_point start = Clock::now();
+        for (int i = 0; i < repetitions; ++i)
+        {
+            function();
+        }
+        return std::chrono::duration<double, std::milli>(Clock::now() - start).count() / repetitions;
+    }
+}
+
+/**
+ * @brief Define a benchmark, registered with the benchmark runner when the program starts
+ */
+#define VOX_BENCHMARK(name) \
+    static void name(); \
+    static const Vox::Benchmark::BenchmarkRegistrar name##Registrar(#name, name); \
+    static void name()
@@ -0,0 +1,57 @@
+#include <string_view>
+
+#include <fmt/format.h>
+
+#include "Benchmark.h"
+
+namespace Vox::Benchmark
+{
+    namespace
+    {
+        volatile size_t consumedValue = 0;
+    }
+
+    std::vector<BenchmarkCase>& GetBenchmarks()
+    {
+        // Built on first use, so registrars in other files can run before main
+        static std::vector<BenchmarkCase> benchmarks;
+        return benchmarks;
+    }
+
+    BenchmarkRegistrar::BenchmarkRegistrar(const char* name, const BenchmarkFunction function)
+    {
+        GetBenchmarks().emplace_back(name, function);
+    }
+
+    void Consume(const size_t value)
+    {
+        consumedValue = consumedValue + value;
+    }
+
+    void Report(const std::string_view label, const double milliseconds)
+    {
+        fmt::print("    {:<40} {:>10.4f} ms\n", label, milliseconds);
+    }
+}
+
+/**
+ * @brief Run every benchmark, or only the benchmarks whose name contains the first argument
+ * Numbers are only meaningful in an optimized build
+ */
+int main(const int argc, char** argv)
+{
+    using namespace Vox::Benchmark;
+    const std::string_view filter = argc > 1 ? argv[1] : "";
+
+    for (const BenchmarkCase& benchmark : GetBenchmarks())
+    {
+        if (!filter.empty() && std::string_view(benchmark.name).find(filter) == std::string_view::npos)
+        {
+            continue;
+        }
+
+        fmt::print("{}\n", benchmark.name);
+        benchmark.function();
+    }
+    return 0;
+}
@@ -0,0 +1,28 @@
+#include "BenchmarkModel.h"
+
+#include <cstdlib>
+#include <string>
+
+#include <fmt/format.h>
+
+// The engine compiles these in Vox.cpp, which the benchmarks don't build
+#define TINYGLTF_IMPLEMENTATION
+#define STB_IMAGE_IMPLEMENTATION
+#define STB_IMAGE_WRITE_IMPLEMENTATION
+#include <tiny_gltf.h>
+
+namespace Vox::Benchmark
+{
+    void LoadModel(const std::string_view fileName, tinygltf::Model& modelOut)
+    {
+        const std::string filepath = fmt::format("{}models/{}", VOX_ASSET_DIRECTORY, fileName);
+        tinygltf::TinyGLTF loader;
+        std::string err;
+        std::string warn;
+        if (!loader.LoadBinaryFromFile(&modelOut, &err, &warn, filepath))
+        {
+            fmt::print("Failed to load '{}': {}\n", filepath, err);
+            std::exit(1);
+        }
+    }
+}
@@ -0,0 +1,16 @@
+#pragma once
+
+#include <string_view>
+
+namespace tinygltf
+{
+    class Model;
+}
+
+namespace Vox::Benchmark
+{
+    /**
+     * @brief Load a binary glTF from the repository's assets/models, exiting if it can't be read
+     */
+    void LoadModel(std::string_view fileName, tinygltf::Model& modelOut);
+}
@@ -0,0 +1,43 @@
+#include <random>
+#include <vector>
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include "benchmarks/Benchmark.h"
+#include "core/math/BoundingBox.h"
+#include "rendering/FrustumCuller.h"
+#include "rendering/camera/Frustum.h"
+
+using namespace Vox;
+
+VOX_BENCHMARK(FrustumCull100k)
+{
+    const Frustum frustum = Frustum::FromMatrix(glm::perspective(1.0f, 16.0f / 9.0f, 0.1f, 500.0f) *
+        glm::lookAt(glm::vec3(0.0f), glm::vec3(0.0f, 0.0f, -1.0f), glm::vec3(0.0f, 1.0f, 0.0f)));
+
+    std::mt19937 random(1);
+    std::uniform_real_distribution<float> position(-600.0f, 600.0f);
+    std::uniform_real_distribution<float> size(0.1f, 40.0f);
+    FrustumCuller culler;
+    std::vector<BoundingBox> boxes;
+    for (int i = 0; i < 100000; ++i)
+    {
+        const glm::vec3 min(position(random), position(random), position(random));
+        boxes.emplace_back(min, min + glm::vec3(size(random), size(random), size(random)));
+        culler.Add(boxes.back());
+    }
+
+    Benchmark::Report("FrustumCuller::Cull", Benchmark::Measure(100, [&]
+    {
+        Benchmark::Consume(culler.Cull(frustum).size());
+    }));
+    Benchmark::Report("Frustum::Intersects per box", Benchmark::Measure(100, [&]
+    {
+        size_t visibleCount = 0;
+        for (const BoundingBox& box : boxes)
+        {
+            visibleCount += frustum.Intersects(box) ? 1 : 0;
+        }
+        Benchmark::Consume(visibleCount);
+    }));
+}
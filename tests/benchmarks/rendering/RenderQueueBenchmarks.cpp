@@ -0,0 +1,91 @@
+#include <random>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "benchmarks/Benchmark.h"
+#include "rendering/CountingRenderBackend.h"
+#include "rendering/RenderQueue.h"
+
+using namespace Vox;
+
+namespace
+{
+    size_t GetStateCalls(const CountingRenderBackend& backend)
+    {
+        return backend.shaderBinds + backend.instanceBinds + backend.geometryBinds + backend.materialSets + backend.transformSets;
+    }
+
+    /**
+     * @brief Count the state changes of submitting the draws in the order they were added, with the same rules as Submit
+     */
+    size_t GetUnsortedStateCalls(const std::vector<DrawCommand>& commands)
+    {
+        size_t calls = 0;
+        const DrawCommand* previous = nullptr;
+        for (const DrawCommand& command : commands)
+        {
+            if (!previous || command.shader != previous->shader)
+            {
+                calls += command.instances != DrawCommand::noInstances ? 5 : 4;
+            }
+            else
+            {
+                calls += command.instances != DrawCommand::noInstances && command.instances != previous->instances ? 1 : 0;
+                calls += command.geometry != previous->geometry ? 1 : 0;
+                calls += command.material != previous->material ? 1 : 0;
+                calls += command.transform != previous->transform ? 1 : 0;
+            }
+            previous = &command;
+        }
+        return calls;
+    }
+}
+
+VOX_BENCHMARK(RenderQueue100k)
+{
+    // 6 shaders, 100 instance bindings, 16 materials and 200 geometries, in random order
+    std::mt19937 random(7);
+    std::vector<DrawCommand> commands;
+    for (int i = 0; i < 100000; ++i)
+    {
+        DrawCommand command;
+        command.shader = random() % 6;
+        command.instances = random() % 100;
+        command.material = random() % 16;
+        command.geometry = random() % 200;
+        commands.push_back(command);
+    }
+
+    RenderQueue queue;
+    CountingRenderBackend backend;
+    const auto fillQueue = [&queue, &commands]
+    {
+        queue.Clear();
+        for (unsigned int i = 0; i < 200; ++i)
+        {
+            DrawGeometry geometry;
+            geometry.indexBuffer = i + 1;
+            queue.AddGeometry(geometry);
+        }
+        queue.AddTransform(glm::mat4x4(1.0f));
+        for (int i = 0; i < 100; ++i)
+        {
+            queue.AddInstances([] {});
+        }
+        for (const DrawCommand& command : commands)
+        {
+            queue.Add(RenderPass::GBuffer, command, 0.5f);
+        }
+    };
+
+    Benchmark::Report("add, sort and submit", Benchmark::Measure(10, [&]
+    {
+        fillQueue();
+        queue.Sort();
+        backend.Reset();
+        queue.Submit(RenderPass::GBuffer, backend);
+        Benchmark::Consume(backend.draws);
+    }));
+    fmt::print("    state calls: {} sorted, {} in the order added\n", GetStateCalls(backend), GetUnsortedStateCalls(commands));
+}
@@ -0,0 +1,114 @@
+#include <algorithm>
+#include <cmath>
+#include <string_view>
+#include <vector>
+
+#include <tiny_gltf.h>
+
+#include "benchmarks/Benchmark.h"
+#include "benchmarks/BenchmarkModel.h"
+#include "rendering/skeletal_mesh/AnimationChannel.h"
+#include "rendering/skeletal_mesh/TestChannels.h"
+
+using namespace Vox;
+
+namespace
+{
+    struct Clip
+    {
+        std::vector<AnimationChannel> channels;
+        float duration = 0.0f;
+    };
+
+    Clip LoadClip(tinygltf::Model& model, const std::string_view name, const float sampleRate)
+    {
+        Clip clip;
+        for (const tinygltf::Animation& animation : model.animations)
+        {
+            if (animation.name != name)
+            {
+                continue;
+            }
+
+            for (const tinygltf::AnimationChannel& channel : animation.channels)
+            {
+                AnimationChannel& animationChannel = clip.channels.emplace_back(model, animation, channel);
+                animationChannel.Resample(sampleRate);
+                clip.duration = std::max(clip.duration, animationChannel.GetDuration());
+            }
+        }
+        return clip;
+    }
+
+    float Evaluate(const AnimationChannel& channel, const float time, unsigned int* cursor)
+    {
+        if (channel.GetType() == AnimationChannel::SamplerType::Rotation)
+        {
+            return cursor ? channel.EvaluateRotation(time, *cursor).w : channel.EvaluateRotation(time).w;
+        }
+        return cursor ? channel.EvaulateVector(time, *cursor).x : channel.EvaulateVector(time).x;
+    }
+
+    /**
+     * @brief Play every clip on its share of the instances, each instance starting a little later than the last
+     */
+    double PlayInstances(const std::vector<Clip>& clips, const int instanceCount, const int frameCount, const bool useCursors)
+    {
+        return Benchmark::Measure(5, [&]
+        {
+            std::vector<std::vector<unsigned int>> cursors(instanceCount);
+            float sum = 0.0f;
+            for (int frame = 0; frame < frameCount; ++frame)
+            {
+                for (int instance = 0; instance < instanceCount; ++instance)
+                {
+                    const Clip& clip = clips[instance % clips.size()];
+                    std::vector<unsigned int>& instanceCursors = cursors[instance];
+                    instanceCursors.resize(clip.channels.size());
+                    const float time = std::fmod(static_cast<float>(frame) / 60.0f + static_cast<float>(instance) * 0.013f, clip.duration);
+                    for (size_t channel = 0; channel < clip.channels.size(); ++channel)
+                    {
+                        sum += Evaluate(clip.channels[channel], time, useCursors ? &instanceCursors[channel] : nullptr);
+                    }
+                }
+            }
+            Benchmark::Consume(static_cast<size_t>(sum));
+        });
+    }
+}
+
+VOX_BENCHMARK(AnimationChannelScorpion)
+{
+    // The clips have 31 keys or fewer, so slerp costs more than finding the keys
+    tinygltf::Model model;
+    Benchmark::LoadModel("scorpion.glb", model);
+    const auto loadClips = [&model](const float sampleRate)
+    {
+        return std::vector<Clip>{LoadClip(model, "StingerShot", sampleRate), LoadClip(model, "Walk", sampleRate)};
+    };
+
+    Benchmark::Report("search, 64 instances x 600 frames", PlayInstances(loadClips(0.0f), 64, 600, false));
+    Benchmark::Report("cursor", PlayInstances(loadClips(0.0f), 64, 600, true));
+    Benchmark::Report("resampled to 30 Hz", PlayInstances(loadClips(30.0f), 64, 600, false));
+    Benchmark::Report("resampled to 60 Hz", PlayInstances(loadClips(60.0f), 64, 600, false));
+}
+
+VOX_BENCHMARK(AnimationChannel3000Keys)
+{
+    // One long translation channel at 30 Hz, where the search is most of the work
+    constexpr unsigned int keyCount = 3000;
+    std::vector<float> times(keyCount);
+    std::vector<glm::vec3> values(keyCount);
+    for (unsigned int i = 0; i < keyCount; ++i)
+    {
+        times[i] = static_cast<float>(i) / 30.0f;
+        values[i] = {std::sin(times[i]), std::cos(times[i]), times[i]};
+    }
+
+    const std::vector<Clip> clips = {{{Test::MakeChannel("translation", times, values)}, times.back()}};
+    std::vector<Clip> resampledClips = clips;
+    resampledClips[0].channels[0].Resample(30.0f);
+    Benchmark::Report("search, 256 instances x 6000 frames", PlayInstances(clips, 256, 6000, false));
+    Benchmark::Report("cursor", PlayInstances(clips, 256, 6000, true));
+    Benchmark::Report("resampled to 30 Hz", PlayInstances(resampledClips, 256, 6000, false));
+}
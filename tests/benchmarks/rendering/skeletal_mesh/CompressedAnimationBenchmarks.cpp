@@ -0,0 +1,147 @@
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include <fmt/format.h>
+#include <tiny_gltf.h>
+
+#include "benchmarks/Benchmark.h"
+#include "benchmarks/BenchmarkModel.h"
+#include "rendering/mesh/ModelNode.h"
+#include "rendering/skeletal_mesh/AnimationChannel.h"
+#include "rendering/skeletal_mesh/AnimationImportSettings.h"
+#include "rendering/skeletal_mesh/CompressedAnimation.h"
+#include "rendering/skeletal_mesh/TestChannels.h"
+
+using namespace Vox;
+
+namespace
+{
+    /**
+     * @brief Sizes and the largest error of a set of clips, against their full precision channels
+     */
+    struct CompressionReport
+    {
+        size_t keyCount = 0;
+        size_t compressedKeyCount = 0;
+        size_t memorySize = 0;
+        size_t compressedMemorySize = 0;
+        float rotationError = 0.0f;
+        float vectorError = 0.0f;
+
+        void Add(const std::vector<AnimationChannel>& channels, const float duration, const int sampleCount)
+        {
+            AnimationImportSettings settings;
+            settings.compress = true;
+            const CompressedAnimation compressed(channels, duration, settings);
+            compressedKeyCount += compressed.GetKeyCount();
+            compressedMemorySize += compressed.GetMemorySize();
+            for (size_t track = 0; track < channels.size(); ++track)
+            {
+                const AnimationChannel& channel = channels[track];
+                keyCount += channel.GetTimeKeys().size();
+                memorySize += sizeof(AnimationChannel) + channel.GetMemorySize();
+                for (int i = 0; i <= sampleCount; ++i)
+                {
+                    const float time = duration * static_cast<float>(i) / static_cast<float>(sampleCount);
+                    if (channel.GetType() == AnimationChannel::SamplerType::Rotation)
+                    {
+                        rotationError = std::max(rotationError, Test::GetRotationError(channel.EvaluateRotation(time), compressed.EvaluateRotation(track, time)));
+                    }
+                    else
+                    {
+                        vectorError = std::max(vectorError, Test::GetVectorError(channel.EvaulateVector(time), compressed.EvaluateVector(track, time)));
+                    }
+                }
+            }
+        }
+
+        void Print() const
+        {
+            fmt::print("    keys: {} -> {}\n", keyCount, compressedKeyCount);
+            fmt::print("    memory: {:.1f} KiB -> {:.1f} KiB\n", static_cast<double>(memorySize) / 1024.0, static_cast<double>(compressedMemorySize) / 1024.0);
+            fmt::print("    max error: {:.5f} rad for rotations, {:.5f} for translations and scales\n", rotationError, vectorError);
+        }
+    };
+}
+
+VOX_BENCHMARK(CompressedAnimationScorpion)
+{
+    tinygltf::Model model;
+    Benchmark::LoadModel("scorpion.glb", model);
+
+    CompressionReport report;
+    std::vector<std::vector<AnimationChannel>> clips;
+    std::vector<CompressedAnimation> compressedClips;
+    std::vector<float> durations;
+    for (const tinygltf::Animation& animation : model.animations)
+    {
+        std::vector<AnimationChannel>& channels = clips.emplace_back();
+        float duration = 0.0f;
+        for (const tinygltf::AnimationChannel& channel : animation.channels)
+        {
+            duration = std::max(duration, channels.emplace_back(model, animation, channel).GetDuration());
+        }
+        durations.push_back(duration);
+        report.Add(channels, duration, 2000);
+
+        AnimationImportSettings settings;
+        settings.compress = true;
+        compressedClips.emplace_back(channels, duration, settings);
+    }
+    report.Print();
+
+    // Sampling whole poses, the way SkeletalModel::EvaluatePose does for each instance
+    std::vector<ModelTransform> localTransforms(256);
+    Benchmark::Report("full precision, 600 frames of every clip", Benchmark::Measure(5, [&]
+    {
+        for (size_t clip = 0; clip < clips.size(); ++clip)
+        {
+            std::vector<unsigned int> cursors(clips[clip].size(), 0);
+            for (int frame = 0; frame < 600; ++frame)
+            {
+                const float time = std::fmod(static_cast<float>(frame) / 60.0f, durations[clip]);
+                for (size_t channel = 0; channel < clips[clip].size(); ++channel)
+                {
+                    clips[clip][channel].ApplyToNode(localTransforms, time, cursors[channel]);
+                }
+            }
+        }
+        Benchmark::Consume(static_cast<size_t>(localTransforms[0].position.x));
+    }));
+    Benchmark::Report("compressed", Benchmark::Measure(5, [&]
+    {
+        for (size_t clip = 0; clip < compressedClips.size(); ++clip)
+        {
+            std::vector<unsigned int> cursors(compressedClips[clip].GetTrackCount(), 0);
+            for (int frame = 0; frame < 600; ++frame)
+            {
+                compressedClips[clip].ApplyToNodes(localTransforms, std::fmod(static_cast<float>(frame) / 60.0f, durations[clip]), cursors);
+            }
+        }
+        Benchmark::Consume(static_cast<size_t>(localTransforms[0].position.x));
+    }));
+}
+
+VOX_BENCHMARK(CompressedAnimation3000Keys)
+{
+    // A dense clip, like motion capture, with a translation and a rotation at 30 Hz
+    constexpr unsigned int keyCount = 3000;
+    std::vector<float> times(keyCount);
+    std::vector<glm::vec3> translations(keyCount);
+    std::vector<glm::quat> rotations(keyCount);
+    for (unsigned int i = 0; i < keyCount; ++i)
+    {
+        times[i] = static_cast<float>(i) / 30.0f;
+        translations[i] = {std::sin(times[i] * 0.5f), 0.2f * std::cos(times[i]), 1.0f};
+        const float halfAngle = 0.4f * std::sin(times[i] * 0.7f);
+        rotations[i] = glm::quat(std::cos(halfAngle), 0.0f, std::sin(halfAngle), 0.0f);
+    }
+
+    std::vector<AnimationChannel> channels;
+    channels.push_back(Test::MakeChannel("translation", times, translations));
+    channels.push_back(Test::MakeChannel("rotation", times, rotations));
+    CompressionReport report;
+    report.Add(channels, times.back(), 20000);
+    report.Print();
+}
@@ -0,0 +1,91 @@
+#include <random>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "benchmarks/Benchmark.h"
+#include "voxel/CollisionOctree.h"
+#include "voxel/TestChunks.h"
+
+using namespace Vox;
+using namespace Vox::Test;
+
+namespace
+{
+    constexpr int halfSize = static_cast<int>(testChunkSize / 2);
+}
+
+VOX_BENCHMARK(CollisionNode)
+{
+    for (const TestChunk chunk : {TestChunk::Terrain, TestChunk::Solid, TestChunk::Noise, TestChunk::Caves})
+    {
+        const std::vector<Voxel> voxels = MakeTestChunk(chunk, 7);
+        Octree::CollisionNode node(testChunkSize, voxels.data());
+        fmt::print("    {}: {} cubes, {} boxes\n", GetTestChunkName(chunk), node.GetCubes().size(), node.GetBoxes().size());
+
+        Benchmark::Report("build from voxels", Benchmark::Measure(20, [&]
+        {
+            const Octree::CollisionNode built(testChunkSize, voxels.data());
+            Benchmark::Consume(built.GetSize());
+        }));
+        Benchmark::Report("GetCubes", Benchmark::Measure(20, [&]
+        {
+            Benchmark::Consume(node.GetCubes().size());
+        }));
+        Benchmark::Report("GetBoxes", Benchmark::Measure(20, [&]
+        {
+            Benchmark::Consume(node.GetBoxes().size());
+        }));
+        Benchmark::Report("100k random SetVoxel", Benchmark::Measure(5, [&]
+        {
+            std::mt19937 random(1);
+            for (int i = 0; i < 100000; ++i)
+            {
+                const int x = static_cast<int>(random() % testChunkSize) - halfSize;
+                const int y = static_cast<int>(random() % testChunkSize) - halfSize;
+                const int z = static_cast<int>(random() % testChunkSize) - halfSize;
+                node.SetVoxel(x, y, z, Octree::PhysicsVoxel(random() % 2 == 0));
+            }
+        }));
+    }
+}
+
+VOX_BENCHMARK(CollisionNodeDenseBuild)
+{
+    for (const TestChunk chunk : {TestChunk::Terrain, TestChunk::Solid, TestChunk::Noise, TestChunk::Empty})
+    {
+        const std::vector<Voxel> voxels = MakeTestChunk(chunk, 7);
+        fmt::print("    {}\n", GetTestChunkName(chunk));
+        Benchmark::Report("SetVoxel for each solid voxel", Benchmark::Measure(40, [&]
+        {
+            Octree::CollisionNode node(testChunkSize);
+            for (unsigned int x = 0; x < testChunkSize; ++x)
+            {
+                for (unsigned int y = 0; y < testChunkSize; ++y)
+                {
+                    for (unsigned int z = 0; z < testChunkSize; ++z)
+                    {
+                        if (voxels[GetTestChunkIndex(x, y, z)].materialId != 0)
+                        {
+                            node.SetVoxel(static_cast<int>(x) - halfSize, static_cast<int>(y) - halfSize, static_cast<int>(z) - halfSize, Octree::PhysicsVoxel(true));
+                        }
+                    }
+                }
+            }
+            Benchmark::Consume(node.GetSize());
+        }));
+        Benchmark::Report("copied to PhysicsVoxels, then built", Benchmark::Measure(40, [&]
+        {
+            std::vector<Octree::PhysicsVoxel> physicsVoxels(voxels.size());
+            for (size_t i = 0; i < voxels.size(); ++i)
+            {
+                physicsVoxels[i].solid = voxels[i].materialId != 0;
+            }
+            Benchmark::Consume(Octree::CollisionNode(testChunkSize, physicsVoxels.data()).GetSize());
+        }));
+        Benchmark::Report("built from chunk voxels", Benchmark::Measure(40, [&]
+        {
+            Benchmark::Consume(Octree::CollisionNode(testChunkSize, voxels.data()).GetSize());
+        }));
+    }
+}
@@ -0,0 +1,144 @@
+#include <array>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "benchmarks/Benchmark.h"
+#include "voxel/LinearOctree.h"
+#include "voxel/TestChunks.h"
+#include "voxel/TypedOctree.h"
+#include "voxel/Voxel.h"
+
+using namespace Vox;
+using namespace Vox::Test;
+
+namespace
+{
+    constexpr int halfSize = static_cast<int>(testChunkSize / 2);
+
+    char VoxelToChar(const Voxel& voxel)
+    {
+        return static_cast<char>(voxel.materialId + 48);
+    }
+
+    /**
+     * @brief Build a tree by setting each voxel that has a material, the way VoxelChunk fills its octree
+     */
+    template <typename Tree>
+    Tree BuildByVoxel(const std::vector<Voxel>& voxels)
+    {
+        Tree tree(testChunkSize);
+        for (unsigned int x = 0; x < testChunkSize; ++x)
+        {
+            for (unsigned int y = 0; y < testChunkSize; ++y)
+            {
+                for (unsigned int z = 0; z < testChunkSize; ++z)
+                {
+                    const Voxel& voxel = voxels[GetTestChunkIndex(x, y, z)];
+                    if (voxel.materialId != 0)
+                    {
+                        tree.SetData(static_cast<int>(x) - halfSize, static_cast<int>(y) - halfSize, static_cast<int>(z) - halfSize, voxel);
+                    }
+                }
+            }
+        }
+        return tree;
+    }
+}
+
+VOX_BENCHMARK(LinearOctreeBuildAndPack)
+{
+    for (const TestChunk chunk : {TestChunk::Terrain, TestChunk::Solid, TestChunk::Noise})
+    {
+        const std::vector<Voxel> voxels = MakeTestChunk(chunk, 7);
+        const LinearOctree<Voxel> tree = BuildByVoxel<LinearOctree<Voxel>>(voxels);
+        fmt::print("    {}: {} bytes packed, {} nodes in the pool\n", GetTestChunkName(chunk), tree.GetPacked(VoxelToChar).size(), tree.GetPoolSize());
+
+        const int repetitions = chunk == TestChunk::Noise ? 20 : 50;
+        Benchmark::Report("TypedNode build and pack", Benchmark::Measure(repetitions, [&]
+        {
+            Benchmark::Consume(BuildByVoxel<TypedNode<Voxel>>(voxels).GetPacked(VoxelToChar).size());
+        }));
+        Benchmark::Report("LinearOctree build and pack", Benchmark::Measure(repetitions, [&]
+        {
+            Benchmark::Consume(BuildByVoxel<LinearOctree<Voxel>>(voxels).GetPacked(VoxelToChar).size());
+        }));
+    }
+}
+
+VOX_BENCHMARK(LinearOctreeDenseBuild)
+{
+    for (const TestChunk chunk : {TestChunk::Terrain, TestChunk::Solid, TestChunk::Noise, TestChunk::Empty})
+    {
+        const std::vector<Voxel> voxels = MakeTestChunk(chunk, 7);
+        fmt::print("    {}\n", GetTestChunkName(chunk));
+        Benchmark::Report("SetData for each voxel", Benchmark::Measure(40, [&]
+        {
+            Benchmark::Consume(BuildByVoxel<LinearOctree<Voxel>>(voxels).GetPoolSize());
+        }));
+        Benchmark::Report("bottom-up from dense voxels", Benchmark::Measure(40, [&]
+        {
+            Benchmark::Consume(LinearOctree<Voxel>(testChunkSize, voxels.data()).GetPoolSize());
+        }));
+    }
+}
+
+VOX_BENCHMARK(LinearOctree200kEdits)
+{
+    // Random sets and gets on a terrain chunk, like editor strokes
+    const std::vector<Voxel> voxels = MakeTestChunk(TestChunk::Terrain, 7);
+    TypedNode<Voxel> typed = BuildByVoxel<TypedNode<Voxel>>(voxels);
+    LinearOctree<Voxel> linear = BuildByVoxel<LinearOctree<Voxel>>(voxels);
+
+    std::mt19937 random(7);
+    std::vector<std::array<int, 3>> positions(200000);
+    std::vector<unsigned int> materials(positions.size());
+    for (size_t i = 0; i < positions.size(); ++i)
+    {
+        for (int& coordinate : positions[i])
+        {
+            coordinate = static_cast<int>(random() % testChunkSize) - halfSize;
+        }
+        materials[i] = random() % 3;
+    }
+
+    // Each pass shifts the materials, so repeating the edits still changes the tree
+    const auto edit = [&](auto& tree)
+    {
+        return [&, pass = 0u]() mutable
+        {
+            for (size_t i = 0; i < positions.size(); ++i)
+            {
+                Voxel voxel;
+                voxel.materialId = (materials[i] + pass) % 3;
+                tree.SetData(positions[i][0], positions[i][1], positions[i][2], voxel);
+            }
+            ++pass;
+        };
+    };
+    Benchmark::Report("TypedNode::SetData", Benchmark::Measure(5, edit(typed)));
+    Benchmark::Report("LinearOctree::SetData", Benchmark::Measure(5, edit(linear)));
+    Benchmark::Report("TypedNode::GetData", Benchmark::Measure(10, [&]
+    {
+        size_t materialSum = 0;
+        for (const std::array<int, 3>& position : positions)
+        {
+            const Voxel* voxel = typed.GetData(position[0], position[1], position[2]);
+            materialSum += voxel ? voxel->materialId : 0;
+        }
+        Benchmark::Consume(materialSum);
+    }));
+    Benchmark::Report("LinearOctree::GetData", Benchmark::Measure(10, [&]
+    {
+        size_t materialSum = 0;
+        for (const std::array<int, 3>& position : positions)
+        {
+            const Voxel* voxel = linear.GetData(position[0], position[1], position[2]);
+            materialSum += voxel ? voxel->materialId : 0;
+        }
+        Benchmark::Consume(materialSum);
+    }));
+    fmt::print("    {} nodes in the pool after the edits\n", linear.GetPoolSize());
+}
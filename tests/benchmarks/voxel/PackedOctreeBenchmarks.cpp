@@ -0,0 +1,101 @@
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "benchmarks/Benchmark.h"
+#include "voxel/LinearOctree.h"
+#include "voxel/PackedOctree.h"
+#include "voxel/TestChunks.h"
+#include "voxel/TypedOctree.h"
+#include "voxel/Voxel.h"
+
+using namespace Vox;
+using namespace Vox::Test;
+
+namespace
+{
+    constexpr int halfSize = static_cast<int>(testChunkSize / 2);
+
+    char VoxelToChar(const Voxel& voxel)
+    {
+        return static_cast<char>(voxel.materialId + 48);
+    }
+
+    Voxel CharToVoxel(const char c)
+    {
+        Voxel result;
+        result.materialId = c - 48;
+        return result;
+    }
+}
+
+VOX_BENCHMARK(PackedOctreePack)
+{
+    for (const TestChunk chunk : {TestChunk::Terrain, TestChunk::Solid, TestChunk::Noise, TestChunk::Empty})
+    {
+        const std::vector<Voxel> voxels = MakeTestChunk(chunk, 5);
+        fmt::print("    {}\n", GetTestChunkName(chunk));
+        Benchmark::Report("TypedNode build and GetPacked", Benchmark::Measure(100, [&]
+        {
+            TypedNode<Voxel> tree(testChunkSize);
+            for (unsigned int x = 0; x < testChunkSize; ++x)
+            {
+                for (unsigned int y = 0; y < testChunkSize; ++y)
+                {
+                    for (unsigned int z = 0; z < testChunkSize; ++z)
+                    {
+                        const Voxel& voxel = voxels[GetTestChunkIndex(x, y, z)];
+                        if (voxel.materialId != 0)
+                        {
+                            tree.SetData(static_cast<int>(x) - halfSize, static_cast<int>(y) - halfSize, static_cast<int>(z) - halfSize, voxel);
+                        }
+                    }
+                }
+            }
+            Benchmark::Consume(tree.GetPacked(VoxelToChar).size());
+        }));
+        Benchmark::Report("LinearOctree build and GetPacked", Benchmark::Measure(100, [&]
+        {
+            Benchmark::Consume(LinearOctree<Voxel>(testChunkSize, voxels.data()).GetPacked(VoxelToChar).size());
+        }));
+        Benchmark::Report("PackedOctree::Pack", Benchmark::Measure(100, [&]
+        {
+            Benchmark::Consume(PackedOctree<Voxel, testChunkSize>::Pack(voxels.data(), VoxelToChar).size());
+        }));
+    }
+}
+
+VOX_BENCHMARK(PackedOctreeUnpack)
+{
+    for (const TestChunk chunk : {TestChunk::Terrain, TestChunk::Solid, TestChunk::Noise, TestChunk::Empty})
+    {
+        const std::vector<Voxel> voxels = MakeTestChunk(chunk, 5);
+        const std::string packed = LinearOctree<Voxel>(testChunkSize, voxels.data()).GetPacked(VoxelToChar);
+        std::vector<Voxel> unpacked(voxels.size());
+        fmt::print("    {}: {} bytes packed\n", GetTestChunkName(chunk), packed.size());
+
+        // How chunks were loaded before, building the tree and reading every voxel back out of it
+        Benchmark::Report("TypedNode::FromPacked and GetData", Benchmark::Measure(100, [&]
+        {
+            const std::shared_ptr<TypedNode<Voxel>> tree = TypedNode<Voxel>::FromPacked(packed, CharToVoxel);
+            for (unsigned int x = 0; x < testChunkSize; ++x)
+            {
+                for (unsigned int y = 0; y < testChunkSize; ++y)
+                {
+                    for (unsigned int z = 0; z < testChunkSize; ++z)
+                    {
+                        const Voxel* voxel = tree->GetData(static_cast<int>(x) - halfSize, static_cast<int>(y) - halfSize, static_cast<int>(z) - halfSize);
+                        unpacked[GetTestChunkIndex(x, y, z)] = voxel ? *voxel : Voxel();
+                    }
+                }
+            }
+            Benchmark::Consume(unpacked[1].materialId);
+        }));
+        Benchmark::Report("PackedOctree::Unpack", Benchmark::Measure(100, [&]
+        {
+            Benchmark::Consume(PackedOctree<Voxel, testChunkSize>::Unpack(packed, unpacked.data(), CharToVoxel));
+        }));
+    }
+}
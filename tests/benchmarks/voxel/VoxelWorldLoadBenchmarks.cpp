@@ -0,0 +1,93 @@
+#include <atomic>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "benchmarks/Benchmark.h"
+#include "core/services/ThreadPool.h"
+#include "voxel/CollisionOctree.h"
+#include "voxel/PackedOctree.h"
+#include "voxel/PalettedVoxelStorage.h"
+#include "voxel/TestChunks.h"
+#include "voxel/Voxel.h"
+
+using namespace Vox;
+using namespace Vox::Test;
+
+namespace
+{
+    using TestChunkOctree = PackedOctree<Voxel, testChunkSize>;
+
+    /**
+     * @brief What VoxelWorld::LoadChunks keeps from each chunk before creating its mesh and body
+     */
+    struct DecodedTestChunk
+    {
+        PalettedVoxelStorage voxels = PalettedVoxelStorage(testChunkSize * testChunkSize * testChunkSize);
+        std::unique_ptr<Octree::CollisionNode> collisionMask;
+    };
+
+    /**
+     * @brief The work LoadChunks hands to the thread pool for one chunk, as in VoxelChunk::ParseString and
+     * VoxelChunk::Decode, which can't be built here since VoxelChunk creates GL resources
+     */
+    bool DecodeTestChunk(const std::string& packed, DecodedTestChunk& decodedOut)
+    {
+        const auto denseVoxels = std::make_unique<std::vector<Voxel>>(testChunkSize * testChunkSize * testChunkSize);
+        if (!TestChunkOctree::Unpack(packed, denseVoxels->data(), [](const char c)
+        {
+            Voxel result;
+            result.materialId = c - 48;
+            return result;
+        }))
+        {
+            return false;
+        }
+        decodedOut.voxels.Pack(denseVoxels->data());
+        decodedOut.collisionMask = std::make_unique<Octree::CollisionNode>(testChunkSize, denseVoxels->data());
+        return true;
+    }
+}
+
+VOX_BENCHMARK(VoxelWorldDecode1024Chunks)
+{
+    // A world a few chunks deep, mostly terrain with some caves, empty air and solid rock
+    constexpr TestChunk worldChunks[] = {TestChunk::Terrain, TestChunk::Caves, TestChunk::Empty, TestChunk::Empty, TestChunk::Solid};
+    std::vector<std::string> packedChunks;
+    for (unsigned int i = 0; i < 1024; ++i)
+    {
+        const std::vector<Voxel> voxels = MakeTestChunk(worldChunks[i % std::size(worldChunks)], i);
+        packedChunks.push_back(TestChunkOctree::Pack(voxels.data(), [](const Voxel& voxel)
+        {
+            return static_cast<char>(voxel.materialId + 48);
+        }));
+    }
+
+    std::vector<DecodedTestChunk> decodedChunks(packedChunks.size());
+    const double serialMs = Benchmark::Measure(3, [&]
+    {
+        size_t decodedCount = 0;
+        for (size_t i = 0; i < packedChunks.size(); ++i)
+        {
+            decodedCount += DecodeTestChunk(packedChunks[i], decodedChunks[i]) ? 1 : 0;
+        }
+        Benchmark::Consume(decodedCount);
+    });
+    Benchmark::Report("one thread", serialMs);
+
+    ThreadPool threadPool;
+    const double parallelMs = Benchmark::Measure(3, [&]
+    {
+        std::atomic<size_t> decodedCount = 0;
+        threadPool.ParallelFor(packedChunks.size(), [&](const size_t i)
+        {
+            decodedCount += DecodeTestChunk(packedChunks[i], decodedChunks[i]) ? 1 : 0;
+        });
+        Benchmark::Consume(decodedCount);
+    });
+    Benchmark::Report(fmt::format("ThreadPool::ParallelFor, {} threads", threadPool.GetThreadCount() + 1), parallelMs);
+    fmt::print("    {:.0f} -> {:.0f} chunks/s\n", packedChunks.size() * 1000.0 / serialMs, packedChunks.size() * 1000.0 / parallelMs);
+}
@@ -0,0 +1,142 @@
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+#include <map>
+#include <random>
+#include <vector>
+
+#include "Test.h"
+#include "core/datatypes/RangeAllocator.h"
+
+using namespace Vox;
+
+VOX_TEST(RangeAllocatorBestFit)
+{
+    RangeAllocator allocator(100);
+    const RangeAllocator::Handle first = allocator.Allocate(10);
+    const RangeAllocator::Handle second = allocator.Allocate(20);
+    const RangeAllocator::Handle third = allocator.Allocate(30);
+    VOX_CHECK(allocator.GetRange(first).offset == 0);
+    VOX_CHECK(allocator.GetRange(second).offset == 10);
+    VOX_CHECK(allocator.GetRange(third).offset == 30);
+    VOX_CHECK(allocator.GetUsedSize() == 60);
+    VOX_CHECK(allocator.GetLargestFreeRange() == 40);
+
+    // The hole left by the second range fits better than the free space at the end
+    allocator.Free(second);
+    const RangeAllocator::Handle fourth = allocator.Allocate(15);
+    VOX_CHECK(allocator.GetRange(fourth).offset == 10);
+    VOX_CHECK(allocator.Allocate(41) == RangeAllocator::invalidHandle);
+
+    // Freed ranges merge back into one
+    allocator.Free(fourth);
+    allocator.Free(first);
+    allocator.Free(third);
+    VOX_CHECK(allocator.GetLargestFreeRange() == 100);
+    VOX_CHECK(allocator.GetAllocationCount() == 0);
+}
+
+VOX_TEST(RangeAllocatorCompact)
+{
+    RangeAllocator allocator(10);
+    std::vector<RangeAllocator::Handle> handles;
+    for (int i = 0; i < 10; ++i)
+    {
+        handles.push_back(allocator.Allocate(1));
+    }
+    VOX_CHECK(allocator.Allocate(1) == RangeAllocator::invalidHandle);
+
+    for (int i = 0; i < 10; i += 2)
+    {
+        allocator.Free(handles[i]);
+    }
+    VOX_CHECK(allocator.GetFreeSize() == 5);
+    VOX_CHECK(allocator.GetLargestFreeRange() == 1);
+
+    const std::vector<RangeAllocator::Move> moves = allocator.Compact(10);
+    VOX_REQUIRE(moves.size() == 5);
+    VOX_CHECK(moves[0].sourceOffset == 1 && moves[0].destinationOffset == 0);
+    VOX_CHECK(allocator.GetLargestFreeRange() == 5);
+    for (int i = 1; i < 10; i += 2)
+    {
+        VOX_CHECK(allocator.GetRange(handles[i]).offset == static_cast<size_t>(i / 2));
+    }
+
+    // Already packed allocations are copied as one block
+    const std::vector<RangeAllocator::Move> growMoves = allocator.Compact(20);
+    VOX_REQUIRE(growMoves.size() == 1);
+    VOX_CHECK(growMoves[0].size == 5 && growMoves[0].sourceOffset == 0);
+    VOX_CHECK(allocator.GetLargestFreeRange() == 15);
+}
+
+VOX_TEST(RangeAllocatorRandomized)
+{
+    // Mirror every allocation in a simulated buffer, and check that no two ranges ever overlap,
+    // and that compaction moves the contents along with the ranges
+    std::mt19937 random(5);
+    for (int trial = 0; trial < 50; ++trial)
+    {
+        size_t capacity = 1000;
+        RangeAllocator allocator(capacity);
+        std::vector<int> memory(capacity, -1);
+        std::map<RangeAllocator::Handle, int> liveTags;
+        int nextTag = 0;
+        for (int step = 0; step < 2000; ++step)
+        {
+            if (liveTags.empty() || random() % 3 != 0)
+            {
+                const size_t size = 1 + random() % 60;
+                RangeAllocator::Handle handle = allocator.Allocate(size);
+                if (handle == RangeAllocator::invalidHandle)
+                {
+                    VOX_REQUIRE(allocator.GetLargestFreeRange() < size);
+                    const size_t newCapacity = allocator.GetFreeSize() < size ? std::max(capacity * 2, allocator.GetUsedSize() + size) : capacity;
+                    std::vector<int> newMemory(newCapacity, -1);
+                    for (const RangeAllocator::Move& move : allocator.Compact(newCapacity))
+                    {
+                        std::memcpy(&newMemory[move.destinationOffset], &memory[move.sourceOffset], move.size * sizeof(int));
+                    }
+                    memory = std::move(newMemory);
+                    capacity = newCapacity;
+                    handle = allocator.Allocate(size);
+                    VOX_REQUIRE(handle != RangeAllocator::invalidHandle);
+                }
+
+                const RangeAllocator::Range range = allocator.GetRange(handle);
+                VOX_REQUIRE(range.size == size && range.offset + size <= capacity);
+                for (size_t i = 0; i < size; ++i)
+                {
+                    VOX_REQUIRE(memory[range.offset + i] == -1);
+                    memory[range.offset + i] = nextTag;
+                }
+                liveTags[handle] = nextTag++;
+            }
+            else
+            {
+                auto freed = liveTags.begin();
+                std::advance(freed, random() % liveTags.size());
+                const RangeAllocator::Range range = allocator.GetRange(freed->first);
+                for (size_t i = 0; i < range.size; ++i)
+                {
+                    VOX_REQUIRE(memory[range.offset + i] == freed->second);
+                    memory[range.offset + i] = -1;
+                }
+                allocator.Free(freed->first);
+                liveTags.erase(freed);
+            }
+
+            size_t usedSize = 0;
+            for (const auto& [handle, tag] : liveTags)
+            {
+                const RangeAllocator::Range range = allocator.GetRange(handle);
+                usedSize += range.size;
+                for (size_t i = 0; i < range.size; ++i)
+                {
+                    VOX_REQUIRE(memory[range.offset + i] == tag);
+                }
+            }
+            VOX_REQUIRE(usedSize == allocator.GetUsedSize());
+            VOX_REQUIRE(allocator.GetAllocationCount() == liveTags.size());
+        }
+    }
+}
@@ -0,0 +1,68 @@
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "Test.h"
+#include "core/services/ThreadPool.h"
+
+using namespace Vox;
+
+VOX_TEST(ThreadPoolParallelFor)
+{
+    // Without workers the calling thread does everything
+    for (const unsigned int threadCount : {0u, 1u, 4u})
+    {
+        ThreadPool threadPool(threadCount);
+        VOX_CHECK(threadPool.GetThreadCount() == threadCount);
+        for (const size_t count : {size_t(0), size_t(1), size_t(1000)})
+        {
+            std::vector<std::atomic<int>> visits(count);
+            threadPool.ParallelFor(count, [&visits](const size_t index)
+            {
+                ++visits[index];
+            });
+
+            bool eachOnce = true;
+            for (const std::atomic<int>& visitCount : visits)
+            {
+                eachOnce &= visitCount == 1;
+            }
+            VOX_CHECK(eachOnce);
+        }
+    }
+}
+
+VOX_TEST(ThreadPoolParallelForWhileBusy)
+{
+    // The only worker is blocked, so the loop has to finish on the calling thread
+    ThreadPool threadPool(1);
+    std::atomic<bool> released = false;
+    threadPool.Submit([&released]
+    {
+        while (!released)
+        {
+            std::this_thread::yield();
+        }
+    });
+
+    std::atomic<size_t> sum = 0;
+    threadPool.ParallelFor(100, [&sum](const size_t index)
+    {
+        sum += index;
+    });
+    VOX_CHECK(sum == 4950);
+    released = true;
+}
+
+VOX_TEST(ThreadPoolFinishesQueuedTasks)
+{
+    std::atomic<int> completedCount = 0;
+    {
+        ThreadPool threadPool(2);
+        for (int i = 0; i < 100; ++i)
+        {
+            threadPool.Submit([&completedCount] { ++completedCount; });
+        }
+    }
+    VOX_CHECK(completedCount == 100);
+}
@@ -0,0 +1,90 @@
+#include <random>
+#include <vector>
+
+#include <glm/geometric.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include "Test.h"
+#include "core/math/BoundingBox.h"
+#include "rendering/FrustumCuller.h"
+#include "rendering/camera/Frustum.h"
+
+using namespace Vox;
+
+namespace
+{
+    // Looking down -z from the origin
+    Frustum MakeFrustum()
+    {
+        const glm::mat4x4 projection = glm::perspective(1.0f, 16.0f / 9.0f, 0.1f, 500.0f);
+        const glm::mat4x4 view = glm::lookAt(glm::vec3(0.0f), glm::vec3(0.0f, 0.0f, -1.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+        return Frustum::FromMatrix(projection * view);
+    }
+}
+
+VOX_TEST(FrustumIntersects)
+{
+    const Frustum frustum = MakeFrustum();
+    VOX_CHECK(frustum.Intersects({{-1.0f, -1.0f, -11.0f}, {1.0f, 1.0f, -9.0f}}));
+    VOX_CHECK(!frustum.Intersects({{-1.0f, -1.0f, 9.0f}, {1.0f, 1.0f, 11.0f}}));
+
+    // Past the far plane, and a wide box that only crosses the view
+    VOX_CHECK(!frustum.Intersects({{-1.0f, -1.0f, -600.0f}, {1.0f, 1.0f, -550.0f}}));
+    VOX_CHECK(frustum.Intersects({{-1000.0f, -1.0f, -20.0f}, {1000.0f, 1.0f, -19.0f}}));
+
+    // Behind the near plane, and off to the side
+    VOX_CHECK(!frustum.Intersects({{-1.0f, -1.0f, -0.05f}, {1.0f, 1.0f, -0.01f}}));
+    VOX_CHECK(!frustum.Intersects({{100.0f, -1.0f, -11.0f}, {102.0f, 1.0f, -9.0f}}));
+}
+
+VOX_TEST(BoundingBoxTransformed)
+{
+    const BoundingBox box({-1.0f, -2.0f, -3.0f}, {4.0f, 5.0f, 6.0f});
+
+    // Rotate a quarter turn around z, then move
+    glm::mat4x4 transform = glm::translate(glm::mat4x4(1.0f), glm::vec3(5.0f, 6.0f, 7.0f));
+    transform = glm::rotate(transform, glm::radians(90.0f), glm::vec3(0.0f, 0.0f, 1.0f));
+    const BoundingBox transformed = box.GetTransformed(transform);
+    const glm::vec3 expectedMin(0.0f, 5.0f, 4.0f);
+    const glm::vec3 expectedMax(7.0f, 10.0f, 13.0f);
+    VOX_CHECK(glm::length(transformed.min - expectedMin) < 1e-4f);
+    VOX_CHECK(glm::length(transformed.max - expectedMax) < 1e-4f);
+
+    BoundingBox empty;
+    VOX_CHECK(empty.IsEmpty());
+    empty.Expand(glm::vec3(1.0f, 2.0f, 3.0f));
+    VOX_CHECK(!empty.IsEmpty());
+    VOX_CHECK(empty.GetExtents() == glm::vec3(0.0f));
+}
+
+VOX_TEST(FrustumCullerMatchesIntersects)
+{
+    const Frustum frustum = MakeFrustum();
+    std::mt19937 random(1);
+    std::uniform_real_distribution<float> position(-600.0f, 600.0f);
+    std::uniform_real_distribution<float> size(0.1f, 40.0f);
+
+    FrustumCuller culler;
+    std::vector<BoundingBox> boxes;
+    for (int i = 0; i < 100000; ++i)
+    {
+        const glm::vec3 min(position(random), position(random), position(random));
+        boxes.emplace_back(min, min + glm::vec3(size(random), size(random), size(random)));
+        VOX_REQUIRE(culler.Add(boxes.back()) == static_cast<uint32_t>(i));
+    }
+
+    const std::vector<uint32_t>& visible = culler.Cull(frustum);
+    size_t visibleIndex = 0;
+    for (uint32_t i = 0; i < boxes.size(); ++i)
+    {
+        const bool culled = visibleIndex >= visible.size() || visible[visibleIndex] != i;
+        visibleIndex += culled ? 0 : 1;
+        VOX_REQUIRE(frustum.Intersects(boxes[i]) == !culled);
+    }
+    VOX_CHECK(visibleIndex == visible.size());
+    VOX_CHECK(!visible.empty());
+
+    culler.Clear();
+    VOX_CHECK(culler.GetBoxCount() == 0);
+    VOX_CHECK(culler.Cull(frustum).empty());
+}
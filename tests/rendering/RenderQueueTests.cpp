@@ -0,0 +1,152 @@
+#include <algorithm>
+#include <array>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "Test.h"
+#include "rendering/CountingRenderBackend.h"
+#include "rendering/RenderQueue.h"
+
+using namespace Vox;
+
+namespace
+{
+    /**
+     * @brief Records the base instance of every draw, which the tests use as the draw's id
+     */
+    class RecordingRenderBackend : public CountingRenderBackend
+    {
+    public:
+        void Draw(const DrawGeometry& geometry, const uint32_t baseInstance, const uint32_t instanceCount) override
+        {
+            CountingRenderBackend::Draw(geometry, baseInstance, instanceCount);
+            drawnIds.push_back(baseInstance);
+        }
+
+        std::vector<uint32_t> drawnIds;
+    };
+}
+
+VOX_TEST(RenderQueueSubmitsInKeyOrder)
+{
+    std::mt19937 random(7);
+    RenderQueue queue;
+    std::vector<uint32_t> geometries;
+    for (unsigned int i = 0; i < 8; ++i)
+    {
+        DrawGeometry geometry;
+        geometry.indexBuffer = 1 + i % 5;
+        geometries.push_back(queue.AddGeometry(geometry));
+    }
+    const uint32_t transform = queue.AddTransform(glm::mat4x4(1.0f));
+
+    // Draws with equal keys have to keep the order they were added in
+    std::vector<std::pair<uint64_t, uint32_t>> expected;
+    for (uint32_t i = 0; i < 20000; ++i)
+    {
+        DrawCommand command;
+        command.shader = random() % 8;
+        command.material = random() % 4000;
+        command.geometry = geometries[random() % geometries.size()];
+        command.transform = transform;
+        command.baseInstance = i;
+        const float depth = static_cast<float>(random() % 100) / 100.0f;
+        queue.Add(RenderPass::GBuffer, command, depth);
+        const unsigned int geometryKey = 1 + command.geometry % 5;
+        expected.emplace_back(RenderQueue::MakeKey(RenderPass::GBuffer, command, geometryKey, depth), i);
+    }
+    std::ranges::stable_sort(expected, {}, &std::pair<uint64_t, uint32_t>::first);
+
+    queue.Sort();
+    RecordingRenderBackend backend;
+    queue.Submit(RenderPass::GBuffer, backend);
+    VOX_REQUIRE(backend.drawnIds.size() == expected.size());
+    for (size_t i = 0; i < expected.size(); ++i)
+    {
+        VOX_REQUIRE(backend.drawnIds[i] == expected[i].second);
+    }
+}
+
+VOX_TEST(RenderQueueSkipsUnchangedState)
+{
+    RenderQueue queue;
+    DrawGeometry firstGeometry;
+    firstGeometry.indexBuffer = 1;
+    DrawGeometry secondGeometry;
+    secondGeometry.indexBuffer = 2;
+    const std::array<uint32_t, 2> geometries = {queue.AddGeometry(firstGeometry), queue.AddGeometry(secondGeometry)};
+    const std::array<uint32_t, 2> instances = {queue.AddInstances([] {}), queue.AddInstances([] {})};
+    const uint32_t transform = queue.AddTransform(glm::mat4x4(1.0f));
+
+    // 10 draws of every combination of 2 shaders, 2 instance bindings and 2 geometries, added in the worst order
+    for (int repeat = 0; repeat < 10; ++repeat)
+    {
+        for (uint32_t shader = 0; shader < 2; ++shader)
+        {
+            for (const uint32_t instance : instances)
+            {
+                for (const uint32_t geometry : geometries)
+                {
+                    DrawCommand command;
+                    command.shader = shader;
+                    command.instances = instance;
+                    command.geometry = geometry;
+                    command.material = geometry;
+                    command.transform = transform;
+                    queue.Add(RenderPass::GBuffer, command);
+                }
+            }
+        }
+    }
+    queue.Sort();
+    CountingRenderBackend backend;
+    queue.Submit(RenderPass::GBuffer, backend);
+
+    // One bind per run of equal state, and a shader change makes everything bind again
+    VOX_CHECK(backend.draws == 80);
+    VOX_CHECK(backend.shaderBinds == 2);
+    VOX_CHECK(backend.instanceBinds == 4);
+    VOX_CHECK(backend.materialSets == 8);
+    VOX_CHECK(backend.geometryBinds == 8);
+    VOX_CHECK(backend.transformSets == 2);
+
+    const RenderQueueStats& stats = queue.GetStats();
+    VOX_CHECK(stats.draws == 80);
+    VOX_CHECK(stats.shaderBinds + stats.instanceBinds + stats.materialSets + stats.geometryBinds + stats.transformSets == 24);
+    VOX_CHECK(stats.skippedBinds == 80 * 5 - 24);
+}
+
+VOX_TEST(RenderQueueSubmitsEachPass)
+{
+    std::mt19937 random(3);
+    for (int trial = 0; trial < 20; ++trial)
+    {
+        RenderQueue queue;
+        const uint32_t geometry = queue.AddGeometry({});
+        const uint32_t transform = queue.AddTransform(glm::mat4x4(1.0f));
+        const size_t drawCount = 1 + random() % 3000;
+        std::array<size_t, 3> passDrawCounts = {};
+        for (size_t i = 0; i < drawCount; ++i)
+        {
+            DrawCommand command;
+            command.shader = random() % 4;
+            command.geometry = geometry;
+            command.transform = transform;
+            const auto pass = static_cast<RenderPass>(random() % 3);
+            ++passDrawCounts[static_cast<size_t>(pass)];
+            queue.Add(pass, command, static_cast<float>(random() % 1000) / 1000.0f);
+        }
+        queue.Sort();
+
+        for (size_t pass = 0; pass < passDrawCounts.size(); ++pass)
+        {
+            CountingRenderBackend backend;
+            queue.Submit(static_cast<RenderPass>(pass), backend);
+            VOX_REQUIRE(backend.draws == passDrawCounts[pass]);
+            VOX_REQUIRE(backend.shaderBinds <= 4);
+        }
+        VOX_CHECK(queue.GetStats().draws == drawCount);
+        VOX_CHECK(queue.GetDrawCount() == drawCount);
+    }
+}
@@ -0,0 +1,61 @@
+#include <vector>
+
+#include "Test.h"
+#include "rendering/mesh/MeshInstanceList.h"
+
+using namespace Vox;
+
+namespace
+{
+    std::vector<PBRMaterial> MakeMaterials()
+    {
+        return {PBRMaterial(glm::vec4(1.0f, 0.0f, 0.0f, 1.0f), 0.5f, 0.1f), PBRMaterial(glm::vec4(0.0f, 1.0f, 0.0f, 1.0f), 0.25f, 0.2f)};
+    }
+}
+
+VOX_TEST(MeshInstanceListPacksSlots)
+{
+    MeshInstanceList list(2);
+    VOX_CHECK(!list.HasChanges());
+    VOX_CHECK(list.GetSlotCount() == 0);
+
+    glm::mat4x4 transform(1.0f);
+    transform[3] = glm::vec4(1.0f, 2.0f, 3.0f, 1.0f);
+    list.Set(3, transform, MakeMaterials(), 7);
+
+    // Setting a slot past the end grows the list, with a fixed run of materials per slot
+    VOX_REQUIRE(list.GetSlotCount() == 4);
+    VOX_REQUIRE(list.GetMaterials().size() == 8);
+    const InstanceData& instance = list.GetInstances()[3];
+    VOX_CHECK(instance.materialOffset == 6);
+    VOX_CHECK(instance.pickId == 7);
+    VOX_CHECK(instance.transform == transform);
+    VOX_CHECK(list.GetMaterials()[6].albedo == glm::vec4(1.0f, 0.0f, 0.0f, 1.0f));
+    VOX_CHECK(list.GetMaterials()[6].metallic == 0.1f);
+    VOX_CHECK(list.GetMaterials()[7].roughness == 0.25f);
+}
+
+VOX_TEST(MeshInstanceListTracksChanges)
+{
+    MeshInstanceList list(2);
+    const glm::mat4x4 transform(1.0f);
+    list.Set(3, transform, MakeMaterials(), 1);
+    VOX_CHECK(list.HasChanges());
+    VOX_CHECK(list.GetFirstChangedSlot() == 3);
+    VOX_CHECK(list.GetChangedSlotEnd() == 4);
+
+    // The changed range covers every changed slot, and the ones in between
+    list.Set(1, transform, MakeMaterials(), 2);
+    VOX_CHECK(list.GetFirstChangedSlot() == 1);
+    VOX_CHECK(list.GetChangedSlotEnd() == 4);
+
+    list.ClearChanges();
+    VOX_CHECK(!list.HasChanges());
+
+    // Missing materials keep what the slot had before
+    list.Set(2, transform, {MakeMaterials()[1]}, 3);
+    VOX_CHECK(list.GetFirstChangedSlot() == 2);
+    VOX_CHECK(list.GetChangedSlotEnd() == 3);
+    VOX_CHECK(list.GetMaterials()[4].roughness == 0.25f);
+    VOX_CHECK(list.GetInstances()[2].pickId == 3);
+}
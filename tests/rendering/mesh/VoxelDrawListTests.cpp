@@ -0,0 +1,24 @@
+#include "Test.h"
+#include "rendering/mesh/VoxelDrawList.h"
+
+using namespace Vox;
+
+VOX_TEST(VoxelDrawListSkipsEmptyChunks)
+{
+    VoxelDrawList drawList;
+    drawList.Add(0, 36, {1, 2, 3});
+    drawList.Add(36, 0, {0, 0, 0});
+    drawList.Add(100, 6, {4, 5, 6});
+    VOX_REQUIRE(drawList.GetDrawCount() == 2);
+
+    // Each draw's base instance points at its own chunk offset
+    const DrawArraysIndirectCommand& command = drawList.GetCommands()[1];
+    VOX_CHECK(command.first == 100);
+    VOX_CHECK(command.count == 6);
+    VOX_CHECK(command.instanceCount == 1);
+    VOX_CHECK(command.baseInstance == 1);
+    VOX_CHECK(drawList.GetChunkOffsets()[1] == glm::vec4(4, 5, 6, 0));
+
+    drawList.Clear();
+    VOX_CHECK(drawList.IsEmpty());
+}
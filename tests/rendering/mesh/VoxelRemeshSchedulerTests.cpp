@@ -0,0 +1,201 @@
+#include <map>
+#include <set>
+#include <vector>
+
+#include "Test.h"
+#include "rendering/mesh/VoxelRemeshScheduler.h"
+
+using namespace Vox;
+
+namespace
+{
+    using MeshId = VoxelRemeshScheduler::MeshId;
+
+    /**
+     * @brief Backend with a fixed number of slots, whose jobs only finish when the test says so
+     */
+    class NullRemeshBackend : public VoxelRemeshBackend
+    {
+    public:
+        explicit NullRemeshBackend(const unsigned int slotCount)
+            :slotCount(slotCount)
+        {
+        }
+
+        BeginResult Begin(const MeshId& mesh, unsigned int& slotOut) override
+        {
+            if (skippedMeshes.contains(mesh))
+            {
+                return BeginResult::Skipped;
+            }
+
+            for (unsigned int slot = 0; slot < slotCount; ++slot)
+            {
+                if (!usedSlots.contains(slot))
+                {
+                    usedSlots.emplace(slot, mesh);
+                    startedMeshes.push_back(mesh);
+                    slotOut = slot;
+                    return BeginResult::Started;
+                }
+            }
+            return BeginResult::Busy;
+        }
+
+        bool IsFinished(const unsigned int slot) override
+        {
+            return finishedSlots.contains(slot);
+        }
+
+        void Complete(const unsigned int slot, const MeshId& mesh) override
+        {
+            const auto usedSlot = usedSlots.find(slot);
+            VOX_CHECK(usedSlot != usedSlots.end() && usedSlot->second == mesh);
+            usedSlots.erase(slot);
+            finishedSlots.erase(slot);
+            completedMeshes.push_back(mesh);
+        }
+
+        void FinishAll()
+        {
+            for (const auto& [slot, mesh] : usedSlots)
+            {
+                finishedSlots.insert(slot);
+            }
+        }
+
+        std::set<MeshId> skippedMeshes;
+        std::vector<MeshId> startedMeshes;
+        std::vector<MeshId> completedMeshes;
+
+    private:
+        unsigned int slotCount;
+        std::map<unsigned int, MeshId> usedSlots;
+        std::set<unsigned int> finishedSlots;
+    };
+
+    MeshId MakeMeshId(const int index)
+    {
+        return {static_cast<size_t>(index), 0};
+    }
+}
+
+VOX_TEST(VoxelRemeshSchedulerClosestFirst)
+{
+    NullRemeshBackend backend(3);
+    VoxelRemeshScheduler scheduler(&backend, 2);
+
+    // Mesh 4 is closest to the camera
+    for (int i = 0; i < 5; ++i)
+    {
+        scheduler.Request(MakeMeshId(i), {10.0f - static_cast<float>(i) * 2.0f, 0.0f, 0.0f});
+    }
+    // Requesting a queued mesh again only moves it
+    scheduler.Request(MakeMeshId(0), {100.0f, 0.0f, 0.0f});
+    VOX_CHECK(scheduler.GetQueuedCount() == 5);
+
+    scheduler.Update({0.0f, 0.0f, 0.0f});
+    VOX_REQUIRE(backend.startedMeshes.size() == 2);
+    VOX_CHECK(backend.startedMeshes[0] == MakeMeshId(4));
+    VOX_CHECK(backend.startedMeshes[1] == MakeMeshId(3));
+    VOX_CHECK(scheduler.GetInFlightCount() == 2);
+    VOX_CHECK(scheduler.GetQueuedCount() == 3);
+
+    // Moving the camera changes the order
+    backend.FinishAll();
+    scheduler.Update({100.0f, 0.0f, 0.0f});
+    VOX_REQUIRE(backend.startedMeshes.size() == 4);
+    VOX_CHECK(backend.startedMeshes[2] == MakeMeshId(0));
+    VOX_CHECK(backend.startedMeshes[3] == MakeMeshId(1));
+}
+
+VOX_TEST(VoxelRemeshSchedulerBusySlots)
+{
+    NullRemeshBackend backend(3);
+    VoxelRemeshScheduler scheduler(&backend, 2);
+    for (int i = 0; i < 5; ++i)
+    {
+        scheduler.Request(MakeMeshId(i), {static_cast<float>(i), 0.0f, 0.0f});
+    }
+
+    // Only one slot is left on the second frame, the rest wait for it
+    scheduler.Update({0.0f, 0.0f, 0.0f});
+    scheduler.Update({0.0f, 0.0f, 0.0f});
+    VOX_CHECK(backend.startedMeshes.size() == 3);
+    VOX_CHECK(scheduler.GetQueuedCount() == 2);
+    VOX_CHECK(backend.completedMeshes.empty());
+
+    backend.FinishAll();
+    scheduler.Update({0.0f, 0.0f, 0.0f});
+    VOX_CHECK(backend.completedMeshes.size() == 3);
+    VOX_CHECK(backend.startedMeshes.size() == 5);
+    VOX_CHECK(scheduler.GetQueuedCount() == 0);
+
+    scheduler.SetBudgetPerFrame(0);
+    scheduler.Request(MakeMeshId(7), {0.0f, 0.0f, 0.0f});
+    backend.FinishAll();
+    scheduler.Update({0.0f, 0.0f, 0.0f});
+    VOX_CHECK(scheduler.GetQueuedCount() == 1);
+    VOX_CHECK(scheduler.GetInFlightCount() == 0);
+}
+
+VOX_TEST(VoxelRemeshSchedulerNeverInFlightTwice)
+{
+    NullRemeshBackend backend(4);
+    VoxelRemeshScheduler scheduler(&backend, 4);
+    scheduler.Request(MakeMeshId(0), {0.0f, 0.0f, 0.0f});
+    scheduler.Update({0.0f, 0.0f, 0.0f});
+    VOX_REQUIRE(backend.startedMeshes.size() == 1);
+
+    // An edit while the job runs waits for it, then starts a new job
+    scheduler.Request(MakeMeshId(0), {0.0f, 0.0f, 0.0f});
+    scheduler.Update({0.0f, 0.0f, 0.0f});
+    VOX_CHECK(backend.startedMeshes.size() == 1);
+    VOX_CHECK(scheduler.GetQueuedCount() == 1);
+
+    backend.FinishAll();
+    scheduler.Update({0.0f, 0.0f, 0.0f});
+    VOX_CHECK(backend.completedMeshes.size() == 1);
+    VOX_CHECK(backend.startedMeshes.size() == 2);
+    VOX_CHECK(scheduler.GetQueuedCount() == 0);
+}
+
+VOX_TEST(VoxelRemeshSchedulerSkipped)
+{
+    NullRemeshBackend backend(2);
+    VoxelRemeshScheduler scheduler(&backend, 1);
+    backend.skippedMeshes.insert(MakeMeshId(9));
+    scheduler.Request(MakeMeshId(9), {0.0f, 0.0f, 0.0f});
+    scheduler.Request(MakeMeshId(1), {1.0f, 0.0f, 0.0f});
+
+    // Skipped meshes are dropped, and don't use up the budget
+    scheduler.Update({0.0f, 0.0f, 0.0f});
+    VOX_REQUIRE(backend.startedMeshes.size() == 1);
+    VOX_CHECK(backend.startedMeshes[0] == MakeMeshId(1));
+    VOX_CHECK(scheduler.GetQueuedCount() == 0);
+}
+
+VOX_TEST(VoxelRemeshSchedulerRequestAfterReorder)
+{
+    // Requests after an Update reordered the queue still find the queued entry, rather than adding another
+    NullRemeshBackend backend(1);
+    VoxelRemeshScheduler scheduler(&backend, 1);
+    for (int i = 0; i < 100; ++i)
+    {
+        scheduler.Request(MakeMeshId(i), {static_cast<float>(100 - i), 0.0f, 0.0f});
+    }
+    scheduler.Update({0.0f, 0.0f, 0.0f});
+    VOX_CHECK(scheduler.GetQueuedCount() == 99);
+
+    for (int i = 0; i < 100; ++i)
+    {
+        scheduler.Request(MakeMeshId(i), {static_cast<float>(i), 0.0f, 0.0f});
+    }
+    VOX_CHECK(scheduler.GetQueuedCount() == 100);
+
+    // The moved positions are the ones used, so mesh 0 goes next
+    backend.FinishAll();
+    scheduler.Update({0.0f, 0.0f, 0.0f});
+    VOX_REQUIRE(backend.startedMeshes.size() == 2);
+    VOX_CHECK(backend.startedMeshes[1] == MakeMeshId(0));
+}
@@ -0,0 +1,120 @@
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "Test.h"
+#include "rendering/skeletal_mesh/AnimationChannel.h"
+#include "rendering/skeletal_mesh/TestChannels.h"
+
+using namespace Vox;
+using Vox::Test::MakeChannel;
+
+namespace
+{
+    /**
+     * @brief Key times with uneven gaps, like an exported clip with some keys removed
+     */
+    std::vector<float> MakeTimes(const unsigned int keyCount, const unsigned int seed)
+    {
+        std::mt19937 random(seed);
+        std::uniform_real_distribution<float> gap(0.005f, 0.1f);
+        std::vector<float> times(keyCount);
+        for (unsigned int i = 1; i < keyCount; ++i)
+        {
+            times[i] = times[i - 1] + gap(random);
+        }
+        return times;
+    }
+
+    /**
+     * @brief Times a player would ask for, moving forward at 60 Hz and looping, with a seek every so often
+     */
+    std::vector<float> MakePlaybackTimes(const float duration)
+    {
+        std::vector<float> times;
+        for (int frame = 0; frame < 2000; ++frame)
+        {
+            times.push_back(frame % 97 == 0 ? duration * 0.37f : std::fmod(static_cast<float>(frame) / 60.0f, duration));
+        }
+        times.push_back(-1.0f);
+        times.push_back(duration + 1.0f);
+        times.push_back(0.0f);
+        return times;
+    }
+}
+
+VOX_TEST(AnimationChannelCursorMatchesSearch)
+{
+    for (unsigned int seed = 0; seed < 4; ++seed)
+    {
+        const std::vector<float> times = MakeTimes(20 + seed * 100, seed);
+        std::vector<glm::vec3> vectors;
+        std::vector<glm::quat> rotations;
+        for (const float time : times)
+        {
+            vectors.emplace_back(std::sin(time), std::cos(time * 3.0f), time);
+            rotations.push_back(glm::angleAxis(time * 2.0f, glm::normalize(glm::vec3(1.0f, 2.0f, time))));
+        }
+        const AnimationChannel translation = MakeChannel("translation", times, vectors);
+        const AnimationChannel rotation = MakeChannel("rotation", times, rotations);
+
+        // The cursor only changes which keys are looked at first, so the results are the same bit for bit
+        unsigned int translationCursor = 0;
+        unsigned int rotationCursor = 0;
+        for (const float time : MakePlaybackTimes(translation.GetDuration()))
+        {
+            VOX_CHECK(translation.EvaulateVector(time, translationCursor) == translation.EvaulateVector(time));
+            VOX_CHECK(rotation.EvaluateRotation(time, rotationCursor) == rotation.EvaluateRotation(time));
+        }
+    }
+}
+
+VOX_TEST(AnimationChannelResample)
+{
+    // A straight line through uneven keys is rebuilt exactly by linear keys at any rate
+    const std::vector<float> times = MakeTimes(50, 7);
+    std::vector<glm::vec3> vectors;
+    for (const float time : times)
+    {
+        vectors.emplace_back(time * 2.0f, 1.0f - time, 3.0f);
+    }
+    const AnimationChannel original = MakeChannel("scale", times, vectors);
+    AnimationChannel resampled = original;
+    resampled.Resample(30.0f);
+
+    const std::vector<float>& sampledTimes = resampled.GetTimeKeys();
+    VOX_REQUIRE(sampledTimes.size() == static_cast<size_t>(std::ceil(times.back() * 30.0f)) + 1);
+    VOX_CHECK(sampledTimes.back() >= times.back());
+    for (size_t i = 0; i < sampledTimes.size(); ++i)
+    {
+        VOX_CHECK(std::abs(sampledTimes[i] - static_cast<float>(i) / 30.0f) < 1e-5f);
+    }
+
+    // The curves match, except after the second last key, where the last key holds the end value a little later
+    unsigned int cursor = 0;
+    for (const float time : MakePlaybackTimes(original.GetDuration()))
+    {
+        if (time > sampledTimes[sampledTimes.size() - 2] && time < original.GetDuration())
+        {
+            continue;
+        }
+        const glm::vec3 difference = resampled.EvaulateVector(time, cursor) - original.EvaulateVector(time);
+        VOX_CHECK(glm::length(difference) < 1e-4f);
+    }
+
+    // A rate of zero keeps the keys as they are
+    AnimationChannel unchanged = original;
+    unchanged.Resample(0.0f);
+    VOX_CHECK(unchanged.GetTimeKeys() == times);
+}
+
+VOX_TEST(AnimationChannelSingleKey)
+{
+    const AnimationChannel channel = MakeChannel("translation", std::vector<float>{0.5f}, std::vector<glm::vec3>{{1.0f, 2.0f, 3.0f}});
+    unsigned int cursor = 0;
+    for (const float time : {-1.0f, 0.0f, 0.5f, 2.0f})
+    {
+        VOX_CHECK(channel.EvaulateVector(time) == glm::vec3(1.0f, 2.0f, 3.0f));
+        VOX_CHECK(channel.EvaulateVector(time, cursor) == glm::vec3(1.0f, 2.0f, 3.0f));
+    }
+}
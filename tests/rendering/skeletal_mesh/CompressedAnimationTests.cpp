@@ -0,0 +1,125 @@
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "Test.h"
+#include "rendering/mesh/ModelNode.h"
+#include "rendering/skeletal_mesh/AnimationImportSettings.h"
+#include "rendering/skeletal_mesh/CompressedAnimation.h"
+#include "rendering/skeletal_mesh/TestChannels.h"
+
+using namespace Vox;
+using Vox::Test::GetRotationError;
+using Vox::Test::GetVectorError;
+using Vox::Test::MakeChannel;
+
+namespace
+{
+    /**
+     * @brief A long clip sampled at 30 Hz, like motion capture, with one channel of each type
+     * The rotation turns all the way around, so every component is the largest one at some point
+     */
+    std::vector<AnimationChannel> MakeDenseClip(const unsigned int keyCount)
+    {
+        std::vector<float> times(keyCount);
+        std::vector<glm::vec3> translations(keyCount);
+        std::vector<glm::quat> rotations(keyCount);
+        std::vector<glm::vec3> scales(keyCount, glm::vec3(1.0f, 2.0f, 1.0f));
+        for (unsigned int i = 0; i < keyCount; ++i)
+        {
+            const float time = static_cast<float>(i) / 30.0f;
+            times[i] = time;
+            translations[i] = {std::sin(time * 0.5f), 0.2f * std::cos(time), 1.0f};
+            rotations[i] = glm::angleAxis(time * 0.7f, glm::normalize(glm::vec3(std::sin(time * 0.1f), 1.0f, 0.5f)));
+        }
+
+        std::vector<AnimationChannel> channels;
+        channels.push_back(MakeChannel("translation", times, translations, 0));
+        channels.push_back(MakeChannel("rotation", times, rotations, 1));
+        channels.push_back(MakeChannel("scale", times, scales, 2));
+        return channels;
+    }
+
+    AnimationImportSettings MakeCompressSettings()
+    {
+        AnimationImportSettings settings;
+        settings.compress = true;
+        return settings;
+    }
+}
+
+VOX_TEST(CompressedAnimationWithinTolerance)
+{
+    const std::vector<AnimationChannel> channels = MakeDenseClip(3000);
+    const float duration = channels[0].GetDuration();
+    const AnimationImportSettings settings = MakeCompressSettings();
+    const CompressedAnimation compressed(channels, duration, settings);
+    VOX_REQUIRE(compressed.GetTrackCount() == channels.size());
+
+    // The constant scale keeps its ends, and the curves lose most of their keys
+    size_t memorySize = 0;
+    for (const AnimationChannel& channel : channels)
+    {
+        memorySize += sizeof(AnimationChannel) + channel.GetMemorySize();
+    }
+    VOX_CHECK(compressed.GetKeyCount() < 3000);
+    VOX_CHECK(compressed.GetMemorySize() * 3 < memorySize);
+
+    // Tolerances are checked at the removed keys, quantization and the curve between keys add a little more
+    float rotationError = 0.0f;
+    float translationError = 0.0f;
+    float scaleError = 0.0f;
+    for (int i = 0; i <= 20000; ++i)
+    {
+        const float time = duration * static_cast<float>(i) / 20000.0f;
+        translationError = std::max(translationError, GetVectorError(channels[0].EvaulateVector(time), compressed.EvaluateVector(0, time)));
+        rotationError = std::max(rotationError, GetRotationError(channels[1].EvaluateRotation(time), compressed.EvaluateRotation(1, time)));
+        scaleError = std::max(scaleError, GetVectorError(channels[2].EvaulateVector(time), compressed.EvaluateVector(2, time)));
+    }
+    VOX_CHECK(rotationError < settings.rotationTolerance * 2.0f);
+    VOX_CHECK(translationError < settings.vectorTolerance * 2.0f);
+    VOX_CHECK(scaleError == 0.0f);
+}
+
+VOX_TEST(CompressedAnimationCursorMatchesSearch)
+{
+    const std::vector<AnimationChannel> channels = MakeDenseClip(500);
+    const float duration = channels[0].GetDuration();
+    const CompressedAnimation compressed(channels, duration, MakeCompressSettings());
+
+    std::vector<ModelTransform> searched(3);
+    std::vector<ModelTransform> withCursors(3);
+    std::vector<unsigned int> cursors(compressed.GetTrackCount(), 0);
+    for (int frame = 0; frame < 3000; ++frame)
+    {
+        // Forward at 60 Hz and looping, with a seek every so often
+        const float time = frame % 97 == 0 ? duration * 0.37f : std::fmod(static_cast<float>(frame) / 60.0f, duration);
+        compressed.ApplyToNodes(searched, time);
+        compressed.ApplyToNodes(withCursors, time, cursors);
+        for (size_t node = 0; node < searched.size(); ++node)
+        {
+            VOX_CHECK(searched[node].position == withCursors[node].position);
+            VOX_CHECK(searched[node].rotation == withCursors[node].rotation);
+            VOX_CHECK(searched[node].scale == withCursors[node].scale);
+        }
+    }
+}
+
+VOX_TEST(CompressedAnimationShortTracks)
+{
+    // Single keys, and tracks that end before the animation does, hold their last key
+    const std::vector<float> times = {0.0f, 0.5f};
+    std::vector<AnimationChannel> channels;
+    channels.push_back(MakeChannel("translation", std::vector<float>{0.25f}, std::vector<glm::vec3>{{1.0f, -2.0f, 3.0f}}, 0));
+    channels.push_back(MakeChannel("rotation", times, std::vector<glm::quat>{glm::angleAxis(0.0f, glm::vec3(0.0f, 1.0f, 0.0f)),
+        glm::angleAxis(1.0f, glm::vec3(0.0f, 1.0f, 0.0f))}, 1));
+    const CompressedAnimation compressed(channels, 2.0f, MakeCompressSettings());
+    VOX_CHECK(compressed.GetKeyCount() == 3);
+
+    for (const float time : {0.0f, 0.25f, 1.0f, 2.0f})
+    {
+        VOX_CHECK(GetVectorError(compressed.EvaluateVector(0, time), glm::vec3(1.0f, -2.0f, 3.0f)) == 0.0f);
+    }
+    VOX_CHECK(GetRotationError(compressed.EvaluateRotation(1, 0.25f), channels[1].EvaluateRotation(0.25f)) < 1e-3f);
+    VOX_CHECK(GetRotationError(compressed.EvaluateRotation(1, 1.5f), glm::angleAxis(1.0f, glm::vec3(0.0f, 1.0f, 0.0f))) < 1e-3f);
+}
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include <tiny_gltf.h>
+
+#include "rendering/skeletal_mesh/AnimationChannel.h"
+
+namespace Vox::Test
+{
+    /**
+     * @brief Build a channel the way the loader does, from a model holding one sampler's keys
+     * @param path the glTF target path, "translation", "rotation" or "scale"
+     */
+    template <typename Value>
+    AnimationChannel MakeChannel(const std::string& path, const std::vector<float>& times, const std::vector<Value>& values, const int node = 0)
+    {
+        tinygltf::Model model;
+        model.buffers.resize(2);
+        model.buffers[0].data.resize(times.size() * sizeof(float));
+        std::memcpy(model.buffers[0].data.data(), times.data(), model.buffers[0].data.size());
+        model.buffers[1].data.resize(values.size() * sizeof(Value));
+        std::memcpy(model.buffers[1].data.data(), values.data(), model.buffers[1].data.size());
+
+        model.bufferViews.resize(2);
+        for (int i = 0; i < 2; ++i)
+        {
+            model.bufferViews[i].buffer = i;
+            model.bufferViews[i].byteLength = model.buffers[i].data.size();
+        }
+
+        tinygltf::Animation animation;
+        tinygltf::AnimationSampler& sampler = animation.samplers.emplace_back();
+        sampler.input = 0;
+        sampler.output = 1;
+        tinygltf::AnimationChannel& channel = animation.channels.emplace_back();
+        channel.sampler = 0;
+        channel.target_node = node;
+        channel.target_path = path;
+        return {model, animation, channel};
+    }
+
+    /**
+     * @brief Get the angle between two rotations, in radians
+     */
+    inline float GetRotationError(const glm::quat& a, const glm::quat& b)
+    {
+        const glm::quat x = glm::normalize(a);
+        const glm::quat y = glm::normalize(b);
+        const float dot = std::abs(x.x * y.x + x.y * y.y + x.z * y.z + x.w * y.w);
+        return 2.0f * std::acos(std::min(dot, 1.0f));
+    }
+
+    /**
+     * @brief Get the largest difference of any component
+     */
+    inline float GetVectorError(const glm::vec3& a, const glm::vec3& b)
+    {
+        return std::max({std::abs(a.x - b.x), std::abs(a.y - b.y), std::abs(a.z - b.z)});
+    }
+}
@@ -0,0 +1,165 @@
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "Test.h"
+#include "voxel/CollisionOctree.h"
+#include "voxel/TestChunks.h"
+
+using namespace Vox::Test;
+
+namespace
+{
+    constexpr int halfSize = static_cast<int>(testChunkSize / 2);
+
+    /**
+     * @return The solid voxels, indexed by [x][y][z]
+     */
+    std::vector<bool> MakeSolidMask(const std::vector<Voxel>& voxels)
+    {
+        std::vector<bool> solid(voxels.size());
+        for (size_t i = 0; i < voxels.size(); ++i)
+        {
+            solid[i] = voxels[i].materialId != 0;
+        }
+        return solid;
+    }
+
+    bool MatchesMask(const Octree::CollisionNode& node, const std::vector<bool>& solid)
+    {
+        for (unsigned int x = 0; x < testChunkSize; ++x)
+        {
+            for (unsigned int y = 0; y < testChunkSize; ++y)
+            {
+                for (unsigned int z = 0; z < testChunkSize; ++z)
+                {
+                    const Octree::PhysicsVoxel* voxel = node.GetVoxel(static_cast<int>(x) - halfSize, static_cast<int>(y) - halfSize, static_cast<int>(z) - halfSize);
+                    if ((voxel && voxel->solid) != solid[GetTestChunkIndex(x, y, z)])
+                    {
+                        return false;
+                    }
+                }
+            }
+        }
+        return true;
+    }
+
+    std::vector<Octree::PhysicsVoxel> MakePhysicsVoxels(const std::vector<Voxel>& voxels)
+    {
+        std::vector<Octree::PhysicsVoxel> physicsVoxels(voxels.size());
+        for (size_t i = 0; i < voxels.size(); ++i)
+        {
+            physicsVoxels[i].solid = voxels[i].materialId != 0;
+        }
+        return physicsVoxels;
+    }
+}
+
+VOX_TEST(CollisionNodeDenseBuild)
+{
+    // Both dense builds make the same tree as setting each solid voxel
+    for (const TestChunk chunk : testChunks)
+    {
+        const std::vector<Voxel> voxels = MakeTestChunk(chunk, 5);
+        Octree::CollisionNode byVoxel(testChunkSize);
+        for (unsigned int x = 0; x < testChunkSize; ++x)
+        {
+            for (unsigned int y = 0; y < testChunkSize; ++y)
+            {
+                for (unsigned int z = 0; z < testChunkSize; ++z)
+                {
+                    if (voxels[GetTestChunkIndex(x, y, z)].materialId != 0)
+                    {
+                        byVoxel.SetVoxel(static_cast<int>(x) - halfSize, static_cast<int>(y) - halfSize, static_cast<int>(z) - halfSize, Octree::PhysicsVoxel(true));
+                    }
+                }
+            }
+        }
+
+        const std::vector<char> packed = byVoxel.GetPacked();
+        VOX_CHECK(Octree::CollisionNode(testChunkSize, MakePhysicsVoxels(voxels).data()).GetPacked() == packed);
+        VOX_CHECK(Octree::CollisionNode(testChunkSize, voxels.data()).GetPacked() == packed);
+    }
+}
+
+VOX_TEST(CollisionNodeSetVoxel)
+{
+    for (const TestChunk chunk : testChunks)
+    {
+        const std::vector<Voxel> voxels = MakeTestChunk(chunk, 1);
+        std::vector<bool> solid = MakeSolidMask(voxels);
+        Octree::CollisionNode node(testChunkSize, voxels.data());
+        VOX_CHECK(node.GetSize() == testChunkSize);
+        VOX_CHECK(MatchesMask(node, solid));
+
+        std::mt19937 random(2);
+        for (int i = 0; i < 20000; ++i)
+        {
+            const unsigned int x = random() % testChunkSize;
+            const unsigned int y = random() % testChunkSize;
+            const unsigned int z = random() % testChunkSize;
+            const bool isSolid = random() % 2 == 0;
+            node.SetVoxel(static_cast<int>(x) - halfSize, static_cast<int>(y) - halfSize, static_cast<int>(z) - halfSize, Octree::PhysicsVoxel(isSolid));
+            solid[GetTestChunkIndex(x, y, z)] = isSolid;
+        }
+        VOX_CHECK(MatchesMask(node, solid));
+    }
+}
+
+VOX_TEST(CollisionNodeBoxes)
+{
+    for (const TestChunk chunk : testChunks)
+    {
+        const std::vector<Voxel> voxels = MakeTestChunk(chunk, 5);
+        const Octree::CollisionNode node(testChunkSize, voxels.data());
+        const std::vector<Octree::Box> boxes = node.GetBoxes();
+
+        // The boxes cover exactly the solid voxels, each of them once
+        std::vector<bool> covered(voxels.size());
+        bool overlaps = false;
+        for (const Octree::Box& box : boxes)
+        {
+            for (unsigned int x = 0; x < box.sizeX; ++x)
+            {
+                for (unsigned int y = 0; y < box.sizeY; ++y)
+                {
+                    for (unsigned int z = 0; z < box.sizeZ; ++z)
+                    {
+                        const size_t index = GetTestChunkIndex(box.x + halfSize + x, box.y + halfSize + y, box.z + halfSize + z);
+                        overlaps |= covered[index];
+                        covered[index] = true;
+                    }
+                }
+            }
+        }
+        VOX_CHECK(!overlaps);
+        VOX_CHECK(covered == MakeSolidMask(voxels));
+        VOX_CHECK(boxes.size() <= node.GetCubes().size());
+    }
+
+    // A solid chunk is one box
+    const std::vector<Voxel> solid = MakeTestChunk(TestChunk::Solid, 5);
+    VOX_CHECK(Octree::CollisionNode(testChunkSize, solid.data()).GetBoxes().size() == 1);
+}
+
+VOX_TEST(CollisionNodeFromPacked)
+{
+    for (const TestChunk chunk : testChunks)
+    {
+        const std::vector<Voxel> voxels = MakeTestChunk(chunk, 3);
+        const Octree::CollisionNode node(testChunkSize, voxels.data());
+        std::vector<char> packed = node.GetPacked();
+        const std::shared_ptr<Octree::CollisionNode> unpacked = Octree::CollisionNode::FromPacked(packed);
+        VOX_REQUIRE(unpacked);
+        VOX_CHECK(unpacked->GetSize() == testChunkSize);
+        VOX_CHECK(unpacked->GetPacked() == packed);
+        VOX_CHECK(MatchesMask(*unpacked, MakeSolidMask(voxels)));
+
+        packed.pop_back();
+        VOX_CHECK(!Octree::CollisionNode::FromPacked(packed));
+    }
+
+    // The size header alone, and less than that
+    VOX_CHECK(!Octree::CollisionNode::FromPacked({32, 0}));
+    VOX_CHECK(!Octree::CollisionNode::FromPacked({32}));
+}
@@ -0,0 +1,188 @@
+#include <random>
+#include <string>
+#include <vector>
+
+#include "Test.h"
+#include "voxel/LinearOctree.h"
+#include "voxel/TestChunks.h"
+#include "voxel/TypedOctree.h"
+#include "voxel/Voxel.h"
+
+using namespace Vox;
+using namespace Vox::Test;
+
+namespace
+{
+    constexpr int halfSize = static_cast<int>(testChunkSize / 2);
+
+    // The same conversion VoxelChunk saves with
+    char VoxelToChar(const Voxel& voxel)
+    {
+        return static_cast<char>(voxel.materialId + 48);
+    }
+
+    Voxel CharToVoxel(const char c)
+    {
+        Voxel result;
+        result.materialId = c - 48;
+        return result;
+    }
+
+    /**
+     * @brief Build a tree by setting each voxel that has a material, the way trees were built before the dense builder
+     */
+    template <typename Tree>
+    Tree BuildByVoxel(const std::vector<Voxel>& voxels)
+    {
+        Tree tree(testChunkSize);
+        for (unsigned int x = 0; x < testChunkSize; ++x)
+        {
+            for (unsigned int y = 0; y < testChunkSize; ++y)
+            {
+                for (unsigned int z = 0; z < testChunkSize; ++z)
+                {
+                    const Voxel& voxel = voxels[GetTestChunkIndex(x, y, z)];
+                    if (voxel.materialId != 0)
+                    {
+                        tree.SetData(static_cast<int>(x) - halfSize, static_cast<int>(y) - halfSize, static_cast<int>(z) - halfSize, voxel);
+                    }
+                }
+            }
+        }
+        return tree;
+    }
+
+    /**
+     * @brief Get a voxel, with unset voxels as Voxel()
+     */
+    template <typename Tree>
+    Voxel GetVoxel(const Tree& tree, const int x, const int y, const int z)
+    {
+        const Voxel* voxel = tree.GetData(x, y, z);
+        return voxel ? *voxel : Voxel();
+    }
+}
+
+VOX_TEST(LinearOctreeMatchesTypedNode)
+{
+    for (const TestChunk chunk : testChunks)
+    {
+        const std::vector<Voxel> voxels = MakeTestChunk(chunk, 1);
+        TypedNode<Voxel> typed = BuildByVoxel<TypedNode<Voxel>>(voxels);
+        LinearOctree<Voxel> linear = BuildByVoxel<LinearOctree<Voxel>>(voxels);
+        VOX_CHECK(linear.GetPacked(VoxelToChar) == typed.GetPacked(VoxelToChar));
+
+        // Random edits split and collapse nodes all over the tree
+        std::mt19937 random(2);
+        const auto editRandomly = [&](const unsigned int firstMaterial)
+        {
+            for (int i = 0; i < 20000; ++i)
+            {
+                const int x = static_cast<int>(random() % testChunkSize) - halfSize;
+                const int y = static_cast<int>(random() % testChunkSize) - halfSize;
+                const int z = static_cast<int>(random() % testChunkSize) - halfSize;
+                Voxel voxel;
+                voxel.materialId = firstMaterial + random() % 3;
+                typed.SetData(x, y, z, voxel);
+                linear.SetData(x, y, z, voxel);
+            }
+        };
+        editRandomly(1);
+        VOX_CHECK(linear.GetPacked(VoxelToChar) == typed.GetPacked(VoxelToChar));
+
+        // Setting Voxel() in an empty node collapses to a full node of Voxel() here, where TypedNode keeps a
+        // partial node, so only the voxels are compared once edits clear them
+        editRandomly(0);
+        bool voxelsMatch = true;
+        for (int x = -halfSize; x < halfSize; ++x)
+        {
+            for (int y = -halfSize; y < halfSize; ++y)
+            {
+                for (int z = -halfSize; z < halfSize; ++z)
+                {
+                    voxelsMatch &= GetVoxel(linear, x, y, z) == GetVoxel(typed, x, y, z);
+                }
+            }
+        }
+        VOX_CHECK(voxelsMatch);
+    }
+}
+
+VOX_TEST(LinearOctreeDenseBuild)
+{
+    // The bottom-up build makes the same tree as setting each voxel, so it packs the same bytes
+    for (const TestChunk chunk : testChunks)
+    {
+        const std::vector<Voxel> voxels = MakeTestChunk(chunk, 5);
+        const LinearOctree<Voxel> dense(testChunkSize, voxels.data());
+        VOX_CHECK(dense.GetPacked(VoxelToChar) == BuildByVoxel<LinearOctree<Voxel>>(voxels).GetPacked(VoxelToChar));
+    }
+}
+
+VOX_TEST(LinearOctreeFromPacked)
+{
+    for (const TestChunk chunk : testChunks)
+    {
+        const std::vector<Voxel> voxels = MakeTestChunk(chunk, 3);
+        const std::string packed = BuildByVoxel<LinearOctree<Voxel>>(voxels).GetPacked(VoxelToChar);
+        const std::shared_ptr<LinearOctree<Voxel>> unpacked = LinearOctree<Voxel>::FromPacked(packed, CharToVoxel);
+        VOX_REQUIRE(unpacked);
+        VOX_CHECK(unpacked->GetSize() == testChunkSize);
+        VOX_CHECK(unpacked->GetPacked(VoxelToChar) == packed);
+
+        bool voxelsMatch = true;
+        for (unsigned int x = 0; x < testChunkSize; ++x)
+        {
+            for (unsigned int y = 0; y < testChunkSize; ++y)
+            {
+                for (unsigned int z = 0; z < testChunkSize; ++z)
+                {
+                    voxelsMatch &= GetVoxel(*unpacked, static_cast<int>(x) - halfSize, static_cast<int>(y) - halfSize,
+                        static_cast<int>(z) - halfSize) == voxels[GetTestChunkIndex(x, y, z)];
+                }
+            }
+        }
+        VOX_CHECK(voxelsMatch);
+
+        // Anything short of the whole stream is rejected, rather than read past its end
+        for (size_t length = 0; length < packed.size(); length += 1 + packed.size() / 64)
+        {
+            VOX_CHECK(!LinearOctree<Voxel>::FromPacked(std::string_view(packed).substr(0, length), CharToVoxel));
+        }
+    }
+
+    VOX_CHECK(!LinearOctree<Voxel>::FromPacked("32,X", CharToVoxel));
+    VOX_CHECK(!LinearOctree<Voxel>::FromPacked("abc,E", CharToVoxel));
+    VOX_CHECK(!LinearOctree<Voxel>::FromPacked("", CharToVoxel));
+}
+
+VOX_TEST(LinearOctreeReusesFreedNodes)
+{
+    // Filling a box splits nodes, and clearing it collapses them again, so the same blocks are used each time
+    LinearOctree<Voxel> tree = BuildByVoxel<LinearOctree<Voxel>>(MakeTestChunk(TestChunk::Terrain, 4));
+    size_t poolSize = 0;
+    for (int stroke = 0; stroke < 1000; ++stroke)
+    {
+        for (const unsigned int material : {5u, 0u})
+        {
+            Voxel voxel;
+            voxel.materialId = material;
+            for (int x = -3; x < 3; ++x)
+            {
+                for (int y = 5; y < 11; ++y)
+                {
+                    for (int z = -7; z < -1; ++z)
+                    {
+                        tree.SetData(x, y, z, voxel);
+                    }
+                }
+            }
+        }
+
+        if (stroke == 0)
+        {
+            poolSize = tree.GetPoolSize();
+        }
+    }
+    VOX_CHECK(tree.GetPoolSize() == poolSize);
+}
@@ -0,0 +1,100 @@
+#include <string>
+#include <vector>
+
+#include "Test.h"
+#include "voxel/LinearOctree.h"
+#include "voxel/PackedOctree.h"
+#include "voxel/TestChunks.h"
+#include "voxel/TypedOctree.h"
+#include "voxel/Voxel.h"
+
+using namespace Vox;
+using namespace Vox::Test;
+
+namespace
+{
+    constexpr int halfSize = static_cast<int>(testChunkSize / 2);
+
+    using TestChunkOctree = PackedOctree<Voxel, testChunkSize>;
+
+    // The same conversion VoxelChunk saves with, as lambdas so they are inlined
+    constexpr auto voxelToChar = [](const Voxel& voxel)
+    {
+        return static_cast<char>(voxel.materialId + 48);
+    };
+
+    constexpr auto charToVoxel = [](const char c)
+    {
+        Voxel result;
+        result.materialId = c - 48;
+        return result;
+    };
+
+    /**
+     * @brief Voxels with a material no test chunk uses, to show which ones Unpack wrote
+     */
+    std::vector<Voxel> MakeFilledVoxels()
+    {
+        Voxel filler;
+        filler.materialId = 77;
+        return std::vector<Voxel>(testChunkSize * testChunkSize * testChunkSize, filler);
+    }
+}
+
+VOX_TEST(PackedOctreePack)
+{
+    // The same bytes as both trees, built the way each is built in the engine
+    for (const TestChunk chunk : testChunks)
+    {
+        const std::vector<Voxel> voxels = MakeTestChunk(chunk, 5);
+        TypedNode<Voxel> typed(testChunkSize);
+        for (unsigned int x = 0; x < testChunkSize; ++x)
+        {
+            for (unsigned int y = 0; y < testChunkSize; ++y)
+            {
+                for (unsigned int z = 0; z < testChunkSize; ++z)
+                {
+                    const Voxel& voxel = voxels[GetTestChunkIndex(x, y, z)];
+                    if (voxel.materialId != 0)
+                    {
+                        typed.SetData(static_cast<int>(x) - halfSize, static_cast<int>(y) - halfSize, static_cast<int>(z) - halfSize, voxel);
+                    }
+                }
+            }
+        }
+
+        const std::string packed = TestChunkOctree::Pack(voxels.data(), voxelToChar);
+        VOX_CHECK(packed == typed.GetPacked(voxelToChar));
+        VOX_CHECK(packed == LinearOctree<Voxel>(testChunkSize, voxels.data()).GetPacked(voxelToChar));
+
+        // Data packed at another size is rejected
+        using HalfSizeOctree = PackedOctree<Voxel, testChunkSize / 2>;
+        std::vector<Voxel> unpacked = MakeFilledVoxels();
+        VOX_CHECK(!HalfSizeOctree::Unpack(packed, unpacked.data(), charToVoxel));
+    }
+}
+
+VOX_TEST(PackedOctreeUnpack)
+{
+    for (const TestChunk chunk : testChunks)
+    {
+        const std::vector<Voxel> voxels = MakeTestChunk(chunk, 5);
+        const std::string packed = LinearOctree<Voxel>(testChunkSize, voxels.data()).GetPacked(voxelToChar);
+
+        // Every voxel is written, with empty nodes as Voxel()
+        std::vector<Voxel> unpacked = MakeFilledVoxels();
+        VOX_REQUIRE(TestChunkOctree::Unpack(packed, unpacked.data(), charToVoxel));
+        VOX_CHECK(unpacked == voxels);
+
+        // Anything short of the whole stream is rejected, rather than read past its end
+        for (size_t length = 0; length < packed.size(); length += 1 + packed.size() / 64)
+        {
+            VOX_CHECK(!TestChunkOctree::Unpack(std::string_view(packed).substr(0, length), unpacked.data(), charToVoxel));
+        }
+    }
+
+    std::vector<Voxel> unpacked = MakeFilledVoxels();
+    VOX_CHECK(!TestChunkOctree::Unpack("32,X", unpacked.data(), charToVoxel));
+    VOX_CHECK(!TestChunkOctree::Unpack("abc,E", unpacked.data(), charToVoxel));
+    VOX_CHECK(!TestChunkOctree::Unpack("", unpacked.data(), charToVoxel));
+}
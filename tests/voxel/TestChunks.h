@@ -0,0 +1,78 @@
+#pragma once
+
+#include <array>
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "voxel/Voxel.h"
+
+namespace Vox::Test
+{
+    constexpr unsigned int testChunkSize = 32;
+
+    enum class TestChunk
+    {
+        // Rolling hills, with a few materials in layers
+        Terrain,
+        Solid,
+        // Uniform random, a third of the voxels set
+        Noise,
+        Empty,
+        // Terrain with a tenth of the buried voxels removed
+        Caves
+    };
+
+    constexpr std::array<TestChunk, 5> testChunks = {TestChunk::Terrain, TestChunk::Solid, TestChunk::Noise, TestChunk::Empty, TestChunk::Caves};
+
+    inline const char* GetTestChunkName(const TestChunk chunk)
+    {
+        constexpr std::array<const char*, 5> names = {"terrain", "solid", "noise", "empty", "caves"};
+        return names[static_cast<int>(chunk)];
+    }
+
+    inline size_t GetTestChunkIndex(const unsigned int x, const unsigned int y, const unsigned int z)
+    {
+        return (x * testChunkSize + y) * testChunkSize + z;
+    }
+
+    /**
+     * @return testChunkSize^3 voxels, indexed by [x][y][z], with materials 1 to 4 for the set ones
+     */
+    inline std::vector<Voxel> MakeTestChunk(const TestChunk chunk, const unsigned int seed)
+    {
+        std::mt19937 random(seed);
+        std::vector<Voxel> voxels(testChunkSize * testChunkSize * testChunkSize);
+        for (unsigned int x = 0; x < testChunkSize; ++x)
+        {
+            for (unsigned int z = 0; z < testChunkSize; ++z)
+            {
+                const int height = 12 + static_cast<int>(6.0f * std::sin(static_cast<float>(x) * 0.3f) + 5.0f * std::cos(static_cast<float>(z) * 0.23f));
+                for (unsigned int y = 0; y < testChunkSize; ++y)
+                {
+                    const int depth = height - static_cast<int>(y);
+                    unsigned int material = 0;
+                    switch (chunk)
+                    {
+                    case TestChunk::Terrain:
+                        material = depth > 3 ? 1 : depth > 0 ? 2 + random() % 2 : 0;
+                        break;
+                    case TestChunk::Solid:
+                        material = 1;
+                        break;
+                    case TestChunk::Noise:
+                        material = random() % 3 == 0 ? 1 + random() % 4 : 0;
+                        break;
+                    case TestChunk::Empty:
+                        break;
+                    case TestChunk::Caves:
+                        material = depth > 2 ? (random() % 10 == 0 ? 0 : 1) : depth > 0 ? 4 : 0;
+                        break;
+                    }
+                    voxels[GetTestChunkIndex(x, y, z)].materialId = material;
+                }
+            }
+        }
+        return voxels;
+    }
+}
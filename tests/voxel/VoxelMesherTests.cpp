@@ -0,0 +1,317 @@
+#include <array>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "Test.h"
+#include "voxel/VoxelMesher.h"
+
+using namespace Vox;
+
+namespace
+{
+    using PaddedVoxelArray = VoxelChunk::PaddedVoxelArray;
+
+    constexpr int size = VoxelChunk::chunkSize;
+
+    /**
+     * @brief How voxelGeneration.comp scans the slices of one face direction
+     * Each slice is scanned row by row, and each row along the column axis. Axes are 0 for x, 1 for y and 2 for z
+     */
+    struct ShaderFace
+    {
+        int sliceAxis;
+        int rowAxis;
+        int columnAxis;
+
+        // Direction of the neighbour that hides the face, along the slice axis
+        int normalStep;
+
+        // Written to the vertex buffer back to front, see the atomicInsertQuad functions
+        bool reversed;
+    };
+
+    // Indexed by VoxelFace
+    constexpr std::array<ShaderFace, voxelFaceCount> shaderFaces = {{
+        {1, 2, 0, 1, true},
+        {1, 2, 0, -1, false},
+        {0, 1, 2, -1, false},
+        {0, 1, 2, 1, true},
+        {2, 1, 0, 1, false},
+        {2, 1, 0, -1, true}
+    }};
+
+    unsigned int GetShaderTexture(const VoxelMaterial& material, const VoxelFace face)
+    {
+        const std::array<unsigned int, voxelFaceCount> textures = {
+            material.top, material.bottom, material.left, material.right, material.front, material.back
+        };
+        return textures[static_cast<int>(face)];
+    }
+
+    /**
+     * @brief A direct port of voxelGeneration.comp, one voxel at a time, with the slices in dispatch order
+     */
+    std::vector<VoxelVertex> MeshLikeShader(const PaddedVoxelArray& voxels, const std::vector<VoxelMaterial>& materials)
+    {
+        const auto getVoxel = [&voxels](const glm::ivec3& position)
+        {
+            return voxels[position.x + 1][position.y + 1][position.z + 1].materialId;
+        };
+
+        std::vector<VoxelVertex> result;
+        for (int faceIndex = 0; faceIndex < voxelFaceCount; ++faceIndex)
+        {
+            const VoxelFace face = static_cast<VoxelFace>(faceIndex);
+            const ShaderFace& layout = shaderFaces[faceIndex];
+            for (int slice = 0; slice < size; ++slice)
+            {
+                const auto getPosition = [&](const int row, const int column)
+                {
+                    glm::ivec3 position;
+                    position[layout.sliceAxis] = slice;
+                    position[layout.rowAxis] = row;
+                    position[layout.columnAxis] = column;
+                    return position;
+                };
+                const auto isExposed = [&](const int row, const int column, const unsigned int material)
+                {
+                    glm::ivec3 neighbour = getPosition(row, column);
+                    neighbour[layout.sliceAxis] += layout.normalStep;
+                    return getVoxel(getPosition(row, column)) == material && getVoxel(neighbour) == 0;
+                };
+
+                // Indexed by [row][column]
+                std::array<std::array<bool, size>, size> visited = {};
+                for (int row = 0; row < size; ++row)
+                {
+                    for (int column = 0; column < size; ++column)
+                    {
+                        const unsigned int material = getVoxel(getPosition(row, column));
+                        if (visited[row][column] || material == 0 || material > materials.size() || !isExposed(row, column, material))
+                        {
+                            continue;
+                        }
+
+                        int columnEnd = column;
+                        for (; columnEnd < size && !visited[row][columnEnd] && isExposed(row, columnEnd, material); ++columnEnd)
+                        {
+                            visited[row][columnEnd] = true;
+                        }
+
+                        int rowEnd = row + 1;
+                        for (; rowEnd < size; ++rowEnd)
+                        {
+                            bool rowInterrupted = false;
+                            for (int subColumn = column; subColumn < columnEnd; ++subColumn)
+                            {
+                                rowInterrupted |= visited[rowEnd][subColumn] || !isExposed(rowEnd, subColumn, material);
+                            }
+                            if (rowInterrupted)
+                            {
+                                break;
+                            }
+                            for (int subColumn = column; subColumn < columnEnd; ++subColumn)
+                            {
+                                visited[rowEnd][subColumn] = true;
+                            }
+                        }
+
+                        const int width = columnEnd - column;
+                        const int height = rowEnd - row;
+                        const unsigned int texture = GetShaderTexture(materials[material - 1], face);
+                        glm::ivec3 origin = getPosition(row, column);
+                        origin[layout.sliceAxis] += layout.normalStep > 0 ? 1 : 0;
+
+                        // Corners in the order the shader writes them to indices 0 to 5, before reversing
+                        const std::array<glm::ivec2, 6> corners = {{{0, 0}, {width, 0}, {0, height}, {width, height}, {0, height}, {width, 0}}};
+                        std::array<VoxelVertex, 6> quad;
+                        for (size_t i = 0; i < corners.size(); ++i)
+                        {
+                            glm::ivec3 position = origin;
+                            position[layout.columnAxis] += corners[i].x;
+                            position[layout.rowAxis] += corners[i].y;
+                            quad[layout.reversed ? 5 - i : i] = VoxelVertex::Pack(glm::uvec3(position), face, glm::uvec2(corners[i]), texture);
+                        }
+                        result.insert(result.end(), quad.begin(), quad.end());
+
+                        column = columnEnd - 1;
+                    }
+                }
+            }
+        }
+        return result;
+    }
+
+    enum class ChunkShape
+    {
+        Noise,
+        Terrain,
+        Solid,
+        Sparse
+    };
+
+    /**
+     * @brief Fill the chunk, leaving the apron empty
+     */
+    void FillChunk(PaddedVoxelArray& voxels, const ChunkShape shape, const unsigned int materialCount, const unsigned int seed)
+    {
+        std::mt19937 random(seed);
+        voxels = {};
+        for (int x = 0; x < size; ++x)
+        {
+            for (int y = 0; y < size; ++y)
+            {
+                for (int z = 0; z < size; ++z)
+                {
+                    unsigned int material = 0;
+                    switch (shape)
+                    {
+                    case ChunkShape::Noise:
+                        material = random() % (materialCount + 2);
+                        break;
+                    case ChunkShape::Terrain:
+                        material = y < 10 + (x * z) % 7 ? 1 + (x / 8 + z / 8 + y / 4) % materialCount : 0;
+                        break;
+                    case ChunkShape::Solid:
+                        material = materialCount;
+                        break;
+                    case ChunkShape::Sparse:
+                        material = random() % 10 < 7 ? 1 + random() % 2 : 0;
+                        break;
+                    }
+                    voxels[x + 1][y + 1][z + 1].materialId = material;
+                }
+            }
+        }
+    }
+
+    std::vector<VoxelMaterial> MakeMaterials()
+    {
+        return {VoxelMaterial(0), VoxelMaterial(1), VoxelMaterial(2), VoxelMaterial(3, 3, 4)};
+    }
+}
+
+VOX_TEST(VoxelMesherMatchesShader)
+{
+    const std::vector<VoxelMaterial> materials = MakeMaterials();
+    const auto voxels = std::make_unique<PaddedVoxelArray>();
+    std::vector<VoxelVertex> vertices;
+    for (const ChunkShape shape : {ChunkShape::Noise, ChunkShape::Terrain, ChunkShape::Solid, ChunkShape::Sparse})
+    {
+        for (unsigned int seed = 0; seed < 3; ++seed)
+        {
+            FillChunk(*voxels, shape, static_cast<unsigned int>(materials.size()), seed);
+            VoxelMesher::GenerateMesh(*voxels, materials, vertices);
+            VOX_CHECK(vertices == MeshLikeShader(*voxels, materials));
+        }
+    }
+}
+
+VOX_TEST(VoxelMesherSolidChunk)
+{
+    const std::vector<VoxelMaterial> materials = MakeMaterials();
+    const auto voxels = std::make_unique<PaddedVoxelArray>();
+    FillChunk(*voxels, ChunkShape::Solid, static_cast<unsigned int>(materials.size()), 0);
+
+    // One quad per side, covering the whole chunk, with the material's texture for that side
+    std::vector<VoxelVertex> vertices;
+    VoxelMesher::GenerateMesh(*voxels, materials, vertices);
+    VOX_REQUIRE(vertices.size() == 6 * voxelFaceCount);
+    for (const VoxelVertex& vertex : vertices)
+    {
+        const glm::uvec2 texCoord = vertex.GetTexCoord();
+        VOX_CHECK((texCoord.x == 0 || texCoord.x == size) && (texCoord.y == 0 || texCoord.y == size));
+        const bool horizontal = vertex.GetFace() == VoxelFace::Top || vertex.GetFace() == VoxelFace::Bottom;
+        VOX_CHECK(vertex.GetTexture() == (horizontal ? 3u : 4u));
+    }
+
+    *voxels = {};
+    VoxelMesher::GenerateMesh(*voxels, materials, vertices);
+    VOX_CHECK(vertices.empty());
+}
+
+VOX_TEST(VoxelMesherManyMaterials)
+{
+    // Every material is meshed in the same pass, so a large palette only changes which quads merge
+    std::vector<VoxelMaterial> materials;
+    for (unsigned int i = 0; i < 300; ++i)
+    {
+        materials.emplace_back(i % 7, i % 5, i % 3);
+    }
+
+    const auto voxels = std::make_unique<PaddedVoxelArray>();
+    std::vector<VoxelVertex> vertices;
+    for (const ChunkShape shape : {ChunkShape::Noise, ChunkShape::Terrain})
+    {
+        for (unsigned int seed = 0; seed < 2; ++seed)
+        {
+            FillChunk(*voxels, shape, static_cast<unsigned int>(materials.size()), seed);
+            VoxelMesher::GenerateMesh(*voxels, materials, vertices);
+            VOX_CHECK(vertices == MeshLikeShader(*voxels, materials));
+        }
+    }
+}
+
+VOX_TEST(VoxelMesherUnknownMaterials)
+{
+    // Voxels whose material isn't in the table hide their neighbours' faces, but have none of their own
+    const std::vector<VoxelMaterial> materials = MakeMaterials();
+    const auto voxels = std::make_unique<PaddedVoxelArray>();
+    (*voxels)[5][5][5].materialId = 1;
+    (*voxels)[5][6][5].materialId = 99;
+
+    std::vector<VoxelVertex> vertices;
+    VoxelMesher::GenerateMesh(*voxels, materials, vertices);
+    VOX_CHECK(vertices.size() == 5 * 6);
+    for (const VoxelVertex& vertex : vertices)
+    {
+        VOX_CHECK(vertex.GetFace() != VoxelFace::Top);
+    }
+}
+
+VOX_TEST(VoxelMesherCullsAcrossChunks)
+{
+    const std::vector<VoxelMaterial> materials = MakeMaterials();
+    const auto voxels = std::make_unique<PaddedVoxelArray>();
+
+    // A solid 2x1 slab, meshed from the left chunk, with the right chunk's border in the apron
+    for (int x = 1; x < size + 2; ++x)
+    {
+        for (int y = 1; y <= size; ++y)
+        {
+            for (int z = 1; z <= size; ++z)
+            {
+                (*voxels)[x][y][z].materialId = 1;
+            }
+        }
+    }
+    std::vector<VoxelVertex> vertices;
+    VoxelMesher::GenerateMesh(*voxels, materials, vertices);
+    VOX_CHECK(vertices.size() == 5 * 6);
+    for (const VoxelVertex& vertex : vertices)
+    {
+        VOX_CHECK(vertex.GetFace() != VoxelFace::Right);
+    }
+
+    // Random neighbours on every side, which only ever hide faces
+    for (unsigned int seed = 0; seed < 4; ++seed)
+    {
+        FillChunk(*voxels, seed % 2 == 0 ? ChunkShape::Terrain : ChunkShape::Sparse, static_cast<unsigned int>(materials.size()), seed);
+        std::mt19937 random(seed);
+        for (int a = 1; a <= size; ++a)
+        {
+            for (int b = 1; b <= size; ++b)
+            {
+                for (const int side : {0, size + 1})
+                {
+                    (*voxels)[side][a][b].materialId = random() % 2;
+                    (*voxels)[a][side][b].materialId = random() % 2;
+                    (*voxels)[a][b][side].materialId = random() % 2;
+                }
+            }
+        }
+        VoxelMesher::GenerateMesh(*voxels, materials, vertices);
+        VOX_CHECK(vertices == MeshLikeShader(*voxels, materials));
+    }
+}
@@ -0,0 +1,52 @@
+#include "Test.h"
+#include "voxel/VoxelVertex.h"
+
+using namespace Vox;
+
+VOX_TEST(VoxelVertexRoundTrip)
+{
+    // Quad corners reach one past the last voxel, so positions and texture coordinates go up to the chunk size
+    for (unsigned int x = 0; x <= 32; ++x)
+    {
+        for (unsigned int y = 0; y <= 32; ++y)
+        {
+            for (unsigned int z = 0; z <= 32; ++z)
+            {
+                for (int faceIndex = 0; faceIndex < voxelFaceCount; ++faceIndex)
+                {
+                    const VoxelFace face = static_cast<VoxelFace>(faceIndex);
+                    const unsigned int texture = (x * 7919 + y * 31 + z) % (VoxelVertex::maxTexture + 1);
+                    const VoxelVertex vertex = VoxelVertex::Pack({x, y, z}, face, {z, x}, texture);
+                    VOX_REQUIRE(vertex.GetPosition() == glm::uvec3(x, y, z));
+                    VOX_REQUIRE(vertex.GetFace() == face);
+                    VOX_REQUIRE(vertex.GetTexCoord() == glm::uvec2(z, x));
+                    VOX_REQUIRE(vertex.GetTexture() == texture);
+                }
+            }
+        }
+    }
+}
+
+VOX_TEST(VoxelVertexLimits)
+{
+    const VoxelVertex vertex = VoxelVertex::Pack(glm::uvec3(VoxelVertex::maxAxisValue), VoxelFace::Back,
+        glm::uvec2(VoxelVertex::maxAxisValue), VoxelVertex::maxTexture);
+    VOX_CHECK(vertex.GetPosition() == glm::uvec3(VoxelVertex::maxAxisValue));
+    VOX_CHECK(vertex.GetFace() == VoxelFace::Back);
+    VOX_CHECK(vertex.GetTexCoord() == glm::uvec2(VoxelVertex::maxAxisValue));
+    VOX_CHECK(vertex.GetTexture() == VoxelVertex::maxTexture);
+
+    // Matches the shader's PackVertex bit for bit
+    VOX_CHECK(VoxelVertex::Pack({1, 2, 3}, VoxelFace::Front, {4, 5}, 6).positionFace == (1u | 2u << 6 | 3u << 12 | 4u << 18));
+    VOX_CHECK(VoxelVertex::Pack({1, 2, 3}, VoxelFace::Front, {4, 5}, 6).texCoordTexture == (4u | 5u << 6 | 6u << 12));
+}
+
+VOX_TEST(VoxelVertexNormals)
+{
+    const glm::vec3 normals[] = {{0, 1, 0}, {0, -1, 0}, {-1, 0, 0}, {1, 0, 0}, {0, 0, 1}, {0, 0, -1}};
+    for (int faceIndex = 0; faceIndex < voxelFaceCount; ++faceIndex)
+    {
+        const VoxelVertex vertex = VoxelVertex::Pack({0, 0, 0}, static_cast<VoxelFace>(faceIndex), {0, 0}, 0);
+        VOX_CHECK(vertex.GetNormal() == normals[faceIndex]);
+    }
+}